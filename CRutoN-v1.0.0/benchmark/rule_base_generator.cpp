@@ -0,0 +1,466 @@
+/*==============================================================================
+	Rule Base Generator
+
+	Generates synthetic grammar, data extraction rule, control rule and
+	initial values files of a given size, together with a resolution policy
+	answering every prompt they raise, so that the scaling of parsing and
+	translation can be measured.
+
+	File			: rule_base_generator.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/*==============================================================================
+	Generator Parameters
+==============================================================================*/
+/*------------------------------------------------------------------------------
+	The size and shape of the generated rule base.
+------------------------------------------------------------------------------*/
+struct GeneratorParameters
+{
+	GeneratorParameters() : num_behaviours(100), num_variables(100),
+		num_timing_constraints(10), nesting_depth(2), group_size(4),
+		ambiguity_rate(10), seed(1), prefix("synthetic") {}
+
+	// the number of behaviours, including the nested behaviours
+	int num_behaviours;
+	// the number of variables, half propositional and half enumerated
+	int num_variables;
+	// the number of preconditions constraining the time of day
+	int num_timing_constraints;
+	// the length of each chain of behaviours executing the next one, the
+	// first of each chain being schedulable
+	int nesting_depth;
+	// the number of schedulable behaviours sharing each priority
+	int group_size;
+	// the percentage of variable references spelt differently from the
+	// variable's first reference, each raising an identifier prompt
+	int ambiguity_rate;
+	// the seed of the random choices
+	int seed;
+	// the prefix of the generated file names
+	std::string prefix;
+};
+
+/*==============================================================================
+	Constants
+==============================================================================*/
+/*------------------------------------------------------------------------------
+	The number of values of each enumerated variable.
+------------------------------------------------------------------------------*/
+static const int NUM_ENUM_VALUES = 4;
+
+/*------------------------------------------------------------------------------
+	The number of letters in each generated name.
+------------------------------------------------------------------------------*/
+static const int NAME_LENGTH = 8;
+
+/*------------------------------------------------------------------------------
+	The grammar, using a distinct keyword for each kind of rule so that no
+	line is accepted by two grammar rules.
+------------------------------------------------------------------------------*/
+static const char* GRAMMAR_RULES =
+	"<pvc1> ::= +<any_text> 'is' <any_text>\n"
+	"<evc1> ::= +<any_text> 'equals' <any_text>\n"
+	"<tc1> ::= 'Time' 'is' 'between' <time> 'and' <time>\n"
+	"<pva1> ::= 'SET' +<any_text> 'TO' <any_text>\n"
+	"<eva1> ::= 'MOVE' +<any_text> 'TO' <any_text>\n"
+	"<exb1> ::= 'Execute' 'sequence' <any_text>\n"
+	"<del1> ::= 'Wait' 'for' <integer> 'seconds'\n";
+
+/*------------------------------------------------------------------------------
+	The data extraction rules for the grammar.
+------------------------------------------------------------------------------*/
+static const char* DATA_EXTRACTION_RULES =
+	"pvc1; prop_name = [1]; truth_value = [3]; true = \"true\"; "
+		"false = \"false\"; non_deterministic = false;\n"
+	"evc1; enum_name = [1]; enum_value = [3]; has_none_value = false; "
+		"non_deterministic = false;\n"
+	"tc1; start_time = [4]; end_time = [6];\n"
+	"pva1; prop_name = [2]; truth_value = [4]; true = \"true\"; "
+		"false = \"false\";\n"
+	"eva1; enum_name = [2]; enum_value = [4]; resets = false;\n"
+	"exb1; behaviour_name = [3];\n"
+	"del1; seconds = [3];\n";
+
+/*------------------------------------------------------------------------------
+	The answers to every prompt: a near match of a variable name is the
+	variable it was meant to be.
+------------------------------------------------------------------------------*/
+static const char* RESOLUTION_POLICY =
+	"identifier\t*\tu\n"
+	"no_preconditions\t*\ti\n"
+	"overwrite\t*\ty\n";
+
+/*==============================================================================
+	Function Prototypes
+==============================================================================*/
+bool parseParameters(int argc, char** argv, GeneratorParameters& p);
+void displayUsage(const char* name);
+const std::string uniqueName(const char prefix, const int n,
+	const bool is_split);
+const std::string generateControlRules(const GeneratorParameters& p,
+	std::string& initial_values);
+bool writeFile(const std::string& filename, const std::string& s);
+
+/*==============================================================================
+	Main
+==============================================================================*/
+int main(int argc, char** argv)
+{
+	GeneratorParameters p;
+	if(!parseParameters(argc, argv, p))
+	{
+		displayUsage(argv[0]);
+		return 1;
+	}
+	std::string initial_values;
+	std::string control_rules = generateControlRules(p, initial_values);
+	if(!writeFile(p.prefix + "-GrammarRules.txt", GRAMMAR_RULES)
+		|| !writeFile(p.prefix + "-DataExtractionRules.txt",
+			DATA_EXTRACTION_RULES)
+		|| !writeFile(p.prefix + "-ControlRules.txt", control_rules)
+		|| !writeFile(p.prefix + "-InitialValues.txt", initial_values)
+		|| !writeFile(p.prefix + "-ResolutionPolicy.txt", RESOLUTION_POLICY))
+	{
+		return 1;
+	}
+	return 0;
+}
+
+/*------------------------------------------------------------------------------
+	parseParameters
+
+	Parses the command line parameters and returns true if successful or
+	false otherwise.
+................................................................................
+	@param	argc				the number of parameters
+	@param	argv				the parameters
+	@param	p					the generator parameters to set
+------------------------------------------------------------------------------*/
+bool parseParameters(int argc, char** argv, GeneratorParameters& p)
+{
+	for(int i = 1; i < argc; i++)
+	{
+		std::string option = argv[i];
+		if(i + 1 == argc)
+		{
+			std::cerr << "missing value for option \'" << option << "\'\n";
+			return false;
+		}
+		std::string value = argv[++i];
+		if(option == "-o")
+		{
+			p.prefix = value;
+			continue;
+		}
+		int* parameter = option == "-b" ? &p.num_behaviours
+			: option == "-v" ? &p.num_variables
+			: option == "-t" ? &p.num_timing_constraints
+			: option == "-d" ? &p.nesting_depth
+			: option == "-g" ? &p.group_size
+			: option == "-a" ? &p.ambiguity_rate
+			: option == "-s" ? &p.seed
+			: nullptr;
+		char* end;
+		long n = std::strtol(value.c_str(), &end, 10);
+		if(parameter == nullptr || *end != '\0' || n < 0 || n > 1000000)
+		{
+			std::cerr << "invalid option \'" << option << " " << value
+				<< "\'\n";
+			return false;
+		}
+		*parameter = (int)n;
+	}
+	if(p.num_behaviours < 1 || p.num_variables < 2 || p.nesting_depth < 1
+		|| p.group_size < 1 || p.ambiguity_rate > 100)
+	{
+		std::cerr << "there must be at least 1 behaviour, 2 variables, a "
+			"nesting depth and group size of at least 1, and an ambiguity "
+			"rate of at most 100\n";
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	displayUsage
+
+	Displays the command line options.
+................................................................................
+	@param	name				the name of the executable
+------------------------------------------------------------------------------*/
+void displayUsage(const char* name)
+{
+	GeneratorParameters p;
+	std::cerr << "usage: " << name << " [options]\n"
+		<< "\t-b <n>\t\tnumber of behaviours, default: " << p.num_behaviours
+			<< "\n"
+		<< "\t-v <n>\t\tnumber of variables, default: " << p.num_variables
+			<< "\n"
+		<< "\t-t <n>\t\tnumber of timing constraints, default: "
+			<< p.num_timing_constraints << "\n"
+		<< "\t-d <n>\t\tnesting depth of behaviour executions, default: "
+			<< p.nesting_depth << "\n"
+		<< "\t-g <n>\t\tschedulable behaviours of equal priority, default: "
+			<< p.group_size << "\n"
+		<< "\t-a <n>\t\tpercentage of ambiguous variable references, "
+			"default: " << p.ambiguity_rate << "\n"
+		<< "\t-s <n>\t\tseed of the random choices, default: " << p.seed
+			<< "\n"
+		<< "\t-o <prefix>\tprefix of the generated files, default: "
+			<< p.prefix << "\n";
+}
+
+/*------------------------------------------------------------------------------
+	uniqueName
+
+	Returns a name which is distinct for each number, and which shares so
+	few letters with the names of the other numbers that no two names are
+	matched as similar identifiers. The split form of a name, with a space
+	between the halves of its letters, is similar enough to be matched with
+	the name itself.
+................................................................................
+	@param	prefix				the character starting the name
+	@param	n					the number
+	@param	is_split			true if the split form should be returned
+	@return						the name
+------------------------------------------------------------------------------*/
+const std::string uniqueName(const char prefix, const int n,
+	const bool is_split)
+{
+	// multiplying by a number coprime with 26 permutes the residues modulo
+	// 26^NAME_LENGTH, scattering the letters of consecutive numbers
+	unsigned long long modulus = 1;
+	for(int i = 0; i < NAME_LENGTH; i++)
+	{
+		modulus *= 26;
+	}
+	unsigned long long scrambled = (n * 123456789011ULL + 12345) % modulus;
+	std::string name = std::string(1, prefix) + "-";
+	for(int i = 0; i < NAME_LENGTH; i++)
+	{
+		if(is_split && i == NAME_LENGTH / 2)
+		{
+			name += " ";
+		}
+		name += (char)('a' + scrambled % 26);
+		scrambled /= 26;
+	}
+	return name;
+}
+
+/*------------------------------------------------------------------------------
+	generateControlRules
+
+	Returns the control rules of the generated rule base, and sets the
+	initial values of the variables they refer to.
+
+	The behaviours are divided into chains of nesting_depth behaviours, each
+	executing the next in its chain. The first behaviour of a chain is
+	schedulable, with preconditions checking random variables, and the
+	others are not. The timing constraints are added to the preconditions of
+	the schedulable behaviours in turn, and every fourth schedulable
+	behaviour has a disjunction among its preconditions.
+................................................................................
+	@param	p					the generator parameters
+	@param	initial_values		set to the contents of the initial values
+								file
+	@return						the contents of the control rules file
+------------------------------------------------------------------------------*/
+const std::string generateControlRules(const GeneratorParameters& p,
+	std::string& initial_values)
+{
+	// the results of mt19937 are the same on every platform, unlike those
+	// of the standard distributions
+	std::mt19937 engine(p.seed);
+	auto random = [&](const int n) {return (int)(engine() % n);};
+	int num_props = (p.num_variables + 1) / 2;
+	int num_enums = p.num_variables / 2;
+	int num_chains = (p.num_behaviours + p.nesting_depth - 1)
+		/ p.nesting_depth;
+	// the variables referred to so far, and the first value each enumerated
+	// variable was given
+	std::set<int> referenced;
+	std::vector<int> first_enum_values(num_enums, -1);
+	int next_variable = 0;
+	// returns the name of the variable used by the next reference; every
+	// variable is referred to once before any is chosen at random
+	auto variable_name = [&](int& variable) -> std::string
+	{
+		variable = next_variable < p.num_variables ? next_variable++
+			: random(p.num_variables);
+		bool is_ambiguous = referenced.count(variable) != 0
+			&& random(100) < p.ambiguity_rate;
+		referenced.insert(variable);
+		return uniqueName(variable < num_props ? 'p' : 'e', variable,
+			is_ambiguous);
+	};
+	auto enum_value = [&](const int variable) -> std::string
+	{
+		int value = random(NUM_ENUM_VALUES);
+		int& first_value = first_enum_values[variable - num_props];
+		if(first_value == -1)
+		{
+			first_value = value;
+		}
+		return "v" + std::to_string(value);
+	};
+	auto check = [&]() -> std::string
+	{
+		int variable;
+		std::string name = variable_name(variable);
+		if(variable < num_props)
+		{
+			return name + " is " + (random(2) ? "true" : "false");
+		}
+		return name + " equals " + enum_value(variable);
+	};
+	auto assignment = [&]() -> std::string
+	{
+		int variable;
+		std::string name = variable_name(variable);
+		if(variable < num_props)
+		{
+			return "SET " + name + " TO " + (random(2) ? "true" : "false");
+		}
+		return "MOVE " + name + " TO " + enum_value(variable);
+	};
+
+	std::ostringstream rules;
+	rules << "name\tpriority\tinterruptable\tschedulable\truleOrder\t"
+		"ruleType\tandOrConnector\tnotConnector\truleActionText\n";
+	int num_timing_constraints = 0;
+	for(int b = 0; b < p.num_behaviours; b++)
+	{
+		int chain = b / p.nesting_depth;
+		int link = b % p.nesting_depth;
+		bool is_schedulable = link == 0;
+		std::ostringstream columns;
+		columns << uniqueName('b', b, false) << "\t"
+			<< (is_schedulable ? 10 + chain / p.group_size : 0) << "\t"
+			<< (is_schedulable ? chain % 2 : 0) << "\t"
+			<< (is_schedulable ? 1 : 0) << "\t";
+		int rule_order = 0;
+		auto add_rule = [&](const char type, const int and_or,
+			const std::string& text)
+		{
+			rules << columns.str() << rule_order++ << "\t" << type << "\t"
+				<< and_or << "\t0\t" << text << "\n";
+		};
+		if(is_schedulable)
+		{
+			int num_checks = 1 + random(3);
+			if(chain % 4 == 3)
+			{
+				// a disjunction of two checks
+				add_rule('R', 2, check());
+				add_rule('R', 0, check());
+			}
+			for(int i = 0; i < num_checks; i++)
+			{
+				add_rule('R', 0, check());
+			}
+			// spread the timing constraints over the chains, several to a
+			// chain if there are more constraints than chains
+			while(num_timing_constraints < p.num_timing_constraints
+				&& num_timing_constraints * num_chains
+					< p.num_timing_constraints * (chain + 1))
+			{
+				int start = random(23);
+				int end = start + 1 + random(23 - start);
+				std::ostringstream constraint;
+				constraint << "Time is between " << (start < 10 ? "0" : "")
+					<< start << ":00:00 and " << (end < 10 ? "0" : "")
+					<< end << ":00:00";
+				add_rule('R', 0, constraint.str());
+				num_timing_constraints++;
+			}
+		}
+		int num_assignments = 1 + random(3);
+		for(int i = 0; i < num_assignments; i++)
+		{
+			add_rule('A', 0, assignment());
+		}
+		if(random(4) == 0)
+		{
+			add_rule('A', 0, "Wait for " + std::to_string(5 + random(55))
+				+ " seconds");
+		}
+		if(link + 1 < p.nesting_depth && b + 1 < p.num_behaviours)
+		{
+			add_rule('A', 0, "Execute sequence "
+				+ uniqueName('b', b + 1, false));
+		}
+		add_rule('A', 0, assignment());
+	}
+
+	// the initial values of the variables referred to
+	std::ostringstream values;
+	for(int variable : referenced)
+	{
+		if(variable < num_props)
+		{
+			values << uniqueName('p', variable, false) << " = \"false\"\n";
+		}
+		else if(first_enum_values[variable - num_props] != -1)
+		{
+			values << uniqueName('e', variable, false) << " = \"v"
+				<< first_enum_values[variable - num_props] << "\"\n";
+		}
+	}
+	initial_values = values.str();
+	return rules.str();
+}
+
+/*------------------------------------------------------------------------------
+	writeFile
+
+	Writes a string to a file, returning true if successful or false
+	otherwise.
+................................................................................
+	@param	filename			the name of the file
+	@param	s					the string to write
+------------------------------------------------------------------------------*/
+bool writeFile(const std::string& filename, const std::string& s)
+{
+	std::ofstream file(filename);
+	file << s;
+	if(!file.good())
+	{
+		std::cerr << "error writing file \'" << filename << "\'\n";
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,91 @@
+#!/bin/sh
+#-------------------------------------------------------------------------------
+#	run_benchmark.sh
+#
+#	Generates a ladder of synthetic rule bases of increasing size, translates
+#	each one, and writes a CSV line of the parse, flatten and translate times,
+#	the peak heap usage and the size of the NuSMV model for each rung.
+#
+#	usage: run_benchmark.sh [sizes...]
+#
+#	The sizes are numbers of behaviours, with as many variables and a tenth
+#	as many timing constraints. The following environment variables may be
+#	set to change the defaults:
+#
+#		CRUTON			the executable to benchmark		(../bin/cruton)
+#		GENERATOR		the rule base generator			(./rule_base_generator)
+#		DEPTH			the nesting depth				(3)
+#		GROUP_SIZE		the equal priority group size	(4)
+#		AMBIGUITY		the ambiguity percentage		(10)
+#		SEED			the seed of the generator		(1)
+#		WORK_DIR		the directory of generated files	(./results)
+#		OPTIONS			further options for cruton		()
+#
+#	Author				: Paul Gainer
+#	Created				: 17/10/2026
+#   Last Modified		: 17/10/2026
+#-------------------------------------------------------------------------------
+BENCHMARK_DIR=$(cd "$(dirname "$0")" && pwd)
+CRUTON=${CRUTON:-$BENCHMARK_DIR/../bin/cruton}
+GENERATOR=${GENERATOR:-$BENCHMARK_DIR/rule_base_generator}
+DEPTH=${DEPTH:-3}
+GROUP_SIZE=${GROUP_SIZE:-4}
+AMBIGUITY=${AMBIGUITY:-10}
+SEED=${SEED:-1}
+WORK_DIR=${WORK_DIR:-$BENCHMARK_DIR/results}
+SIZES=${*:-50 100 200 400 800 1600}
+
+for f in "$CRUTON" "$GENERATOR"; do
+	if [ ! -x "$f" ]; then
+		echo "executable '$f' not found, run 'make benchmark'" >&2
+		exit 1
+	fi
+done
+mkdir -p "$WORK_DIR" || exit 1
+
+echo "behaviours,variables,timing_constraints,parse_seconds,"\
+"flatten_seconds,translate_seconds,peak_bytes,model_bytes,state_bits,defines"
+for n in $SIZES; do
+	prefix=$WORK_DIR/rules-$n
+	"$GENERATOR" -b "$n" -v "$n" -t $((n / 10)) -d "$DEPTH" -g "$GROUP_SIZE" \
+		-a "$AMBIGUITY" -s "$SEED" -o "$prefix" || exit 1
+	# answer every prompt from the generated policy, failing on any other
+	"$CRUTON" -ig "$prefix-GrammarRules.txt" \
+		-id "$prefix-DataExtractionRules.txt" \
+		-ic "$prefix-ControlRules.txt" -ii "$prefix-InitialValues.txt" \
+		-rp "$prefix-ResolutionPolicy.txt" -rs 1 -st "$prefix-statistics.json" \
+		-on "$prefix-model.smv" $OPTIONS < /dev/null > "$prefix-output.txt" 2>&1
+	if [ $? -ne 0 ] || [ ! -f "$prefix-statistics.json" ]; then
+		echo "translation of $n behaviours failed, see $prefix-output.txt" >&2
+		exit 1
+	fi
+	# the phases of the intermediate form parser are parsing, and the others
+	# translation
+	awk -v n="$n" -v t=$((n / 10)) '
+		function value(key,    s) {
+			s = $0
+			sub(".*\"" key "\": *", "", s)
+			sub("[,}].*", "", s)
+			return s + 0
+		}
+		/"seconds":/ {
+			if($0 ~ /"flatten(NestedBehaviourExecutions|ChangedBehaviours)"/)
+				flatten += value("seconds")
+			else if($0 ~ /"(parse|match)/ \
+				|| $0 ~ /"(validateBehaviours|buildLogicalExpression)/ \
+				|| $0 ~ /(CachedIntermediateForm|PreviousRun|ControlRules)"/)
+				parse += value("seconds")
+			else
+				translate += value("seconds")
+		}
+		/"peak_bytes":/ {
+			if(value("peak_bytes") > peak) peak = value("peak_bytes")
+		}
+		/^\t\t"bytes":/ {model = value("bytes")}
+		/^\t\t"state_bits":/ {bits = value("state_bits")}
+		/^\t\t"defines":/ {defines = value("defines")}
+		END {
+			printf "%d,%d,%d,%.6f,%.6f,%.6f,%d,%d,%d,%d\n", n, n, t, parse,
+				flatten, translate, peak, model, bits, defines
+		}' "$prefix-statistics.json"
+done
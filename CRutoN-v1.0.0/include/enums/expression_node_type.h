@@ -0,0 +1,41 @@
+/*==============================================================================
+	ExpressionNodeType
+
+	An enumeration for the different types of node in an expression DAG.
+
+	File			: expression_node_type.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef EXPRESSION_NODE_TYPE_H_
+#define EXPRESSION_NODE_TYPE_H_
+
+enum ExpressionNodeType
+{
+	EXPRESSION_TRUE = 0, EXPRESSION_FALSE, EXPRESSION_ATOM, EXPRESSION_NOT,
+	EXPRESSION_AND, EXPRESSION_OR
+};
+
+#endif
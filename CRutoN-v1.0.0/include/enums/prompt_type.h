@@ -0,0 +1,42 @@
+/*==============================================================================
+	PromptType
+
+	An enumeration for the different kinds of prompt that may be answered by
+	a resolution policy.
+
+	File			: prompt_type.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef PROMPT_TYPE_H_
+#define PROMPT_TYPE_H_
+
+enum PromptType
+{
+	PROMPT_IDENTIFIER_MATCH = 0, PROMPT_NO_PRECONDITIONS, PROMPT_ANY_TEXT,
+	PROMPT_DATA_EXTRACTION_RULE, PROMPT_FILE_OVERWRITE
+};
+
+#endif
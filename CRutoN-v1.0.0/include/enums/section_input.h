@@ -0,0 +1,44 @@
+/*==============================================================================
+	SectionInput
+
+	An enumeration for the parts of the intermediate form and of the
+	analyses made before translation from which a section of the NuSMV model
+	is built, combined as bit flags.
+
+	File			: section_input.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef SECTION_INPUT_H_
+#define SECTION_INPUT_H_
+
+enum SectionInput
+{
+	INPUT_BEHAVIOURS = 1, INPUT_EXECUTIONS = 2, INPUT_ACTIONS = 4,
+	INPUT_PRECONDITIONS = 8, INPUT_VARIABLES = 16, INPUT_CLASSES = 32,
+	INPUT_INITIAL_VALUES = 64
+};
+
+#endif
@@ -55,21 +55,6 @@ extern bool g_no_prompt_identifier_matching;
 ------------------------------------------------------------------------------*/
 extern bool g_disallow_true_false_enum;
 
-/*------------------------------------------------------------------------------
-	True if true non-determinism should be used in the NuSMV model, w.r.t. the
-	scheduling of behaviours with equal priority.
-
-	WARNING: For n behaviours of equal priority, 2^n defines will be added to
-	the resulting NuSMV model.
-------------------------------------------------------------------------------*/
-extern bool g_true_non_determinism;
-
-/*------------------------------------------------------------------------------
-	True if a minimum of one previous state should be used for state_n_seconds
-	terms.
-------------------------------------------------------------------------------*/
-extern bool g_minimum_one_state_state_n_seconds;
-
 /*------------------------------------------------------------------------------
 	Sets the string matching threshhold used for automatic string matching of
 	behaviour/prop variable/enum variable names. A Threshold of 75 would
@@ -80,26 +65,6 @@ extern bool g_minimum_one_state_state_n_seconds;
 ------------------------------------------------------------------------------*/
 extern int g_string_matching_threshhold;
 
-/*------------------------------------------------------------------------------
-	Sets the string matching threshhold used for automatic string matching of
-	behaviour/prop variable/enum variable names. A Threshold of 75 would
-	automatically match two strings with 75% similarity.
-------------------------------------------------------------------------------*/
-extern int g_state_time_seconds;
-
-/*------------------------------------------------------------------------------
-	Sets the maximum number of seconds for a state_n_seconds term. Used to
-	restrict the size of enumerated types in the NuSMV models.
-------------------------------------------------------------------------------*/
-extern int g_max_seconds_per_state_n_seconds;
-
-/*------------------------------------------------------------------------------
-	Setting this to a valid time value HH:MM:SS fixes the time of day, and
-	automatically sets preconditions corresponding to time constraints to be
-	false or true in the NuSMV model.
-------------------------------------------------------------------------------*/
-extern std::string g_time_of_day;
-
 /*------------------------------------------------------------------------------
 	The executable version number.
 ------------------------------------------------------------------------------*/
@@ -140,4 +105,89 @@ extern std::string g_intermediate_form_file;
 ------------------------------------------------------------------------------*/
 extern std::string g_NuSMV_file;
 
+/*------------------------------------------------------------------------------
+	The resolution policy file answering prompts, see resolution_policy.h.
+------------------------------------------------------------------------------*/
+extern std::string g_resolution_policy_file;
+
+/*------------------------------------------------------------------------------
+	The file to which the answers given to prompts should be recorded.
+------------------------------------------------------------------------------*/
+extern std::string g_resolution_record_file;
+
+/*------------------------------------------------------------------------------
+	True if a prompt with no answer in the resolution policy should be an
+	error instead of being asked on standard input.
+------------------------------------------------------------------------------*/
+extern bool g_strict_resolution;
+
+/*------------------------------------------------------------------------------
+	The file listing the configurations under which the intermediate form
+	should be translated, one per line.
+------------------------------------------------------------------------------*/
+extern std::string g_translation_configuration_file;
+
+/*------------------------------------------------------------------------------
+	The number of threads used to match control rules, to translate the
+	configurations and build the sections of each translation, and to check
+	reachability.
+------------------------------------------------------------------------------*/
+extern int g_translation_threads;
+
+/*------------------------------------------------------------------------------
+	The file listing the behaviours, variables or specifications whose cone
+	of influence should be translated, see cone_of_influence.h.
+------------------------------------------------------------------------------*/
+extern std::string g_cone_of_influence_file;
+
+/*------------------------------------------------------------------------------
+	The number of steps to simulate instead of translating, or 0 if the
+	intermediate form should be translated.
+------------------------------------------------------------------------------*/
+extern int g_simulation_steps;
+
+/*------------------------------------------------------------------------------
+	The number of steps simulated from each random initial state.
+------------------------------------------------------------------------------*/
+extern int g_simulation_run_length;
+
+/*------------------------------------------------------------------------------
+	The seed of the random choices made by the simulator.
+------------------------------------------------------------------------------*/
+extern int g_simulation_seed;
+
+/*------------------------------------------------------------------------------
+	A trace written by NuSMV that should be replayed by the simulator.
+------------------------------------------------------------------------------*/
+extern std::string g_simulation_trace_file;
+
+/*------------------------------------------------------------------------------
+	True if the behaviours that can be scheduled in a reachable state should
+	be found instead of translating.
+------------------------------------------------------------------------------*/
+extern bool g_check_reachability;
+
+/*------------------------------------------------------------------------------
+	The largest number of states explored by the reachability checker.
+------------------------------------------------------------------------------*/
+extern int g_reachability_max_states;
+
+/*------------------------------------------------------------------------------
+	The file to which the reachability checker writes a trace to each
+	reachable behaviour.
+------------------------------------------------------------------------------*/
+extern std::string g_reachability_witness_file;
+
+/*------------------------------------------------------------------------------
+	The file to which the statistics of the phases of parsing and translation,
+	and of the size of the NuSMV model, are written as JSON.
+------------------------------------------------------------------------------*/
+extern std::string g_statistics_file;
+
+/*------------------------------------------------------------------------------
+	The directory holding the cache of parsed intermediate forms, see
+	intermediate_form_cache.h, or empty if no cache should be used.
+------------------------------------------------------------------------------*/
+extern std::string g_parse_cache_directory;
+
 #endif
@@ -35,6 +35,7 @@
 #include <ostream>
 
 #include "enums/action_type.h"
+#include "intermediate/arena.h"
 
 class Action
 {
@@ -85,11 +86,12 @@ public:
 	/*--------------------------------------------------------------------------
 		clone
 
-		Returns a pointer to a copy of this.
+		Returns a pointer to a copy of this, constructed in the given arena.
 	............................................................................
+		@param	arena			the arena in which to construct the copy
 		@return					a pointer to a copy of this instance
 	--------------------------------------------------------------------------*/
-	virtual Action* clone() const = 0;
+	virtual Action* clone(Arena& arena) const = 0;
 
 protected:
 	/*==========================================================================
@@ -52,7 +52,8 @@ public:
 		@param	order			an integer used to determine the order in
 								which actions are executed by a behaviour
 	--------------------------------------------------------------------------*/
-	ActionExecute(const std::string behav, const int order) : behaviour(behav)
+	ActionExecute(const std::string behav, const int order) : behaviour(behav),
+		behaviour_id(-1)
 	{
 		action_type = EXECUTE;
 		action_order = order;
@@ -79,6 +80,25 @@ public:
 	--------------------------------------------------------------------------*/
 	void setBehaviour(const std::string b) {behaviour = b;}
 
+	/*--------------------------------------------------------------------------
+		getBehaviourId
+
+		Accessor for behaviour_id.
+	............................................................................
+		@return					the id of the behaviour to be executed, or -1
+								if the behaviour has not yet been resolved
+	--------------------------------------------------------------------------*/
+	const int getBehaviourId() const {return behaviour_id;}
+
+	/*--------------------------------------------------------------------------
+		setBehaviourId
+
+		Mutator for behaviour_id.
+	............................................................................
+		@param	id				the id of the behaviour to be executed
+	--------------------------------------------------------------------------*/
+	void setBehaviourId(const int id) {behaviour_id = id;}
+
 	/*--------------------------------------------------------------------------
 		getActionDescription
 
@@ -91,11 +111,12 @@ public:
 	/*--------------------------------------------------------------------------
 		clone
 
-		Returns a pointer to a copy of this.
+		Returns a pointer to a copy of this, constructed in the given arena.
 	............................................................................
+		@param	arena			the arena in which to construct the copy
 		@return					a pointer to a copy of this instance
 	--------------------------------------------------------------------------*/
-	Action* clone() const;
+	Action* clone(Arena& arena) const;
 
 	friend std::ostream& operator<<(std::ostream& os,
 		const ActionExecute& a);
@@ -108,6 +129,11 @@ private:
 		The behaviour to execute.
 	--------------------------------------------------------------------------*/
 	std::string behaviour;
+
+	/*--------------------------------------------------------------------------
+		The id of the behaviour to execute.
+	--------------------------------------------------------------------------*/
+	int behaviour_id;
 };
 
 #endif
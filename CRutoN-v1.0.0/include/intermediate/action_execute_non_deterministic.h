@@ -32,9 +32,10 @@
 #ifndef ACTION_EXECUTE_NON_DETERMINISTIC_H
 #define ACTION_EXECUTE_NON_DETERMINISTIC_H
 
-#include <list>
+#include <cstddef>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "enums/action_type.h"
 #include "intermediate/action.h"
@@ -66,9 +67,22 @@ public:
 
 		Accessor for behaviour_values.
 	............................................................................
-		@return					the list of behaviour names
+		@return					the behaviour names
 	--------------------------------------------------------------------------*/
-	std::list<std::string> getBehaviourValues() {return behaviour_values;}
+	const std::vector<std::string>& getBehaviourValues() const
+	{
+		return behaviour_values;
+	}
+
+	/*--------------------------------------------------------------------------
+		getBehaviourIds
+
+		Accessor for behaviour_ids.
+	............................................................................
+		@return					the ids of the behaviours, in the same order
+								as the behaviour names
+	--------------------------------------------------------------------------*/
+	const std::vector<int>& getBehaviourIds() const {return behaviour_ids;}
 
 	/*--------------------------------------------------------------------------
 		addBehaviourValue
@@ -82,17 +96,34 @@ public:
 	void addBehaviourValue(const std::string behaviour_value);
 
 	/*--------------------------------------------------------------------------
-		updateBehaviourName
+		resolveBehaviourValue
 
-		Updates the name of an executed behaviour.
+		Sets the name and id of the behaviour matched by an executed behaviour
+		name.
 	............................................................................
-		@param	existing_name	the name of an existing behaviour in the list
-								of behaviours
-		@param	new_name		a replacement name for the existing behaviour
-								name
+		@param	position		the position of the name in behaviour_values
+		@param	name			the name of the matched behaviour
+		@param	id				the id of the matched behaviour
 	--------------------------------------------------------------------------*/
-	void updateBehaviourName(const std::string existing_name,
-		const std::string new_name);
+	void resolveBehaviourValue(const std::size_t position,
+		const std::string name, const int id);
+
+	/*--------------------------------------------------------------------------
+		setBehaviourValues
+
+		Mutator for behaviour_values and behaviour_ids, replacing every
+		behaviour that can be executed.
+	............................................................................
+		@param	values			the behaviour names
+		@param	ids				the ids of the behaviours, in the same order
+								as the behaviour names
+	--------------------------------------------------------------------------*/
+	void setBehaviourValues(const std::vector<std::string>& values,
+		const std::vector<int>& ids)
+	{
+		behaviour_values = values;
+		behaviour_ids = ids;
+	}
 
 	/*--------------------------------------------------------------------------
 		getActionDescription
@@ -106,11 +137,12 @@ public:
 	/*--------------------------------------------------------------------------
 		clone
 
-		Returns a pointer to a copy of this.
+		Returns a pointer to a copy of this, constructed in the given arena.
 	............................................................................
+		@param	arena			the arena in which to construct the copy
 		@return					a pointer to a copy of this instance
 	--------------------------------------------------------------------------*/
-	Action* clone() const;
+	Action* clone(Arena& arena) const;
 
 	friend std::ostream& operator<<(std::ostream& os,
 		const ActionExecuteNonDeterministic& a);
@@ -122,7 +154,13 @@ private:
 	/*--------------------------------------------------------------------------
 		The names of the behaviours to be executed non-deterministically.
 	--------------------------------------------------------------------------*/
-	std::list<std::string> behaviour_values;
+	std::vector<std::string> behaviour_values;
+
+	/*--------------------------------------------------------------------------
+		The ids of the behaviours to be executed non-deterministically, or -1
+		for any behaviour that has not yet been resolved.
+	--------------------------------------------------------------------------*/
+	std::vector<int> behaviour_ids;
 };
 
 #endif
@@ -81,11 +81,12 @@ public:
 	/*--------------------------------------------------------------------------
 		clone
 
-		Returns a pointer to a copy of this.
+		Returns a pointer to a copy of this, constructed in the given arena.
 	............................................................................
+		@param	arena			the arena in which to construct the copy
 		@return					a pointer to a copy of this instance
 	--------------------------------------------------------------------------*/
-	Action* clone() const;
+	Action* clone(Arena& arena) const;
 
 	friend std::ostream& operator<<(std::ostream& os,
 		const ActionWait& a);
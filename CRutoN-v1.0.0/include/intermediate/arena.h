@@ -0,0 +1,178 @@
+/*==============================================================================
+	Arena
+
+	A monotonic allocator holding every node of the intermediate form.
+	Objects are constructed in large blocks and are never freed
+	individually; the whole arena is released at once when it is destroyed.
+
+	File			: arena.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef ARENA_H_
+#define ARENA_H_
+
+#define ARENA_BLOCK_SIZE 32768
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+class Arena
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	Arena() : next(nullptr), remaining(0), last_finaliser(nullptr) {}
+
+	~Arena()
+	{
+		release();
+	}
+
+	Arena(const Arena&) = delete;
+	Arena& operator=(const Arena&) = delete;
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		create
+
+		Constructs a new object of type T in the arena. The object is destroyed
+		when the arena is released and must not be deleted.
+	............................................................................
+		@param	args			the arguments passed to the constructor of T
+		@return					a pointer to the new object
+	--------------------------------------------------------------------------*/
+	template<typename T, typename... Args>
+	T* create(Args&&... args);
+
+	/*--------------------------------------------------------------------------
+		release
+
+		Destroys every object in the arena, most recently created first, and
+		frees all blocks.
+	--------------------------------------------------------------------------*/
+	void release();
+
+
+private:
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Records how to destroy an object that is not trivially destructible.
+		Finalisers are chained from the most recently created object.
+	--------------------------------------------------------------------------*/
+	struct Finaliser
+	{
+		void (*destroy)(void*);
+		void* object;
+		Finaliser* previous;
+	};
+
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The blocks owned by the arena.
+	--------------------------------------------------------------------------*/
+	std::vector<char*> blocks;
+
+	/*--------------------------------------------------------------------------
+		The next free byte in the current block.
+	--------------------------------------------------------------------------*/
+	char* next;
+
+	/*--------------------------------------------------------------------------
+		The number of free bytes remaining in the current block.
+	--------------------------------------------------------------------------*/
+	std::size_t remaining;
+
+	/*--------------------------------------------------------------------------
+		The finaliser of the most recently created object that is not
+		trivially destructible.
+	--------------------------------------------------------------------------*/
+	Finaliser* last_finaliser;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		allocate
+
+		Returns a pointer to size bytes of uninitialised memory with the given
+		alignment, starting a new block if the current block is full.
+	............................................................................
+		@param	size			the number of bytes to allocate
+		@param	alignment		the required alignment, a power of two
+		@return					a pointer to the allocated memory
+	--------------------------------------------------------------------------*/
+	void* allocate(const std::size_t size, const std::size_t alignment);
+
+	/*--------------------------------------------------------------------------
+		destroy
+
+		Calls the destructor of an object of type T.
+	............................................................................
+		@param	object			a pointer to the object to destroy
+	--------------------------------------------------------------------------*/
+	template<typename T>
+	static void destroy(void* object)
+	{
+		static_cast<T*>(object)->~T();
+	}
+};
+
+/*------------------------------------------------------------------------------
+	create
+
+	Constructs a new object of type T in the arena.
+------------------------------------------------------------------------------*/
+template<typename T, typename... Args>
+T* Arena::create(Args&&... args)
+{
+	T* object = new (allocate(sizeof(T), alignof(T)))
+		T(std::forward<Args>(args)...);
+	if(!std::is_trivially_destructible<T>::value)
+	{
+		Finaliser* finaliser = new (allocate(sizeof(Finaliser),
+			alignof(Finaliser))) Finaliser;
+		finaliser->destroy = &Arena::destroy<T>;
+		finaliser->object = object;
+		finaliser->previous = last_finaliser;
+		last_finaliser = finaliser;
+	}
+	return object;
+}
+
+#endif
@@ -33,17 +33,19 @@
 #ifndef BEHAVIOUR_H_
 #define BEHAVIOUR_H_
 
+#include "intermediate/indexed.h"
 #include "intermediate/named.h"
 #include "intermediate/action.h"
+#include "intermediate/arena.h"
 #include "intermediate/logical_expression_tree.h"
 #include "intermediate/precondition.h"
 
 #include <algorithm>
-#include <list>
 #include <ostream>
 #include <string>
+#include <vector>
 
-class Behaviour : public Named
+class Behaviour : public Named, public Indexed
 {
 public:
 	/*==========================================================================
@@ -66,8 +68,6 @@ public:
 		name = nm;
 	}
 
-	~Behaviour();
-
 	/*==========================================================================
 		Public Functions
 	==========================================================================*/
@@ -105,18 +105,22 @@ public:
 
 		Accessor for preconditions.
 	............................................................................
-		@return					the list of preconditions
+		@return					the preconditions, ordered by precondition
+								order
 	--------------------------------------------------------------------------*/
-	std::list<Precondition*> getPreconditions() {return preconditions;}
+	const std::vector<Precondition*>& getPreconditions() const
+	{
+		return preconditions;
+	}
 
 	/*--------------------------------------------------------------------------
 		getActions
 
 		Accessor for actions.
 	............................................................................
-		@return					the list of actions
+		@return					the actions, ordered by action order
 	--------------------------------------------------------------------------*/
-	std::list<Action*> getActions() {return actions;}
+	const std::vector<Action*>& getActions() const {return actions;}
 
 	/*--------------------------------------------------------------------------
 		getLogicalExpressionTree
@@ -156,8 +160,10 @@ public:
 		buildLogicalExpressionTree
 
 		Builds the logical expression tree using the preconditions.
+	............................................................................
+		@param	arena			the arena in which to construct the tree
 	--------------------------------------------------------------------------*/
-	void buildLogicalExpressionTree();
+	void buildLogicalExpressionTree(Arena& arena);
 
 	friend std::ostream& operator<<(std::ostream& os, const Behaviour& b);
 
@@ -183,14 +189,14 @@ private:
 	bool schedulable;
 
 	/*--------------------------------------------------------------------------
-		The list of preconditions.
+		The preconditions, ordered by precondition order.
 	--------------------------------------------------------------------------*/
-	std::list<Precondition*> preconditions;
+	std::vector<Precondition*> preconditions;
 
 	/*--------------------------------------------------------------------------
-		The list of actions.
+		The actions, ordered by action order.
 	--------------------------------------------------------------------------*/
-	std::list<Action*> actions;
+	std::vector<Action*> actions;
 
 	/*--------------------------------------------------------------------------
 		The logical expression tree.
@@ -208,9 +214,11 @@ private:
 	............................................................................
 		@param	it				the reverse iterator pointing to the
 								precondition to store at the node
+		@param	arena			the arena in which to construct the node
 		@return					a pointer to the new node
 	--------------------------------------------------------------------------*/
-	TreeNode* buildNextNode(std::list<Precondition*>::reverse_iterator it);
+	TreeNode* buildNextNode(std::vector<Precondition*>::reverse_iterator it,
+		Arena& arena);
 };
 
 #endif
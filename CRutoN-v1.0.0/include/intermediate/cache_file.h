@@ -0,0 +1,288 @@
+/*==============================================================================
+	CacheWriter, CacheReader, CacheHash
+
+	The encoding shared by the cache files in a parse cache directory.
+	Values are written least significant byte first, so that cache files do
+	not depend on the byte order of the machine, and files are named by a 64
+	bit FNV-1a hash of the inputs they were built from.
+
+	File			: cache_file.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef CACHE_FILE_H_
+#define CACHE_FILE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class CacheWriter
+{
+public:
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		putInt
+
+		Appends an integer as four bytes.
+	--------------------------------------------------------------------------*/
+	void putInt(const int n);
+
+	/*--------------------------------------------------------------------------
+		putBool
+
+		Appends a boolean as a single byte.
+	--------------------------------------------------------------------------*/
+	void putBool(const bool b) {data += (char)(b ? 1 : 0);}
+
+	/*--------------------------------------------------------------------------
+		putString
+
+		Appends a string, preceded by its length.
+	--------------------------------------------------------------------------*/
+	void putString(const std::string& s);
+
+	/*--------------------------------------------------------------------------
+		putFloat
+
+		Appends the bits of a float.
+	--------------------------------------------------------------------------*/
+	void putFloat(const float f);
+
+	/*--------------------------------------------------------------------------
+		putBytes
+
+		Appends bytes as they are, with no length.
+	--------------------------------------------------------------------------*/
+	void putBytes(const std::string& s) {data += s;}
+
+	/*--------------------------------------------------------------------------
+		getData
+
+		Accessor for data.
+	--------------------------------------------------------------------------*/
+	const std::string& getData() const {return data;}
+
+	/*--------------------------------------------------------------------------
+		writeToFile
+
+		Writes the appended values to a file, through a temporary file so that
+		the file is never seen partly written. Throws an error if the file
+		cannot be written.
+	............................................................................
+		@param	filename		the name of the file
+	--------------------------------------------------------------------------*/
+	void writeToFile(const std::string& filename) const throw(std::string);
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The values appended so far.
+	--------------------------------------------------------------------------*/
+	std::string data;
+};
+
+class CacheReader
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	d				a pointer to the contents of a cache file
+		@param	size			the number of bytes in the file
+	--------------------------------------------------------------------------*/
+	CacheReader(const char* d, const std::size_t size) : next(d),
+		end(d + size) {}
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		atEnd
+
+		Returns true if every value has been read.
+	--------------------------------------------------------------------------*/
+	const bool atEnd() const {return next == end;}
+
+	/*--------------------------------------------------------------------------
+		getInt, getBool, getString, getFloat
+
+		Read the values appended by the corresponding functions of
+		CacheWriter. Throw an error if the file ends too soon.
+	--------------------------------------------------------------------------*/
+	const int getInt() throw(std::string);
+	const bool getBool() throw(std::string);
+	const std::string getString() throw(std::string);
+	const float getFloat() throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		getIndex
+
+		Reads an integer, throwing an error if it is not in the range
+		[minimum, limit).
+	............................................................................
+		@param	limit			one more than the largest valid integer
+		@param	minimum			the smallest valid integer
+		@return					the integer
+	--------------------------------------------------------------------------*/
+	const int getIndex(const int limit, const int minimum = 0)
+		throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		expectBytes
+
+		Reads bytes, throwing an error if they differ from the given bytes.
+	............................................................................
+		@param	s				the expected bytes
+	--------------------------------------------------------------------------*/
+	void expectBytes(const std::string& s) throw(std::string);
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The next byte to read, and the end of the file.
+	--------------------------------------------------------------------------*/
+	const char* next;
+	const char* end;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		need
+
+		Throws an error if fewer than n bytes remain.
+	--------------------------------------------------------------------------*/
+	void need(const std::size_t n) throw(std::string);
+};
+
+class CacheHash
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	CacheHash();
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addString
+
+		Adds a string, followed by a separator, to the hash.
+	--------------------------------------------------------------------------*/
+	void addString(const std::string& s);
+
+	/*--------------------------------------------------------------------------
+		addFile
+
+		Adds the size and contents of a file to the hash. Throws an error if
+		the file cannot be read.
+	............................................................................
+		@param	filename		the name of the file
+	--------------------------------------------------------------------------*/
+	void addFile(const std::string& filename) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		addParseOptions
+
+		Adds the options affecting how rules are parsed to the hash, and the
+		contents of the resolution policy file if one was given, as its
+		answers replace the user's.
+	--------------------------------------------------------------------------*/
+	void addParseOptions() throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		getValue
+
+		Accessor for value.
+	--------------------------------------------------------------------------*/
+	const std::uint64_t getValue() const {return value;}
+
+	/*--------------------------------------------------------------------------
+		put
+
+		Appends the hash to a cache file, so that a file can be checked
+		against the inputs it was built from.
+	--------------------------------------------------------------------------*/
+	void put(CacheWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		check
+
+		Reads a hash appended by put, returning true if it equals this hash.
+	--------------------------------------------------------------------------*/
+	const bool check(CacheReader& reader) const throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		getFilename
+
+		Returns the name of a file in a directory, named by the hash.
+	............................................................................
+		@param	directory		the directory
+		@param	extension		the extension of the file
+		@return					the name of the file
+	--------------------------------------------------------------------------*/
+	const std::string getFilename(const std::string& directory,
+		const std::string& extension) const;
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The hash of the values added so far.
+	--------------------------------------------------------------------------*/
+	std::uint64_t value;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addBytes
+
+		Adds bytes to the hash.
+	--------------------------------------------------------------------------*/
+	void addBytes(const char* data, const std::size_t size);
+};
+
+#endif
@@ -36,9 +36,10 @@
 #include <ostream>
 #include <string>
 
+#include "intermediate/indexed.h"
 #include "intermediate/named.h"
 
-class EnumVariable : public Named
+class EnumVariable : public Named, public Indexed
 {
 public:
 	/*==========================================================================
@@ -77,6 +78,16 @@ public:
 	--------------------------------------------------------------------------*/
 	const bool resets() const {return enum_resets;}
 
+	/*--------------------------------------------------------------------------
+		hasNoneValue
+
+		Accessor for has_none_value.
+	............................................................................
+		@return					true if the variable has the value 'no_value',
+								or false otherwise
+	--------------------------------------------------------------------------*/
+	const bool hasNoneValue() const {return has_none_value;}
+
 	/*--------------------------------------------------------------------------
 		addValue
 
@@ -0,0 +1,78 @@
+/*==============================================================================
+	Indexed
+
+	An interface inherited by PropVariable, EnumVariable and Behaviour. The
+	id of an instance is its position in the corresponding list in
+	IntermediateForm, and is used in place of its name to refer to it once
+	parsing is complete.
+
+	File			: indexed.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef INDEXED_H_
+#define INDEXED_H_
+
+class Indexed
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	Indexed() : id(-1) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		getId
+
+		Accessor for id.
+	............................................................................
+		@return					the id, or -1 if the instance has not been
+								added to the intermediate form
+	--------------------------------------------------------------------------*/
+	const int getId() const {return id;}
+
+	/*--------------------------------------------------------------------------
+		setId
+
+		Mutator for id.
+	............................................................................
+		@param	i				the new value for id
+	--------------------------------------------------------------------------*/
+	void setId(const int i) {id = i;}
+
+protected:
+	/*==========================================================================
+		Protected Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The position of the instance in its list in the intermediate form.
+	--------------------------------------------------------------------------*/
+	int id;
+};
+
+#endif
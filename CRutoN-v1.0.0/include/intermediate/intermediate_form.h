@@ -41,16 +41,22 @@
 #define NO_PRECONDITIONS_REMOVE 1
 #define NO_PRECONDITIONS_SET_NON_SCHEDULABLE 2
 
-#include <list>
+#include <map>
 #include <ostream>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "define.h"
 #include "global.h"
 #include "utility.h"
+#include "intermediate/arena.h"
 #include "intermediate/enum_variable.h"
+#include "intermediate/name_index.h"
 #include "intermediate/prop_variable.h"
 
+class Action;
 class Behaviour;
 
 class IntermediateForm
@@ -61,55 +67,77 @@ public:
 	==========================================================================*/
 	IntermediateForm()  {}
 
-	~IntermediateForm();
-
 	/*==========================================================================
 		Public Functions
 	==========================================================================*/
 	/*--------------------------------------------------------------------------
-		getBehaviours
+		create
 
-		Accessor for behaviours.
+		Constructs a new behaviour, precondition, action or variable in the
+		arena. The object lives until the intermediate form is destroyed and
+		must not be deleted.
 	............................................................................
-		@return					the list of behaviours
+		@param	args			the arguments passed to the constructor of T
+		@return					a pointer to the new object
 	--------------------------------------------------------------------------*/
-	std::list<Behaviour*> getBehaviours() {return behaviours;}
+	template<typename T, typename... Args>
+	T* create(Args&&... args)
+	{
+		return arena.create<T>(std::forward<Args>(args)...);
+	}
 
 	/*--------------------------------------------------------------------------
-		getPropVariables
+		getArena
 
-		Accessor for prop_variables.
+		Accessor for arena.
 	............................................................................
-		@return					the list of propositional variables
+		@return					the arena holding every node of the
+								intermediate form
 	--------------------------------------------------------------------------*/
-	std::list<PropVariable*> getPropVariables() {return prop_variables;}
+	Arena& getArena() {return arena;}
 
 	/*--------------------------------------------------------------------------
-		getEnumVariables
+		getBehaviours
 
-		Accessor for enum_variables.
+		Accessor for behaviours.
+	............................................................................
+		@return					the behaviours, indexed by id
+	--------------------------------------------------------------------------*/
+	const std::vector<Behaviour*>& getBehaviours() const {return behaviours;}
+
+	/*--------------------------------------------------------------------------
+		getBehaviour
+
+		Returns the behaviour with the given id.
 	............................................................................
-		@return					the list of enumerated variables
+		@param	id				the id of the behaviour
+		@return					a pointer to the behaviour
 	--------------------------------------------------------------------------*/
-	std::list<EnumVariable*> getEnumVariables() {return enum_variables;}
+	Behaviour* getBehaviour(const int id) const {return behaviours[id];}
 
 	/*--------------------------------------------------------------------------
-		setPropVariables
+		getPropVariables
 
-		Mutator for prop_variables.
+		Accessor for prop_variables.
 	............................................................................
-		@param	p				the new list of propositional variables
+		@return					the propositional variables, indexed by id
 	--------------------------------------------------------------------------*/
-	void setPropVariables(std::list<PropVariable*> p) {prop_variables = p;}
+	const std::vector<PropVariable*>& getPropVariables() const
+	{
+		return prop_variables;
+	}
 
 	/*--------------------------------------------------------------------------
-		setEnumVariables
+		getEnumVariables
 
-		Mutator for enum_variables.
+		Accessor for enum_variables.
 	............................................................................
-		@param	e				the new list of enumerated variables
+		@return					the enumerated variables, indexed by id
 	--------------------------------------------------------------------------*/
-	void setEnumVariables(std::list<EnumVariable*> e) {enum_variables = e;}
+	const std::vector<EnumVariable*>& getEnumVariables() const
+	{
+		return enum_variables;
+	}
 
 	/*--------------------------------------------------------------------------
 		getPropVariableByName
@@ -150,6 +178,22 @@ public:
 	Behaviour* getBehaviourByName(const std::string& name,
 		const std::string& info);
 
+	/*--------------------------------------------------------------------------
+		findPropVariable, findEnumVariable, findBehaviour
+
+		Return the propositional variable, enumerated variable or behaviour
+		with exactly the given name, or nullptr if there is none or if two
+		names of its kind differ only by case. Unlike the lookups by name,
+		these never prompt the user.
+	............................................................................
+		@param	name			the name to find
+		@return					a pointer to the variable or behaviour, or
+								nullptr
+	--------------------------------------------------------------------------*/
+	PropVariable* findPropVariable(const std::string& name);
+	EnumVariable* findEnumVariable(const std::string& name);
+	Behaviour* findBehaviour(const std::string& name);
+
 	/*--------------------------------------------------------------------------
 		addBehaviour
 
@@ -157,7 +201,18 @@ public:
 	............................................................................
 		@param	b				the behaviour to add to the list
 	--------------------------------------------------------------------------*/
-	void addBehaviour(Behaviour* b) {behaviours.push_back(b);}
+	void addBehaviour(Behaviour* b);
+
+	/*--------------------------------------------------------------------------
+		replaceBehaviour
+
+		Replaces the behaviour with the given id, for when a behaviour is
+		parsed again. The replaced behaviour is left in the arena.
+	............................................................................
+		@param	id				the id of the behaviour to replace
+		@param	b				the behaviour taking its place
+	--------------------------------------------------------------------------*/
+	void replaceBehaviour(const int id, Behaviour* b);
 
 	/*--------------------------------------------------------------------------
 		addPropVariable
@@ -166,7 +221,12 @@ public:
 	............................................................................
 		@param	p				the propositional variable to add to the list
 	--------------------------------------------------------------------------*/
-	void addPropVariable(PropVariable* p) {prop_variables.push_back(p);}
+	void addPropVariable(PropVariable* p)
+	{
+		p->setId(prop_variables.size());
+		prop_variables.push_back(p);
+		prop_variable_index.insert(p);
+	}
 
 	/*--------------------------------------------------------------------------
 		addEnumVariable
@@ -175,14 +235,50 @@ public:
 	............................................................................
 		@param	e				the enumerated variable to add to the list
 	--------------------------------------------------------------------------*/
-	void addEnumVariable(EnumVariable* e) {enum_variables.push_back(e);}
+	void addEnumVariable(EnumVariable* e)
+	{
+		e->setId(enum_variables.size());
+		enum_variables.push_back(e);
+		enum_variable_index.insert(e);
+	}
+
+	/*--------------------------------------------------------------------------
+		setSimilarPropVariableNames
+
+		Sets the similarities found in advance between the names that
+		propositional variables may be given.
+	............................................................................
+		@param	names			the names compared with each other
+		@param	similar			the names similar to each name in the set
+	--------------------------------------------------------------------------*/
+	void setSimilarPropVariableNames(const std::set<std::string>& names,
+		const SimilarNames& similar)
+	{
+		prop_variable_index.setSimilarNames(names, similar);
+	}
+
+	/*--------------------------------------------------------------------------
+		setSimilarEnumVariableNames
+
+		Sets the similarities found in advance between the names that
+		enumerated variables may be given.
+	............................................................................
+		@param	names			the names compared with each other
+		@param	similar			the names similar to each name in the set
+	--------------------------------------------------------------------------*/
+	void setSimilarEnumVariableNames(const std::set<std::string>& names,
+		const SimilarNames& similar)
+	{
+		enum_variable_index.setSimilarNames(names, similar);
+	}
 
 	/*--------------------------------------------------------------------------
 		validateBehaviours
 
-		Firstly, ensures that all behaviour executions reference existing
-		behaviours. Secondly, prompts the user to decide how to interpret
-		behaviours with no preconditions.
+		Firstly, prompts the user to decide how to interpret behaviours with
+		no preconditions. Secondly, ensures that all behaviour executions
+		reference existing behaviours, and resolves the id of each executed
+		behaviour.
 	............................................................................
 		@throws					an error message if validation failed
 	--------------------------------------------------------------------------*/
@@ -208,6 +304,23 @@ public:
 	--------------------------------------------------------------------------*/
 	void flattenNestedBehaviourExecutions();
 
+	/*--------------------------------------------------------------------------
+		flattenNestedBehaviourExecutions
+
+		Flattens the nested executions of a single behaviour, as they are
+		flattened when every behaviour is flattened in order of id. Actions
+		are substituted from the behaviours of lower id as they have been
+		flattened, and from those of higher id as they were before
+		flattening.
+	............................................................................
+		@param	behaviour		the behaviour to flatten
+		@param	unflattened_actions	the actions, before flattening, of the
+								behaviours whose actions have since been
+								flattened, keyed by id
+	--------------------------------------------------------------------------*/
+	void flattenNestedBehaviourExecutions(Behaviour* behaviour,
+		const std::map<int, std::vector<Action*>>& unflattened_actions);
+
 	friend std::ostream& operator<<(std::ostream& os,
 		const IntermediateForm& a);
 
@@ -216,20 +329,32 @@ private:
 		Private Member Variables
 	==========================================================================*/
 	/*--------------------------------------------------------------------------
-		The set of behaviours.
+		The arena owning the behaviours, preconditions, actions, tree nodes and
+		variables, all of which are released together.
 	--------------------------------------------------------------------------*/
-	std::list<Behaviour*> behaviours;
+	Arena arena;
 
 	/*--------------------------------------------------------------------------
-		The set of propositional variables.
+		The set of behaviours, indexed by id.
 	--------------------------------------------------------------------------*/
-	std::list<PropVariable*> prop_variables;
+	std::vector<Behaviour*> behaviours;
 
 	/*--------------------------------------------------------------------------
-		The set of enumerated variables.
+		The set of propositional variables, indexed by id.
 	--------------------------------------------------------------------------*/
-	std::list<EnumVariable*> enum_variables;
+	std::vector<PropVariable*> prop_variables;
 
+	/*--------------------------------------------------------------------------
+		The set of enumerated variables, indexed by id.
+	--------------------------------------------------------------------------*/
+	std::vector<EnumVariable*> enum_variables;
+
+	/*--------------------------------------------------------------------------
+		Name indices over behaviours, prop_variables and enum_variables.
+	--------------------------------------------------------------------------*/
+	NameIndex<Behaviour> behaviour_index;
+	NameIndex<PropVariable> prop_variable_index;
+	NameIndex<EnumVariable> enum_variable_index;
 
 	/*==========================================================================
 		Private Static Member Functions
@@ -238,8 +363,9 @@ private:
 		disambiguationPrompt
 
 		Prompts the user to disambiguate the name of a given precondition,
-		action or behaviour.
+		action or behaviour. Throws an error if the prompt cannot be answered.
 	............................................................................
+		@param	name			the name being disambiguated
 		@param	existing_name	the name of the existing propositional variable
 								/enumerated variable/behaviour
 		@param	type			text describing the type being disambiguated
@@ -249,14 +375,15 @@ private:
 								DISAMBIGUATION_USE_EXISTING, or
 								DISAMBIGUATION_IGNORE
 	--------------------------------------------------------------------------*/
-	static const int disambiguationPrompt(const std::string& existing_name,
-		const std::string& type);
+	static const int disambiguationPrompt(const std::string& name,
+		const std::string& existing_name, const std::string& type)
+			throw(std::string);
 
 	/*--------------------------------------------------------------------------
 		noPreconditionPrompt
 
 		Prompts the user to choose how to interpret a behaviour with no
-		preconditions.
+		preconditions. Throws an error if the prompt cannot be answered.
 	............................................................................
 		@param	behaviour_name	the name of the behaviour having no
 								preconditions
@@ -264,7 +391,8 @@ private:
 								NO_PRECONDITIONS_REMOVE,
 								or NO_PRECONDITIONS_SET_NON_SCHEDULABLE
 	--------------------------------------------------------------------------*/
-	static const int noPreconditionPrompt(const std::string& behaviour_name);
+	static const int noPreconditionPrompt(const std::string& behaviour_name)
+		throw(std::string);
 
 	/*--------------------------------------------------------------------------
 		getByName
@@ -273,8 +401,9 @@ private:
 		name. If automatic identifier matching is disabled then the user is
 		prompted when ambiguity or case-insensitive matches are encountered.
 	............................................................................
-		@param	variable		the list of propositional variables/enumerated
-								variables/behaviour
+		@param	instances		the propositional variables/enumerated
+								variables/behaviours
+		@param	index			the name index over the list
 		@param	name			the name of the propositional variable/
 								enumerated variable/behaviour to retrieve
 		@param	type			text describing the type being disambiguated
@@ -285,8 +414,9 @@ private:
 								behaviour, or nullptr if none is found
 	--------------------------------------------------------------------------*/
 	template<typename T>
-	static T* getByName(std::list<T*>& variables, const std::string& name,
-		const std::string& type, const std::string& info);
+	static T* getByName(std::vector<T*>& instances, NameIndex<T>& index,
+		const std::string& name, const std::string& type,
+		const std::string& info);
 };
 
 #endif
@@ -0,0 +1,244 @@
+/*==============================================================================
+	IntermediateFormCache
+
+	A persistent cache of fully resolved intermediate forms, so that
+	unchanged rule files need not be parsed again. Each cache file is named
+	by a hash of the contents of the grammar, data extraction rule and
+	control rule files, the resolution policy, and the options that affect
+	parsing, and holds every behaviour, precondition, action and variable
+	after the user's disambiguation decisions and behaviour flattening.
+	Objects refer to each other by id rather than by pointer, so a cache
+	file is decoded in one pass over its memory mapped contents.
+
+	File			: intermediate_form_cache.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef INTERMEDIATE_FORM_CACHE_H_
+#define INTERMEDIATE_FORM_CACHE_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "intermediate/cache_file.h"
+
+class Action;
+class IntermediateForm;
+class Precondition;
+
+class IntermediateFormCache
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	dir				the directory holding the cache files
+	--------------------------------------------------------------------------*/
+	IntermediateFormCache(const std::string& dir) : directory(dir) {}
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		computeKey
+
+		Sets the key of the cache file from the contents of the given input
+		files, the resolution policy file, and the options affecting parsing.
+		Throws an error if an input file cannot be read.
+	............................................................................
+		@param	grammar_rule_file	the name of the grammar rule file
+		@param	data_rule_file		the name of the data extraction rule file
+		@param	control_rule_file	the name of the control rule file
+	--------------------------------------------------------------------------*/
+	void computeKey(const std::string& grammar_rule_file,
+		const std::string& data_rule_file,
+		const std::string& control_rule_file) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		getFilename
+
+		Returns the name of the cache file for the current key.
+	............................................................................
+		@return					the name of the cache file
+	--------------------------------------------------------------------------*/
+	const std::string getFilename() const;
+
+	/*--------------------------------------------------------------------------
+		load
+
+		Returns the intermediate form held in the cache file for the current
+		key, or nullptr if there is no such file. A cache file that cannot be
+		decoded is reported and treated as missing.
+	............................................................................
+		@param	answers			set to the answers given to prompts while
+								the intermediate form was parsed
+		@return					a new intermediate form, owned by the caller,
+								or nullptr
+	--------------------------------------------------------------------------*/
+	IntermediateForm* load(
+		std::vector<std::pair<std::string, std::string>>& answers) const;
+
+	/*--------------------------------------------------------------------------
+		store
+
+		Writes an intermediate form to the cache file for the current key,
+		replacing any existing file. Throws an error if the file cannot be
+		written.
+	............................................................................
+		@param	intermediate_form	the intermediate form to store
+		@param	answers			the answers given to prompts while the
+								intermediate form was parsed, each paired
+								with the kind and key of its prompt
+	--------------------------------------------------------------------------*/
+	void store(const IntermediateForm& intermediate_form,
+		const std::vector<std::pair<std::string, std::string>>& answers)
+			const throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		encodeIntermediateForm
+
+		Appends the encoding of the variables and behaviours of an
+		intermediate form to a cache file.
+	............................................................................
+		@param	intermediate_form	the intermediate form to encode
+		@param	writer			the cache file being written
+	--------------------------------------------------------------------------*/
+	static void encodeIntermediateForm(
+		const IntermediateForm& intermediate_form, CacheWriter& writer);
+
+	/*--------------------------------------------------------------------------
+		decodeIntermediateForm
+
+		Constructs an intermediate form from the encoding of its variables
+		and behaviours. Throws an error if the encoding is not valid.
+	............................................................................
+		@param	reader			the cache file being read
+		@return					a new intermediate form, owned by the caller
+	--------------------------------------------------------------------------*/
+	static IntermediateForm* decodeIntermediateForm(CacheReader& reader)
+		throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		encodePrecondition
+
+		Appends the encoding of a precondition to a cache file. Variables are
+		encoded by id.
+	............................................................................
+		@param	precondition	the precondition to encode
+		@param	writer			the cache file being written
+	--------------------------------------------------------------------------*/
+	static void encodePrecondition(Precondition* precondition,
+		CacheWriter& writer);
+
+	/*--------------------------------------------------------------------------
+		encodeAction
+
+		Appends the encoding of an action to a cache file. Variables are
+		encoded by id, and executed behaviours by both name and id.
+	............................................................................
+		@param	action			the action to encode
+		@param	writer			the cache file being written
+	--------------------------------------------------------------------------*/
+	static void encodeAction(Action* action, CacheWriter& writer);
+
+	/*--------------------------------------------------------------------------
+		decodeAction
+
+		Constructs an action from its encoding, in the arena of the given
+		intermediate form. Throws an error if the encoding is not valid.
+	............................................................................
+		@param	reader			the cache file being read
+		@param	intermediate_form	the intermediate form holding the
+								variables the action refers to
+		@param	num_behaviours	the number of behaviours the action may
+								execute
+		@return					a pointer to the new action
+	--------------------------------------------------------------------------*/
+	static Action* decodeAction(CacheReader& reader,
+		IntermediateForm* intermediate_form, const int num_behaviours)
+			throw(std::string);
+
+
+private:
+	/*==========================================================================
+		Private Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The characters starting every cache file.
+	--------------------------------------------------------------------------*/
+	static const std::string MAGIC;
+
+	/*--------------------------------------------------------------------------
+		The version of the cache file format, which must be incremented
+		whenever the format or the meaning of the intermediate form changes.
+	--------------------------------------------------------------------------*/
+	static const int FORMAT_VERSION;
+
+	/*--------------------------------------------------------------------------
+		The extension of cache files.
+	--------------------------------------------------------------------------*/
+	static const std::string EXTENSION;
+
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The directory holding the cache files.
+	--------------------------------------------------------------------------*/
+	std::string directory;
+
+	/*--------------------------------------------------------------------------
+		The hash of the inputs and options, naming the cache file.
+	--------------------------------------------------------------------------*/
+	CacheHash key;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		decode
+
+		Constructs the intermediate form held in the contents of a cache
+		file. Throws an error if the contents are not a valid cache file for
+		the current key.
+	............................................................................
+		@param	data			a pointer to the contents of the file
+		@param	size			the number of bytes in the file
+		@param	answers			set to the answers held in the file
+		@return					a new intermediate form
+	--------------------------------------------------------------------------*/
+	IntermediateForm* decode(const char* data, const std::size_t size,
+		std::vector<std::pair<std::string, std::string>>& answers) const
+			throw(std::string);
+};
+
+#endif
@@ -52,11 +52,6 @@ public:
 	--------------------------------------------------------------------------*/
 	LogicalExpressionTree(TreeNode* rt) : root(rt) {}
 
-	~LogicalExpressionTree()
-	{
-		delete root;
-	}
-
 	/*==========================================================================
 		Public Functions
 	==========================================================================*/
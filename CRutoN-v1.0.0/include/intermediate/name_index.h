@@ -0,0 +1,421 @@
+/*==============================================================================
+	NameIndex
+
+	A hash index over the names of propositional variables, enumerated
+	variables or behaviours, used to resolve identifiers without scanning
+	every entry.
+
+	File			: name_index.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef NAME_INDEX_H_
+#define NAME_INDEX_H_
+
+#include <algorithm>
+#include <list>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "global.h"
+#include "utility.h"
+
+/*------------------------------------------------------------------------------
+	Maps each name to the names that are similar to it, with their similarity.
+------------------------------------------------------------------------------*/
+typedef std::unordered_map<std::string, std::unordered_map<std::string, int>>
+	SimilarNames;
+
+template<typename T>
+class NameIndex
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	NameIndex() : has_case_variants(false), is_stale(true) {}
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		insert
+
+		Adds an instance appended to the end of the indexed list.
+	............................................................................
+		@param	instance		the instance that was appended to the list
+	--------------------------------------------------------------------------*/
+	void insert(T* instance);
+
+	/*--------------------------------------------------------------------------
+		invalidate
+
+		Marks the index as stale. Must be called whenever the indexed list is
+		modified other than by appending, or when an instance is renamed. The
+		index is rebuilt on the next lookup.
+	--------------------------------------------------------------------------*/
+	void invalidate() {is_stale = true;}
+
+	/*--------------------------------------------------------------------------
+		getCaseInsensitiveMatch
+
+		Returns the last instance in the list whose name is a case-insensitive
+		match for the given name, or nullptr if there is no such instance.
+	............................................................................
+		@param	instances		the indexed list
+		@param	name			the name to find
+		@return					the last case-insensitive match in the list
+	--------------------------------------------------------------------------*/
+	T* getCaseInsensitiveMatch(const std::vector<T*>& instances,
+		const std::string& name);
+
+	/*--------------------------------------------------------------------------
+		getExactMatch
+
+		Returns the instance in the list with the given name, or nullptr if
+		there is no such instance or if two indexed names differ only by
+		case, when a lookup by name could have prompted the user.
+	............................................................................
+		@param	instances		the indexed list
+		@param	name			the name to find
+		@return					the instance with the given name, or nullptr
+	--------------------------------------------------------------------------*/
+	T* getExactMatch(const std::vector<T*>& instances,
+		const std::string& name);
+
+	/*--------------------------------------------------------------------------
+		setSimilarNames
+
+		Sets the similarities found in advance between the names in a set, so
+		that they are not computed again on lookup.
+	............................................................................
+		@param	names			the names compared with each other
+		@param	similar			maps each name in the set to the names in the
+								set whose similarity to it reaches the
+								matching threshold
+	--------------------------------------------------------------------------*/
+	void setSimilarNames(const std::set<std::string>& names,
+		const SimilarNames& similar);
+
+	/*--------------------------------------------------------------------------
+		getSimilarityMatches
+
+		Adds the instances in the list whose names are similar to the given
+		name to a list of matches, in list order, each with its similarity
+		(as a percentage).
+	............................................................................
+		@param	instances		the indexed list
+		@param	name			the name to find
+		@param	matches			the list to add the matches to
+	--------------------------------------------------------------------------*/
+	void getSimilarityMatches(const std::vector<T*>& instances,
+		const std::string& name, std::list<std::pair<T*, const int>>& matches);
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Maps each name to the last instance in the list having that name.
+	--------------------------------------------------------------------------*/
+	std::unordered_map<std::string, T*> exact_names;
+
+	/*--------------------------------------------------------------------------
+		Maps each lowercase name to the last instance in the list having that
+		name when case is ignored.
+	--------------------------------------------------------------------------*/
+	std::unordered_map<std::string, T*> lowercase_names;
+
+	/*--------------------------------------------------------------------------
+		True if two indexed names differ only by case, in which case an exact
+		match is not necessarily the last case-insensitive match.
+	--------------------------------------------------------------------------*/
+	bool has_case_variants;
+
+	/*--------------------------------------------------------------------------
+		True if the index must be rebuilt before it is next used.
+	--------------------------------------------------------------------------*/
+	bool is_stale;
+
+	/*--------------------------------------------------------------------------
+		The names whose similarities to each other were found in advance.
+	--------------------------------------------------------------------------*/
+	std::unordered_set<std::string> compared_names;
+
+	/*--------------------------------------------------------------------------
+		The similarities found in advance, see setSimilarNames.
+	--------------------------------------------------------------------------*/
+	SimilarNames similar_names;
+
+	/*--------------------------------------------------------------------------
+		The instances in the list whose names were not compared in advance.
+	--------------------------------------------------------------------------*/
+	std::vector<T*> uncompared;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		rebuild
+
+		Rebuilds the index from the list.
+	............................................................................
+		@param	instances		the indexed list
+	--------------------------------------------------------------------------*/
+	void rebuild(const std::vector<T*>& instances);
+
+	/*--------------------------------------------------------------------------
+		index
+
+		Adds an instance to both maps.
+	............................................................................
+		@param	instance		the instance to add
+	--------------------------------------------------------------------------*/
+	void index(T* instance);
+
+	/*--------------------------------------------------------------------------
+		computeSimilarity
+
+		Returns the similarity of an existing name to the given name if it
+		reaches the matching threshold, or -1 otherwise.
+	............................................................................
+		@param	existing_name	the name of an existing instance
+		@param	name			the name to find
+		@return					the similarity of the two names, or -1
+	--------------------------------------------------------------------------*/
+	static const int computeSimilarity(const std::string& existing_name,
+		const std::string& name);
+};
+
+/*------------------------------------------------------------------------------
+	insert
+
+	Adds an instance appended to the end of the indexed list.
+------------------------------------------------------------------------------*/
+template<typename T>
+void NameIndex<T>::insert(T* instance)
+{
+	if(!is_stale)
+	{
+		index(instance);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	getCaseInsensitiveMatch
+
+	Returns the last instance in the list whose name is a case-insensitive
+	match for the given name, or nullptr if there is no such instance.
+------------------------------------------------------------------------------*/
+template<typename T>
+T* NameIndex<T>::getCaseInsensitiveMatch(const std::vector<T*>& instances,
+	const std::string& name)
+{
+	if(is_stale)
+	{
+		rebuild(instances);
+	}
+	if(!has_case_variants)
+	{
+		auto it = exact_names.find(name);
+		if(it != exact_names.end())
+		{
+			return it->second;
+		}
+	}
+	auto it = lowercase_names.find(toLower(name));
+	return it == lowercase_names.end() ? nullptr : it->second;
+}
+
+/*------------------------------------------------------------------------------
+	getExactMatch
+
+	Returns the instance in the list with the given name, or nullptr if there
+	is no such instance or if two indexed names differ only by case.
+------------------------------------------------------------------------------*/
+template<typename T>
+T* NameIndex<T>::getExactMatch(const std::vector<T*>& instances,
+	const std::string& name)
+{
+	if(is_stale)
+	{
+		rebuild(instances);
+	}
+	if(has_case_variants)
+	{
+		return nullptr;
+	}
+	auto it = exact_names.find(name);
+	return it == exact_names.end() ? nullptr : it->second;
+}
+
+/*------------------------------------------------------------------------------
+	setSimilarNames
+
+	Sets the similarities found in advance between the names in a set.
+------------------------------------------------------------------------------*/
+template<typename T>
+void NameIndex<T>::setSimilarNames(const std::set<std::string>& names,
+	const SimilarNames& similar)
+{
+	compared_names = std::unordered_set<std::string>(names.begin(),
+		names.end());
+	similar_names = similar;
+	is_stale = true;
+}
+
+/*------------------------------------------------------------------------------
+	getSimilarityMatches
+
+	Adds the instances in the list whose names are similar to the given name
+	to a list of matches, in list order. If the name was compared in advance,
+	only the instances with a similar name and those whose names were not
+	compared in advance are considered.
+------------------------------------------------------------------------------*/
+template<typename T>
+void NameIndex<T>::getSimilarityMatches(const std::vector<T*>& instances,
+	const std::string& name, std::list<std::pair<T*, const int>>& matches)
+{
+	if(is_stale)
+	{
+		rebuild(instances);
+	}
+	if(compared_names.count(name) == 0)
+	{
+		for(T* instance : instances)
+		{
+			int similarity = computeSimilarity(instance->getName(), name);
+			if(similarity != -1)
+			{
+				matches.push_back(std::pair<T*, const int>(instance,
+					similarity));
+			}
+		}
+		return;
+	}
+	std::vector<std::pair<T*, int>> found;
+	auto it = similar_names.find(name);
+	if(it != similar_names.end())
+	{
+		for(const std::pair<const std::string, int>& similar : it->second)
+		{
+			auto instance = exact_names.find(similar.first);
+			if(instance != exact_names.end())
+			{
+				found.push_back(std::make_pair(instance->second,
+					similar.second));
+			}
+		}
+	}
+	for(T* instance : uncompared)
+	{
+		int similarity = computeSimilarity(instance->getName(), name);
+		if(similarity != -1)
+		{
+			found.push_back(std::make_pair(instance, similarity));
+		}
+	}
+	std::sort(found.begin(), found.end(),
+		[](const std::pair<T*, int>& this_pair,
+			const std::pair<T*, int>& that_pair)
+		{
+			return this_pair.first->getId() < that_pair.first->getId();
+		});
+	for(const std::pair<T*, int>& match : found)
+	{
+		matches.push_back(std::pair<T*, const int>(match.first,
+			match.second));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	computeSimilarity
+
+	Returns the similarity of an existing name to the given name if it reaches
+	the matching threshold, or -1 otherwise. Only computes the LCS for names
+	that could possibly reach the threshold.
+------------------------------------------------------------------------------*/
+template<typename T>
+const int NameIndex<T>::computeSimilarity(const std::string& existing_name,
+	const std::string& name)
+{
+	if(similarityUpperBound(existing_name, name)
+		< g_string_matching_threshhold)
+	{
+		return -1;
+	}
+	int similarity = stringSimilarity(existing_name, name,
+		g_string_matching_threshhold);
+	return similarity >= g_string_matching_threshhold ? similarity : -1;
+}
+
+/*------------------------------------------------------------------------------
+	rebuild
+
+	Rebuilds the index from the list.
+------------------------------------------------------------------------------*/
+template<typename T>
+void NameIndex<T>::rebuild(const std::vector<T*>& instances)
+{
+	exact_names.clear();
+	lowercase_names.clear();
+	uncompared.clear();
+	has_case_variants = false;
+	for(T* instance : instances)
+	{
+		index(instance);
+	}
+	is_stale = false;
+}
+
+/*------------------------------------------------------------------------------
+	index
+
+	Adds an instance to both maps.
+------------------------------------------------------------------------------*/
+template<typename T>
+void NameIndex<T>::index(T* instance)
+{
+	const std::string name = instance->getName();
+	exact_names[name] = instance;
+	T*& lowercase_entry = lowercase_names[toLower(name)];
+	if(lowercase_entry != nullptr && lowercase_entry->getName() != name)
+	{
+		has_case_variants = true;
+	}
+	lowercase_entry = instance;
+	if(compared_names.count(name) == 0)
+	{
+		uncompared.push_back(instance);
+	}
+}
+
+#endif
@@ -40,6 +40,7 @@
 #include "enums/precondition_type.h"
 #include "enums/time_constraint_type.h"
 #include "utility.h"
+#include "intermediate/precondition.h"
 
 class PreconditionTimingConstraint : public Precondition
 {
@@ -35,9 +35,10 @@
 #include <ostream>
 #include <string>
 
+#include "intermediate/indexed.h"
 #include "intermediate/named.h"
 
-class PropVariable : public Named
+class PropVariable : public Named, public Indexed
 {
 public:
 	/*==========================================================================
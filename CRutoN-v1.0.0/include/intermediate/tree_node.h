@@ -58,18 +58,6 @@ public:
 		const TreeNodeType type) : left(l), right(r), precondition(pre),
 			node_type(type) {}
 
-	~TreeNode()
-	{
-		if(left != nullptr)
-		{
-			delete left;
-		}
-		if(right != nullptr)
-		{
-			delete right;
-		}
-	}
-
 	/*==========================================================================
 		Public Functions
 	==========================================================================*/
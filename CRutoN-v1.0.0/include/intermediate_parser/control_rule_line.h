@@ -0,0 +1,73 @@
+/*==============================================================================
+	ControlRuleLine
+
+	A line of a control rule file as it was parsed: its text, the behaviour
+	it was added to, the rule matched for its precondition or action, and
+	the variable that rule names. Recorded so that a later run can tell
+	which behaviours of an edited control rule file changed, and reuse what
+	was parsed for the rest.
+
+	File			: control_rule_line.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef CONTROL_RULE_LINE_H_
+#define CONTROL_RULE_LINE_H_
+
+#include <string>
+
+#include "intermediate_parser/parsed_rule.h"
+
+struct ControlRuleLine
+{
+	/*--------------------------------------------------------------------------
+		Constructor
+	--------------------------------------------------------------------------*/
+	ControlRuleLine() : behaviour_id(-1), variable_id(-1) {}
+
+	/*--------------------------------------------------------------------------
+		The text of the line, as it is in the file.
+	--------------------------------------------------------------------------*/
+	std::string text;
+
+	/*--------------------------------------------------------------------------
+		The id of the behaviour to which the precondition or action was
+		added.
+	--------------------------------------------------------------------------*/
+	int behaviour_id;
+
+	/*--------------------------------------------------------------------------
+		The rule matched for the precondition or action.
+	--------------------------------------------------------------------------*/
+	ParsedRule rule;
+
+	/*--------------------------------------------------------------------------
+		The id of the propositional or enumerated variable that the rule
+		names, or -1 if it names none.
+	--------------------------------------------------------------------------*/
+	int variable_id;
+};
+
+#endif
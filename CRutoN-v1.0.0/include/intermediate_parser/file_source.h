@@ -0,0 +1,170 @@
+/*==============================================================================
+	FileSource
+
+	A read-only source of characters from a file. Regular files are memory
+	mapped so that the parsers can work directly on the mapped bytes, other
+	inputs (standard input, pipes, or any file that cannot be mapped) are
+	read into a buffer.
+
+	File			: file_source.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef FILE_SOURCE_H_
+#define FILE_SOURCE_H_
+
+#include <cstddef>
+#include <string>
+
+#include "intermediate_parser/token_cursor.h"
+
+class FileSource
+{
+public:
+	/*==========================================================================
+		Public Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The file name used to read from standard input.
+	--------------------------------------------------------------------------*/
+	static const std::string STANDARD_INPUT;
+
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	filename		the name of the file to read, or
+								STANDARD_INPUT to read from standard input
+		@param	binary			true if a buffered file should hold the raw
+								bytes of the file, or false if line endings
+								should be translated as in text mode
+	--------------------------------------------------------------------------*/
+	FileSource(const std::string& filename, const bool binary = false);
+
+	~FileSource();
+
+	FileSource(const FileSource&) = delete;
+	FileSource& operator=(const FileSource&) = delete;
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		isOpen
+
+		Accessor for is_open.
+	............................................................................
+		@return					true if the file was read successfully
+	--------------------------------------------------------------------------*/
+	bool isOpen() const {return is_open;}
+
+	/*--------------------------------------------------------------------------
+		isMapped
+
+		Returns true if the file is memory mapped rather than buffered.
+	............................................................................
+		@return					true if the file is memory mapped
+	--------------------------------------------------------------------------*/
+	bool isMapped() const {return mapped_data != nullptr;}
+
+	/*--------------------------------------------------------------------------
+		getData
+
+		Returns a pointer to the first character of the file.
+	............................................................................
+		@return					a pointer to the first character
+	--------------------------------------------------------------------------*/
+	const char* getData() const
+	{
+		return isMapped() ? mapped_data : buffer.data();
+	}
+
+	/*--------------------------------------------------------------------------
+		size
+
+		Returns the number of characters in the file.
+	............................................................................
+		@return					the number of characters
+	--------------------------------------------------------------------------*/
+	std::size_t size() const
+	{
+		return isMapped() ? mapped_size : buffer.size();
+	}
+
+	/*--------------------------------------------------------------------------
+		getSpan
+
+		Returns a span over the whole file.
+	............................................................................
+		@return					a span over the whole file
+	--------------------------------------------------------------------------*/
+	const StringSpan getSpan() const {return StringSpan(getData(), size(), 0);}
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		True if the file was read successfully.
+	--------------------------------------------------------------------------*/
+	bool is_open;
+
+	/*--------------------------------------------------------------------------
+		A pointer to the mapped file, or nullptr if the file is buffered.
+	--------------------------------------------------------------------------*/
+	const char* mapped_data;
+
+	/*--------------------------------------------------------------------------
+		The size of the mapped file.
+	--------------------------------------------------------------------------*/
+	std::size_t mapped_size;
+
+	/*--------------------------------------------------------------------------
+		The contents of the file if it could not be mapped.
+	--------------------------------------------------------------------------*/
+	std::string buffer;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		mapFile
+
+		Attempts to memory map the given file. Returns true if successful.
+	--------------------------------------------------------------------------*/
+	bool mapFile(const std::string& filename);
+
+	/*--------------------------------------------------------------------------
+		bufferFile
+
+		Reads the given file into the buffer, in binary or text mode. Returns
+		true if successful.
+	--------------------------------------------------------------------------*/
+	bool bufferFile(const std::string& filename, const bool binary);
+};
+
+#endif
@@ -0,0 +1,196 @@
+/*==============================================================================
+	GrammarMatcher
+
+	A token-level matcher compiled from the grammar rules. All rules share a
+	single prefix trie over their leading tokens, with typed edges for the
+	predefined symbols, so that every rule that could accept a line is found
+	in one pass over its tokens.
+
+	File			: grammar_matcher.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef GRAMMAR_MATCHER_H_
+#define GRAMMAR_MATCHER_H_
+
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "intermediate_parser/automaton.h"
+#include "intermediate_parser/non_terminal_symbol.h"
+
+class GrammarMatcher
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	GrammarMatcher()
+	{
+		// the root of the trie
+		newNode(true);
+	}
+
+	~GrammarMatcher()
+	{
+		for(Automaton* prototype : prototypes)
+		{
+			delete prototype;
+		}
+	}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addRule
+
+		Compiles the given grammar rule into the matcher.
+	............................................................................
+		@param	rule			a pointer to the non-terminal symbol
+								corresponding to the grammar rule
+	--------------------------------------------------------------------------*/
+	void addRule(NonTerminalSymbol* rule);
+
+	/*--------------------------------------------------------------------------
+		getCandidateRules
+
+		Returns the set of grammar rules that can accept the given line. This
+		is a superset of the rules that will accept the line when it is fed
+		to them token-by-token, so only these rules need to be fed the line.
+	............................................................................
+		@param	line			text extracted from the control rule file
+		@return					the set of grammar rules that can accept the
+								line
+	--------------------------------------------------------------------------*/
+	const std::set<const NonTerminalSymbol*> getCandidateRules(
+		const std::string& line) const;
+
+private:
+	/*==========================================================================
+		Private Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The prototype index of typed edges that accept any token.
+	--------------------------------------------------------------------------*/
+	static const int ANY_TEXT;
+
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		A state in the matcher. States on the shared prefix trie may be reused
+		by any rule, all other states belong to a single rule.
+	--------------------------------------------------------------------------*/
+	struct Node
+	{
+		bool is_trie_node;
+		std::map<std::string, int> terminal_edges;
+		std::vector<std::pair<int, int>> typed_edges;
+		std::vector<int> epsilon_edges;
+		std::vector<const NonTerminalSymbol*> accepting_rules;
+	};
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The states of the matcher, the first of which is the root of the trie.
+	--------------------------------------------------------------------------*/
+	std::vector<Node> nodes;
+
+	/*--------------------------------------------------------------------------
+		Unfed copies of the predefined automata, used to check whether a token
+		is valid input for a typed edge.
+	--------------------------------------------------------------------------*/
+	std::vector<Automaton*> prototypes;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		newNode
+
+		Adds a new state to the matcher and returns its index.
+	--------------------------------------------------------------------------*/
+	int newNode(const bool is_trie_node);
+
+	/*--------------------------------------------------------------------------
+		compileAutomaton
+
+		Compiles the given automaton, including any repeats, starting from the
+		given state. Returns the index of the final state.
+	--------------------------------------------------------------------------*/
+	int compileAutomaton(Automaton* automaton, const int from);
+
+	/*--------------------------------------------------------------------------
+		compileSingle
+
+		Compiles a single repetition of the given automaton starting from the
+		given state. Returns the index of the final state.
+	--------------------------------------------------------------------------*/
+	int compileSingle(Automaton* automaton, const int from);
+
+	/*--------------------------------------------------------------------------
+		addTerminalEdge
+
+		Adds an edge labelled with the given terminal from the given state,
+		reusing an existing trie edge if possible. Returns the index of the
+		target state.
+	--------------------------------------------------------------------------*/
+	int addTerminalEdge(const int from, const std::string& terminal);
+
+	/*--------------------------------------------------------------------------
+		addTypedEdge
+
+		Adds an edge accepting tokens that are valid for the given prototype
+		from the given state, reusing an existing trie edge if possible.
+		Returns the index of the target state.
+	--------------------------------------------------------------------------*/
+	int addTypedEdge(const int from, const int prototype);
+
+	/*--------------------------------------------------------------------------
+		getPrototypeIndex
+
+		Returns the index of the prototype for the given predefined automaton,
+		adding a new prototype if one does not already exist.
+	--------------------------------------------------------------------------*/
+	int getPrototypeIndex(Automaton* automaton);
+
+	/*--------------------------------------------------------------------------
+		addEpsilonClosure
+
+		Adds the given state, and all states reachable from it by epsilon
+		edges, to the set of states.
+	--------------------------------------------------------------------------*/
+	void addEpsilonClosure(const int node, std::vector<int>& states,
+		std::vector<unsigned int>& marks, const unsigned int mark) const;
+};
+
+#endif
@@ -41,6 +41,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <set>
 #include <vector>
 
 #include <intermediate/intermediate_form.h>
@@ -50,20 +51,28 @@
 #include "intermediate/logical_expression_tree.h"
 #include "intermediate/tree_node.h"
 #include "intermediate_parser/any_text_symbol.h"
+#include "intermediate_parser/control_rule_line.h"
 #include "intermediate_parser/float_symbol.h"
+#include "intermediate_parser/grammar_matcher.h"
 #include "intermediate_parser/integer_symbol.h"
 #include "intermediate_parser/non_terminal_symbol.h"
+#include "intermediate_parser/parsed_rule.h"
 #include "intermediate_parser/relational_operator_symbol.h"
 #include "intermediate_parser/terminal_symbol.h"
 #include "intermediate_parser/time_symbol.h"
 
+class IntermediateFormCache;
+class PhaseStatistics;
+class PreviousRunCache;
+
 class IntermediateFormParser
 {
 public:
 	/*==========================================================================
 		Public Constructors/Deconstructor
 	==========================================================================*/
-	IntermediateFormParser() : intermediate_form(nullptr)
+	IntermediateFormParser() : intermediate_form(nullptr),
+		statistics(nullptr), cache(nullptr), previous_run(nullptr)
 	{
 		buildPredefinedAutomatonTypeMap();
 		buildPredefinedAutomatonMap();
@@ -157,6 +166,40 @@ public:
 	--------------------------------------------------------------------------*/
 	IntermediateForm* getIntermediateForm() {return intermediate_form;}
 
+	/*--------------------------------------------------------------------------
+		setStatistics
+
+		Sets the statistics in which the phases of parsing are recorded, or
+		null if they should not be recorded.
+	............................................................................
+		@param	s				the statistics, which are not owned
+	--------------------------------------------------------------------------*/
+	void setStatistics(PhaseStatistics* s) {statistics = s;}
+
+	/*--------------------------------------------------------------------------
+		setCache
+
+		Sets the cache from which the intermediate form is loaded if the input
+		files have been parsed before, and to which it is stored otherwise, or
+		null if no cache should be used.
+	............................................................................
+		@param	c				the cache, which is not owned
+	--------------------------------------------------------------------------*/
+	void setCache(IntermediateFormCache* c) {cache = c;}
+
+	/*--------------------------------------------------------------------------
+		setPreviousRunCache
+
+		Sets the cache holding the last control rule file parsed with the
+		same grammar and data extraction rule files, so that only the
+		behaviours whose lines have changed since are parsed again, and to
+		which the control rule file is then recorded, or null if no cache
+		should be used.
+	............................................................................
+		@param	c				the cache, which is not owned
+	--------------------------------------------------------------------------*/
+	void setPreviousRunCache(PreviousRunCache* c) {previous_run = c;}
+
 private:
 	/*==========================================================================
 		Private Static Member Variables
@@ -176,6 +219,25 @@ private:
 	static const int ACTION_DELAY;
 	static const int STATE_N_SECONDS;
 
+
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The automata against which a thread matches the text of rules, as
+		non_terminal_symbols_by_type, and whether the user may be prompted to
+		resolve an ambiguity. Each thread needs its own automata, as they
+		hold the state of the text being matched.
+	--------------------------------------------------------------------------*/
+	struct MatchContext
+	{
+		MatchContext(const std::vector<std::list<NonTerminalSymbol*>>& s,
+			const bool c) : symbols_by_type(s), can_prompt(c) {}
+
+		const std::vector<std::list<NonTerminalSymbol*>>& symbols_by_type;
+		const bool can_prompt;
+	};
+
 	/*==========================================================================
 		Private Member Variables
 	==========================================================================*/
@@ -184,6 +246,42 @@ private:
 	--------------------------------------------------------------------------*/
 	IntermediateForm* intermediate_form;
 
+	/*--------------------------------------------------------------------------
+		The statistics in which the phases of parsing are recorded, or null.
+	--------------------------------------------------------------------------*/
+	PhaseStatistics* statistics;
+
+	/*--------------------------------------------------------------------------
+		The cache of parsed intermediate forms, or null.
+	--------------------------------------------------------------------------*/
+	IntermediateFormCache* cache;
+
+	/*--------------------------------------------------------------------------
+		The cache of the last control rule file parsed, or null.
+	--------------------------------------------------------------------------*/
+	PreviousRunCache* previous_run;
+
+	/*--------------------------------------------------------------------------
+		The rules matched in parallel for the control rule file being parsed,
+		and those matched for the last control rule file, keyed by rule type
+		followed by text.
+	--------------------------------------------------------------------------*/
+	std::map<std::string, ParsedRule> matched_rules;
+
+	/*--------------------------------------------------------------------------
+		The lines of the control rule file as they were parsed, recorded if
+		there is a cache of the last control rule file. Left empty if a
+		behaviour was removed while validating, as the lines then no longer
+		correspond to the ids of the behaviours.
+	--------------------------------------------------------------------------*/
+	std::vector<ControlRuleLine> control_rule_lines;
+
+	/*--------------------------------------------------------------------------
+		The actions, before flattening, of the behaviours executing others,
+		keyed by id, recorded with control_rule_lines.
+	--------------------------------------------------------------------------*/
+	std::map<int, std::vector<Action*>> unflattened_actions;
+
 	/*--------------------------------------------------------------------------
 		The list of all parsed non-terminal symbols.
 	--------------------------------------------------------------------------*/
@@ -222,6 +320,12 @@ private:
 	--------------------------------------------------------------------------*/
 	std::vector<std::list<NonTerminalSymbol*>> non_terminal_symbols_by_type;
 
+	/*--------------------------------------------------------------------------
+		The matcher compiled from the typed non-terminal symbols, used to find
+		the grammar rules that can accept a line in a single pass.
+	--------------------------------------------------------------------------*/
+	GrammarMatcher grammar_matcher;
+
 	/*==========================================================================
 		Private Functions
 	==========================================================================*/
@@ -344,6 +448,25 @@ private:
 	--------------------------------------------------------------------------*/
 	const int getAutomatonType(const std::string name) const;
 
+	/*--------------------------------------------------------------------------
+		parseChangedBehaviours
+
+		Parses the control rule file again from the last control rule file
+		parsed, parsing only the behaviours whose lines have changed, and
+		flattening again only those behaviours and the behaviours executing
+		them. Returns false, leaving the file to be parsed in full, if the
+		behaviours were added, removed or reordered, if a changed line names
+		a variable or behaviour not already known by exactly that name, or
+		if the answers given to prompts while parsing could differ. The
+		variables keep their ids, and the answers are recorded again.
+	............................................................................
+		@param	filename		the name of the file containing the control rule
+								definitions
+		@return					true if the intermediate form was parsed, or
+								false if the file must be parsed in full
+	--------------------------------------------------------------------------*/
+	bool parseChangedBehaviours(const std::string filename);
+
 	/*--------------------------------------------------------------------------
 		parseAction
 
@@ -355,11 +478,124 @@ private:
 								representing the action
 		@order					the integer indicating the order in which the
 								action should be executed by the behaviour
+		@param	line			set to the rule matched and the variable it
+								names
 		@return					a pointer to the parsed Action
 		@throw					an error message if parsing was unsuccessful
 	--------------------------------------------------------------------------*/
-	Action* parseAction(const std::string s, const int order)
-		throw(std::string);
+	Action* parseAction(const std::string s, const int order,
+		ControlRuleLine& line) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		matchAction
+
+		Given a string corresponding to an action, matches it against the
+		grammar and data extraction rules and returns the matched rule, or
+		throws an error if matching was unsuccessful.
+	............................................................................
+		@param	s				the text extracted from the control rule file
+								representing the action
+		@param	context			the automata to match against
+		@return					the matched rule
+		@throw					an error message if matching was unsuccessful
+	--------------------------------------------------------------------------*/
+	const ParsedRule matchAction(const std::string s,
+		const MatchContext& context) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		buildAction
+
+		Given a matched action, an integer corresponding to the order of the
+		action in the corresponding behaviour, and the variable it assigns,
+		constructs and returns a new Action.
+	............................................................................
+		@param	rule			the matched action
+		@param	order			the integer indicating the order in which the
+								action should be executed by the behaviour
+		@param	variable_id		the id of the variable the action assigns,
+								see addRuleVariable
+		@return					a pointer to the new Action
+	--------------------------------------------------------------------------*/
+	Action* buildAction(const ParsedRule& rule, const int order,
+		const int variable_id);
+
+	/*--------------------------------------------------------------------------
+		addRuleVariable
+
+		Looks up the variable named by a matched precondition or action,
+		adding it if there is none, and updates it as the rule requires, see
+		updateRuleVariable.
+	............................................................................
+		@param	rule			the matched precondition or action
+		@return					the id of the propositional or enumerated
+								variable named, or -1 if the rule names none
+	--------------------------------------------------------------------------*/
+	const int addRuleVariable(const ParsedRule& rule);
+
+	/*--------------------------------------------------------------------------
+		updateRuleVariable
+
+		Updates the variable named by a matched precondition or action as the
+		rule requires: marking it non-deterministic, resetting, or having a
+		none value, and adding the value checked or assigned.
+	............................................................................
+		@param	rule			the matched precondition or action
+		@param	variable_id		the id of the variable the rule names
+	--------------------------------------------------------------------------*/
+	void updateRuleVariable(const ParsedRule& rule, const int variable_id);
+
+	/*--------------------------------------------------------------------------
+		matchRule
+
+		Returns the rule matched for the text of a precondition or action,
+		reusing the rule matched for the same text in parallel, or for the
+		last control rule file. Throws an error if matching was unsuccessful.
+	............................................................................
+		@param	rule_type		"R" for a precondition, or "A" for an action
+		@param	s				the text extracted from the control rule file
+		@return					the matched rule
+		@throw					an error message if matching was unsuccessful
+	--------------------------------------------------------------------------*/
+	const ParsedRule matchRule(const std::string rule_type,
+		const std::string s) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		matchRulesInParallel
+
+		Matches the text of rules across a pool of threads, adding the rules
+		matched to matched_rules. Rules that cannot be matched without
+		prompting the user, or that are not valid, are left to be matched
+		again in file order, so that prompts and errors are seen in the same
+		order as when matching in a single thread.
+	............................................................................
+		@param	rules			pairs of rule type and text
+	--------------------------------------------------------------------------*/
+	void matchRulesInParallel(
+		const std::vector<std::pair<std::string, std::string>>& rules);
+
+	/*--------------------------------------------------------------------------
+		setSimilarVariableNames
+
+		Finds the similarities between the names of the variables named by
+		the matched rules, so that adding the rules in file order only has to
+		look them up.
+	............................................................................
+		@param	rules			pairs of rule type and text
+	--------------------------------------------------------------------------*/
+	void setSimilarVariableNames(
+		const std::vector<std::pair<std::string, std::string>>& rules);
+
+	/*--------------------------------------------------------------------------
+		findSimilarNames
+
+		Compares each name in a set with every other across a pool of
+		threads, finding the names similar to each name.
+	............................................................................
+		@param	names			the names to compare
+		@return					the names similar to each name
+	--------------------------------------------------------------------------*/
+	static const SimilarNames findSimilarNames(
+		const std::set<std::string>& names);
 
 	/*--------------------------------------------------------------------------
 		parsePrecondition
@@ -370,25 +606,61 @@ private:
 	............................................................................
 		@param	s				the text extracted from the control rule file
 								representing the precondition
+		@param	line			set to the rule matched and the variable it
+								names
 		@return					a pointer to the parsed Precondition
 		@throw					an error message if parsing was unsuccessful
 	--------------------------------------------------------------------------*/
-	Precondition* parsePrecondition(const std::string s) throw(std::string);
+	Precondition* parsePrecondition(const std::string s, ControlRuleLine& line)
+		throw(std::string);
 
 	/*--------------------------------------------------------------------------
-		parsePreconditionNoStateNSeconds
+		matchPrecondition
+
+		Given a string corresponding to a precondition, possibly with a
+		state-n-seconds term, matches it against the grammar and data
+		extraction rules and returns the matched rule, or throws an error if
+		matching was unsuccessful.
+	............................................................................
+		@param	s				the text extracted from the control rule file
+								representing the precondition
+		@param	context			the automata to match against
+		@return					the matched rule
+		@throw					an error message if matching was unsuccessful
+	--------------------------------------------------------------------------*/
+	const ParsedRule matchPrecondition(const std::string s,
+		const MatchContext& context) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		matchPreconditionNoStateNSeconds
 
 		Given a string corresponding to a precondition, with no state-n-seconds
-		term, constructs and returns a new Precondition, or	throws an error if
-		parsing was unsuccessful.
+		term, matches it against the grammar and data extraction rules and
+		returns the matched rule, or throws an error if matching was
+		unsuccessful.
 	............................................................................
 		@param	s				the text extracted from the control rule file
 								representing the precondition
-		@return					a pointer to the parsed Precondition
-		@throw					an error message if parsing was unsuccessful
+		@param	context			the automata to match against
+		@return					the matched rule
+		@throw					an error message if matching was unsuccessful
 	--------------------------------------------------------------------------*/
-	Precondition* parsePreconditionNoStateNSeconds(const std::string s)
-		throw(std::string);
+	const ParsedRule matchPreconditionNoStateNSeconds(const std::string s,
+		const MatchContext& context) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		buildPrecondition
+
+		Given a matched precondition and the variable it checks, constructs
+		and returns a new Precondition.
+	............................................................................
+		@param	rule			the matched precondition
+		@param	variable_id		the id of the variable the precondition
+								checks, see addRuleVariable
+		@return					a pointer to the new Precondition
+	--------------------------------------------------------------------------*/
+	Precondition* buildPrecondition(const ParsedRule& rule,
+		const int variable_id);
 
 	/*--------------------------------------------------------------------------
 		parseStateNSeconds
@@ -403,6 +675,7 @@ private:
 	............................................................................
 		@param	s				the text extracted from the control rule file
 								representing the state_n_seconds term
+		@param	context			the automata to match against
 		@return					a pair, where the first element is an integer
 								corresponding to the number of seconds, and the
 								second element is apair, where the first element
@@ -414,7 +687,8 @@ private:
 		@throw					an error message if parsing was unsuccessful
 	--------------------------------------------------------------------------*/
 	std::pair<const int, const std::pair<const bool, const bool>>*
-		parseStateNSeconds(const std::string s) throw (std::string);
+		parseStateNSeconds(const std::string s, const MatchContext& context)
+			throw (std::string);
 
 	/*--------------------------------------------------------------------------
 		getAcceptingGrammarRules
@@ -426,6 +700,7 @@ private:
 	............................................................................
 		@param	s				text extracted from the control rule file
 		@param	types			the list of possible types
+		@param	context			the automata to feed the text to
 		@return					a vector of pointers to pairs, where for each
 								pair the first element is an integer
 								corresponding to the type of rule, and the
@@ -433,8 +708,8 @@ private:
 								non-terminal symbol
 	--------------------------------------------------------------------------*/
 	const std::vector<std::pair<int, NonTerminalSymbol*>*>
-		getAcceptingGrammarRules(const std::string s, std::vector<int> types)
-			const;
+		getAcceptingGrammarRules(const std::string s, std::vector<int> types,
+			const MatchContext& context) const;
 
 	/*--------------------------------------------------------------------------
 		validateAcceptingGrammarRules
@@ -460,7 +735,8 @@ private:
 		Prompts the user to select a matching grammar rule for a parsed term
 		if more than one match is found. A pair corresponding to the type
 		and accepting non-terminal symbol for the selected grammar rule is then
-		returned. Throws an error if no match is found.
+		returned. Throws an error if no match is found, or if a prompt is
+		needed and the context does not allow one.
 	............................................................................
 		@param	candidates		a pointer to a vector of pointers to pairs,
 								where for each pair the first element is an
@@ -469,11 +745,13 @@ private:
 								non-terminal symbol
 		@param	s				the original parsed text, used to prompt the
 								user to disambiguate candidates
+		@param	context			the context of the match, which may not
+								allow prompts
 		@throw					an error message if disambiguation fails
 	--------------------------------------------------------------------------*/
 	std::pair<int, NonTerminalSymbol*>* disambiguateCandidates(
 		std::vector<std::pair<int,NonTerminalSymbol*>*>* candidates,
-		const std::string s) throw(std::string);
+		const std::string s, const MatchContext& context) throw(std::string);
 
 	/*--------------------------------------------------------------------------
 		getLastAndConnective
@@ -83,12 +83,17 @@ public:
 	/*--------------------------------------------------------------------------
 		feedLine
 
-		Feeds a line, token by token, to the automaton.
+		Feeds a line, token by token, to the automaton. Throws an error if an
+		ambiguity in a +<any_text> symbol cannot be resolved, or if resolving
+		it needs a prompt that is not allowed.
 	............................................................................
 		@param	line			the line to feed, token-by-token, to the
 								automaton
+		@param	can_prompt		true if the user may be prompted to resolve
+								an ambiguity
 	--------------------------------------------------------------------------*/
-	void feedLine(const std::string line);
+	void feedLine(const std::string line, const bool can_prompt)
+		throw(std::string);
 
 	/*--------------------------------------------------------------------------
 		getInputFromSubAutomaton
@@ -103,6 +108,15 @@ public:
 	const std::string getInputFromSubAutomaton(const unsigned int automaton_num)
 		const;
 
+	/*--------------------------------------------------------------------------
+		getAutomata
+
+		Accessor for automata.
+	............................................................................
+		@return					the list of sub-automata
+	--------------------------------------------------------------------------*/
+	const std::list<Automaton*>& getAutomata() const {return automata;}
+
 	/*--------------------------------------------------------------------------
 		overrides of pure virtual functions in class Automaton
 	--------------------------------------------------------------------------*/
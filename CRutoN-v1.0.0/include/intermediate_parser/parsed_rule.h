@@ -0,0 +1,80 @@
+/*==============================================================================
+	ParsedRule
+
+	The result of matching the text of a precondition or action against the
+	grammar and data extraction rules, before any variable or behaviour is
+	looked up in the intermediate form. Matching depends only on the text
+	and the rule files, so a rule matched once can be reused whenever the
+	same text appears again.
+
+	File			: parsed_rule.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef PARSED_RULE_H_
+#define PARSED_RULE_H_
+
+#include <string>
+#include <vector>
+
+#include "enums/time_constraint_type.h"
+
+struct ParsedRule
+{
+	/*--------------------------------------------------------------------------
+		Constructor
+	--------------------------------------------------------------------------*/
+	ParsedRule() : type(0), time_constraint_type(TimeConstraintType::NONE),
+		time_constraint_seconds(-1) {}
+
+	/*--------------------------------------------------------------------------
+		The type of the accepting grammar rule, one of the precondition or
+		action types of IntermediateFormParser.
+	--------------------------------------------------------------------------*/
+	int type;
+
+	/*--------------------------------------------------------------------------
+		The values extracted from the text, depending on the type:
+			prop value check		name, truth value, non-deterministic
+			enum value check		name, value, has none value,
+									non-deterministic
+			time constraint			start time, end time
+			prop value assignment	name, truth value
+			enum value assignment	name, value, resets
+			execute non-d			the names of the behaviours
+			execute					the name of the behaviour
+			delay					the number of seconds
+		where boolean values are "1" or "0".
+	--------------------------------------------------------------------------*/
+	std::vector<std::string> fields;
+
+	/*--------------------------------------------------------------------------
+		The state-n-seconds term of a precondition, if any.
+	--------------------------------------------------------------------------*/
+	TimeConstraintType time_constraint_type;
+	int time_constraint_seconds;
+};
+
+#endif
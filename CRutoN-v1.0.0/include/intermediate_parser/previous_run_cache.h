@@ -0,0 +1,194 @@
+/*==============================================================================
+	PreviousRunCache
+
+	The record of the last control rule file parsed with a set of grammar
+	and data extraction rule files: the intermediate form built from it, the
+	answers given to prompts, each line of the file as it was parsed, and
+	the actions of the behaviours that execute others as they were before
+	flattening. When the control rule file is edited, only the behaviours
+	whose lines changed are parsed again, see
+	IntermediateFormParser::parseChangedBehaviours.
+
+	File			: previous_run_cache.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef PREVIOUS_RUN_CACHE_H_
+#define PREVIOUS_RUN_CACHE_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "intermediate/cache_file.h"
+#include "intermediate_parser/control_rule_line.h"
+
+class Action;
+class IntermediateForm;
+
+class PreviousRunCache
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	dir				the directory holding the cache files
+	--------------------------------------------------------------------------*/
+	PreviousRunCache(const std::string& dir) : directory(dir) {}
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		computeKey
+
+		Sets the key of the cache file from the contents of the given grammar
+		and data extraction rule files, the resolution policy file, and the
+		options affecting parsing. The control rule file is not part of the
+		key, as it is the file expected to change between runs. Throws an
+		error if an input file cannot be read.
+	............................................................................
+		@param	grammar_rule_file	the name of the grammar rule file
+		@param	data_rule_file		the name of the data extraction rule file
+	--------------------------------------------------------------------------*/
+	void computeKey(const std::string& grammar_rule_file,
+		const std::string& data_rule_file) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		getFilename
+
+		Returns the name of the cache file for the current key.
+	............................................................................
+		@return					the name of the cache file
+	--------------------------------------------------------------------------*/
+	const std::string getFilename() const;
+
+	/*--------------------------------------------------------------------------
+		load
+
+		Returns the intermediate form held in the cache file for the current
+		key, or nullptr if there is no such file. A cache file that cannot be
+		decoded is reported and treated as missing.
+	............................................................................
+		@param	lines			set to the lines of the control rule file
+		@param	unflattened_actions	set to the actions, before flattening,
+								of the behaviours executing others, keyed
+								by id and constructed in the arena of the
+								intermediate form
+		@param	answers			set to the answers given to prompts while
+								the intermediate form was parsed
+		@return					a new intermediate form, owned by the caller,
+								or nullptr
+	--------------------------------------------------------------------------*/
+	IntermediateForm* load(std::vector<ControlRuleLine>& lines,
+		std::map<int, std::vector<Action*>>& unflattened_actions,
+		std::vector<std::pair<std::string, std::string>>& answers) const;
+
+	/*--------------------------------------------------------------------------
+		store
+
+		Writes an intermediate form, and how it was parsed, to the cache file
+		for the current key, replacing any existing file. Throws an error if
+		the file cannot be written.
+	............................................................................
+		@param	intermediate_form	the intermediate form to store
+		@param	lines			the lines of the control rule file
+		@param	unflattened_actions	the actions, before flattening, of the
+								behaviours executing others, keyed by id
+		@param	answers			the answers given to prompts while the
+								intermediate form was parsed
+	--------------------------------------------------------------------------*/
+	void store(const IntermediateForm& intermediate_form,
+		const std::vector<ControlRuleLine>& lines,
+		const std::map<int, std::vector<Action*>>& unflattened_actions,
+		const std::vector<std::pair<std::string, std::string>>& answers)
+			const throw(std::string);
+
+
+private:
+	/*==========================================================================
+		Private Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The characters starting every cache file.
+	--------------------------------------------------------------------------*/
+	static const std::string MAGIC;
+
+	/*--------------------------------------------------------------------------
+		The version of the cache file format, which must be incremented
+		whenever the format or the meaning of what is recorded changes.
+	--------------------------------------------------------------------------*/
+	static const int FORMAT_VERSION;
+
+	/*--------------------------------------------------------------------------
+		The extension of cache files.
+	--------------------------------------------------------------------------*/
+	static const std::string EXTENSION;
+
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The directory holding the cache files.
+	--------------------------------------------------------------------------*/
+	std::string directory;
+
+	/*--------------------------------------------------------------------------
+		The hash of the inputs and options, naming the cache file.
+	--------------------------------------------------------------------------*/
+	CacheHash key;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		decode
+
+		Constructs the intermediate form held in the contents of a cache
+		file, and reads how it was parsed. Throws an error if the contents
+		are not a valid cache file for the current key.
+	............................................................................
+		@param	data			a pointer to the contents of the file
+		@param	size			the number of bytes in the file
+		@param	lines			set to the lines held in the file
+		@param	unflattened_actions	set to the actions before flattening
+		@param	answers			set to the answers held in the file
+		@return					a new intermediate form
+	--------------------------------------------------------------------------*/
+	IntermediateForm* decode(const char* data, const std::size_t size,
+		std::vector<ControlRuleLine>& lines,
+		std::map<int, std::vector<Action*>>& unflattened_actions,
+		std::vector<std::pair<std::string, std::string>>& answers) const
+			throw(std::string);
+};
+
+#endif
@@ -0,0 +1,347 @@
+/*==============================================================================
+	TokenCursor
+
+	A cursor over a character buffer that returns tokens and lines as spans
+	of the buffer, along with their offsets, rather than copying them out of
+	the remaining input.
+
+	File			: token_cursor.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef TOKEN_CURSOR_H_
+#define TOKEN_CURSOR_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+class StringSpan
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	StringSpan() : data(nullptr), length(0), offset(0) {}
+
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	d				a pointer to the first character of the span
+		@param	len				the number of characters in the span
+		@param	off				the offset of the span in the source
+	--------------------------------------------------------------------------*/
+	StringSpan(const char* d, const std::size_t len, const std::size_t off) :
+		data(d), length(len), offset(off) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		getData
+
+		Accessor for data.
+	............................................................................
+		@return					a pointer to the first character of the span
+	--------------------------------------------------------------------------*/
+	const char* getData() const {return data;}
+
+	/*--------------------------------------------------------------------------
+		size
+
+		Accessor for length.
+	............................................................................
+		@return					the number of characters in the span
+	--------------------------------------------------------------------------*/
+	std::size_t size() const {return length;}
+
+	/*--------------------------------------------------------------------------
+		empty
+
+		Returns true if the span contains no characters.
+	............................................................................
+		@return					true if the span is empty
+	--------------------------------------------------------------------------*/
+	bool empty() const {return length == 0;}
+
+	/*--------------------------------------------------------------------------
+		getOffset
+
+		Accessor for offset.
+	............................................................................
+		@return					the offset of the span in the source
+	--------------------------------------------------------------------------*/
+	std::size_t getOffset() const {return offset;}
+
+	/*--------------------------------------------------------------------------
+		str
+
+		Returns a copy of the characters in the span.
+	............................................................................
+		@return					the span as a string
+	--------------------------------------------------------------------------*/
+	std::string str() const {return std::string(data, length);}
+
+	/*--------------------------------------------------------------------------
+		find
+
+		Returns the position of the first occurrence of the string in the span
+		at or after the given position.
+	............................................................................
+		@param	s				the string to find
+		@param	from			the position to start searching from
+		@return					the position of the string, or
+								std::string::npos if it was not found
+	--------------------------------------------------------------------------*/
+	std::size_t find(const std::string& s, const std::size_t from = 0) const
+	{
+		if(from > length)
+		{
+			return std::string::npos;
+		}
+		const char* end = data + length;
+		const char* it = std::search(data + from, end, s.begin(), s.end());
+		return (it == end && !s.empty()) ? std::string::npos : it - data;
+	}
+
+	/*--------------------------------------------------------------------------
+		substr
+
+		Returns the part of the span starting at the given position.
+	............................................................................
+		@param	pos				the position of the first character
+		@return					a span from pos to the end of this span
+	--------------------------------------------------------------------------*/
+	const StringSpan substr(const std::size_t pos) const
+	{
+		std::size_t start = pos < length ? pos : length;
+		return StringSpan(data + start, length - start, offset + start);
+	}
+
+	/*--------------------------------------------------------------------------
+		comparison with strings
+	--------------------------------------------------------------------------*/
+	bool operator==(const char* s) const
+	{
+		return std::strlen(s) == length && std::memcmp(data, s, length) == 0;
+	}
+	bool operator!=(const char* s) const {return !(*this == s);}
+	bool operator==(const std::string& s) const
+	{
+		return s.size() == length && s.compare(0, length, data, length) == 0;
+	}
+	bool operator!=(const std::string& s) const {return !(*this == s);}
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		A pointer to the first character of the span.
+	--------------------------------------------------------------------------*/
+	const char* data;
+
+	/*--------------------------------------------------------------------------
+		The number of characters in the span.
+	--------------------------------------------------------------------------*/
+	std::size_t length;
+
+	/*--------------------------------------------------------------------------
+		The offset of the span in the source.
+	--------------------------------------------------------------------------*/
+	std::size_t offset;
+};
+
+class TokenCursor
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+
+		The string must outlive the cursor and any spans it returns.
+	............................................................................
+		@param	s				the input string
+	--------------------------------------------------------------------------*/
+	TokenCursor(const std::string& s) : data(s.data()), length(s.size()),
+		pos(0), base_offset(0) {}
+
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	span			the span to read, offsets are relative to the
+								source of the span
+	--------------------------------------------------------------------------*/
+	TokenCursor(const StringSpan& span) : data(span.getData()),
+		length(span.size()), pos(0), base_offset(span.getOffset()) {}
+
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	d				a pointer to the character buffer
+		@param	len				the number of characters in the buffer
+		@param	off				the offset of the buffer in the source
+	--------------------------------------------------------------------------*/
+	TokenCursor(const char* d, const std::size_t len,
+		const std::size_t off = 0) : data(d), length(len), pos(0),
+			base_offset(off) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		isWhitespace
+
+		Returns true if the character is whitespace in the classic locale.
+	............................................................................
+		@param	c				the character
+		@return					true if the character is whitespace
+	--------------------------------------------------------------------------*/
+	static bool isWhitespace(const char c)
+	{
+		return c == ' ' || (c >= '\t' && c <= '\r');
+	}
+
+	/*--------------------------------------------------------------------------
+		getOffset
+
+		Returns the offset of the cursor in the source.
+	............................................................................
+		@return					the offset of the cursor
+	--------------------------------------------------------------------------*/
+	std::size_t getOffset() const {return base_offset + pos;}
+
+	/*--------------------------------------------------------------------------
+		atEnd
+
+		Returns true if there are no characters left to read.
+	............................................................................
+		@return					true if the cursor is at the end of the input
+	--------------------------------------------------------------------------*/
+	bool atEnd() const {return pos >= length;}
+
+	/*--------------------------------------------------------------------------
+		hasNextToken
+
+		Returns true if there is a token available to read. Does not move
+		the cursor.
+	............................................................................
+		@return					true if there is another token
+	--------------------------------------------------------------------------*/
+	const bool hasNextToken() const;
+
+	/*--------------------------------------------------------------------------
+		getNextToken
+
+		Returns the next available token and moves the cursor past it.
+	............................................................................
+		@return					the next token, or an empty span if there are
+								no more tokens
+	--------------------------------------------------------------------------*/
+	const StringSpan getNextToken();
+
+	/*--------------------------------------------------------------------------
+		peekNextToken
+
+		Returns the next available token without moving the cursor.
+	............................................................................
+		@return					the next token, or an empty span if there are
+								no more tokens
+	--------------------------------------------------------------------------*/
+	const StringSpan peekNextToken() const;
+
+	/*--------------------------------------------------------------------------
+		getNextLine
+
+		Returns the next line, without the terminating newline, and moves the
+		cursor to the start of the following line.
+	............................................................................
+		@return					the next line
+	--------------------------------------------------------------------------*/
+	const StringSpan getNextLine();
+
+	/*--------------------------------------------------------------------------
+		getRemaining
+
+		Returns the input that has not yet been read, without moving the
+		cursor.
+	............................................................................
+		@return					the remaining input
+	--------------------------------------------------------------------------*/
+	const StringSpan getRemaining() const;
+
+	/*--------------------------------------------------------------------------
+		getShortestPrefixEndingWithChar
+
+		Returns the shortest prefix of the remaining input that terminates
+		with the given character, and moves the cursor past it. Whitespace
+		is removed from the prefix, so it is returned as a string.
+	............................................................................
+		@param	c				the terminating character
+		@return					the shortest prefix of the remaining input that
+								terminates with c
+	--------------------------------------------------------------------------*/
+	const std::string getShortestPrefixEndingWithChar(const char c);
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		A pointer to the character buffer.
+	--------------------------------------------------------------------------*/
+	const char* data;
+
+	/*--------------------------------------------------------------------------
+		The number of characters in the buffer.
+	--------------------------------------------------------------------------*/
+	std::size_t length;
+
+	/*--------------------------------------------------------------------------
+		The position of the cursor in the buffer.
+	--------------------------------------------------------------------------*/
+	std::size_t pos;
+
+	/*--------------------------------------------------------------------------
+		The offset of the buffer in the source.
+	--------------------------------------------------------------------------*/
+	std::size_t base_offset;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		skipWhitespace
+
+		Returns the position of the first non-whitespace character at or
+		after the given position.
+	--------------------------------------------------------------------------*/
+	std::size_t skipWhitespace(std::size_t from) const;
+};
+
+#endif
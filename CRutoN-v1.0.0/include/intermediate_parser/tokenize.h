@@ -32,60 +32,6 @@
 
 #include <string>
 
-/*--------------------------------------------------------------------------
-	hasNextToken
-
-	Returns true if the string has a token available to read.
-............................................................................
-	@param	input_string	the input string
-	@return					true if the input string has another token
---------------------------------------------------------------------------*/
-const bool hasNextToken(std::string& input_string);
-
-/*--------------------------------------------------------------------------
-	getNextToken
-
-	Removes and returns the next available token from the string.
-............................................................................
-	@param	input_string	the input string
-	@return					the next available token from the string
---------------------------------------------------------------------------*/
-const std::string getNextToken(std::string& input_string);
-
-/*--------------------------------------------------------------------------
-	peekNextToken
-
-	Returns the next available token from the string.
-............................................................................
-	@param	input_string	the input string
-	@return					the next available token from the string
---------------------------------------------------------------------------*/
-const std::string peekNextToken(std::string& input_string);
-
-/*--------------------------------------------------------------------------
-	getNextLine
-
-	Removes and returns the next available line from the string.
-............................................................................
-	@param	input_string	the input string
-	@return					the next available line from the string
---------------------------------------------------------------------------*/
-const std::string getNextLine(std::string& input_string);
-
-/*--------------------------------------------------------------------------
-	getShortestPrefixEndingWithChar
-
-	Returns the shortest prefix of the string that terminates with the
-	given character.
-............................................................................
-	@param	input_string	the input string
-	@param	c				the terminating character
-	@return					the shortes prefix of the string that terminates
-							with c
---------------------------------------------------------------------------*/
-const std::string getShortestPrefixEndingWithChar(
-	std::string& input_string, const char c);
-
 /*--------------------------------------------------------------------------
 	trimString
 
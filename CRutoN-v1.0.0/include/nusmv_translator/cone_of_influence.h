@@ -0,0 +1,198 @@
+/*==============================================================================
+	ConeOfInfluence
+
+	Computes the part of the intermediate form that a set of target
+	behaviours and variables depend upon, so that the NuSMV translation can
+	omit everything outside of it.
+
+	File			: cone_of_influence.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef CONE_OF_INFLUENCE_H_
+#define CONE_OF_INFLUENCE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "intermediate/behaviour.h"
+#include "intermediate/intermediate_form.h"
+
+/*------------------------------------------------------------------------------
+	Every behaviour that can be scheduled competes for the schedule variable,
+	so the schedule depends upon the preconditions of all of them. The cone
+	therefore contains the schedulable behaviours, the target behaviours and
+	every behaviour that these may execute, together with the target
+	variables and every variable checked by a precondition of a behaviour in
+	the cone. A variable outside of the cone is never read by the model, and
+	a behaviour outside of the cone can never be scheduled.
+------------------------------------------------------------------------------*/
+class ConeOfInfluence
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	inter			the intermediate form to slice
+	--------------------------------------------------------------------------*/
+	ConeOfInfluence(const IntermediateForm* inter);
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		loadTargets
+
+		Adds each target in the given file, one per line. Lines that are empty
+		or begin with # are ignored. Throws an error if the file cannot be read
+		or a target matches nothing.
+	............................................................................
+		@param	filename		the name of the targets file
+	--------------------------------------------------------------------------*/
+	void loadTargets(const std::string& filename) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		addTarget
+
+		Adds a target, which is either the name of a behaviour or variable, or
+		a NuSMV specification whose identifiers name behaviours or variables
+		as they appear in the translation. Throws an error if the target
+		matches nothing.
+	............................................................................
+		@param	target			the target to add
+	--------------------------------------------------------------------------*/
+	void addTarget(const std::string& target) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		compute
+
+		Computes the cone of influence of the targets added so far.
+	--------------------------------------------------------------------------*/
+	void compute();
+
+	/*--------------------------------------------------------------------------
+		containsBehaviour
+
+		Returns true if the behaviour with the given id is in the cone.
+	............................................................................
+		@param	id				the id of the behaviour
+		@return					true if the behaviour is in the cone, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool containsBehaviour(const int id) const
+	{
+		return behaviour_in_cone[id];
+	}
+
+	/*--------------------------------------------------------------------------
+		containsPropVariable
+
+		Returns true if the propositional variable with the given id is in the
+		cone.
+	............................................................................
+		@param	id				the id of the propositional variable
+		@return					true if the variable is in the cone, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool containsPropVariable(const int id) const
+	{
+		return prop_variable_in_cone[id];
+	}
+
+	/*--------------------------------------------------------------------------
+		containsEnumVariable
+
+		Returns true if the enumerated variable with the given id is in the
+		cone.
+	............................................................................
+		@param	id				the id of the enumerated variable
+		@return					true if the variable is in the cone, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool containsEnumVariable(const int id) const
+	{
+		return enum_variable_in_cone[id];
+	}
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The intermediate form.
+	--------------------------------------------------------------------------*/
+	const IntermediateForm* intermediate_form;
+
+	/*--------------------------------------------------------------------------
+		Map each name and NuSMV identifier that can be given as a target to
+		the ids of the behaviours and variables that it denotes.
+	--------------------------------------------------------------------------*/
+	std::multimap<std::string, int> behaviour_names;
+	std::multimap<std::string, int> prop_variable_names;
+	std::multimap<std::string, int> enum_variable_names;
+
+	/*--------------------------------------------------------------------------
+		The ids of the target behaviours.
+	--------------------------------------------------------------------------*/
+	std::vector<int> target_behaviours;
+
+	/*--------------------------------------------------------------------------
+		Marks, by id, the behaviours and variables that are in the cone.
+	--------------------------------------------------------------------------*/
+	std::vector<bool> behaviour_in_cone;
+	std::vector<bool> prop_variable_in_cone;
+	std::vector<bool> enum_variable_in_cone;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addTargetName
+
+		Adds whatever the given name or identifier denotes to the targets.
+	............................................................................
+		@param	name			the name or identifier
+		@return					true if the name denotes something, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool addTargetName(const std::string& name);
+
+	/*--------------------------------------------------------------------------
+		addBehaviour
+
+		Adds the given behaviour to the cone, together with every behaviour it
+		may execute and the variables checked by their preconditions.
+	............................................................................
+		@param	behaviour		the behaviour to add
+	--------------------------------------------------------------------------*/
+	void addBehaviour(Behaviour* behaviour);
+};
+
+#endif
@@ -0,0 +1,292 @@
+/*==============================================================================
+	ExpressionDag
+
+	A hash-consed DAG of boolean expressions, used to build the precondition
+	definitions of a NuSMV model so that subexpressions common to several
+	behaviours are defined once.
+
+	File			: expression_dag.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef EXPRESSION_DAG_H_
+#define EXPRESSION_DAG_H_
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "enums/expression_node_type.h"
+
+/*------------------------------------------------------------------------------
+	Each node is created at most once, so equal expressions share a node
+	whichever behaviours they come from. Expressions are simplified as they
+	are built: constants are folded, double negations are removed, and
+	idempotent, complementary and absorbed operands are eliminated. The
+	conjunctions and disjunctions that are used more than once can then be
+	given names, and are written as references to those names elsewhere.
+------------------------------------------------------------------------------*/
+class ExpressionDag
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+
+		Creates a DAG holding only the constants TRUE and FALSE.
+	--------------------------------------------------------------------------*/
+	ExpressionDag();
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addConstant
+
+		Returns the node for a constant.
+	............................................................................
+		@param	value			the value of the constant
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addConstant(const bool value) const {return value ? 0 : 1;}
+
+	/*--------------------------------------------------------------------------
+		addAtom
+
+		Returns the node for an expression that is not simplified further.
+	............................................................................
+		@param	text			the text of the expression
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addAtom(const std::string& text);
+
+	/*--------------------------------------------------------------------------
+		addNot
+
+		Returns the node for the negation of an expression.
+	............................................................................
+		@param	operand			the node of the expression
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addNot(const int operand);
+
+	/*--------------------------------------------------------------------------
+		addAnd
+
+		Returns the node for the conjunction of two expressions.
+	............................................................................
+		@param	left			the node of the left expression
+		@param	right			the node of the right expression
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addAnd(const int left, const int right);
+
+	/*--------------------------------------------------------------------------
+		addOr
+
+		Returns the node for the disjunction of two expressions.
+	............................................................................
+		@param	left			the node of the left expression
+		@param	right			the node of the right expression
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addOr(const int left, const int right);
+
+	/*--------------------------------------------------------------------------
+		addRoot
+
+		Records a use of a node from outside of the DAG.
+	............................................................................
+		@param	node			the node
+	--------------------------------------------------------------------------*/
+	void addRoot(const int node) {roots.push_back(node);}
+
+	/*--------------------------------------------------------------------------
+		nameSharedNodes
+
+		Names each conjunction and disjunction that is used more than once,
+		counting the uses by the roots and by the nodes reachable from them.
+	............................................................................
+		@param	prefix			the prefix of the names, which are numbered
+								from 1
+	--------------------------------------------------------------------------*/
+	void nameSharedNodes(const std::string& prefix);
+
+	/*--------------------------------------------------------------------------
+		getSharedNodes
+
+		Accessor for shared_nodes.
+	............................................................................
+		@return					the named nodes, in the order they were named
+	--------------------------------------------------------------------------*/
+	const std::vector<int>& getSharedNodes() const {return shared_nodes;}
+
+	/*--------------------------------------------------------------------------
+		getName
+
+		Returns the name of a node, which is empty if the node is not shared.
+	............................................................................
+		@param	node			the node
+		@return					the name
+	--------------------------------------------------------------------------*/
+	const std::string& getName(const int node) const {return names[node];}
+
+	/*--------------------------------------------------------------------------
+		getExpression
+
+		Returns the expression of a node, referring to shared nodes by name.
+	............................................................................
+		@param	node			the node
+		@return					the expression
+	--------------------------------------------------------------------------*/
+	const std::string getExpression(const int node) const;
+
+	/*--------------------------------------------------------------------------
+		getDefinition
+
+		Returns the expression of a node, which is written out in full even
+		if the node itself is shared.
+	............................................................................
+		@param	node			the node
+		@return					the expression
+	--------------------------------------------------------------------------*/
+	const std::string getDefinition(const int node) const;
+
+
+private:
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		A node, with the text of an atom or the operands of an operator.
+	--------------------------------------------------------------------------*/
+	struct ExpressionNode
+	{
+		ExpressionNodeType type;
+		std::string text;
+		int left;
+		int right;
+	};
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The nodes, indexed by node.
+	--------------------------------------------------------------------------*/
+	std::vector<ExpressionNode> nodes;
+
+	/*--------------------------------------------------------------------------
+		Maps a key identifying the type and contents of each node to the node,
+		the operands of commutative operators being ordered in the key.
+	--------------------------------------------------------------------------*/
+	std::unordered_map<std::string, int> node_index;
+
+	/*--------------------------------------------------------------------------
+		The nodes used from outside of the DAG.
+	--------------------------------------------------------------------------*/
+	std::vector<int> roots;
+
+	/*--------------------------------------------------------------------------
+		The names of the nodes, indexed by node, and the named nodes.
+	--------------------------------------------------------------------------*/
+	std::vector<std::string> names;
+	std::vector<int> shared_nodes;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addNode
+
+		Returns the node with the given contents, creating it if it does not
+		already exist.
+	............................................................................
+		@param	type			the type of the node
+		@param	text			the text of an atom, or empty
+		@param	left			the first operand, or -1
+		@param	right			the second operand, or -1
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addNode(const ExpressionNodeType type, const std::string& text,
+		const int left, const int right);
+
+	/*--------------------------------------------------------------------------
+		hasOperand
+
+		Returns true if a node is an operator of the given type with the
+		given operand.
+	............................................................................
+		@param	node			the node
+		@param	type			the type of operator
+		@param	operand			the operand
+		@return					true if the node has the operand, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool hasOperand(const int node, const ExpressionNodeType type,
+		const int operand) const;
+
+	/*--------------------------------------------------------------------------
+		isComplement
+
+		Returns true if one of the given nodes is the negation of the other.
+	............................................................................
+		@param	node_1			the first node
+		@param	node_2			the second node
+		@return					true if the nodes are complementary, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool isComplement(const int node_1, const int node_2) const;
+
+	/*--------------------------------------------------------------------------
+		countUses
+
+		Counts the uses of the operands of a node and of the nodes below it,
+		visiting each node once.
+	............................................................................
+		@param	node			the node
+		@param	uses			the number of uses, indexed by node
+		@param	visited			marks the visited nodes
+		@param	order			the visited nodes, operands first
+	--------------------------------------------------------------------------*/
+	void countUses(const int node, std::vector<int>& uses,
+		std::vector<bool>& visited, std::vector<int>& order) const;
+
+	/*--------------------------------------------------------------------------
+		buildExpression
+
+		Builds the expression of a node.
+	............................................................................
+		@param	node			the node
+		@param	expand			true if the node should be written out in full
+								even if it is shared
+		@return					the expression
+	--------------------------------------------------------------------------*/
+	const std::string buildExpression(const int node, const bool expand) const;
+};
+
+#endif
@@ -48,10 +48,12 @@
 #define B_IS_SCHEDULED "is_scheduled"
 
 #define SCHEDULE "schedule"
+#define SCHEDULE_CHOICE "schedule_choice"
 #define LAST_SCHEDULE "last_schedule"
 #define STEP "step"
 #define TIME "time"
 #define PRECONDITION_PREFIX "pre_"
+#define SHARED_PRECONDITION_PREFIX "pre_shared_"
 #define BEEN_IN_WAS_IN_PREFIX "s_"
 #define BEEN_IN_WAS_IN_FINAL "final"
 #define BEEN_IN_WAS_IN_START "0"
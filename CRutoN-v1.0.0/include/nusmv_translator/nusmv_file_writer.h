@@ -0,0 +1,89 @@
+/*==============================================================================
+	NuSMVFileWriter
+
+	Writes NuSMV input to a file.
+
+	File			: nusmv_file_writer.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef NUSMV_FILE_WRITER_H_
+#define NUSMV_FILE_WRITER_H_
+
+#include <fstream>
+#include <string>
+
+#include "nusmv_translator/nusmv_writer.h"
+
+class NuSMVFileWriter: public NuSMVWriter
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+
+		Opens the file for writing, replacing any existing contents.
+	............................................................................
+		@param	filename		the name of the file to write to
+	--------------------------------------------------------------------------*/
+	NuSMVFileWriter(const std::string& filename) :
+		file_stream(filename) {}
+
+	~NuSMVFileWriter() {flush();}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		isOpen
+
+		Returns true if the file was opened successfully.
+	............................................................................
+		@return					true if the file is open, or false otherwise
+	--------------------------------------------------------------------------*/
+	const bool isOpen() const {return file_stream.is_open();}
+
+protected:
+	/*--------------------------------------------------------------------------
+		overrides of pure virtual functions in class NuSMVWriter
+	--------------------------------------------------------------------------*/
+	void writeBuffer(const char* data, const std::size_t length)
+	{
+		file_stream.write(data, length);
+	}
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The file being written.
+	--------------------------------------------------------------------------*/
+	std::ofstream file_stream;
+};
+
+#endif
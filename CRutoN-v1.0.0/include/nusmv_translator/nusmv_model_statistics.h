@@ -0,0 +1,175 @@
+/*==============================================================================
+	NuSMVModelStatistics
+
+	Measures the size of a NuSMV model as it is written: its variables, the
+	bits needed to encode its state, its definitions, the branches of its
+	case expressions, and the size of each section.
+
+	File			: nusmv_model_statistics.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef NUSMV_MODEL_STATISTICS_H_
+#define NUSMV_MODEL_STATISTICS_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/*------------------------------------------------------------------------------
+	The model is measured from its text, which is passed in by the writer in
+	blocks that need not end at the end of a line. The sections of module
+	main are named by their keyword, and every other module is a single
+	section named after it.
+------------------------------------------------------------------------------*/
+class NuSMVModelStatistics
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	NuSMVModelStatistics() : num_variables(0), num_module_instances(0),
+		num_input_variables(0), num_state_bits(0), num_input_bits(0),
+		case_depth(0), section(0)
+	{
+		// the comments before the first module
+		addSection("header");
+	}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		scan
+
+		Measures a block of the model's text.
+	............................................................................
+		@param	data			the text
+		@param	length			the number of characters of text
+	--------------------------------------------------------------------------*/
+	void scan(const char* data, const std::size_t length);
+
+	/*--------------------------------------------------------------------------
+		writeJson
+
+		Writes the measurements as a JSON object.
+	............................................................................
+		@param	os				the stream to write to
+		@param	num_tabs		the indentation of the object's contents
+	--------------------------------------------------------------------------*/
+	void writeJson(std::ostream& os, const int num_tabs) const;
+
+
+private:
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The size of a section, with its number of statements, each case
+		expression being part of one statement.
+	--------------------------------------------------------------------------*/
+	struct Section
+	{
+		std::string name;
+		unsigned long long num_bytes;
+		unsigned long long num_lines;
+		unsigned long long num_statements;
+		unsigned long long num_case_branches;
+	};
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The number of state variables declared in VAR and FROZENVAR sections,
+		the number of module instances, the number of input variables, and
+		the bits needed to encode the state and input variables.
+	--------------------------------------------------------------------------*/
+	unsigned long long num_variables;
+	unsigned long long num_module_instances;
+	unsigned long long num_input_variables;
+	unsigned long long num_state_bits;
+	unsigned long long num_input_bits;
+
+	/*--------------------------------------------------------------------------
+		The sections in the order in which they first appear, and the text of
+		the line being scanned.
+	--------------------------------------------------------------------------*/
+	std::vector<Section> sections;
+	std::string line;
+
+	/*--------------------------------------------------------------------------
+		The module being scanned, the depth of nested case expressions, and
+		the index of the current section.
+	--------------------------------------------------------------------------*/
+	std::string module;
+	int case_depth;
+	unsigned int section;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addSection
+
+		Makes the section with the given name current, adding it if it has
+		not been seen before.
+	............................................................................
+		@param	name			the name of the section
+	--------------------------------------------------------------------------*/
+	void addSection(const std::string& name);
+
+	/*--------------------------------------------------------------------------
+		scanLine
+
+		Measures a complete line of the model's text.
+	............................................................................
+		@param	text			the line, without its newline
+	--------------------------------------------------------------------------*/
+	void scanLine(const std::string& text);
+
+	/*--------------------------------------------------------------------------
+		countDeclaration
+
+		Counts a variable declared in a VAR, FROZENVAR or IVAR section.
+	............................................................................
+		@param	declaration		the declaration, without leading whitespace
+	--------------------------------------------------------------------------*/
+	void countDeclaration(const std::string& declaration);
+
+	/*--------------------------------------------------------------------------
+		getTypeBits
+
+		Returns the number of bits needed to encode a variable of the given
+		type, which is 0 for a module instance.
+	............................................................................
+		@param	type			the type, as declared
+		@return					the number of bits
+	--------------------------------------------------------------------------*/
+	static const unsigned int getTypeBits(const std::string& type);
+};
+
+#endif
@@ -0,0 +1,73 @@
+/*==============================================================================
+	NuSMVStreamWriter
+
+	Writes NuSMV input to an output stream.
+
+	File			: nusmv_stream_writer.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef NUSMV_STREAM_WRITER_H_
+#define NUSMV_STREAM_WRITER_H_
+
+#include <ostream>
+
+#include "nusmv_translator/nusmv_writer.h"
+
+class NuSMVStreamWriter: public NuSMVWriter
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	os				the stream to write to
+	--------------------------------------------------------------------------*/
+	NuSMVStreamWriter(std::ostream& os) : stream(os) {}
+
+	~NuSMVStreamWriter() {flush();}
+
+protected:
+	/*--------------------------------------------------------------------------
+		overrides of pure virtual functions in class NuSMVWriter
+	--------------------------------------------------------------------------*/
+	void writeBuffer(const char* data, const std::size_t length)
+	{
+		stream.write(data, length);
+	}
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The stream to write to.
+	--------------------------------------------------------------------------*/
+	std::ostream& stream;
+};
+
+#endif
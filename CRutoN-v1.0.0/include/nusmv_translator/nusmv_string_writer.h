@@ -0,0 +1,73 @@
+/*==============================================================================
+	NuSMVStringWriter
+
+	Writes NuSMV input to a string buffer.
+
+	File			: nusmv_string_writer.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef NUSMV_STRING_WRITER_H_
+#define NUSMV_STRING_WRITER_H_
+
+#include <string>
+
+#include "nusmv_translator/nusmv_writer.h"
+
+class NuSMVStringWriter: public NuSMVWriter
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	s				the string to append to
+	--------------------------------------------------------------------------*/
+	NuSMVStringWriter(std::string& s) : output(s) {}
+
+	~NuSMVStringWriter() {flush();}
+
+protected:
+	/*--------------------------------------------------------------------------
+		overrides of pure virtual functions in class NuSMVWriter
+	--------------------------------------------------------------------------*/
+	void writeBuffer(const char* data, const std::size_t length)
+	{
+		output.append(data, length);
+	}
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The string to append to.
+	--------------------------------------------------------------------------*/
+	std::string& output;
+};
+
+#endif
@@ -32,12 +32,26 @@
 #ifndef NUSMV_TRANSLATOR_H_
 #define NUSMV_TRANSLATOR_H_
 
+#include <cstdint>
+#include <functional>
 #include <string>
 #include <list>
 #include <map>
+#include <set>
+#include <vector>
 
+#include "enums/variable_class.h"
+#include "intermediate/intermediate_form.h"
 #include "intermediate/precondition_timing_constraint.h"
+#include "intermediate/tree_node.h"
+#include "nusmv_translator/expression_dag.h"
 #include "nusmv_translator/nusmv_definitions.h"
+#include "nusmv_translator/nusmv_writer.h"
+#include "nusmv_translator/translator_options.h"
+
+class PhaseStatistics;
+class PhaseTimer;
+class TranslationCache;
 
 class NuSMVTranslator
 {
@@ -48,10 +62,17 @@ public:
 	/*--------------------------------------------------------------------------
 		Constructor
 	............................................................................
-		@param	inter			the intermediate form representation
+		@param	inter			the intermediate form representation, which is
+								not modified and may be shared with other
+								translators
+		@param	opts			the settings used for the translation
 	--------------------------------------------------------------------------*/
-	NuSMVTranslator(IntermediateForm* inter) : intermediate_form(inter),
-		max_num_actions(0) {}
+	NuSMVTranslator(const IntermediateForm* inter,
+		const TranslatorOptions& opts) :
+			intermediate_form(inter), options(opts), max_num_actions(0),
+			num_variables(0), num_bits(0), num_removed_variables(0),
+			num_removed_bits(0), statistics(nullptr),
+			translation_cache(nullptr) {}
 
 	~NuSMVTranslator();
 
@@ -59,29 +80,143 @@ public:
 		Public Functions
 	===========================================================================*/
 	/*--------------------------------------------------------------------------
-		translate
+		prepareTranslation
 
-		Translates the intermediate form into NuSMV input, which is returned as
-		a string.
+		Analyses the intermediate form before it is translated, displaying any
+		errors or warnings. Must be called before translate.
 	............................................................................
-		@return					the NuSMV input as a string, or an empty string
-								if there was an error
+		@return					true if the intermediate form can be
+								translated, or false if there was an error
 	--------------------------------------------------------------------------*/
-	const std::string translate();
+	const bool prepareTranslation();
+
+	/*--------------------------------------------------------------------------
+		prepareTranslation
+
+		Analyses the intermediate form before it is translated, displaying any
+		errors or warnings. The given initial values are assigned to variables.
+		Must be called before translate.
+	............................................................................
+		@param	initial_values	maps variable names to their initial values,
+								see buildInitialVariableValueMap
+		@return					true if the intermediate form can be
+								translated, or false if there was an error
+	--------------------------------------------------------------------------*/
+	const bool prepareTranslation(
+		const std::map<std::string, std::string>& initial_values);
 
 	/*--------------------------------------------------------------------------
 		translate
 
-		Translates the intermediate form into NuSMV input, which is returned as
-		a string. Initial values for variables can be specified in the initial
-		value file.
+		Translates the intermediate form into NuSMV input, which is written to
+		the given writer as it is built. With more than one thread the
+		sections of the model are built concurrently into separate buffers,
+		and the input written is the same as with one thread.
+	............................................................................
+		@param	writer			the writer to which the NuSMV input is written
+		@param	num_threads		the number of threads building the sections
+	--------------------------------------------------------------------------*/
+	void translate(NuSMVWriter& writer, const unsigned int num_threads = 1);
+
+	/*--------------------------------------------------------------------------
+		getSliceSummary
+
+		Describes how much of the intermediate form was left out of the
+		translation by the cone of influence. Must be called after
+		prepareTranslation.
+	............................................................................
+		@return					the description
+	--------------------------------------------------------------------------*/
+	const std::string getSliceSummary() const;
+
+	/*==========================================================================
+		Public Static Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		buildInitialVariableValueMap
+
+		Builds the initial variable value map. The names in the file are
+		resolved against the intermediate form, so the user may be prompted to
+		disambiguate them. The map is built once and can then be given to any
+		number of translators.
+	............................................................................
+		@param	intermediate_form		the intermediate form
+		@param	filename				the name of the file containing the
+										initial variable values
+		@param	initial_variable_values	the map to which the initial values
+										are added
+		@return							true if the file was parsed
+										successfully, or false otherwise
+	--------------------------------------------------------------------------*/
+	static const bool buildInitialVariableValueMap(
+		IntermediateForm* intermediate_form, const std::string& filename,
+		std::map<std::string, std::string>& initial_variable_values);
+
+	/*--------------------------------------------------------------------------
+		validateIdentifier
+
+		Checks the given identifier to ensure that it contains no characters
+		that are illegal in NuSMV. Illegal characters are replaced with
+		INVALID_CHAR_REPLACEMENT_STRING defined in
+		nusmv_definitions.h. The validated identifier is then returned.
+	............................................................................
+		@param	identifier		the unvalidated indentifier
+		@return					the validated identifier
+	--------------------------------------------------------------------------*/
+	static const std::string validateIdentifier(std::string identifier);
+
+	/*--------------------------------------------------------------------------
+		isValidStartCharacter
+
+		Given a character, returns true if this character is a legal starting
+		character for an identifier in NuSMV.
 	............................................................................
-		@param	initial_value_file	the file containing initial values for
-									variables
-		@return						the NuSMV input as a string, or an empty
-									string if there was an error
+		@param	c				the character
+		@return					true if the character is a legal starting
+								character for an identifier in NuSMV, or false
+								otherwise
 	--------------------------------------------------------------------------*/
-	const std::string translate(std::string& initial_value_file);
+	static const bool isValidStartCharacter(const char c);
+
+	/*--------------------------------------------------------------------------
+		isValidCharacter
+
+		Given a character, returns true if this character is a legal character
+		for an identifier in NuSMV.
+	............................................................................
+		@param	c				the character
+		@return					true if the character is a legal character for
+								an identifier in NuSMV, or false otherwise
+	--------------------------------------------------------------------------*/
+	static const bool isValidCharacter(const char c);
+
+	/*--------------------------------------------------------------------------
+		setStatistics
+
+		Sets the statistics in which the phases of the preparation and the
+		translation are recorded, or null if they should not be recorded.
+	............................................................................
+		@param	s				the statistics, which are not owned
+	--------------------------------------------------------------------------*/
+	void setStatistics(PhaseStatistics* s) {statistics = s;}
+
+	/*--------------------------------------------------------------------------
+		setTranslationCache
+
+		Sets the cache holding the sections of the last model translated with
+		the same options, or null if sections should not be cached. Only the
+		sections whose inputs have changed since are built again, and the
+		analyses only they need are left out of prepareTranslation. Must be
+		called before prepareTranslation, and only without a cone of
+		influence.
+	............................................................................
+		@param	c				the cache, which is not owned
+	--------------------------------------------------------------------------*/
+	void setTranslationCache(TranslationCache* c) {translation_cache = c;}
+
+	// the simulator follows the semantics of the translation, using its
+	// analysis of the intermediate form
+	friend class Simulator;
 
 private:
 	/*==========================================================================
@@ -92,19 +227,77 @@ private:
 	--------------------------------------------------------------------------*/
 	static const std::string MODULE_BEHAVIOUR;
 
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		A section of the NuSMV model, the name of its phase, the inputs it is
+		built from, as a combination of SectionInput flags, and a function
+		that writes the section to the given writer.
+	--------------------------------------------------------------------------*/
+	struct Section
+	{
+		Section(const std::string& n, const int i,
+			const std::function<void(NuSMVWriter&)>& b) : name(n),
+				inputs(i), build(b) {}
+
+		std::string name;
+		int inputs;
+		std::function<void(NuSMVWriter&)> build;
+	};
+
 	/*==========================================================================
 		Private Member Variables
 	==========================================================================*/
 	/*--------------------------------------------------------------------------
 		The intermediate form.
 	--------------------------------------------------------------------------*/
-	IntermediateForm* intermediate_form;
+	const IntermediateForm* intermediate_form;
+
+	/*--------------------------------------------------------------------------
+		The settings used for the translation.
+	--------------------------------------------------------------------------*/
+	const TranslatorOptions options;
 
 	/*--------------------------------------------------------------------------
 		Used to record the maximum number of actions found in a behaviour.
 	--------------------------------------------------------------------------*/
 	unsigned int max_num_actions;
 
+	/*--------------------------------------------------------------------------
+		The behaviours that are translated, ordered by id. These are the
+		behaviours in the cone of influence, if one was given.
+	--------------------------------------------------------------------------*/
+	std::vector<Behaviour*> behaviours;
+
+	/*--------------------------------------------------------------------------
+		The number of variables in the intermediate form and the number of
+		bits needed to encode them, including the been in state and was in
+		state counters, and how many of each were left out of the translation.
+	--------------------------------------------------------------------------*/
+	unsigned int num_variables;
+	unsigned int num_bits;
+	unsigned int num_removed_variables;
+	unsigned int num_removed_bits;
+
+	/*--------------------------------------------------------------------------
+		The statistics in which the phases of the preparation and the
+		translation are recorded, or null.
+	--------------------------------------------------------------------------*/
+	PhaseStatistics* statistics;
+
+	/*--------------------------------------------------------------------------
+		The cache of the sections last translated with the same options, or
+		null.
+	--------------------------------------------------------------------------*/
+	TranslationCache* translation_cache;
+
+	/*--------------------------------------------------------------------------
+		The digest of each input of the sections, indexed by the bit of its
+		SectionInput flag, see computeInputDigests.
+	--------------------------------------------------------------------------*/
+	std::vector<std::uint64_t> input_digests;
+
 	/*--------------------------------------------------------------------------
 		A list of all behaviours that are schedulable.
 	--------------------------------------------------------------------------*/
@@ -113,12 +306,20 @@ private:
 	/*--------------------------------------------------------------------------
 		A list of all behaviours that execute another behaviour.
 	--------------------------------------------------------------------------*/
-	std::list<Behaviour*> executing_behaviours;
+	std::vector<Behaviour*> executing_behaviours;
 
 	/*--------------------------------------------------------------------------
-		A list of all behaviours that are executed by another behaviour.
+		A list of all behaviours that are executed by another behaviour,
+		ordered by id.
 	--------------------------------------------------------------------------*/
-	std::set<Behaviour*> executable_behaviours;
+	std::vector<Behaviour*> executable_behaviours;
+
+	/*--------------------------------------------------------------------------
+		The names of the schedulable behaviours, grouped by equal priority
+		with the highest priority first. Only built if true non-determinism
+		is used.
+	--------------------------------------------------------------------------*/
+	std::vector<std::vector<std::string>> equal_priority_groups;
 
 	/*--------------------------------------------------------------------------
 		An exhaustive list of different time intervals in a day, where for every
@@ -136,25 +337,36 @@ private:
 	std::map<std::string, std::list<std::string>> prop_variable_assignment_map;
 
 	/*--------------------------------------------------------------------------
-		Maps enumerated variable names to lists of statements defining the
-		values of the variable in the next state, according to which behaviour
-		is scheduled and which action is being undertaken.
+		Maps enumerated variable names to the variable and a list of statements
+		defining the values of the variable in the next state, according to
+		which behaviour is scheduled and which action is being undertaken.
 	--------------------------------------------------------------------------*/
-	std::map<std::string, std::list<std::string>> enum_variable_assignment_map;
+	std::map<std::string, std::pair<EnumVariable*, std::list<std::string>>>
+		enum_variable_assignment_map;
 
 	/*--------------------------------------------------------------------------
-		Maps preconditions with a been_in_state suffix to a list of values used
-		to construct the enumerated variable used to record the duration
-		throughout which the precondition has held.
+		Maps the names of the counters used to record the duration throughout
+		which a been_in_state suffixed precondition has held to one of the
+		preconditions sharing the counter, and to a list of values for the
+		largest threshold of those preconditions. A counter is shared by the
+		preconditions that check the same variable and value.
 	--------------------------------------------------------------------------*/
-	std::map<Precondition*, std::list<std::string>> been_in_state_map;
+	std::map<std::string, std::pair<Precondition*, std::list<std::string>>>
+		been_in_state_map;
 
 	/*--------------------------------------------------------------------------
-		Maps preconditions with a was_in_state suffix to a list of values used
-		to construct the enumerated variable used to record whether the
-		the precondition has held within a previous duration of time.
+		Maps the names of the counters used to record whether a was_in_state
+		suffixed precondition has held within a previous duration of time, as
+		been_in_state_map does for been_in_state suffixed preconditions.
 	--------------------------------------------------------------------------*/
-	std::map<Precondition*, std::list<std::string>> was_in_state_map;
+	std::map<std::string, std::pair<Precondition*, std::list<std::string>>>
+		was_in_state_map;
+
+	/*--------------------------------------------------------------------------
+		Maps each been_in_state or was_in_state suffixed precondition with a
+		counter to the number of steps in its own threshold.
+	--------------------------------------------------------------------------*/
+	std::map<Precondition*, int> counter_steps;
 
 	/*--------------------------------------------------------------------------
 		Maps timing constraint preconditions to lists of values, where each
@@ -170,122 +382,56 @@ private:
 	--------------------------------------------------------------------------*/
 	std::map<std::string, std::string> initial_variable_values;
 
-	/*==========================================================================
-		Private Static Functions
-	==========================================================================*/
 	/*--------------------------------------------------------------------------
-		validateIdentifier
-
-		Checks the given identifier to ensure that it contains no characters
-		that are illegal in NuSMV. Illegal characters are replaced with
-		INVALID_CHAR_REPLACEMENT_STRING defined in
-		nusmv_definitions.h. The validated identifier is then returned.
-	............................................................................
-		@param	identifier		the unvalidated indentifier
-		@return					the validated identifier
-	--------------------------------------------------------------------------*/
-	static const std::string validateIdentifier(std::string identifier);
-
-	/*--------------------------------------------------------------------------
-		isValidStartCharacter
-
-		Given a character, returns true if this character is a legal starting
-		character for an identifier in NuSMV.
-	............................................................................
-		@param	c				the character
-		@return					true if the character is a legal starting
-								character for an identifier in NuSMV, or false
-								otherwise
+		The class of each propositional and enumerated variable, indexed by
+		id, see classifyVariables.
 	--------------------------------------------------------------------------*/
-	static const bool isValidStartCharacter(const char c);
+	std::vector<VariableClass> prop_variable_classes;
+	std::vector<VariableClass> enum_variable_classes;
 
 	/*--------------------------------------------------------------------------
-		isValidCharacter
-
-		Given a character, returns true if this character is a legal character
-		for an identifier in NuSMV.
-	............................................................................
-		@param	c				the character
-		@return					true if the character is a legal character for
-								an identifier in NuSMV, or false otherwise
+		The value of each constant propositional and enumerated variable,
+		indexed by id, as it is written in the NuSMV model.
 	--------------------------------------------------------------------------*/
-	static const bool isValidCharacter(const char c);
-
-	/*--------------------------------------------------------------------------
-		addLine
-
-		Adds a new line to the string s, prefixed with num_tabs tabs, and
-		possibly terminating with a semi-colon.
-	............................................................................
-		@param	s				the string to which the line is added
-		@param	line			the line to add to the string s
-		@param	num_tabs		the number of tabs to insert before the line
-		@param	terminating_semi_colon	true if the line should be terminated
-								with a semi-colon
-	--------------------------------------------------------------------------*/
-	static void addLine(std::string& s, const std::string& line,
-		const int num_tabs, const bool terminating_semi_colon);
-
-	/*--------------------------------------------------------------------------
-		momentAfter
-
-		Given a time as a string, returns a string corresponding the next minute
-		in time. For instance, given the string 11:23:00, this function would
-		return the string 11:24:00.
-	............................................................................
-		@param	time			a string corresponding to a time with format
-								HH:MM:SS
-		@return					a string corresponding to the time one minute
-								after time
-	--------------------------------------------------------------------------*/
-	static const std::string momentAfter(const std::string& time);
+	std::vector<std::string> prop_variable_constants;
+	std::vector<std::string> enum_variable_constants;
 
+	/*==========================================================================
+		Private Static Functions
+	==========================================================================*/
 	/*--------------------------------------------------------------------------
-		momentBefore
+		timeToSeconds
 
-		Given a time as a string, returns a string corresponding the previous
-		minute in time. For instance, given the string 11:23:00, this function
-		would return the string 11:22:00.
+		Given a time as a string, returns the number of seconds since midnight,
+		truncated to the minute. For instance, given the string 11:23:45, this
+		function would return 40,980.
 	............................................................................
 		@param	time			a string corresponding to a time with format
 								HH:MM:SS
-		@return					a string corresponding to the time one minute
-								before time
+		@return					the number of seconds between midnight and the
+								start of the minute containing time
 	--------------------------------------------------------------------------*/
-	static const std::string momentBefore(const std::string& time);
+	static const int timeToSeconds(const std::string& time);
 
 	/*--------------------------------------------------------------------------
-		timeIsAfter
+		secondsToTime
 
-		Returns true if time_1 is later than time_2.
+		Given a number of seconds since midnight, returns the corresponding time
+		as a string. For instance, given 40,980 this function would return the
+		string 11:23:00.
 	............................................................................
-		@param	time_2			a string corresponding to a time with format
-								HH:MM:SS
-		@param	time_2			a string corresponding to a time with format
+		@param	seconds			the number of seconds since midnight
+		@return					a string corresponding to the time with format
 								HH:MM:SS
-		@return					true if time_1 is after time_2
 	--------------------------------------------------------------------------*/
-	static const bool timeIsAfter(const std::string& time_1,
-			const std::string& time_2);
-
-	/*--------------------------------------------------------------------------
-		timeIsBefore
-
-		Returns true if time_1 is earlier than time_2.
-	............................................................................
-		@param	time_2			a string corresponding to a time with format
-								HH:MM:SS
-		@param	time_2			a string corresponding to a time with format
-								HH:MM:SS
-		@return					true if time_1 is before time_2
-	--------------------------------------------------------------------------*/
-	static const bool timeIsBefore(const std::string& time_1,
-		const std::string& time_2);
+	static const std::string secondsToTime(const int seconds);
 
 	/*--------------------------------------------------------------------------
 		timeConstraintHoldsAtTime
 
-		Returns true if the giving time constraint holds at the given time.
+		Returns true if the giving time constraint holds at the given time. A
+		constraint whose start time is later than its end time holds from the
+		start time until midnight, and from midnight until the end time.
 	............................................................................
 		@param	p				a pointer to a timing constraint precondition
 		@param	time			a string corresponding to a time with format
@@ -312,7 +458,7 @@ private:
 	--------------------------------------------------------------------------*/
 	template<typename T>
 	static std::vector<std::vector<T>> vectorPowerSet(
-		std::vector<T>& v, const bool sort_increasing_size);
+		const std::vector<T>& v, const bool sort_increasing_size);
 
 	/*--------------------------------------------------------------------------
 		filterVectorByCharacteristicVector
@@ -330,7 +476,93 @@ private:
 	--------------------------------------------------------------------------*/
 	template<typename T>
 	static std::vector<T> filterVectorByCharacteristicVector(
-		std::vector<T>& v, int characteristic_vector);
+		const std::vector<T>& v, int characteristic_vector);
+
+	/*--------------------------------------------------------------------------
+		numBits
+
+		Returns the number of bits needed to encode a variable with the given
+		number of values.
+	............................................................................
+		@param	num_values		the number of values
+		@return					the number of bits
+	--------------------------------------------------------------------------*/
+	static const unsigned int numBits(const unsigned int num_values);
+
+	/*--------------------------------------------------------------------------
+		classifyVariable
+
+		Classifies a deterministic variable. A variable that is never assigned
+		and has no known initial value is frozen if such variables are to be
+		frozen, and a variable that can only ever hold its initial value is
+		constant.
+	............................................................................
+		@param	assigned_values	the values assigned to the variable by the
+								translated behaviours
+		@param	initial_value	the initial value of the variable, or an
+								empty string if it is not known
+		@param	freeze_unassigned	true if a variable that is never
+								assigned and has no initial value is frozen
+		@return					the class of the variable
+	--------------------------------------------------------------------------*/
+	static const VariableClass classifyVariable(
+		const std::set<std::string>& assigned_values,
+		const std::string& initial_value, const bool freeze_unassigned);
+
+	/*--------------------------------------------------------------------------
+		isDeclaredValue
+
+		Returns true if the given value, as it is written in the model, is one
+		of the values of the given enumerated variable.
+	............................................................................
+		@param	enum_variable	the enumerated variable
+		@param	value			the value, after validateIdentifier
+		@return					true if the variable can hold the value, or
+								false otherwise
+	--------------------------------------------------------------------------*/
+	static const bool isDeclaredValue(EnumVariable* enum_variable,
+		const std::string& value);
+
+	/*--------------------------------------------------------------------------
+		getCounterName
+
+		Returns the name of the counter used for a been_in_state or
+		was_in_state suffixed precondition.
+	............................................................................
+		@param	p				the precondition, a propositional or enumerated
+								value check
+		@return					the name of the counter
+	--------------------------------------------------------------------------*/
+	static const std::string getCounterName(Precondition* p);
+
+	/*--------------------------------------------------------------------------
+		getCounterCheck
+
+		Returns an expression that checks the variable and value counted for
+		a been_in_state or was_in_state suffixed precondition.
+	............................................................................
+		@param	p				the precondition, a propositional or enumerated
+								value check
+		@param	holds			true if the expression should hold when the
+								variable has the value, or false if it should
+								hold when it does not
+		@return					the expression
+	--------------------------------------------------------------------------*/
+	static const std::string getCounterCheck(Precondition* p,
+		const bool holds);
+
+	/*--------------------------------------------------------------------------
+		getValueSet
+
+		Returns a set expression holding a range of the given values.
+	............................................................................
+		@param	values			the values
+		@param	first			the index of the first value in the set
+		@param	last			the index of the last value in the set
+		@return					the set expression
+	--------------------------------------------------------------------------*/
+	static const std::string getValueSet(const std::list<std::string>& values,
+		const int first, const int last);
 
 	/*==========================================================================
 		Private Functions
@@ -343,23 +575,72 @@ private:
 	void buildBehaviourLists();
 
 	/*--------------------------------------------------------------------------
-		buildTimingConstraintMap
+		buildEqualPriorityGroups
 
-		Builds the timing constraint map.
+		Groups the names of the schedulable behaviours by equal priority.
 	--------------------------------------------------------------------------*/
-	void buildTimingConstraintMap();
+	void buildEqualPriorityGroups();
 
 	/*--------------------------------------------------------------------------
-		buildInitialVariableValueMap
+		isTranslated
 
-		Builds the initial variable value map.
+		Returns true if the given behaviour or variable is in the cone of
+		influence, or if no cone of influence was given.
 	............................................................................
-		@param	filename		the name of the file containing the initial
-								variable values
-		@return					true if the file was parsed successfully, or
-								false otherwise
+		@param	behaviour		the behaviour or variable
+		@return					true if it should be translated, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool isTranslated(Behaviour* behaviour) const;
+	const bool isTranslated(PropVariable* prop_variable) const;
+	const bool isTranslated(EnumVariable* enum_variable) const;
+
+	/*--------------------------------------------------------------------------
+		isDynamic
+
+		Returns true if the given variable is translated and is classified as
+		dynamic, so that it is declared in the VAR section and assigned.
+	............................................................................
+		@param	prop_variable	the variable
+		@return					true if the variable is dynamic, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool isDynamic(PropVariable* prop_variable) const;
+	const bool isDynamic(EnumVariable* enum_variable) const;
+
+	/*--------------------------------------------------------------------------
+		countVariable
+
+		Adds a variable with the given number of values to the counts of
+		variables and bits.
+	............................................................................
+		@param	num_values		the number of values of the variable
+		@param	removed			true if the variable is left out of the
+								translation
+	--------------------------------------------------------------------------*/
+	void countVariable(const unsigned int num_values, const bool removed);
+
+	/*--------------------------------------------------------------------------
+		getCounterExpression
+
+		Returns an expression over the counter of a been_in_state or
+		was_in_state suffixed precondition that holds when the time constraint
+		of the precondition is met.
+	............................................................................
+		@param	p				the precondition, which must have a counter
+		@return					the expression
 	--------------------------------------------------------------------------*/
-	bool buildInitialVariableValueMap(std::string filename);
+	const std::string getCounterExpression(Precondition* p) const;
+
+	/*--------------------------------------------------------------------------
+		buildTimingConstraintMap
+
+		Builds the timing constraint map. The start and end of every timing
+		constraint are converted once to minutes of the day, a constraint
+		wrapping past midnight being split in two, and the day is partitioned
+		by a sweep over the sorted interval endpoints.
+	--------------------------------------------------------------------------*/
+	void buildTimingConstraintMap();
 
 	/*--------------------------------------------------------------------------
 		buildBeenInWasInStateMaps
@@ -368,23 +649,80 @@ private:
 	--------------------------------------------------------------------------*/
 	void buildBeenInWasInStateMaps();
 
+	/*--------------------------------------------------------------------------
+		classifyVariables
+
+		Classifies each variable as dynamic, frozen or constant, and records
+		the value of each constant variable.
+	--------------------------------------------------------------------------*/
+	void classifyVariables();
+
+	/*--------------------------------------------------------------------------
+		buildVariableAssignmentMaps
+
+		Builds the propositional and enumerated variable assignment maps. Must
+		be called after classifyVariables.
+	--------------------------------------------------------------------------*/
+	void buildVariableAssignmentMaps();
+
 	/*--------------------------------------------------------------------------
 		buildEnumsVar
 
 		Builds the variable definitions for	the enumerated variables.
 	............................................................................
-		@return					the enumerated variable declarations
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	std::list<std::string> buildEnumsVar();
+	void buildEnumsVar(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildBoolsVar
 
 		Builds the variable definitions for	the boolean variables.
 	............................................................................
-		@return					the boolean variable declarations
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	std::list<std::string> buildBoolsVar();
+	void buildBoolsVar(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildFrozenVars
+
+		Builds the FROZENVAR section declaring the frozen variables, if there
+		are any.
+	............................................................................
+		@param	writer			the writer to which the declarations are written
+	--------------------------------------------------------------------------*/
+	void buildFrozenVars(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildScheduleChoiceIvars
+
+		Builds the IVAR section declaring an input variable for each group of
+		equal priority behaviours that is too large to be scheduled by
+		enumerating its subsets, if there are any.
+	............................................................................
+		@param	writer			the writer to which the declarations are written
+	--------------------------------------------------------------------------*/
+	void buildScheduleChoiceIvars(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildConstantsDeclaration
+
+		Builds the CONSTANTS section declaring the values of the constant
+		enumerated variables, which no longer appear in any variable's type,
+		if there are any.
+	............................................................................
+		@param	writer			the writer to which the declarations are written
+	--------------------------------------------------------------------------*/
+	void buildConstantsDeclaration(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildConstantDefines
+
+		Builds a definition giving the value of each constant variable.
+	............................................................................
+		@param	writer			the writer to which the definitions are written
+	--------------------------------------------------------------------------*/
+	void buildConstantDefines(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildBeenInStatesVar
@@ -392,11 +730,9 @@ private:
 		Builds the the definitions for the enumerated variables used for
 		been_in_state suffixed preconditions.
 	............................................................................
-		@return					the enumerated variable declarations for
-								variables used for been_in_state suffixed
-								preconditions
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	std::list<std::string> buildBeenInStatesVar();
+	void buildBeenInStatesVar(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildWasInStatesVar
@@ -404,32 +740,51 @@ private:
 		Builds the the definitions for the enumerated variables used for
 		was_in_state suffixed preconditions.
 	............................................................................
-		@return					the enumerated variable declarations for
-								variables used for was_in_state suffixed
-								preconditions
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	std::list<std::string> buildWasInStatesVar();
+	void buildWasInStatesVar(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildIntegerCountersVar
+
+		Builds the definitions for the bounded integer counters used for
+		been_in_state and was_in_state suffixed preconditions.
+	............................................................................
+		@param	writer			the writer to which the declarations are written
+	--------------------------------------------------------------------------*/
+	void buildIntegerCountersVar(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildCounterReport
+
+		Builds a comment for each been_in_state or was_in_state suffixed
+		precondition, giving its counter, the check made against the counter
+		and the number of bits needed to encode the counter.
+	............................................................................
+		@param	writer			the writer to which the comments are written
+	--------------------------------------------------------------------------*/
+	void buildCounterReport(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildEnumVar
 
 		Builds the the definition for a given enumerated variable.
 	............................................................................
+		@param	writer			the writer to which the declarations are written
 		@param					the name of the enumerated variable
-		@return					the enumerated variable declaration
 	--------------------------------------------------------------------------*/
-	const std::string buildEnumVar(const std::string name,
-		std::list<std::string> values);
+	void buildEnumVar(NuSMVWriter& writer, const std::string& name,
+		const std::list<std::string>& values) const;
 
 	/*--------------------------------------------------------------------------
 		buildBoolumVar
 
 		Builds the the definition for a given boolean variable.
 	............................................................................
+		@param	writer			the writer to which the declarations are written
 		@param					the name of the bool variable
-		@return					the boolean variable declaration
 	--------------------------------------------------------------------------*/
-	const std::string buildBoolVar(const std::string name);
+	void buildBoolVar(NuSMVWriter& writer, const std::string& name) const;
 
 	/*--------------------------------------------------------------------------
 		buildTimeVar
@@ -437,9 +792,9 @@ private:
 		Builds the variable definition for the time variable which indicates
 		the time of day.
 	............................................................................
-		@return					the time variable declaration
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	const std::string buildTimeVar();
+	void buildTimeVar(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildStepVar
@@ -447,9 +802,9 @@ private:
 		Builds the variable definition for the step variable, this records
 		which action is currently being performed by a behaviour.
 	............................................................................
-		@return					the steo variable declaration
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	const std::string buildStepVar();
+	void buildStepVar(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildScheduleVar
@@ -457,9 +812,9 @@ private:
 		Builds the variable definition for the schedule variable, this records
 		which behaviour is currently scheduled for execution.
 	............................................................................
-		@return					the schedule variable declaration
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	const std::string buildScheduleVar();
+	void buildScheduleVar(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildLastScheduleVar
@@ -468,30 +823,34 @@ private:
 		is used to 'remember' any previous behaviour that may have executed the
 		current behaviour.
 	............................................................................
-		@return					the last_schedule variable declaration
+		@param	writer			the writer to which the declarations are written
 	--------------------------------------------------------------------------*/
-	const std::string buildLastScheduleVar();
+	void buildLastScheduleVar(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildPreconditionDefines
 
 		For all behaviours, builds an expression that evaluates to true if all
-		of the behaviour's preconditions hold.
+		of the behaviour's preconditions hold. Subexpressions shared by
+		several behaviours are defined once and referred to by name.
 	............................................................................
-		@return					the list of precondition definitions
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	std::list<std::string> buildPreconditionDefines();
+	void buildPreconditionDefines(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
-		buildPreconditionDefine
+		addPreconditionExpression
 
-		Given the root node of a logical expression tree, recursively builds an
-		expression that evaluates to true if all of the tree's preconditions hold.
+		Given the root node of a logical expression tree, recursively adds an
+		expression that evaluates to true if all of the tree's preconditions
+		hold to the given DAG.
 	............................................................................
+		@param	dag				the DAG to which the expression is added
 		@param	node			the root of the logical expression tree
-		@return					the precondition definition
+		@return					the node of the expression in the DAG
 	--------------------------------------------------------------------------*/
-	const std::string buildPreconditionDefine(const TreeNode* node);
+	const int addPreconditionExpression(ExpressionDag& dag,
+		const TreeNode* node) const;
 
 	/*--------------------------------------------------------------------------
 		buildCanInterruptDefines
@@ -500,9 +859,9 @@ private:
 		that behaviour can interrupt a currently scheduled behaviour in the next
 		moment in time.
 	............................................................................
-		@return					the list of can_interrupt definitions
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::list<std::string> buildCanInterruptDefines();
+	void buildCanInterruptDefines(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildABehaviourCanBeScheduledDefine
@@ -511,9 +870,9 @@ private:
 		true if there is a behaviour that can be scheduled for execution in the
 		next moment in time.
 	............................................................................
-		@return					the a_behaviour_can_be_executed definition
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::string buildABehaviourCanBeScheduledDefine();
+	void buildABehaviourCanBeScheduledDefine(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildABehaviourIsEndingDefine
@@ -521,9 +880,9 @@ private:
 		Builds the a_behaviour_is_ending definition, which evaluates to
 		true if the currently scheduled behaviour is executing its last action.
 	............................................................................
-		@return					the a_behaviour_is_ending definition
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::string buildABehaviourIsEndingDefine();
+	void buildABehaviourIsEndingDefine(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildAnExecutedBehaviourIsEndingDefine
@@ -532,9 +891,9 @@ private:
 		to true if the currently scheduled behaviour is executing its last
 		action, and this scheduled behaviour was executed by another behaviour.
 	............................................................................
-		@return					the an_executed_behaviour_is_ending definition
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::string buildAnExecutedBehaviourIsEndingDefine();
+	void buildAnExecutedBehaviourIsEndingDefine(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildAnExecutedBehaviourIsEndingAsALastActionDefine
@@ -545,10 +904,10 @@ private:
 		another behaviour, and the action that executed this behaviour was the
 		last action in the ordered list of actions in the executing behaviour.
 	............................................................................
-		@return					the an_executed_behaviour_is_ending_as_a_last
-		 	 	 	 	 	 	 _action definition
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::string buildAnExecutedBehaviourIsEndingAsALastActionDefine();
+	void buildAnExecutedBehaviourIsEndingAsALastActionDefine(
+		NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildAnExecutedBehaviourIsScheduledDefine
@@ -557,10 +916,9 @@ private:
 		evaluates to true if the currently scheduled behaviour was executed by
 		another behaviour.
 	............................................................................
-		@return					the an_executed_behaviour_is_executing
-								definition
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::string buildAnExecutedBehaviourIsScheduledDefine();
+	void buildAnExecutedBehaviourIsScheduledDefine(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildBehaviourModuleInstances
@@ -568,21 +926,21 @@ private:
 		Builds the instances of the	behaviour modules. One instance is created
 		for each behaviour in the intermediate form.
 	............................................................................
-		@return					the list of behaviour module instance
-								definitions
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	std::list<std::string> buildBehaviourModuleInstances();
+	void buildBehaviourModuleInstances(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildBehaviourModuleInstance
 
 		Builds an instance of a behaviour module for the given behaviour.
 	............................................................................
+		@param	writer			the writer to which the definitions are written
 		@param	behaviour		the behaviour for which a behaviour module
 								instance definition should be built
-		@return					the behaviour module instance definition
 	--------------------------------------------------------------------------*/
-	const std::string buildBehaviourModuleInstance(Behaviour* behaviour);
+	void buildBehaviourModuleInstance(NuSMVWriter& writer,
+		Behaviour* behaviour) const;
 
 	/*--------------------------------------------------------------------------
 		buildExecutedBehaviourExecuteNextDefine
@@ -591,9 +949,9 @@ private:
 		if an executed behaviour will be scheduled for execution in the next
 		moment in time,
 	............................................................................
-		@return					the executed_behaviour_execute_next definitions
+		@param	writer			the writer to which the definitions are written
 	--------------------------------------------------------------------------*/
-	const std::string buildExecutedBehaviourExecuteNextDefine();
+	void buildExecutedBehaviourExecuteNextDefine(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildBeenInStateAssigns
@@ -601,10 +959,9 @@ private:
 		Builds the assignments for the enumerated variables used for
 		been_in_state suffixed preconditions.
 	............................................................................
-		@return					the assignments for enumerated variables used
-								for been_in_state suffixed preconditions
+		@param	writer			the writer to which the assignments are written
 	--------------------------------------------------------------------------*/
-	const std::string buildBeenInStateAssigns();
+	void buildBeenInStateAssigns(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildWasInStateAssigns
@@ -612,56 +969,119 @@ private:
 		Builds the assignments for the enumerated variables used for
 		was_in_state suffixed preconditions.
 	............................................................................
-		@return					the assignments for enumerated variables used
-								for was_in_state suffixed preconditions
+		@param	writer			the writer to which the assignments are written
+	--------------------------------------------------------------------------*/
+	void buildWasInStateAssigns(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		buildIntegerCounterAssigns
+
+		Builds the assignments for the bounded integer counters used for
+		been_in_state and was_in_state suffixed preconditions. Been in state
+		counters saturate at their bound, and was in state counters return to
+		0 when their bound is passed.
+	............................................................................
+		@param	writer			the writer to which the assignments are written
 	--------------------------------------------------------------------------*/
-	const std::string buildWasInStateAssigns();
+	void buildIntegerCounterAssigns(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildTimeAssign
 
 		Builds the assignments for the time variable.
 	............................................................................
-		@return					the assignments for the time variable
+		@param	writer			the writer to which the assignments are written
 	--------------------------------------------------------------------------*/
-	const std::string buildTimeAssign();
+	void buildTimeAssign(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildStepAssign
 
 		Builds the assignments for the step variable.
 	............................................................................
-		@return					the assignments for the step variable
+		@param	writer			the writer to which the assignments are written
 	--------------------------------------------------------------------------*/
-	const std::string buildStepAssign();
+	void buildStepAssign(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildLastScheduleAssign
 
 		Builds the assignments for the last_schedule variable.
 	............................................................................
-		@return					the assignments for the last_schedule variable
+		@param	writer			the writer to which the assignments are written
 	--------------------------------------------------------------------------*/
-	const std::string buildLastScheduleAssign();
+	void buildLastScheduleAssign(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildScheduleAssign
 
-		Builds the assignments for the schedule variable.
+		Builds the assignments for the schedule variable. With true
+		non-determinism, a group of equal priority behaviours is scheduled
+		either with a case for each subset of the group, or with a case for
+		each behaviour chosen by the group's input variable followed by a
+		case for each behaviour, whichever the group size allows.
 	............................................................................
-		@return					the assignments for the schedule variable
+		@param	writer			the writer to which the assignments are written
 	--------------------------------------------------------------------------*/
-	const std::string buildScheduleAssign();
+	void buildScheduleAssign(NuSMVWriter& writer) const;
 
 	/*--------------------------------------------------------------------------
 		buildVariableAssigns
 
 		Builds the assignments for the boolean and enumerated variables.
 	............................................................................
-		@return					the assignments for the boolean and enumerated
-								variables
+		@param	writer			the writer to which the assignments are written
+	--------------------------------------------------------------------------*/
+	void buildVariableAssigns(NuSMVWriter& writer) const;
+
+	/*--------------------------------------------------------------------------
+		getSections
+
+		Lists the sections of the model written after the header, in the
+		order they are written.
+	............................................................................
+		@param	sections		the list to which the sections are added
+	--------------------------------------------------------------------------*/
+	void getSections(std::vector<Section>& sections);
+
+	/*--------------------------------------------------------------------------
+		computeInputDigests
+
+		Computes the digest of each input of the sections from the translated
+		behaviours, the variables and their classes, and the initial values.
+		Must be called after classifyVariables.
+	--------------------------------------------------------------------------*/
+	void computeInputDigests();
+
+	/*--------------------------------------------------------------------------
+		getSectionDigest
+
+		Returns the digest of the given inputs of a section. Must be called
+		after computeInputDigests.
+	............................................................................
+		@param	inputs			a combination of SectionInput flags
+		@return					the digest of those inputs
+	--------------------------------------------------------------------------*/
+	const std::uint64_t getSectionDigest(const int inputs) const;
+
+	/*--------------------------------------------------------------------------
+		writeSections
+
+		Builds the given sections and writes them to the writer in order. With
+		one thread each section is written as it is built. Otherwise the
+		sections are built concurrently, each into its own buffer, and the
+		buffers are then written in order, so that the output does not depend
+		on the number of threads. With a translation cache, a section whose
+		inputs are unchanged is written from the cache instead of being built.
+	............................................................................
+		@param	sections		the sections, in the order they are written
+		@param	writer			the writer to which the sections are written
+		@param	num_threads		the number of threads building the sections
+		@param	timer			the timer recording the phases
 	--------------------------------------------------------------------------*/
-	const std::string buildVariableAssigns();
+	void writeSections(const std::vector<Section>& sections,
+		NuSMVWriter& writer, const unsigned int num_threads,
+		PhaseTimer& timer);
 };
 
 #endif
@@ -0,0 +1,177 @@
+/*==============================================================================
+	NuSMVWriter
+
+	An output sink for NuSMV input. Lines are buffered by the writer and
+	passed on to the underlying output in large blocks.
+
+	File			: nusmv_writer.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef NUSMV_WRITER_H_
+#define NUSMV_WRITER_H_
+
+#include <cstddef>
+#include <string>
+
+class NuSMVModelStatistics;
+
+class NuSMVWriter
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	NuSMVWriter() : statistics(nullptr) {buffer.reserve(BUFFER_SIZE);}
+
+	virtual ~NuSMVWriter() {}
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		beginLine
+
+		Begins a new line, prefixed with num_tabs tabs.
+	............................................................................
+		@param	num_tabs		the number of tabs to insert before the line
+	--------------------------------------------------------------------------*/
+	void beginLine(const int num_tabs);
+
+	/*--------------------------------------------------------------------------
+		endLine
+
+		Ends the current line, possibly terminating it with a semi-colon.
+	............................................................................
+		@param	terminating_semi_colon	true if the line should be terminated
+								with a semi-colon
+	--------------------------------------------------------------------------*/
+	void endLine(const bool terminating_semi_colon);
+
+	/*--------------------------------------------------------------------------
+		addLine
+
+		Writes a complete line, prefixed with num_tabs tabs, and possibly
+		terminating with a semi-colon.
+	............................................................................
+		@param	line			the line to write
+		@param	num_tabs		the number of tabs to insert before the line
+		@param	terminating_semi_colon	true if the line should be terminated
+								with a semi-colon
+	--------------------------------------------------------------------------*/
+	void addLine(const std::string& line, const int num_tabs,
+		const bool terminating_semi_colon);
+
+	/*--------------------------------------------------------------------------
+		addText
+
+		Writes a block of complete lines. A block larger than the buffer is
+		passed straight on to the underlying output.
+	............................................................................
+		@param	text			the lines to write
+	--------------------------------------------------------------------------*/
+	void addText(const std::string& text);
+
+	/*--------------------------------------------------------------------------
+		flush
+
+		Passes any buffered text on to the underlying output.
+	--------------------------------------------------------------------------*/
+	void flush();
+
+	/*--------------------------------------------------------------------------
+		setStatistics
+
+		Sets the statistics that measure the text written, or null if it
+		should not be measured.
+	............................................................................
+		@param	s				the statistics, which are not owned
+	--------------------------------------------------------------------------*/
+	void setStatistics(NuSMVModelStatistics* s) {statistics = s;}
+
+	/*--------------------------------------------------------------------------
+		<< operator overloads
+
+		Append text to the current line.
+	--------------------------------------------------------------------------*/
+	NuSMVWriter& operator<<(const std::string& s);
+	NuSMVWriter& operator<<(const char* s);
+	NuSMVWriter& operator<<(const char c);
+
+protected:
+	/*==========================================================================
+		Protected Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		writeBuffer
+
+		Writes a block of buffered text to the underlying output.
+	............................................................................
+		@param	data			the text to write
+		@param	length			the number of characters to write
+	--------------------------------------------------------------------------*/
+	virtual void writeBuffer(const char* data, const std::size_t length) = 0;
+
+private:
+	/*==========================================================================
+		Private Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The number of characters buffered before they are written out.
+	--------------------------------------------------------------------------*/
+	static const std::size_t BUFFER_SIZE = 64 * 1024;
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Text not yet written to the underlying output.
+	--------------------------------------------------------------------------*/
+	std::string buffer;
+
+	/*--------------------------------------------------------------------------
+		The statistics measuring the text written, or null.
+	--------------------------------------------------------------------------*/
+	NuSMVModelStatistics* statistics;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		flushIfFull
+
+		Flushes the buffer once it holds at least BUFFER_SIZE characters.
+	--------------------------------------------------------------------------*/
+	void flushIfFull()
+	{
+		if(buffer.size() >= BUFFER_SIZE)
+		{
+			flush();
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,184 @@
+/*==============================================================================
+	TranslationCache
+
+	The sections of the NuSMV models last translated with a set of
+	translator options, each with the digest of the inputs it was built
+	from, so that a section whose inputs are unchanged is not built again,
+	see NuSMVTranslator::writeSections.
+
+	File			: translation_cache.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef TRANSLATION_CACHE_H_
+#define TRANSLATION_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "intermediate/cache_file.h"
+#include "nusmv_translator/translator_options.h"
+
+class TranslationCache
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	dir				the directory holding the cache files
+	--------------------------------------------------------------------------*/
+	TranslationCache(const std::string& dir) : directory(dir) {}
+
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		computeKey
+
+		Sets the key of the cache files from the given translator options.
+		The intermediate form is not part of the key, as each section is
+		checked against the digest of its own inputs.
+	............................................................................
+		@param	options			the settings used for the translation
+	--------------------------------------------------------------------------*/
+	void computeKey(const TranslatorOptions& options);
+
+	/*--------------------------------------------------------------------------
+		getKey
+
+		Returns the value of the current key, which is equal for caches of
+		translations with equal options.
+	............................................................................
+		@return					the value of the key
+	--------------------------------------------------------------------------*/
+	const std::uint64_t getKey() const {return key.getValue();}
+
+	/*--------------------------------------------------------------------------
+		getFilename
+
+		Returns the name of the cache file of a section for the current key.
+	............................................................................
+		@param	name			the name of the section
+		@return					the name of the cache file
+	--------------------------------------------------------------------------*/
+	const std::string getFilename(const std::string& name) const;
+
+	/*--------------------------------------------------------------------------
+		find
+
+		Returns the text of a section, or nullptr if the section is not held
+		or was built from different inputs. The cache file of the section is
+		read the first time it is found, and a cache file that cannot be
+		decoded is reported and treated as missing.
+	............................................................................
+		@param	name			the name of the section
+		@param	digest			the digest of the inputs of the section
+		@return					the text of the section, or nullptr
+	--------------------------------------------------------------------------*/
+	const std::string* find(const std::string& name,
+		const std::uint64_t digest);
+
+	/*--------------------------------------------------------------------------
+		store
+
+		Holds the text of a section and writes it to the cache file of the
+		section, replacing any existing file. Throws an error if the file
+		cannot be written.
+	............................................................................
+		@param	name			the name of the section
+		@param	digest			the digest of the inputs of the section
+		@param	text			the text of the section
+	--------------------------------------------------------------------------*/
+	void store(const std::string& name, const std::uint64_t digest,
+		const std::string& text) throw(std::string);
+
+
+private:
+	/*==========================================================================
+		Private Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The characters starting every cache file.
+	--------------------------------------------------------------------------*/
+	static const std::string MAGIC;
+
+	/*--------------------------------------------------------------------------
+		The version of the cache file format, which must be incremented
+		whenever the format or the meaning of what is recorded changes.
+	--------------------------------------------------------------------------*/
+	static const int FORMAT_VERSION;
+
+	/*--------------------------------------------------------------------------
+		The extension of cache files.
+	--------------------------------------------------------------------------*/
+	static const std::string EXTENSION;
+
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The directory holding the cache files.
+	--------------------------------------------------------------------------*/
+	std::string directory;
+
+	/*--------------------------------------------------------------------------
+		The hash of the translator options, which with the name of a section
+		names the cache file of the section.
+	--------------------------------------------------------------------------*/
+	CacheHash key;
+
+	/*--------------------------------------------------------------------------
+		Maps the name of each section read or stored to the digest of its
+		inputs and its text.
+	--------------------------------------------------------------------------*/
+	std::map<std::string, std::pair<std::uint64_t, std::string>> sections;
+
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		decode
+
+		Reads the digest and the text of a section from the contents of its
+		cache file. Throws an error if the contents are not a valid cache
+		file of the section for the current key.
+	............................................................................
+		@param	name			the name of the section
+		@param	data			a pointer to the contents of the file
+		@param	size			the number of bytes in the file
+	--------------------------------------------------------------------------*/
+	void decode(const std::string& name, const char* data,
+		const std::size_t size) throw(std::string);
+};
+
+#endif
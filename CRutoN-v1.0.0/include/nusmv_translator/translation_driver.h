@@ -0,0 +1,127 @@
+/*==============================================================================
+	TranslationDriver
+
+	Translates one intermediate form under several configurations. Every
+	translator is prepared in turn, so that any errors or warnings are
+	displayed in order, and the translations are then written concurrently
+	by a pool of worker threads. The intermediate form is shared by every
+	translator and is not modified.
+
+	File			: translation_driver.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef TRANSLATION_DRIVER_H_
+#define TRANSLATION_DRIVER_H_
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "intermediate/intermediate_form.h"
+#include "nusmv_translator/translator_options.h"
+
+class TranslationDriver
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	inter			the intermediate form to translate
+		@param	values			maps variable names to their initial values
+	--------------------------------------------------------------------------*/
+	TranslationDriver(const IntermediateForm* inter,
+		const std::map<std::string, std::string>& values) :
+			intermediate_form(inter), initial_values(values) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		addConfiguration
+
+		Adds a translation to be written to the given file.
+	............................................................................
+		@param	options			the settings used for the translation
+		@param	file			the file to which the NuSMV model is written
+	--------------------------------------------------------------------------*/
+	void addConfiguration(const TranslatorOptions& options,
+		const std::string& file);
+
+	/*--------------------------------------------------------------------------
+		setCacheDirectory
+
+		Sets the directory holding the sections last translated with each set
+		of options, or an empty string if sections should not be cached.
+		Translations with a cone of influence are not cached.
+	............................................................................
+		@param	dir				the directory holding the cache files
+	--------------------------------------------------------------------------*/
+	void setCacheDirectory(const std::string& dir) {cache_directory = dir;}
+
+	/*--------------------------------------------------------------------------
+		run
+
+		Prepares and writes every translation, returning true if all of them
+		were written successfully.
+	............................................................................
+		@param	num_threads		the number of worker threads to use
+		@return					true if every NuSMV model was written, or
+								false otherwise
+	--------------------------------------------------------------------------*/
+	const bool run(const unsigned int num_threads);
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The intermediate form shared by every translator.
+	--------------------------------------------------------------------------*/
+	const IntermediateForm* intermediate_form;
+
+	/*--------------------------------------------------------------------------
+		Maps variable names to their initial values.
+	--------------------------------------------------------------------------*/
+	const std::map<std::string, std::string> initial_values;
+
+	/*--------------------------------------------------------------------------
+		The settings and output file of each translation.
+	--------------------------------------------------------------------------*/
+	std::vector<std::pair<TranslatorOptions, std::string>> configurations;
+
+	/*--------------------------------------------------------------------------
+		The directory holding the translation cache files, or an empty
+		string.
+	--------------------------------------------------------------------------*/
+	std::string cache_directory;
+};
+
+#endif
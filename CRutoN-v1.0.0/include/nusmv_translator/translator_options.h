@@ -0,0 +1,120 @@
+/*==============================================================================
+	TranslatorOptions
+
+	The settings used by a single NuSMV translator, so that several
+	translators with different settings can share one intermediate form.
+
+	File			: translator_options.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef TRANSLATOR_OPTIONS_H_
+#define TRANSLATOR_OPTIONS_H_
+
+#include <string>
+
+class ConeOfInfluence;
+
+struct TranslatorOptions
+{
+	/*--------------------------------------------------------------------------
+		Constructor
+
+		Sets each option to its default value.
+	--------------------------------------------------------------------------*/
+	TranslatorOptions() : true_non_determinism(true),
+		minimum_one_state_state_n_seconds(false), state_time_seconds(600),
+		max_seconds_per_state_n_seconds(5000), integer_counters(false),
+		max_power_set_group_size(4), freeze_unassigned_variables(false),
+		time_of_day(""),
+		cone_of_influence(nullptr) {}
+
+	/*--------------------------------------------------------------------------
+		True if true non-determinism should be used in the NuSMV model, w.r.t.
+		the scheduling of behaviours with equal priority.
+
+		WARNING: For n behaviours of equal priority, 2^n defines will be added
+		to the resulting NuSMV model.
+	--------------------------------------------------------------------------*/
+	bool true_non_determinism;
+
+	/*--------------------------------------------------------------------------
+		True if a minimum of one previous state should be used for
+		state_n_seconds terms.
+	--------------------------------------------------------------------------*/
+	bool minimum_one_state_state_n_seconds;
+
+	/*--------------------------------------------------------------------------
+		The number of seconds represented by each state in the NuSMV model.
+	--------------------------------------------------------------------------*/
+	int state_time_seconds;
+
+	/*--------------------------------------------------------------------------
+		Sets the maximum number of seconds for a state_n_seconds term. Used to
+		restrict the size of enumerated types in the NuSMV models.
+	--------------------------------------------------------------------------*/
+	int max_seconds_per_state_n_seconds;
+
+	/*--------------------------------------------------------------------------
+		True if been_in_state/was_in_state counters should be bounded integer
+		ranges with saturating arithmetic rather than enumerated types. A
+		single counter is then shared by the preconditions that check the
+		same variable and value, whatever their thresholds.
+	--------------------------------------------------------------------------*/
+	bool integer_counters;
+
+	/*--------------------------------------------------------------------------
+		The largest group of schedulable behaviours with equal priority whose
+		scheduling is encoded with a case for every subset of the group, when
+		true non-determinism is used. Larger groups are scheduled through an
+		input variable choosing one of the behaviours, which needs a number of
+		cases linear in the size of the group.
+	--------------------------------------------------------------------------*/
+	int max_power_set_group_size;
+
+	/*--------------------------------------------------------------------------
+		True if variables that no behaviour assigns and that have no initial
+		value should be declared as frozen, so that their value is chosen
+		once rather than in every state. This changes the meaning of models
+		in which such variables stand for changing sensor inputs.
+	--------------------------------------------------------------------------*/
+	bool freeze_unassigned_variables;
+
+	/*--------------------------------------------------------------------------
+		Setting this to a valid time value HH:MM:SS fixes the time of day, and
+		automatically sets preconditions corresponding to time constraints to
+		be false or true in the NuSMV model.
+	--------------------------------------------------------------------------*/
+	std::string time_of_day;
+
+	/*--------------------------------------------------------------------------
+		If not null, only the behaviours and variables in this cone of
+		influence are translated. The cone is not owned and may be shared by
+		several translators.
+	--------------------------------------------------------------------------*/
+	const ConeOfInfluence* cone_of_influence;
+};
+
+#endif
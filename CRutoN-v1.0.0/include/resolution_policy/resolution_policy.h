@@ -0,0 +1,259 @@
+/*==============================================================================
+	ResolutionPolicy
+
+	Answers the prompts raised while parsing and translating, so that CRuToN
+	can be run without user interaction.
+
+	A policy file holds one answer per line, with tab separated fields:
+
+		kind	key field 1	...	key field n	answer
+
+	where kind is one of identifier, no_preconditions, any_text,
+	data_extraction_rule or overwrite, the key fields identify the prompt,
+	and the answer is exactly what would be entered at the prompt. A key
+	consisting of the single field * answers every prompt of that kind for
+	which no other line matches. Blank lines and lines beginning with # are
+	ignored. Tabs and backslashes within fields are written as \t and \\.
+
+	The keys for each kind of prompt are:
+
+		identifier				type, name, existing name
+		no_preconditions		behaviour name
+		any_text				input line, ambiguous token
+		data_extraction_rule	parsed term
+		overwrite				file name
+
+	File			: resolution_policy.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef RESOLUTION_POLICY_H_
+#define RESOLUTION_POLICY_H_
+
+#include <fstream>
+#include <functional>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "enums/prompt_type.h"
+
+class ResolutionPolicy
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	ResolutionPolicy() : strict(false) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		load
+
+		Loads the answers in the given policy file. Throws an error if the file
+		cannot be read or contains a malformed line.
+	............................................................................
+		@param	filename		the name of the policy file
+	--------------------------------------------------------------------------*/
+	void load(const std::string& filename) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		setStrict
+
+		Mutator for strict. In strict mode a prompt with no answer in the
+		policy throws an error instead of reading from standard input.
+	............................................................................
+		@param	s				true if strict mode should be enabled
+	--------------------------------------------------------------------------*/
+	void setStrict(const bool s) {strict = s;}
+
+	/*--------------------------------------------------------------------------
+		setRecordFile
+
+		Sets the file to which every answer given is written in the policy
+		file format, so that a run can be replayed. The file is only replaced
+		once the first answer is recorded, so a run that asks no questions,
+		such as one loading a cached intermediate form, leaves it as it was.
+		Throws an error if the file cannot be written.
+	............................................................................
+		@param	filename		the name of the file to record answers to
+	--------------------------------------------------------------------------*/
+	void setRecordFile(const std::string& filename) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		prompt
+
+		Returns the answer to a prompt. The answer is taken from the policy if
+		one is given, otherwise the question is asked on standard output until
+		a valid answer is read from standard input. Throws an error if the
+		policy gives an invalid answer, if no answer is given in strict mode,
+		or if standard input is closed.
+	............................................................................
+		@param	type			the kind of prompt
+		@param	key				the fields identifying the prompt
+		@param	question		the text displayed before reading an answer
+		@param	is_valid		returns true if the given answer is valid
+		@return					the answer
+	--------------------------------------------------------------------------*/
+	const std::string prompt(const PromptType type,
+		const std::vector<std::string>& key, const std::string& question,
+		const std::function<bool(const std::string&)>& is_valid)
+			throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		replayAnswer
+
+		Records an answer given to a prompt in an earlier run, such as one
+		whose intermediate form was cached, as if it had been given again.
+		Throws an error if the record file cannot be written.
+	............................................................................
+		@param	formatted_key	the kind and key of the prompt in the policy
+								file format
+		@param	answer			the answer
+	--------------------------------------------------------------------------*/
+	void replayAnswer(const std::string& formatted_key,
+		const std::string& answer) throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		getGivenAnswers
+
+		Accessor for given_answers.
+	............................................................................
+		@return					the kind and key of each prompt answered, in
+								the policy file format, with its answer
+	--------------------------------------------------------------------------*/
+	const std::vector<std::pair<std::string, std::string>>& getGivenAnswers()
+		const
+	{
+		return given_answers;
+	}
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The answers given in the policy, mapped to by the kind and key of the
+		prompt in the policy file format. Each answer is paired with the line
+		of the policy file on which it was given.
+	--------------------------------------------------------------------------*/
+	std::map<std::string, std::pair<std::string, int>> answers;
+
+	/*--------------------------------------------------------------------------
+		The name of the loaded policy file.
+	--------------------------------------------------------------------------*/
+	std::string policy_file;
+
+	/*--------------------------------------------------------------------------
+		The name of the file to which answers are recorded, or empty if no
+		record file was set.
+	--------------------------------------------------------------------------*/
+	std::string record_file;
+
+	/*--------------------------------------------------------------------------
+		The stream to which answers are recorded, opened when the first
+		answer is recorded.
+	--------------------------------------------------------------------------*/
+	std::ofstream record_stream;
+
+	/*--------------------------------------------------------------------------
+		The prompts that have already been answered.
+	--------------------------------------------------------------------------*/
+	std::set<std::string> recorded;
+
+	/*--------------------------------------------------------------------------
+		The first answer given to each prompt, paired with the kind and key of
+		the prompt in the policy file format, in the order they were given.
+	--------------------------------------------------------------------------*/
+	std::vector<std::pair<std::string, std::string>> given_answers;
+
+	/*--------------------------------------------------------------------------
+		True if unanswered prompts should throw an error.
+	--------------------------------------------------------------------------*/
+	bool strict;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		record
+
+		Records the first answer given to a prompt, writing it to the record
+		file if one was set. The record file is replaced when the first answer
+		is written to it. Throws an error if the file cannot be written.
+	............................................................................
+		@param	formatted_key	the kind and key of the prompt in the policy
+								file format
+		@param	answer			the answer
+	--------------------------------------------------------------------------*/
+	void record(const std::string& formatted_key, const std::string& answer)
+		throw(std::string);
+
+	/*==========================================================================
+		Private Static Member Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		formatKey
+
+		Returns the kind and key of a prompt in the policy file format.
+	............................................................................
+		@param	type			the kind of prompt
+		@param	key				the fields identifying the prompt
+		@return					the tab separated kind and escaped key fields
+	--------------------------------------------------------------------------*/
+	static const std::string formatKey(const PromptType type,
+		const std::vector<std::string>& key);
+
+	/*--------------------------------------------------------------------------
+		escape
+
+		Escapes the tabs and backslashes in a field.
+	............................................................................
+		@param	field			the field to escape
+		@return					the escaped field
+	--------------------------------------------------------------------------*/
+	static const std::string escape(const std::string& field);
+
+	/*--------------------------------------------------------------------------
+		unescape
+
+		Reverses escape.
+	............................................................................
+		@param	field			the escaped field
+		@return					the field
+	--------------------------------------------------------------------------*/
+	static const std::string unescape(const std::string& field);
+};
+
+/*------------------------------------------------------------------------------
+	The policy used to answer every prompt.
+------------------------------------------------------------------------------*/
+extern ResolutionPolicy g_resolution_policy;
+
+#endif
@@ -0,0 +1,280 @@
+/*==============================================================================
+	ReachabilityChecker
+
+	Finds the behaviours that can be scheduled in some reachable state of
+	the intermediate form's NuSMV translation, by an explicit-state breadth
+	first search over the states of a simulator.
+
+	File			: reachability_checker.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef REACHABILITY_CHECKER_H_
+#define REACHABILITY_CHECKER_H_
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "simulator/simulator.h"
+
+/*------------------------------------------------------------------------------
+	Every combination of the simulator's non-deterministic choices is taken
+	from each state, so that all the states of the NuSMV model reachable from
+	its initial states are explored. No locks are taken. Each state is written
+	in the simulator's packed encoding under a state number, and is then
+	published in an open addressing hash table by a single compare and swap
+	of that number, so that a thread finding a slot in use can compare its
+	state at once. Each level of the search is split into chunks, which are
+	dealt to the worker threads' deques. A worker takes chunks from the back
+	of its own deque and, once that is empty, steals them from the front of
+	the others', as in the deque of Chase and Lev. As the search is breadth
+	first, the trace found to the first state in which a behaviour is
+	scheduled is a shortest one.
+------------------------------------------------------------------------------*/
+class ReachabilityChecker
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	sim				the simulator, which must have been prepared
+		@param	threads			the number of worker threads
+		@param	max				the largest number of states to explore
+	--------------------------------------------------------------------------*/
+	ReachabilityChecker(Simulator& sim, const unsigned int threads,
+		const unsigned int max) :
+			simulator(sim), num_threads(threads), max_states(max),
+			num_words(0), capacity(0), num_states(0), num_numbers(0),
+			is_full(false), depth(0), elapsed_seconds(0) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		check
+
+		Explores the reachable states, until every reachable state has been
+		found or the largest number of states is reached.
+	............................................................................
+		@return					true if every reachable state was found, or
+								false otherwise
+	--------------------------------------------------------------------------*/
+	const bool check();
+
+	/*--------------------------------------------------------------------------
+		writeResults
+
+		Writes the number of states explored and the rate at which they were
+		explored, and for each behaviour the length of the shortest trace to a
+		state in which it is scheduled, if there is one.
+	............................................................................
+		@param	os				the stream to write to
+	--------------------------------------------------------------------------*/
+	void writeResults(std::ostream& os) const;
+
+	/*--------------------------------------------------------------------------
+		writeWitnesses
+
+		Writes a trace for each reachable behaviour, ending in a state in
+		which it is scheduled, in the format of NuSMV so that it can be
+		replayed by the simulator.
+	............................................................................
+		@param	os				the stream to write to
+	--------------------------------------------------------------------------*/
+	void writeWitnesses(std::ostream& os) const;
+
+
+private:
+	/*==========================================================================
+		Private Static Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		An empty slot of the hash table. A slot holding a state holds its
+		number plus one.
+	--------------------------------------------------------------------------*/
+	static const unsigned int SLOT_EMPTY;
+
+	/*--------------------------------------------------------------------------
+		The parent of an initial state, and the witness of a behaviour that
+		has not been found to be reachable.
+	--------------------------------------------------------------------------*/
+	static const unsigned int NO_STATE;
+
+	/*--------------------------------------------------------------------------
+		The number of states in each chunk of a level of the search.
+	--------------------------------------------------------------------------*/
+	static const unsigned int CHUNK_SIZE;
+
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The chunks of a level of the search held by a worker, each giving a
+		range of positions in the level. The chunks are dealt before the
+		workers start, so only the top and bottom of the deque change: the
+		owner takes the chunk below bottom, and thieves the chunk at top.
+	--------------------------------------------------------------------------*/
+	struct WorkQueue
+	{
+		std::vector<std::pair<unsigned int, unsigned int>> chunks;
+		std::atomic<long long> top;
+		std::atomic<long long> bottom;
+	};
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The simulator whose states are explored.
+	--------------------------------------------------------------------------*/
+	Simulator& simulator;
+
+	/*--------------------------------------------------------------------------
+		The number of worker threads, and the largest number of states to
+		explore.
+	--------------------------------------------------------------------------*/
+	unsigned int num_threads;
+	unsigned int max_states;
+
+	/*--------------------------------------------------------------------------
+		The number of words in a state, and the number of slots in the hash
+		table, which is a power of two.
+	--------------------------------------------------------------------------*/
+	unsigned int num_words;
+	unsigned int capacity;
+
+	/*--------------------------------------------------------------------------
+		The hash table, giving for each slot SLOT_EMPTY or the number of the
+		state it holds plus one, and for each state number the words of the
+		state and the number of the state's parent in the search.
+	--------------------------------------------------------------------------*/
+	std::vector<std::atomic<unsigned int>> slots;
+	std::vector<uint64_t> words;
+	std::vector<unsigned int> parents;
+
+	/*--------------------------------------------------------------------------
+		The number of states found, the number of state numbers handed out,
+		and whether the search stopped because the largest number of states
+		was reached. A number is handed out before its state is published,
+		and a worker that loses the slot to the same state keeps the number
+		for its next state, so at most one number per worker is unused.
+	--------------------------------------------------------------------------*/
+	std::atomic<unsigned int> num_states;
+	std::atomic<unsigned int> num_numbers;
+	std::atomic<bool> is_full;
+
+	/*--------------------------------------------------------------------------
+		The number of the first state found in which each behaviour is
+		scheduled, indexed by schedule value, or NO_STATE.
+	--------------------------------------------------------------------------*/
+	std::vector<std::atomic<unsigned int>> witnesses;
+
+	/*--------------------------------------------------------------------------
+		The number of levels of the search that were explored, and the time
+		taken to explore them.
+	--------------------------------------------------------------------------*/
+	unsigned int depth;
+	double elapsed_seconds;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		hash
+
+		Returns the hash of a state.
+	............................................................................
+		@param	state			the state
+		@return					the hash
+	--------------------------------------------------------------------------*/
+	static const uint64_t hash(const std::vector<uint64_t>& state);
+
+	/*--------------------------------------------------------------------------
+		insert
+
+		Adds a state to the hash table if it is not already there. May be
+		called by several threads at once.
+	............................................................................
+		@param	state			the state
+		@param	parent			the number of the state from which it was
+								reached, or NO_STATE
+		@param	spare			the caller's unused state number, or
+								NO_STATE, which is used for the state if it
+								is added
+		@param	is_new			set to true if the state was added, or false
+								otherwise
+		@return					the number of the state, or NO_STATE if the
+								largest number of states has been reached
+	--------------------------------------------------------------------------*/
+	const unsigned int insert(const std::vector<uint64_t>& state,
+		const unsigned int parent, unsigned int& spare, bool& is_new);
+
+	/*--------------------------------------------------------------------------
+		recordWitness
+
+		Records a new state as the witness of the behaviour scheduled in it,
+		if no witness has been found for that behaviour.
+	............................................................................
+		@param	state			the state
+		@param	number			the number of the state
+	--------------------------------------------------------------------------*/
+	void recordWitness(const std::vector<uint64_t>& state,
+		const unsigned int number);
+
+	/*--------------------------------------------------------------------------
+		takeChunk
+
+		Takes a chunk for a worker, from the back of its own queue or
+		otherwise from the front of another worker's queue, without locking.
+	............................................................................
+		@param	queues			the queue of each worker
+		@param	worker			the worker
+		@param	chunk			set to the chunk taken
+		@return					true if a chunk was taken, or false if every
+								queue is empty
+	--------------------------------------------------------------------------*/
+	const bool takeChunk(std::vector<WorkQueue>& queues,
+		const unsigned int worker, std::pair<unsigned int, unsigned int>& chunk)
+		const;
+
+	/*--------------------------------------------------------------------------
+		getTrace
+
+		Returns the numbers of the states on the path found from an initial
+		state to a state.
+	............................................................................
+		@param	number			the number of the last state
+		@return					the numbers, starting with the initial state
+	--------------------------------------------------------------------------*/
+	const std::vector<unsigned int> getTrace(unsigned int number) const;
+};
+
+#endif
@@ -0,0 +1,616 @@
+/*==============================================================================
+	Simulator
+
+	An explicit-state simulator for the intermediate form, following the
+	semantics of its NuSMV translation.
+
+	File			: simulator.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef SIMULATOR_H_
+#define SIMULATOR_H_
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "enums/action_type.h"
+#include "enums/simulator_node_type.h"
+#include "intermediate/intermediate_form.h"
+#include "intermediate/precondition.h"
+#include "intermediate/tree_node.h"
+#include "nusmv_translator/nusmv_translator.h"
+#include "nusmv_translator/translator_options.h"
+
+/*------------------------------------------------------------------------------
+	The simulator takes the analysis of a NuSMV translator with the same
+	options, so that it shares the translation's scheduling, variable
+	classification, time intervals and counters. Each variable of the NuSMV
+	model becomes a field of a packed state vector holding the index of its
+	value, and the preconditions are compiled into a list of nodes that is
+	evaluated once for each step. Non-deterministic choices are made at
+	random, or are taken from a NuSMV trace being replayed, so that the
+	simulator can be checked against the model and vice versa.
+------------------------------------------------------------------------------*/
+class Simulator
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	inter			the intermediate form representation, which is
+								not modified
+		@param	opts			the settings of the translation whose
+								semantics are simulated
+		@param	seed			the seed of the random choices
+	--------------------------------------------------------------------------*/
+	Simulator(const IntermediateForm* inter, const TranslatorOptions& opts,
+		const unsigned int seed) :
+			translator(inter, opts), num_words(0), time_field(-1),
+			step_field(-1), schedule_field(-1), last_schedule_field(-1),
+			max_step(0), num_runs(0), elapsed_seconds(0)
+	{
+		context.random_engine.seed(seed);
+	}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		prepareSimulation
+
+		Analyses the intermediate form as it is analysed for translation,
+		displaying any errors or warnings, and compiles the behaviours and
+		variables. Must be called before simulate or replayTrace.
+	............................................................................
+		@param	initial_values	maps variable names to their initial values
+		@return					true if the analysis was successful, or false
+								otherwise
+	--------------------------------------------------------------------------*/
+	const bool prepareSimulation(
+		const std::map<std::string, std::string>& initial_values);
+
+	/*--------------------------------------------------------------------------
+		simulate
+
+		Simulates a number of random steps, restarting from a random initial
+		state after each run of the given length, and adds them to the
+		statistics.
+	............................................................................
+		@param	steps			the number of steps to simulate
+		@param	run_length		the number of steps in each run
+	--------------------------------------------------------------------------*/
+	void simulate(const unsigned long long steps,
+		const unsigned int run_length);
+
+	/*--------------------------------------------------------------------------
+		replayTrace
+
+		Replays a trace written by NuSMV, taking each non-deterministic
+		choice from the trace and checking every state of the trace against
+		the simulated state. A file holding several traces is replayed one
+		trace after another. Throws an error describing the first state in
+		which the trace and the simulation disagree.
+	............................................................................
+		@param	filename		the name of the trace file
+		@return					the number of states replayed
+	--------------------------------------------------------------------------*/
+	const unsigned int replayTrace(const std::string& filename)
+		throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		writeStatistics
+
+		Writes the number of simulated steps and the rate at which they were
+		simulated, and for each behaviour the number of times it was started,
+		completed and interrupted, and the number of steps it was scheduled.
+	............................................................................
+		@param	os				the stream to write to
+	--------------------------------------------------------------------------*/
+	void writeStatistics(std::ostream& os) const;
+
+	// the reachability checker explores the states of the simulation
+	friend class ReachabilityChecker;
+
+private:
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		A variable of the NuSMV model, packed into bits [shift, shift + bits)
+		of one word of the state vector.
+	--------------------------------------------------------------------------*/
+	struct SimulatorField
+	{
+		std::string name;
+		std::vector<std::string> values;
+		int word;
+		int shift;
+		uint64_t mask;
+	};
+
+	/*--------------------------------------------------------------------------
+		A node of a compiled expression. A constant holds low, a range node
+		holds when its field's value is in [low, high], and a set node holds
+		when its field's value is marked in values. The operands of an
+		operator are earlier nodes.
+	--------------------------------------------------------------------------*/
+	struct SimulatorNode
+	{
+		SimulatorNodeType type;
+		int field;
+		int low;
+		int high;
+		std::vector<bool> values;
+		int left;
+		int right;
+	};
+
+	/*--------------------------------------------------------------------------
+		An action, with the field and value of an assignment to a dynamic
+		variable, or the schedule values of the behaviours it executes.
+	--------------------------------------------------------------------------*/
+	struct SimulatorAction
+	{
+		ActionType type;
+		int field;
+		int value;
+		std::vector<int> behaviours;
+	};
+
+	/*--------------------------------------------------------------------------
+		A translated behaviour. The behaviours are indexed by their value of
+		the schedule field, 0 being schedule_none.
+	--------------------------------------------------------------------------*/
+	struct SimulatorBehaviour
+	{
+		std::string name;
+		int precondition;
+		int priority;
+		bool schedulable;
+		bool interruptible;
+		bool executable;
+		std::vector<SimulatorAction> actions;
+		// the schedulable behaviours of higher priority, which can interrupt
+		// this behaviour if it is interruptible
+		std::vector<int> interrupting_behaviours;
+		// the behaviours executed by the last action
+		std::vector<int> last_action_behaviours;
+	};
+
+	/*--------------------------------------------------------------------------
+		A been_in_state or was_in_state counter, with the node checking the
+		counted variable and value, and the largest value of the counter.
+	--------------------------------------------------------------------------*/
+	struct SimulatorCounter
+	{
+		int field;
+		int check;
+		bool is_been_in_state;
+		int bound;
+	};
+
+	/*--------------------------------------------------------------------------
+		A state of a trace, giving the index of the value of each field, or
+		-1 where the trace does not give a value, and whether it is the first
+		state of its trace.
+	--------------------------------------------------------------------------*/
+	struct TraceState
+	{
+		std::string name;
+		bool is_initial;
+		std::vector<int> values;
+	};
+
+	/*--------------------------------------------------------------------------
+		The working state of a thread simulating steps: the values of the
+		compiled nodes, the source of its choices, and its statistics.
+	--------------------------------------------------------------------------*/
+	struct SimulatorContext
+	{
+		SimulatorContext() : target(nullptr), is_enumerating(false),
+			choice_num(0), num_steps(0) {}
+
+		// the value of each node in the current state
+		std::vector<char> node_values;
+		// marks the behaviours that can be scheduled in the current state,
+		// indexed by schedule value, and the candidates of a choice
+		std::vector<char> can_be_scheduled;
+		std::vector<int> candidates;
+		// the source of the random choices
+		std::mt19937_64 random_engine;
+		// the values of the state of a trace being replayed, from which
+		// the choices are taken, or null
+		const std::vector<int>* target;
+		// true if every combination of choices is enumerated, in which case
+		// choices holds the index of the option taken by each choice of the
+		// current combination, and num_options the number of options
+		bool is_enumerating;
+		std::vector<int> choices;
+		std::vector<int> num_options;
+		unsigned int choice_num;
+		// the statistics of each behaviour, indexed by schedule value, the
+		// steps with nothing scheduled being counted as scheduled steps of
+		// schedule_none
+		std::vector<unsigned long long> num_started;
+		std::vector<unsigned long long> num_completed;
+		std::vector<unsigned long long> num_interrupted;
+		std::vector<unsigned long long> num_scheduled_steps;
+		unsigned long long num_steps;
+	};
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The translator whose analysis is simulated.
+	--------------------------------------------------------------------------*/
+	NuSMVTranslator translator;
+
+	/*--------------------------------------------------------------------------
+		The fields of the state vector, the number of words in the vector, and
+		maps field names to fields.
+	--------------------------------------------------------------------------*/
+	std::vector<SimulatorField> fields;
+	int num_words;
+	std::map<std::string, int> field_index;
+
+	/*--------------------------------------------------------------------------
+		The fields of the time, step, schedule and last_schedule variables.
+		There is no time field if the time of day is fixed or no behaviour
+		has a timing constraint.
+	--------------------------------------------------------------------------*/
+	int time_field;
+	int step_field;
+	int schedule_field;
+	int last_schedule_field;
+
+	/*--------------------------------------------------------------------------
+		The initial value of each field, or -1 if it is chosen at random.
+	--------------------------------------------------------------------------*/
+	std::vector<int> initial_field_values;
+
+	/*--------------------------------------------------------------------------
+		The fields whose values are chosen at random in every state.
+	--------------------------------------------------------------------------*/
+	std::vector<int> random_fields;
+
+	/*--------------------------------------------------------------------------
+		The fields of resetting enumerated variables, and the value none that
+		they take in every state in which they are not assigned.
+	--------------------------------------------------------------------------*/
+	std::vector<std::pair<int, int>> resetting_fields;
+
+	/*--------------------------------------------------------------------------
+		The compiled expressions.
+	--------------------------------------------------------------------------*/
+	std::vector<SimulatorNode> nodes;
+
+	/*--------------------------------------------------------------------------
+		The behaviours, indexed by schedule value, and the schedule value of
+		each behaviour, indexed by id, which is 0 if it is not translated.
+	--------------------------------------------------------------------------*/
+	std::vector<SimulatorBehaviour> behaviours;
+	std::vector<int> schedule_values;
+
+	/*--------------------------------------------------------------------------
+		The schedulable behaviours in groups that are scheduled in order,
+		choosing any behaviour of the first group with a behaviour that can
+		be scheduled. Without true non-determinism every group has one
+		behaviour.
+	--------------------------------------------------------------------------*/
+	std::vector<std::vector<int>> schedule_groups;
+
+	/*--------------------------------------------------------------------------
+		The been_in_state and was_in_state counters.
+	--------------------------------------------------------------------------*/
+	std::vector<SimulatorCounter> counters;
+
+	/*--------------------------------------------------------------------------
+		The largest number of actions in a behaviour.
+	--------------------------------------------------------------------------*/
+	int max_step;
+
+	/*--------------------------------------------------------------------------
+		The context of the steps simulated by simulate and replayTrace.
+	--------------------------------------------------------------------------*/
+	SimulatorContext context;
+
+	/*--------------------------------------------------------------------------
+		The number of simulated runs, and the time taken to simulate them.
+	--------------------------------------------------------------------------*/
+	unsigned long long num_runs;
+	double elapsed_seconds;
+
+	/*==========================================================================
+		Private Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		getField
+
+		Returns the value of a field in a state.
+	............................................................................
+		@param	state			the state
+		@param	field			the field
+		@return					the index of the value
+	--------------------------------------------------------------------------*/
+	const int getField(const std::vector<uint64_t>& state,
+		const int field) const
+	{
+		const SimulatorField& f = fields[field];
+		return (int)((state[f.word] >> f.shift) & f.mask);
+	}
+
+	/*--------------------------------------------------------------------------
+		setField
+
+		Sets the value of a field in a state.
+	............................................................................
+		@param	state			the state
+		@param	field			the field
+		@param	value			the index of the value
+	--------------------------------------------------------------------------*/
+	void setField(std::vector<uint64_t>& state, const int field,
+		const int value) const
+	{
+		const SimulatorField& f = fields[field];
+		state[f.word] = (state[f.word] & ~(f.mask << f.shift))
+			| ((uint64_t)value << f.shift);
+	}
+
+	/*--------------------------------------------------------------------------
+		addField
+
+		Adds a field to the state vector, starting a new word if the field
+		does not fit into the last one.
+	............................................................................
+		@param	name			the name of the variable in the NuSMV model
+		@param	values			the names of its values
+		@param	initial_value	the initial value, or -1 if it is chosen at
+								random
+		@return					the field
+	--------------------------------------------------------------------------*/
+	const int addField(const std::string& name,
+		const std::vector<std::string>& values, const int initial_value);
+
+	/*--------------------------------------------------------------------------
+		addNode
+
+		Adds a node to the compiled expressions.
+	............................................................................
+		@param	type			the type of the node
+		@param	field			the field of a range or set node, or -1
+		@param	low				the value of a constant, or the lowest value
+								of a range
+		@param	high			the highest value of a range
+		@param	left			the first operand, or -1
+		@param	right			the second operand, or -1
+		@return					the node
+	--------------------------------------------------------------------------*/
+	const int addNode(const SimulatorNodeType type, const int field,
+		const int low, const int high, const int left, const int right);
+
+	/*--------------------------------------------------------------------------
+		buildFields
+
+		Adds the fields of the variables of the NuSMV model.
+	--------------------------------------------------------------------------*/
+	void buildFields();
+
+	/*--------------------------------------------------------------------------
+		buildBehaviours
+
+		Compiles the preconditions and actions of the translated behaviours,
+		and the order in which they are scheduled.
+	--------------------------------------------------------------------------*/
+	void buildBehaviours();
+
+	/*--------------------------------------------------------------------------
+		buildCounters
+
+		Compiles the checks made by the been_in_state and was_in_state
+		counters.
+	--------------------------------------------------------------------------*/
+	void buildCounters();
+
+	/*--------------------------------------------------------------------------
+		addPreconditionNode
+
+		Given the root node of a logical expression tree, recursively compiles
+		an expression that evaluates to true if all of the tree's
+		preconditions hold, as it is written in the NuSMV model.
+	............................................................................
+		@param	node			the root node of the tree
+		@return					the compiled node
+	--------------------------------------------------------------------------*/
+	const int addPreconditionNode(const TreeNode* node);
+
+	/*--------------------------------------------------------------------------
+		addCheckNode
+
+		Compiles the check that a variable has the value given by a
+		propositional or enumerated value check.
+	............................................................................
+		@param	p				the precondition
+		@param	is_counted		true if this is the check counted by a
+								been_in_state or was_in_state counter, which
+								compares the truth value of a
+								non-deterministic variable
+		@return					the compiled node
+	--------------------------------------------------------------------------*/
+	const int addCheckNode(Precondition* p, const bool is_counted);
+
+	/*--------------------------------------------------------------------------
+		getValueIndex
+
+		Returns the index of a value of a field.
+	............................................................................
+		@param	field			the field
+		@param	value			the name of the value
+		@return					the index of the value, or -1 if the field
+								has no such value
+	--------------------------------------------------------------------------*/
+	const int getValueIndex(const int field, const std::string& value) const;
+
+	/*--------------------------------------------------------------------------
+		prepareContext
+
+		Sizes the working state of a context for the compiled behaviours.
+	............................................................................
+		@param	c				the context
+	--------------------------------------------------------------------------*/
+	void prepareContext(SimulatorContext& c) const;
+
+	/*--------------------------------------------------------------------------
+		evaluate
+
+		Evaluates every compiled node in a state.
+	............................................................................
+		@param	c				the context holding the values of the nodes
+		@param	state			the state
+	--------------------------------------------------------------------------*/
+	void evaluate(SimulatorContext& c, const std::vector<uint64_t>& state)
+		const;
+
+	/*--------------------------------------------------------------------------
+		choose
+
+		Chooses one of a number of options, taking the next option of the
+		current combination if every combination is being enumerated, or
+		otherwise a random option.
+	............................................................................
+		@param	c				the context making the choice
+		@param	num				the number of options, at least one
+		@return					the index of the option
+	--------------------------------------------------------------------------*/
+	const int choose(SimulatorContext& c, const int num) const;
+
+	/*--------------------------------------------------------------------------
+		nextChoices
+
+		Moves on to the next combination of the choices made since the
+		combination was last started, when every combination is being
+		enumerated.
+	............................................................................
+		@param	c				the context making the choices
+		@return					true if there is another combination, or
+								false if every combination has been taken
+	--------------------------------------------------------------------------*/
+	const bool nextChoices(SimulatorContext& c) const;
+
+	/*--------------------------------------------------------------------------
+		chooseValue
+
+		Chooses any value of a field.
+	............................................................................
+		@param	c				the context making the choice
+		@param	field			the field
+		@return					the index of the value
+	--------------------------------------------------------------------------*/
+	const int chooseValue(SimulatorContext& c, const int field) const;
+
+	/*--------------------------------------------------------------------------
+		chooseCandidate
+
+		Chooses one of the given values of a field.
+	............................................................................
+		@param	c				the context making the choice
+		@param	field			the field
+		@param	values			the values that may be chosen, which must
+								not be empty
+		@return					the index of the value
+	--------------------------------------------------------------------------*/
+	const int chooseCandidate(SimulatorContext& c, const int field,
+		const std::vector<int>& values) const;
+
+	/*--------------------------------------------------------------------------
+		initialise
+
+		Sets a state to an initial state of the NuSMV model.
+	............................................................................
+		@param	c				the context making the choices
+		@param	state			the state
+	--------------------------------------------------------------------------*/
+	void initialise(SimulatorContext& c, std::vector<uint64_t>& state) const;
+
+	/*--------------------------------------------------------------------------
+		step
+
+		Sets a state to a successor of the current state in the NuSMV model,
+		and adds the step to the statistics of the context.
+	............................................................................
+		@param	c				the context making the choices
+		@param	current			the current state
+		@param	next			the successor state
+	--------------------------------------------------------------------------*/
+	void step(SimulatorContext& c, const std::vector<uint64_t>& current,
+		std::vector<uint64_t>& next) const;
+
+	/*--------------------------------------------------------------------------
+		getResumeStep
+
+		Returns the step at which an executing behaviour resumes after the
+		behaviour it executed ends, or 0 if the scheduled behaviour was not
+		executed by an action other than the last action of the last
+		scheduled behaviour.
+	............................................................................
+		@param	schedule		the scheduled behaviour, which is ending
+		@param	last_schedule	the last scheduled behaviour
+		@return					the step
+	--------------------------------------------------------------------------*/
+	const int getResumeStep(const int schedule, const int last_schedule) const;
+
+	/*--------------------------------------------------------------------------
+		parseTrace
+
+		Parses the traces written by NuSMV. The values of the inputs, and of
+		definitions and variables that are not fields, are ignored.
+	............................................................................
+		@param	filename		the name of the trace file
+		@param	states			the states of the traces
+	--------------------------------------------------------------------------*/
+	void parseTrace(const std::string& filename,
+		std::vector<TraceState>& states) const throw(std::string);
+
+	/*--------------------------------------------------------------------------
+		checkState
+
+		Throws an error if a simulated state differs from a state of a trace.
+	............................................................................
+		@param	state			the simulated state
+		@param	trace_state		the state of the trace
+	--------------------------------------------------------------------------*/
+	void checkState(const std::vector<uint64_t>& state,
+		const TraceState& trace_state) const throw(std::string);
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*==============================================================================
+	AllocationCounter
+
+	Counts the memory allocated through the global operator new, so that the
+	peak memory use of each phase of a translation can be reported.
+
+	File			: allocation_counter.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef ALLOCATION_COUNTER_H_
+#define ALLOCATION_COUNTER_H_
+
+#include <cstddef>
+
+/*------------------------------------------------------------------------------
+	The global operator new and operator delete are replaced in
+	allocation_counter.cpp. Once counting is enabled every allocation made by
+	the program is counted, by the size of the block that malloc returned.
+	Until then nothing is counted, and allocation costs the same as malloc.
+------------------------------------------------------------------------------*/
+class AllocationCounter
+{
+public:
+	/*==========================================================================
+		Public Static Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		enable
+
+		Starts counting the allocations made from now on. The bytes allocated
+		are counted from this point, so releasing a block allocated before it
+		lowers them.
+	--------------------------------------------------------------------------*/
+	static void enable();
+
+	/*--------------------------------------------------------------------------
+		getNumAllocations
+
+		Returns the number of allocations made so far.
+	............................................................................
+		@return					the number of allocations
+	--------------------------------------------------------------------------*/
+	static const unsigned long long getNumAllocations();
+
+	/*--------------------------------------------------------------------------
+		getAllocatedBytes
+
+		Returns the number of bytes allocated and not yet released.
+	............................................................................
+		@return					the number of bytes
+	--------------------------------------------------------------------------*/
+	static const std::size_t getAllocatedBytes();
+
+	/*--------------------------------------------------------------------------
+		getPeakAllocatedBytes
+
+		Returns the largest number of bytes allocated at once since the peak
+		was last reset.
+	............................................................................
+		@return					the number of bytes
+	--------------------------------------------------------------------------*/
+	static const std::size_t getPeakAllocatedBytes();
+
+	/*--------------------------------------------------------------------------
+		resetPeakAllocatedBytes
+
+		Resets the peak to the number of bytes allocated now.
+	--------------------------------------------------------------------------*/
+	static void resetPeakAllocatedBytes();
+};
+
+#endif
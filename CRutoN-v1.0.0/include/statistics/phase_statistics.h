@@ -0,0 +1,116 @@
+/*==============================================================================
+	PhaseStatistics
+
+	Records the wall time and memory use of each phase of parsing and
+	translation.
+
+	File			: phase_statistics.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef PHASE_STATISTICS_H_
+#define PHASE_STATISTICS_H_
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class PhaseStatistics
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	PhaseStatistics() : is_in_phase(false), start_num_allocations(0) {}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		beginPhase
+
+		Begins a phase, ending the current phase if there is one.
+	............................................................................
+		@param	name			the name of the phase
+	--------------------------------------------------------------------------*/
+	void beginPhase(const std::string& name);
+
+	/*--------------------------------------------------------------------------
+		endPhase
+
+		Ends the current phase, if there is one, and records its statistics.
+	--------------------------------------------------------------------------*/
+	void endPhase();
+
+	/*--------------------------------------------------------------------------
+		writeJson
+
+		Writes the statistics of each phase as a JSON array.
+	............................................................................
+		@param	os				the stream to write to
+		@param	num_tabs		the indentation of the array's contents
+	--------------------------------------------------------------------------*/
+	void writeJson(std::ostream& os, const int num_tabs) const;
+
+
+private:
+	/*==========================================================================
+		Private Types
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The statistics of a phase: its wall time, the number of allocations
+		made, the largest number of bytes allocated at once during the phase,
+		and the number of bytes still allocated at its end.
+	--------------------------------------------------------------------------*/
+	struct Phase
+	{
+		std::string name;
+		double seconds;
+		unsigned long long num_allocations;
+		std::size_t peak_bytes;
+		std::size_t end_bytes;
+	};
+
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The phases that have ended, in order.
+	--------------------------------------------------------------------------*/
+	std::vector<Phase> phases;
+
+	/*--------------------------------------------------------------------------
+		The name of the current phase, and the time and number of
+		allocations at its start.
+	--------------------------------------------------------------------------*/
+	bool is_in_phase;
+	std::string phase_name;
+	std::chrono::steady_clock::time_point start_time;
+	unsigned long long start_num_allocations;
+};
+
+#endif
@@ -0,0 +1,108 @@
+/*==============================================================================
+	PhaseTimer
+
+	Times the phases of a function, recording them in a PhaseStatistics if
+	one is given.
+
+	File			: phase_timer.h
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#ifndef PHASE_TIMER_H_
+#define PHASE_TIMER_H_
+
+#include <string>
+
+#include "statistics/phase_statistics.h"
+
+/*------------------------------------------------------------------------------
+	A phase is begun when the timer is constructed and ended when it is
+	destroyed, or when the next phase is begun. Nothing is recorded if the
+	statistics are null, so that a timer can be left in place when no
+	statistics were asked for.
+------------------------------------------------------------------------------*/
+class PhaseTimer
+{
+public:
+	/*==========================================================================
+		Public Constructors/Deconstructor
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		Constructor
+	............................................................................
+		@param	s				the statistics to record the phases in, or
+								null
+		@param	name			the name of the first phase
+	--------------------------------------------------------------------------*/
+	PhaseTimer(PhaseStatistics* s, const std::string& name) : statistics(s)
+	{
+		next(name);
+	}
+
+	~PhaseTimer() {stop();}
+
+	/*==========================================================================
+		Public Functions
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		next
+
+		Ends the current phase and begins the next.
+	............................................................................
+		@param	name			the name of the next phase
+	--------------------------------------------------------------------------*/
+	void next(const std::string& name)
+	{
+		if(statistics != nullptr)
+		{
+			statistics->beginPhase(name);
+		}
+	}
+
+	/*--------------------------------------------------------------------------
+		stop
+
+		Ends the current phase.
+	--------------------------------------------------------------------------*/
+	void stop()
+	{
+		if(statistics != nullptr)
+		{
+			statistics->endPhase();
+		}
+	}
+
+
+private:
+	/*==========================================================================
+		Private Member Variables
+	==========================================================================*/
+	/*--------------------------------------------------------------------------
+		The statistics the phases are recorded in, or null.
+	--------------------------------------------------------------------------*/
+	PhaseStatistics* statistics;
+};
+
+#endif
@@ -146,6 +146,37 @@ const bool caseInsensitiveCompare(const std::string& s_1,
 const std::pair<const std::string, const int> compareStrings(
 	const std::string& this_string, const std::string& that_string);
 
+/*------------------------------------------------------------------------------
+	stringSimilarity
+
+	Calculates the similarity (as a percentage) of the two strings, as returned
+	by compareStrings, without constructing their LCS. Stops early once the
+	similarity provably falls below the threshold.
+................................................................................
+	@param	this_string		the first string
+	@param	that_string		the second string
+	@param	threshold		the similarity of interest to the caller
+	@return					the similarity of the two strings if it is at
+							least threshold, or otherwise some value less
+							than threshold
+------------------------------------------------------------------------------*/
+const int stringSimilarity(const std::string& this_string,
+	const std::string& that_string, const int threshold = 0);
+
+/*------------------------------------------------------------------------------
+	similarityUpperBound
+
+	Returns an upper bound on the similarity that compareStrings would return
+	for the two strings, computed from their character counts in linear time.
+................................................................................
+	@param	this_string		the first string
+	@param	that_string		the second string
+	@return					an integer no smaller than the similarity (as a
+							percentage) of the two strings
+------------------------------------------------------------------------------*/
+const int similarityUpperBound(const std::string& this_string,
+	const std::string& that_string);
+
 /*------------------------------------------------------------------------------
 	displayTitle
 
@@ -36,21 +36,57 @@
 #include <cstdio>
 #include <iostream>
 #include <fstream>
+#include <map>
+#include <set>
+#include <sstream>
 #include <string>
+#include <vector>
 
 #include "define.h"
 #include "global.h"
 #include "intermediate/intermediate_form.h"
+#include "intermediate/intermediate_form_cache.h"
 #include "command_line_parser/command_line_parser.h"
 #include "command_line_parser/parser_option_type.h"
+#include "intermediate_parser/file_source.h"
 #include "intermediate_parser/intermediate_form_parser.h"
+#include "intermediate_parser/previous_run_cache.h"
+#include "intermediate_parser/token_cursor.h"
+#include "nusmv_translator/cone_of_influence.h"
+#include "nusmv_translator/nusmv_model_statistics.h"
+#include "nusmv_translator/nusmv_file_writer.h"
+#include "nusmv_translator/nusmv_stream_writer.h"
 #include "nusmv_translator/nusmv_translator.h"
+#include "nusmv_translator/translation_cache.h"
+#include "nusmv_translator/translation_driver.h"
+#include "nusmv_translator/translator_options.h"
+#include "resolution_policy/resolution_policy.h"
+#include "simulator/reachability_checker.h"
+#include "simulator/simulator.h"
+#include "statistics/allocation_counter.h"
+#include "statistics/phase_statistics.h"
 
 /*==============================================================================
 	Function Prototypes
 ==============================================================================*/
-bool parseCommandLineParameters(int parameter_count, char** parameters);
+bool parseCommandLineParameters(int parameter_count, char** parameters,
+	TranslatorOptions& options);
+void addTranslatorOptions(CommandLineParser& command_line_parser,
+	TranslatorOptions& options);
+bool setUpResolutionPolicy();
+bool setUpConeOfInfluence(ConeOfInfluence& cone_of_influence);
+bool simulate(const IntermediateForm* intermediate_form,
+	const TranslatorOptions& options,
+	const std::map<std::string, std::string>& initial_values);
+bool checkReachability(const IntermediateForm* intermediate_form,
+	const TranslatorOptions& options,
+	const std::map<std::string, std::string>& initial_values);
+bool parseTranslationConfigurations(TranslationDriver& driver,
+	const TranslatorOptions& default_options);
+bool writeStatistics(const PhaseStatistics& phase_statistics,
+	const NuSMVModelStatistics& model_statistics);
 bool validateTime(const std::string& time);
+bool confirmFileWrite(const std::string& file);
 bool writeStringToFile(const std::string& file, const std::string& s);
 
 /*==============================================================================
@@ -58,13 +94,47 @@ bool writeStringToFile(const std::string& file, const std::string& s);
 ==============================================================================*/
 int main(int argc, char** argv)
 {
-	if(!parseCommandLineParameters(argc, argv))
+	// the translator options given on the command line
+	TranslatorOptions options;
+	if(!parseCommandLineParameters(argc, argv, options))
 	{
 		// there was an error parsing the command line parameters, exit
-		return 0;
+		return 1;
+	}
+	if(!setUpResolutionPolicy())
+	{
+		// the resolution policy could not be loaded, exit
+		return 1;
+	}
+
+	if(!g_statistics_file.empty() && (g_check_reachability
+		|| g_simulation_steps > 0 || !g_simulation_trace_file.empty()
+		|| !g_translation_configuration_file.empty()))
+	{
+		displayWarning("statistics are only written for a single "
+			"translation, the statistics file will not be written");
+		g_statistics_file = "";
+	}
+	if(!g_statistics_file.empty())
+	{
+		// allocations are only counted when they are reported
+		AllocationCounter::enable();
 	}
 
 	IntermediateFormParser parser;
+	// the phases of parsing and translation are only recorded if a
+	// statistics file was given
+	PhaseStatistics phase_statistics;
+	PhaseStatistics* statistics = g_statistics_file.empty() ? nullptr :
+		&phase_statistics;
+	parser.setStatistics(statistics);
+	IntermediateFormCache cache(g_parse_cache_directory);
+	PreviousRunCache previous_run(g_parse_cache_directory);
+	if(!g_parse_cache_directory.empty())
+	{
+		parser.setCache(&cache);
+		parser.setPreviousRunCache(&previous_run);
+	}
 
 	if(parser.parse(g_grammar_rule_file, g_data_extraction_rule_file,
 		g_control_rule_file))
@@ -87,23 +157,67 @@ int main(int argc, char** argv)
 			// no output file was specified, write it to standard output
 			std::cout << *intermediate_form;
 		}
-		NuSMVTranslator t(intermediate_form);
-		std::string output_NuSMV;
-		// translate the intermediate form into NuSMV input
-		if(!g_initial_values_file.empty())
+		std::map<std::string, std::string> initial_values;
+		if(!g_initial_values_file.empty()
+			&& !NuSMVTranslator::buildInitialVariableValueMap(
+				intermediate_form, g_initial_values_file, initial_values))
 		{
-			// an initial values file was specified
-			output_NuSMV = t.translate(g_initial_values_file);
+			// there was an error in the initial values file, exit
+			return 1;
 		}
-		else
+		ConeOfInfluence cone_of_influence(intermediate_form);
+		if(!g_cone_of_influence_file.empty())
 		{
-			output_NuSMV = t.translate();
+			if(!setUpConeOfInfluence(cone_of_influence))
+			{
+				// there was an error in the targets file, exit
+				return 1;
+			}
+			// every configuration translates only the cone of influence
+			options.cone_of_influence = &cone_of_influence;
 		}
-
-		if(output_NuSMV == "")
+		if(g_check_reachability)
+		{
+			// explore the reachable states instead of translating
+			return checkReachability(intermediate_form, options,
+				initial_values) ? 0 : 1;
+		}
+		if(g_simulation_steps > 0 || !g_simulation_trace_file.empty())
+		{
+			// simulate the intermediate form instead of translating it
+			return simulate(intermediate_form, options, initial_values) ?
+				0 : 1;
+		}
+		if(!g_translation_configuration_file.empty())
+		{
+			// translate the intermediate form once for each configuration
+			TranslationDriver driver(intermediate_form, initial_values);
+			driver.setCacheDirectory(g_parse_cache_directory);
+			if(!parseTranslationConfigurations(driver, options))
+			{
+				return 1;
+			}
+			return driver.run(g_translation_threads) ? 0 : 1;
+		}
+		NuSMVTranslator t(intermediate_form, options);
+		t.setStatistics(statistics);
+		TranslationCache translation_cache(g_parse_cache_directory);
+		if(!g_parse_cache_directory.empty()
+			&& options.cone_of_influence == nullptr)
+		{
+			// only the sections whose inputs have changed are translated
+			// again
+			t.setTranslationCache(&translation_cache);
+		}
+		// prepare the intermediate form for translation into NuSMV input
+		if(!t.prepareTranslation(initial_values))
 		{
 			// there was an error during translation, exit
-			return 0;
+			return 1;
+		}
+		if(options.cone_of_influence != nullptr)
+		{
+			std::cout << "cone of influence: " << t.getSliceSummary() << "\n";
 		}
 		/*	if behaviour flattening was not enabled, display a warning.
 			behaviours with nested executions that are not flattened may
@@ -114,21 +228,42 @@ int main(int argc, char** argv)
 				+ "enabled, nested behaviour executions may not"
 				+ "\nbe correctly represented in the NuSMV model");
 		}
+		NuSMVModelStatistics model_statistics;
 		if(g_NuSMV_file != "")
 		{
-			// an NuSMV output file was specified, write to it
-			if(writeStringToFile(g_NuSMV_file, output_NuSMV))
+			// an NuSMV output file was specified, translate into it
+			if(confirmFileWrite(g_NuSMV_file))
 			{
+				NuSMVFileWriter writer(g_NuSMV_file);
+				writer.setStatistics(statistics != nullptr ?
+					&model_statistics : nullptr);
+				t.translate(writer, g_translation_threads);
 				std::cout << "NuSMV code written to file \'"
 					+ g_NuSMV_file + "\' successfully\n";
 			}
+			else
+			{
+				// the NuSMV model was not written
+				return 1;
+			}
 		}
 		else
 		{
-			// no output file was specified, write it to standard error
-			std::cerr << output_NuSMV;
+			// no output file was specified, translate into standard error
+			NuSMVStreamWriter writer(std::cerr);
+			writer.setStatistics(statistics != nullptr ?
+				&model_statistics : nullptr);
+			t.translate(writer, g_translation_threads);
 		}
+		if(statistics != nullptr
+			&& !writeStatistics(phase_statistics, model_statistics))
+		{
+			// the statistics were not written
+			return 1;
+		}
+		return 0;
 	}
+	return 1;
 }
 
 /*------------------------------------------------------------------------------
@@ -139,8 +274,10 @@ int main(int argc, char** argv)
 ................................................................................
 	@param	parameter_count		the number of parsed parameters
 	@param	parameters			the array of c-style string parameters
+	@param	options				the translator options to set
 ------------------------------------------------------------------------------*/
-bool parseCommandLineParameters(int parameter_count, char** parameters)
+bool parseCommandLineParameters(int parameter_count, char** parameters,
+	TranslatorOptions& options)
 {
 	// create a new parser with the executable name and version number with
 	// parameter sorting enabled
@@ -161,20 +298,7 @@ bool parseCommandLineParameters(int parameter_count, char** parameters)
 		CommandLineParser::OPTIONAL, &g_intermediate_form_file, "file");
 	command_line_parser.addStringOption("-on", "NuSMV output file\n",
 		CommandLineParser::OPTIONAL, &g_NuSMV_file, "file");
-	command_line_parser.addStringOption("-tod",
-		"set time of day in the robot house\n",
-		CommandLineParser::OPTIONAL, &g_time_of_day, "HH:MM:SS");
-	command_line_parser.addIntRangeOption("-sps",
-		std::string("set seconds per state\n")
-			+ "\t\t\tdefault: "
-			+ integerToString(g_state_time_seconds) + "\n",
-		CommandLineParser::OPTIONAL, &g_state_time_seconds, 1, INT_MAX);
-	command_line_parser.addIntRangeOption("-sms",
-		std::string("set max seconds for was_in_state/been_in_state\n")
-			+"\t\t\tdefault: "
-			+ integerToString(g_max_seconds_per_state_n_seconds) + "\n",
-		CommandLineParser::OPTIONAL, &g_max_seconds_per_state_n_seconds, 1,
-			INT_MAX);
+	addTranslatorOptions(command_line_parser, options);
 	command_line_parser.addIntRangeOption("-smt",
 		std::string("set string matching threshhold\n")
 			+"\t\t\tdefault: "
@@ -198,24 +322,89 @@ bool parseCommandLineParameters(int parameter_count, char** parameters)
 			+ (g_disallow_true_false_enum ? "enabled" : "disabled")
 			+ "\n",
 		CommandLineParser::OPTIONAL, &g_disallow_true_false_enum);
-	command_line_parser.addBoolOption("-tnd",
-		std::string("enable true non-determinism in scheduling behaviours\n")
-			+ "\t\t\tdefault: "
-			+ (g_true_non_determinism ? "enabled" : "disabled")
-			+ "\n",
-		CommandLineParser::OPTIONAL, &g_true_non_determinism);
-	command_line_parser.addBoolOption("-mos",
-		std::string("enable min of 1 state for was_in_state/been_in_state\n")
-			+ "\t\t\tdefault: "
-			+ (g_minimum_one_state_state_n_seconds ? "enabled" : "disabled")
-			+ "\n",
-		CommandLineParser::OPTIONAL, &g_minimum_one_state_state_n_seconds);
 	command_line_parser.addBoolOption("-f",
 		std::string("enable behaviour flattening\n")
 			+ "\t\t\tdefault: "
 			+ (g_flatten_behaviours ? "enabled" : "disabled")
 			+ "\n",
 		CommandLineParser::OPTIONAL, &g_flatten_behaviours);
+	command_line_parser.addStringOption("-rp",
+		"resolution policy file answering prompts\n",
+		CommandLineParser::OPTIONAL, &g_resolution_policy_file, "file");
+	command_line_parser.addStringOption("-rr",
+		"file to record answers given to prompts\n",
+		CommandLineParser::OPTIONAL, &g_resolution_record_file, "file");
+	command_line_parser.addBoolOption("-rs",
+		std::string("enable failing on prompts with no policy answer\n")
+			+ "\t\t\tdefault: "
+			+ (g_strict_resolution ? "enabled" : "disabled")
+			+ "\n",
+		CommandLineParser::OPTIONAL, &g_strict_resolution);
+	command_line_parser.addStringOption("-tc",
+		std::string("translation configurations file, each line gives\n")
+			+ "\t\t\tan -on file and any of -tod -sps -sms -tnd -mos\n"
+			+ "\t\t\t-bic -psg\n",
+		CommandLineParser::OPTIONAL, &g_translation_configuration_file,
+			"file");
+	command_line_parser.addIntRangeOption("-tt",
+		std::string("set number of rule matching, translation and\n")
+			+ "\t\t\treachability threads\n"
+			+ "\t\t\tdefault: "
+			+ integerToString(g_translation_threads) + "\n",
+		CommandLineParser::OPTIONAL, &g_translation_threads, 1, INT_MAX);
+	command_line_parser.addStringOption("-ct",
+		std::string("cone of influence targets file, only the behaviours\n")
+			+ "\t\t\tand variables that the targets depend on are\n"
+			+ "\t\t\ttranslated\n",
+		CommandLineParser::OPTIONAL, &g_cone_of_influence_file, "file");
+	command_line_parser.addIntRangeOption("-sim",
+		std::string("simulate a number of random steps instead of\n")
+			+ "\t\t\ttranslating\n",
+		CommandLineParser::OPTIONAL, &g_simulation_steps, 1, INT_MAX);
+	command_line_parser.addIntRangeOption("-simr",
+		std::string("set steps simulated from each initial state\n")
+			+ "\t\t\tdefault: "
+			+ integerToString(g_simulation_run_length) + "\n",
+		CommandLineParser::OPTIONAL, &g_simulation_run_length, 1, INT_MAX);
+	command_line_parser.addIntRangeOption("-sims",
+		std::string("set seed of the simulator's random choices\n")
+			+ "\t\t\tdefault: "
+			+ integerToString(g_simulation_seed) + "\n",
+		CommandLineParser::OPTIONAL, &g_simulation_seed, 0, INT_MAX);
+	command_line_parser.addStringOption("-simt",
+		std::string("NuSMV trace file replayed by the simulator, which\n")
+			+ "\t\t\tchecks each state of the trace\n",
+		CommandLineParser::OPTIONAL, &g_simulation_trace_file, "file");
+	command_line_parser.addBoolOption("-rch",
+		std::string("enable finding the behaviours that can be scheduled\n")
+			+ "\t\t\tin a reachable state instead of translating\n"
+			+ "\t\t\tdefault: "
+			+ (g_check_reachability ? "enabled" : "disabled")
+			+ "\n",
+		CommandLineParser::OPTIONAL, &g_check_reachability);
+	command_line_parser.addIntRangeOption("-rchs",
+		std::string("set max states explored by the reachability check\n")
+			+ "\t\t\tdefault: "
+			+ integerToString(g_reachability_max_states) + "\n",
+		CommandLineParser::OPTIONAL, &g_reachability_max_states, 1,
+			INT_MAX / 2);
+	command_line_parser.addStringOption("-rchw",
+		std::string("file to write a trace to each reachable behaviour,\n")
+			+ "\t\t\twhich can be replayed with -simt\n",
+		CommandLineParser::OPTIONAL, &g_reachability_witness_file, "file");
+	command_line_parser.addStringOption("-st",
+		std::string("file to write JSON statistics of the time and memory\n")
+			+ "\t\t\tused by each phase of parsing and translation,\n"
+			+ "\t\t\tand of the size of the NuSMV model\n",
+		CommandLineParser::OPTIONAL, &g_statistics_file, "file");
+	command_line_parser.addStringOption("-pc",
+		std::string("directory caching parsed rules, files parsed before\n")
+			+ "\t\t\twith the same options are loaded from the cache,\n"
+			+ "\t\t\tan edited control rule file has only its changed\n"
+			+ "\t\t\tbehaviours parsed and flattened again, and only the\n"
+			+ "\t\t\tsections of the NuSMV model whose inputs changed\n"
+			+ "\t\t\tare translated again\n",
+		CommandLineParser::OPTIONAL, &g_parse_cache_directory, "dir");
 
 	if(!command_line_parser.parse())
 	{
@@ -223,7 +412,7 @@ bool parseCommandLineParameters(int parameter_count, char** parameters)
 		command_line_parser.displayUsageInformation();
 		return false;
 	}
-	if(g_time_of_day != "" && !validateTime(g_time_of_day))
+	if(options.time_of_day != "" && !validateTime(options.time_of_day))
 	{
 		// the given time of day was invalid
 		return false;
@@ -231,6 +420,333 @@ bool parseCommandLineParameters(int parameter_count, char** parameters)
 	return true;
 }
 
+/*------------------------------------------------------------------------------
+	addTranslatorOptions
+
+	Adds the options that set the translator options to the given parser.
+................................................................................
+	@param	command_line_parser	the parser to which the options are added
+	@param	options				the translator options to set, whose values
+								are displayed as the defaults
+------------------------------------------------------------------------------*/
+void addTranslatorOptions(CommandLineParser& command_line_parser,
+	TranslatorOptions& options)
+{
+	command_line_parser.addStringOption("-tod",
+		"set time of day in the robot house\n",
+		CommandLineParser::OPTIONAL, &options.time_of_day, "HH:MM:SS");
+	command_line_parser.addIntRangeOption("-sps",
+		std::string("set seconds per state\n")
+			+ "\t\t\tdefault: "
+			+ integerToString(options.state_time_seconds) + "\n",
+		CommandLineParser::OPTIONAL, &options.state_time_seconds, 1, INT_MAX);
+	command_line_parser.addIntRangeOption("-sms",
+		std::string("set max seconds for was_in_state/been_in_state\n")
+			+"\t\t\tdefault: "
+			+ integerToString(options.max_seconds_per_state_n_seconds) + "\n",
+		CommandLineParser::OPTIONAL, &options.max_seconds_per_state_n_seconds,
+			1, INT_MAX);
+	command_line_parser.addBoolOption("-tnd",
+		std::string("enable true non-determinism in scheduling behaviours\n")
+			+ "\t\t\tdefault: "
+			+ (options.true_non_determinism ? "enabled" : "disabled")
+			+ "\n",
+		CommandLineParser::OPTIONAL, &options.true_non_determinism);
+	command_line_parser.addBoolOption("-mos",
+		std::string("enable min of 1 state for was_in_state/been_in_state\n")
+			+ "\t\t\tdefault: "
+			+ (options.minimum_one_state_state_n_seconds ?
+				"enabled" : "disabled")
+			+ "\n",
+		CommandLineParser::OPTIONAL,
+			&options.minimum_one_state_state_n_seconds);
+	command_line_parser.addBoolOption("-bic",
+		std::string("enable bounded integer was_in_state/been_in_state\n")
+			+ "\t\t\tcounters, shared between thresholds\n"
+			+ "\t\t\tdefault: "
+			+ (options.integer_counters ? "enabled" : "disabled")
+			+ "\n",
+		CommandLineParser::OPTIONAL, &options.integer_counters);
+	command_line_parser.addIntRangeOption("-psg",
+		std::string("set max equal priority behaviours scheduled by\n")
+			+ "\t\t\tenumerating subsets, larger groups use a choice\n"
+			+ "\t\t\tvariable\n"
+			+ "\t\t\tdefault: "
+			+ integerToString(options.max_power_set_group_size) + "\n",
+		CommandLineParser::OPTIONAL, &options.max_power_set_group_size, 1,
+			16);
+	command_line_parser.addBoolOption("-fuv",
+		std::string("enable declaring variables that are never assigned\n")
+			+ "\t\t\tand have no initial value as frozen\n"
+			+ "\t\t\tdefault: "
+			+ (options.freeze_unassigned_variables ? "enabled" : "disabled")
+			+ "\n",
+		CommandLineParser::OPTIONAL, &options.freeze_unassigned_variables);
+}
+
+/*------------------------------------------------------------------------------
+	parseTranslationConfigurations
+
+	Parses the translation configurations file, adding each configuration to
+	the driver, and returns true if successful or false otherwise. Each line
+	holds the parameters of one translation: an -on parameter naming the
+	output file, and any of the translator options, which otherwise take the
+	values given on the command line. Blank lines and lines beginning with #
+	are ignored. Once the whole file has parsed, the user is asked before
+	each existing output file is overwritten, as for a single translation,
+	and no file may be the output of more than one configuration.
+................................................................................
+	@param	driver				the driver to which the configurations are
+								added
+	@param	default_options		the translator options given on the command
+								line
+------------------------------------------------------------------------------*/
+bool parseTranslationConfigurations(TranslationDriver& driver,
+	const TranslatorOptions& default_options)
+{
+	const std::string& filename = g_translation_configuration_file;
+	FileSource file_source(filename);
+	if(!file_source.isOpen())
+	{
+		displayError("error loading file \'" + filename + "\'");
+		return false;
+	}
+	TokenCursor file_cursor(file_source.getSpan());
+	int line_number = 0;
+	// the configurations and their output files, in the order they are given
+	std::vector<std::pair<TranslatorOptions, std::string>> configurations;
+	std::set<std::string> files;
+	while(!file_cursor.atEnd())
+	{
+		TokenCursor line(file_cursor.getNextLine());
+		line_number++;
+		if(!line.hasNextToken() || line.peekNextToken().str()[0] == '#')
+		{
+			continue;
+		}
+		// build an argument vector from the line, as if given to main
+		std::vector<std::string> arguments(1, EXEC_NAME);
+		while(line.hasNextToken())
+		{
+			arguments.push_back(line.getNextToken().str());
+		}
+		std::vector<char*> argument_pointers;
+		for(std::string& argument : arguments)
+		{
+			argument_pointers.push_back(&argument[0]);
+		}
+
+		TranslatorOptions options = default_options;
+		std::string file = "";
+		CommandLineParser line_parser(EXEC_NAME, EXEC_VERSION,
+			CommandLineParser::NO_PARAMETER_SORT, argument_pointers.size(),
+			argument_pointers.data());
+		line_parser.addStringOption("-on", "NuSMV output file\n",
+			CommandLineParser::REQUIRED, &file, "file");
+		addTranslatorOptions(line_parser, options);
+		if(!line_parser.parse() || (options.time_of_day != ""
+			&& !validateTime(options.time_of_day)))
+		{
+			displayError("error on line " + integerToString(line_number)
+				+ " of file \'" + filename + "\'");
+			return false;
+		}
+		if(!files.insert(file).second)
+		{
+			// a later translation would silently replace an earlier one
+			displayError("output file \'" + file + "\' on line "
+				+ integerToString(line_number) + " of file \'" + filename
+				+ "\' is already written by another configuration");
+			return false;
+		}
+		configurations.push_back(std::make_pair(options, file));
+	}
+	if(configurations.empty())
+	{
+		displayError("no configurations were found in file \'" + filename
+			+ "\'");
+		return false;
+	}
+	// only confirmed once every line has parsed, as an existing file is
+	// removed when it may be overwritten
+	for(auto& configuration : configurations)
+	{
+		if(!confirmFileWrite(configuration.second))
+		{
+			// the NuSMV model would not be written
+			return false;
+		}
+		driver.addConfiguration(configuration.first, configuration.second);
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	setUpResolutionPolicy
+
+	Loads the resolution policy file and opens the record file, if either was
+	given, and returns true if successful or false otherwise.
+------------------------------------------------------------------------------*/
+bool setUpResolutionPolicy()
+{
+	try
+	{
+		if(!g_resolution_policy_file.empty())
+		{
+			g_resolution_policy.load(g_resolution_policy_file);
+		}
+		// opened after loading, the record file may replace the policy file
+		if(!g_resolution_record_file.empty())
+		{
+			g_resolution_policy.setRecordFile(g_resolution_record_file);
+		}
+		g_resolution_policy.setStrict(g_strict_resolution);
+	}
+	catch(const std::string& error)
+	{
+		displayError(error);
+		return false;
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	setUpConeOfInfluence
+
+	Adds the targets in the cone of influence file and computes the cone,
+	returning true if successful or false otherwise.
+................................................................................
+	@param	cone_of_influence	the cone of influence to compute
+------------------------------------------------------------------------------*/
+bool setUpConeOfInfluence(ConeOfInfluence& cone_of_influence)
+{
+	try
+	{
+		cone_of_influence.loadTargets(g_cone_of_influence_file);
+	}
+	catch(const std::string& error)
+	{
+		displayError(error);
+		return false;
+	}
+	cone_of_influence.compute();
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	simulate
+
+	Replays the NuSMV trace file and simulates the random steps given on the
+	command line, then displays the simulation statistics. Returns true if
+	successful or false otherwise.
+................................................................................
+	@param	intermediate_form	the intermediate form to simulate
+	@param	options				the translator options, whose translation's
+								semantics are simulated
+	@param	initial_values		maps variable names to their initial values
+------------------------------------------------------------------------------*/
+bool simulate(const IntermediateForm* intermediate_form,
+	const TranslatorOptions& options,
+	const std::map<std::string, std::string>& initial_values)
+{
+	Simulator simulator(intermediate_form, options, g_simulation_seed);
+	if(!simulator.prepareSimulation(initial_values))
+	{
+		return false;
+	}
+	if(!g_simulation_trace_file.empty())
+	{
+		try
+		{
+			unsigned int num_states =
+				simulator.replayTrace(g_simulation_trace_file);
+			std::cout << "trace file \'" << g_simulation_trace_file
+				<< "\' replayed successfully, all " << num_states
+				<< " states agree with the simulation\n";
+		}
+		catch(const std::string& error)
+		{
+			displayError(error);
+			return false;
+		}
+	}
+	if(g_simulation_steps > 0)
+	{
+		simulator.simulate(g_simulation_steps, g_simulation_run_length);
+	}
+	simulator.writeStatistics(std::cout);
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	checkReachability
+
+	Explores the reachable states of the intermediate form's translation,
+	displays which behaviours can be scheduled, and writes a trace to each of
+	them if a witness file was given. Returns true if successful or false
+	otherwise.
+................................................................................
+	@param	intermediate_form	the intermediate form to check
+	@param	options				the translator options, whose translation's
+								states are explored
+	@param	initial_values		maps variable names to their initial values
+------------------------------------------------------------------------------*/
+bool checkReachability(const IntermediateForm* intermediate_form,
+	const TranslatorOptions& options,
+	const std::map<std::string, std::string>& initial_values)
+{
+	Simulator simulator(intermediate_form, options, g_simulation_seed);
+	if(!simulator.prepareSimulation(initial_values))
+	{
+		return false;
+	}
+	ReachabilityChecker checker(simulator, g_translation_threads,
+		g_reachability_max_states);
+	if(!checker.check())
+	{
+		displayWarning("the reachability check stopped after exploring "
+			+ integerToString(g_reachability_max_states) + " states, so "
+			"behaviours that were not reached may still be reachable");
+	}
+	checker.writeResults(std::cout);
+	if(!g_reachability_witness_file.empty())
+	{
+		std::ostringstream witnesses;
+		checker.writeWitnesses(witnesses);
+		return writeStringToFile(g_reachability_witness_file,
+			witnesses.str());
+	}
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	writeStatistics
+
+	Writes the statistics of the phases of parsing and translation, and of the
+	NuSMV model, to the statistics file as a JSON object. Returns true if
+	successful or false otherwise.
+................................................................................
+	@param	phase_statistics	the statistics of the phases
+	@param	model_statistics	the statistics of the NuSMV model
+------------------------------------------------------------------------------*/
+bool writeStatistics(const PhaseStatistics& phase_statistics,
+	const NuSMVModelStatistics& model_statistics)
+{
+	std::ostringstream json;
+	json << "{\n\t\"phases\": ";
+	phase_statistics.writeJson(json, 2);
+	json << ",\n\t\"model\": ";
+	model_statistics.writeJson(json, 2);
+	json << "\n}\n";
+	if(!writeStringToFile(g_statistics_file, json.str()))
+	{
+		return false;
+	}
+	std::cout << "statistics written to file \'" << g_statistics_file
+		<< "\' successfully\n";
+	return true;
+}
+
 /*------------------------------------------------------------------------------
 	validateTime
 
@@ -301,17 +817,16 @@ bool validateTime(const std::string& time)
 }
 
 /*------------------------------------------------------------------------------
-	writeStringToFile
+	confirmFileWrite
 
-	Writes the given string s to file, prompts for permission to overwrite
-	if the file already exists.
+	Returns true if the given file may be written, prompts for permission to
+	overwrite if the file already exists.
 ................................................................................
-	@param	file				the name of the file to which the string s
-								should be written
-	@return						true if the string is successfully written to
-								the file, or false otherwise
+	@param	file				the name of the file to be written
+	@return						true if the file may be written, or false
+								otherwise
 ------------------------------------------------------------------------------*/
-bool writeStringToFile(const std::string& file, const std::string& s)
+bool confirmFileWrite(const std::string& file)
 {
 	std::ifstream file_stream_in(file);
 	bool write_to_file = true;
@@ -320,22 +835,50 @@ bool writeStringToFile(const std::string& file, const std::string& s)
 		displayWarning("file \'" + file
 			+ "\' already exists");
 		std::string input;
-		do
+		try
 		{
-			std::cout << "overwrite this file (y/n) ? ";
-			std::cin >> input;
-		} while(input != "y" && input != "Y" && input != "n" && input != "N");
+			std::vector<std::string> key = {file};
+			input = g_resolution_policy.prompt(PROMPT_FILE_OVERWRITE, key,
+				"overwrite this file (y/n) ? ",
+				[](const std::string& s)
+				{
+					return s == "y" || s == "Y" || s == "n" || s == "N";
+				});
+		}
+		catch(const std::string& error)
+		{
+			displayError(error);
+			input = "n";
+		}
 		if((write_to_file = (input == "y" || input == "Y")))
 		{
+			file_stream_in.close();
 			std::remove(file.c_str());
 		}
 	}
-	if(write_to_file)
-	{
-		std::ofstream file_stream_out(file);
-		file_stream_out << s;
-		file_stream_out.close();
-	}
 	file_stream_in.close();
 	return write_to_file;
 }
+
+/*------------------------------------------------------------------------------
+	writeStringToFile
+
+	Writes the given string s to file, prompts for permission to overwrite
+	if the file already exists.
+................................................................................
+	@param	file				the name of the file to which the string s
+								should be written
+	@return						true if the string is successfully written to
+								the file, or false otherwise
+------------------------------------------------------------------------------*/
+bool writeStringToFile(const std::string& file, const std::string& s)
+{
+	if(!confirmFileWrite(file))
+	{
+		return false;
+	}
+	std::ofstream file_stream_out(file);
+	file_stream_out << s;
+	file_stream_out.close();
+	return true;
+}
@@ -28,6 +28,7 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <string>
+#include <thread>
 
 #include "define.h"
 #include "global.h"
@@ -36,12 +37,7 @@ bool g_flatten_behaviours = true;
 bool g_no_prompt_case_insensitivity = true;
 bool g_no_prompt_identifier_matching = true;
 bool g_disallow_true_false_enum = true;
-bool g_true_non_determinism = true;
-bool g_minimum_one_state_state_n_seconds = false;
 int g_string_matching_threshhold = 90;
-int g_state_time_seconds = 600;
-int g_max_seconds_per_state_n_seconds = 5000;
-std::string g_time_of_day = "";
 const std::string EXEC_VERSION = "1.0.0";
 const std::string EXEC_NAME = "CRuToN";
 std::string g_control_rule_file = "";
@@ -50,3 +46,19 @@ std::string g_data_extraction_rule_file = "";
 std::string g_initial_values_file = "";
 std::string g_intermediate_form_file = "";
 std::string g_NuSMV_file = "";
+std::string g_resolution_policy_file = "";
+std::string g_resolution_record_file = "";
+bool g_strict_resolution = false;
+std::string g_translation_configuration_file = "";
+int g_translation_threads = std::thread::hardware_concurrency() > 0 ?
+	std::thread::hardware_concurrency() : 1;
+std::string g_cone_of_influence_file = "";
+int g_simulation_steps = 0;
+int g_simulation_run_length = 1000;
+int g_simulation_seed = 1;
+std::string g_simulation_trace_file = "";
+bool g_check_reachability = false;
+int g_reachability_max_states = 1000000;
+std::string g_reachability_witness_file = "";
+std::string g_statistics_file = "";
+std::string g_parse_cache_directory = "";
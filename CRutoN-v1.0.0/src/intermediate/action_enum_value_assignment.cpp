@@ -48,11 +48,11 @@ std::string ActionEnumValueAssignment::getActionDescription() const
 /*------------------------------------------------------------------------------
 	clone
 
-	Returns a pointer to a copy of this.
+	Returns a pointer to a copy of this, constructed in the given arena.
 ------------------------------------------------------------------------------*/
-Action* ActionEnumValueAssignment::clone() const
+Action* ActionEnumValueAssignment::clone(Arena& arena) const
 {
-	return new ActionEnumValueAssignment(enum_variable,
+	return arena.create<ActionEnumValueAssignment>(enum_variable,
 		enum_value, action_order);
 }
 
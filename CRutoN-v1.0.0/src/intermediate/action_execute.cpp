@@ -47,11 +47,14 @@ std::string ActionExecute::getActionDescription() const
 /*------------------------------------------------------------------------------
 	clone
 
-	Returns a pointer to a copy of this.
+	Returns a pointer to a copy of this, constructed in the given arena.
 ------------------------------------------------------------------------------*/
-Action* ActionExecute::clone() const
+Action* ActionExecute::clone(Arena& arena) const
 {
-	return new ActionExecute(behaviour, action_order);
+	ActionExecute* new_action =
+		arena.create<ActionExecute>(behaviour, action_order);
+	new_action->setBehaviourId(behaviour_id);
+	return new_action;
 }
 
 /*------------------------------------------------------------------------------
@@ -28,9 +28,10 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <algorithm>
-#include <list>
+#include <cstddef>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "intermediate/action_execute_non_deterministic.h"
 
@@ -55,27 +56,21 @@ void ActionExecuteNonDeterministic::addBehaviourValue(
 	if(!found)
 	{
 		behaviour_values.push_back(behaviour_value);
+		behaviour_ids.push_back(-1);
 	}
 }
 
 /*------------------------------------------------------------------------------
-	updateBehaviourName
+	resolveBehaviourValue
 
-	Updates the name of an executed behaviour.
+	Sets the name and id of the behaviour matched by an executed behaviour
+	name.
 ------------------------------------------------------------------------------*/
-void ActionExecuteNonDeterministic::updateBehaviourName(
-	const std::string existing_name, const std::string new_name)
+void ActionExecuteNonDeterministic::resolveBehaviourValue(
+	const std::size_t position, const std::string name, const int id)
 {
-	auto it = behaviour_values.begin();
-	auto end = behaviour_values.end();
-	while(it != end)
-	{
-		if(*it == existing_name)
-		{
-			(*it) = new_name;
-		}
-		it++;
-	}
+	behaviour_values[position] = name;
+	behaviour_ids[position] = id;
 }
 
 /*------------------------------------------------------------------------------
@@ -93,16 +88,14 @@ std::string ActionExecuteNonDeterministic::getActionDescription() const
 /*------------------------------------------------------------------------------
 	clone
 
-	Returns a pointer to a copy of this.
+	Returns a pointer to a copy of this, constructed in the given arena.
 ------------------------------------------------------------------------------*/
-Action* ActionExecuteNonDeterministic::clone() const
+Action* ActionExecuteNonDeterministic::clone(Arena& arena) const
 {
 	ActionExecuteNonDeterministic* new_action =
-		new ActionExecuteNonDeterministic(action_order);
-	for(std::string value : behaviour_values)
-	{
-		new_action->addBehaviourValue(value);
-	}
+		arena.create<ActionExecuteNonDeterministic>(action_order);
+	new_action->behaviour_values = behaviour_values;
+	new_action->behaviour_ids = behaviour_ids;
 	return new_action;
 }
 
@@ -47,11 +47,11 @@ std::string ActionPropValueAssignment::getActionDescription() const
 /*------------------------------------------------------------------------------
 	clone
 
-	Returns a pointer to a copy of this.
+	Returns a pointer to a copy of this, constructed in the given arena.
 ------------------------------------------------------------------------------*/
-Action* ActionPropValueAssignment::clone() const
+Action* ActionPropValueAssignment::clone(Arena& arena) const
 {
-	return new ActionPropValueAssignment(prop_variable,
+	return arena.create<ActionPropValueAssignment>(prop_variable,
 		truth_value, action_order);
 }
 
@@ -47,11 +47,11 @@ std::string ActionWait::getActionDescription() const
 /*------------------------------------------------------------------------------
 	clone
 
-	Returns a pointer to a copy of this.
+	Returns a pointer to a copy of this, constructed in the given arena.
 ------------------------------------------------------------------------------*/
-Action* ActionWait::clone() const
+Action* ActionWait::clone(Arena& arena) const
 {
-	return new ActionWait(wait_seconds, action_order);
+	return arena.create<ActionWait>(wait_seconds, action_order);
 }
 
 /*------------------------------------------------------------------------------
@@ -0,0 +1,85 @@
+/*==============================================================================
+	Arena
+
+	File			: arena.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include "intermediate/arena.h"
+
+/*------------------------------------------------------------------------------
+	release
+
+	Destroys every object in the arena, most recently created first, and frees
+	all blocks.
+------------------------------------------------------------------------------*/
+void Arena::release()
+{
+	while(last_finaliser != nullptr)
+	{
+		Finaliser* finaliser = last_finaliser;
+		last_finaliser = finaliser->previous;
+		finaliser->destroy(finaliser->object);
+	}
+	for(char* block : blocks)
+	{
+		::operator delete(block);
+	}
+	blocks.clear();
+	next = nullptr;
+	remaining = 0;
+}
+
+/*------------------------------------------------------------------------------
+	allocate
+
+	Returns a pointer to size bytes of uninitialised memory with the given
+	alignment, starting a new block if the current block is full.
+------------------------------------------------------------------------------*/
+void* Arena::allocate(const std::size_t size, const std::size_t alignment)
+{
+	std::size_t padding = (alignment
+		- reinterpret_cast<std::uintptr_t>(next) % alignment) % alignment;
+	if(next == nullptr || padding + size > remaining)
+	{
+		// start a new block, large enough for oversized requests
+		std::size_t block_size = size + alignment > ARENA_BLOCK_SIZE
+			? size + alignment : ARENA_BLOCK_SIZE;
+		char* block = static_cast<char*>(::operator new(block_size));
+		blocks.push_back(block);
+		next = block;
+		remaining = block_size;
+		padding = (alignment
+			- reinterpret_cast<std::uintptr_t>(next) % alignment) % alignment;
+	}
+	void* memory = next + padding;
+	next += padding + size;
+	remaining -= padding + size;
+	return memory;
+}
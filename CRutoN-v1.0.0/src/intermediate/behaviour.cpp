@@ -28,8 +28,8 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <algorithm>
-#include <list>
 #include <sstream>
+#include <vector>
 
 #include "utility.h"
 #include "enums/action_type.h"
@@ -41,22 +41,6 @@
 #include "intermediate/logical_expression_tree.h"
 #include "intermediate/tree_node.h"
 
-Behaviour::~Behaviour()
-{
-	for(Action* a : actions)
-	{
-		delete a;
-	}
-	for(Precondition* p : preconditions)
-	{
-		delete p;
-	}
-	if(logical_expression_tree != nullptr)
-	{
-		delete logical_expression_tree;
-	}
-}
-
 /*------------------------------------------------------------------------------
 	addPrecondition
 
@@ -64,15 +48,16 @@ Behaviour::~Behaviour()
 ------------------------------------------------------------------------------*/
 void Behaviour::addPrecondition(Precondition* precondition)
 {
-	// add the new precondition then sort by precondition order, lowest first
-	preconditions.push_back(precondition);
-	preconditions.sort(
+	// insert the new precondition after any having the same or a lower
+	// precondition order, keeping the preconditions sorted, lowest first
+	preconditions.insert(std::upper_bound(preconditions.begin(),
+		preconditions.end(), precondition,
 		[&](Precondition* this_precondition,
 			Precondition* that_precondition)
 		{
 			return this_precondition->getPreconditionOrder()
 				< that_precondition->getPreconditionOrder();
-		});
+		}), precondition);
 }
 
 /*------------------------------------------------------------------------------
@@ -82,14 +67,14 @@ void Behaviour::addPrecondition(Precondition* precondition)
 ------------------------------------------------------------------------------*/
 void Behaviour::addAction(Action* action)
 {
-	// add the new action then sort by action order, lowest first
-	actions.push_back(action);
-	actions.sort(
+	// insert the new action after any having the same or a lower action
+	// order, keeping the actions sorted, lowest first
+	actions.insert(std::upper_bound(actions.begin(), actions.end(), action,
 		[&](Action* this_action, Action* that_action)
 		{
 			return this_action->getActionOrder() <
 				that_action->getActionOrder();
-		});
+		}), action);
 }
 
 /*------------------------------------------------------------------------------
@@ -97,14 +82,15 @@ void Behaviour::addAction(Action* action)
 
 	Builds the logical expression tree using the preconditions.
 ------------------------------------------------------------------------------*/
-void Behaviour::buildLogicalExpressionTree()
+void Behaviour::buildLogicalExpressionTree(Arena& arena)
 {
 	auto it = preconditions.rbegin();
 	if(it == preconditions.rend())
 	{
 		return;
 	}
-	logical_expression_tree = new LogicalExpressionTree(buildNextNode(it));
+	logical_expression_tree = arena.create<LogicalExpressionTree>(
+		buildNextNode(it, arena));
 }
 
 /*------------------------------------------------------------------------------
@@ -114,7 +100,7 @@ void Behaviour::buildLogicalExpressionTree()
 	pointed to by the iterator it.
 ------------------------------------------------------------------------------*/
 TreeNode* Behaviour::buildNextNode(
-	std::list<Precondition*>::reverse_iterator it)
+	std::vector<Precondition*>::reverse_iterator it, Arena& arena)
 {
 	auto prev_it = it;
 	prev_it++;
@@ -124,13 +110,13 @@ TreeNode* Behaviour::buildNextNode(
 	if(prev_it == preconditions.rend())
 	{
 		// this is the last precondition in the list, create a new leaf node
-		node = new TreeNode(nullptr, nullptr, precondition,
+		node = arena.create<TreeNode>(nullptr, nullptr, precondition,
 			TreeNodeType::LEAF);
 		if(not_connector == 1)
 		{
 			// this precondition is negated so create a new
 			// NOT node with node as its child
-			node = new TreeNode(node, nullptr, nullptr,
+			node = arena.create<TreeNode>(node, nullptr, nullptr,
 				TreeNodeType::INTERNAL_NOT);
 		}
 	}
@@ -139,27 +125,27 @@ TreeNode* Behaviour::buildNextNode(
 		Precondition* previous_precondition = *prev_it;
 		int and_or_connector = previous_precondition->getAndOrConnector();
 		// construct a new leaf node for the left child
-		TreeNode* left = new TreeNode(nullptr, nullptr, precondition,
+		TreeNode* left = arena.create<TreeNode>(nullptr, nullptr, precondition,
 			TreeNodeType::LEAF);
 		if(not_connector == 1)
 		{
 			// this is negated so create a new NOT node with the
 			// old left node as a child
-			left = new TreeNode(left, nullptr, nullptr,
+			left = arena.create<TreeNode>(left, nullptr, nullptr,
 				TreeNodeType::INTERNAL_NOT);
 		}
 		// recursively construct the right child
-		TreeNode* right = buildNextNode(prev_it);
+		TreeNode* right = buildNextNode(prev_it, arena);
 		if(and_or_connector < 2)
 		{
 			// create a new AND node
-			node = new TreeNode(left, right, nullptr,
+			node = arena.create<TreeNode>(left, right, nullptr,
 				TreeNodeType::INTERNAL_AND);
 		}
 		else
 		{
 			// create a new OR node
-			node = new TreeNode(left, right, nullptr,
+			node = arena.create<TreeNode>(left, right, nullptr,
 				TreeNodeType::INTERNAL_OR);
 		}
 	}
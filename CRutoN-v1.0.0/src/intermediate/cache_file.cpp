@@ -0,0 +1,320 @@
+/*==============================================================================
+	CacheWriter, CacheReader, CacheHash
+
+	The encoding shared by the cache files in a parse cache directory.
+
+	File			: cache_file.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+#include "global.h"
+#include "utility.h"
+#include "intermediate/cache_file.h"
+#include "intermediate_parser/file_source.h"
+
+/*------------------------------------------------------------------------------
+	The offset basis and prime of the 64 bit FNV-1a hash.
+------------------------------------------------------------------------------*/
+static const std::uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+static const std::uint64_t FNV_PRIME = 1099511628211ULL;
+
+/*------------------------------------------------------------------------------
+	putInt
+
+	Appends an integer as four bytes.
+------------------------------------------------------------------------------*/
+void CacheWriter::putInt(const int n)
+{
+	std::uint32_t u = (std::uint32_t)n;
+	for(int i = 0; i < 4; i++)
+	{
+		data += (char)((u >> (8 * i)) & 0xFF);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	putString
+
+	Appends a string, preceded by its length.
+------------------------------------------------------------------------------*/
+void CacheWriter::putString(const std::string& s)
+{
+	putInt(s.size());
+	data += s;
+}
+
+/*------------------------------------------------------------------------------
+	putFloat
+
+	Appends the bits of a float.
+------------------------------------------------------------------------------*/
+void CacheWriter::putFloat(const float f)
+{
+	std::uint32_t u;
+	std::memcpy(&u, &f, sizeof(u));
+	putInt((int)u);
+}
+
+/*------------------------------------------------------------------------------
+	writeToFile
+
+	Writes the appended values to a file, through a temporary file.
+------------------------------------------------------------------------------*/
+void CacheWriter::writeToFile(const std::string& filename) const
+	throw(std::string)
+{
+	std::string temporary_filename = filename + ".tmp";
+	std::ofstream ofstream(temporary_filename, std::ios::binary);
+	ofstream.write(data.data(), data.size());
+	ofstream.close();
+	if(!ofstream.good())
+	{
+		std::remove(temporary_filename.c_str());
+		throw("error writing cache file \'" + filename + "\'\n");
+	}
+	std::remove(filename.c_str());
+	if(std::rename(temporary_filename.c_str(), filename.c_str()) != 0)
+	{
+		std::remove(temporary_filename.c_str());
+		throw("error writing cache file \'" + filename + "\'\n");
+	}
+}
+
+/*------------------------------------------------------------------------------
+	need
+
+	Throws an error if fewer than n bytes remain.
+------------------------------------------------------------------------------*/
+void CacheReader::need(const std::size_t n) throw(std::string)
+{
+	if((std::size_t)(end - next) < n)
+	{
+		throw(std::string("unexpected end of file\n"));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	getInt
+
+	Reads an integer written by CacheWriter::putInt.
+------------------------------------------------------------------------------*/
+const int CacheReader::getInt() throw(std::string)
+{
+	need(4);
+	std::uint32_t u = 0;
+	for(int i = 0; i < 4; i++)
+	{
+		u |= (std::uint32_t)(unsigned char)*next++ << (8 * i);
+	}
+	return (int)u;
+}
+
+/*------------------------------------------------------------------------------
+	getBool
+
+	Reads a boolean written by CacheWriter::putBool.
+------------------------------------------------------------------------------*/
+const bool CacheReader::getBool() throw(std::string)
+{
+	need(1);
+	return *next++ != 0;
+}
+
+/*------------------------------------------------------------------------------
+	getString
+
+	Reads a string written by CacheWriter::putString.
+------------------------------------------------------------------------------*/
+const std::string CacheReader::getString() throw(std::string)
+{
+	int size = getInt();
+	if(size < 0)
+	{
+		throw(std::string("value out of range\n"));
+	}
+	need(size);
+	std::string s(next, size);
+	next += size;
+	return s;
+}
+
+/*------------------------------------------------------------------------------
+	getFloat
+
+	Reads a float written by CacheWriter::putFloat.
+------------------------------------------------------------------------------*/
+const float CacheReader::getFloat() throw(std::string)
+{
+	std::uint32_t u = (std::uint32_t)getInt();
+	float f;
+	std::memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+/*------------------------------------------------------------------------------
+	getIndex
+
+	Reads an integer in the range [minimum, limit).
+------------------------------------------------------------------------------*/
+const int CacheReader::getIndex(const int limit, const int minimum)
+	throw(std::string)
+{
+	int n = getInt();
+	if(n < minimum || n >= limit)
+	{
+		throw(std::string("value out of range\n"));
+	}
+	return n;
+}
+
+/*------------------------------------------------------------------------------
+	expectBytes
+
+	Reads bytes, throwing an error if they differ from the given bytes.
+------------------------------------------------------------------------------*/
+void CacheReader::expectBytes(const std::string& s) throw(std::string)
+{
+	if((std::size_t)(end - next) < s.size()
+		|| s.compare(0, s.size(), next, s.size()) != 0)
+	{
+		throw(std::string("not a cache file\n"));
+	}
+	next += s.size();
+}
+
+/*------------------------------------------------------------------------------
+	Constructor
+------------------------------------------------------------------------------*/
+CacheHash::CacheHash() : value(FNV_OFFSET_BASIS) {}
+
+/*------------------------------------------------------------------------------
+	addBytes
+
+	Adds bytes to the hash.
+------------------------------------------------------------------------------*/
+void CacheHash::addBytes(const char* data, const std::size_t size)
+{
+	for(std::size_t i = 0; i < size; i++)
+	{
+		value = (value ^ (unsigned char)data[i]) * FNV_PRIME;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	addString
+
+	Adds a string, followed by a separator, to the hash.
+------------------------------------------------------------------------------*/
+void CacheHash::addString(const std::string& s)
+{
+	addBytes(s.data(), s.size());
+	addBytes("", 1);
+}
+
+/*------------------------------------------------------------------------------
+	addFile
+
+	Adds the size and contents of a file to the hash.
+------------------------------------------------------------------------------*/
+void CacheHash::addFile(const std::string& filename) throw(std::string)
+{
+	FileSource source(filename, true);
+	if(!source.isOpen())
+	{
+		throw("error loading file \'" + filename + "\'\n");
+	}
+	addString(integerToString(source.size()));
+	addBytes(source.getData(), source.size());
+}
+
+/*------------------------------------------------------------------------------
+	addParseOptions
+
+	Adds the options affecting how rules are parsed, and the resolution
+	policy file, to the hash.
+------------------------------------------------------------------------------*/
+void CacheHash::addParseOptions() throw(std::string)
+{
+	// the answers of the policy replace the user's disambiguation decisions
+	if(!g_resolution_policy_file.empty())
+	{
+		addFile(g_resolution_policy_file);
+	}
+	addString(integerToString(g_string_matching_threshhold));
+	addString(std::string() + (g_no_prompt_case_insensitivity ? "1" : "0")
+		+ (g_no_prompt_identifier_matching ? "1" : "0")
+		+ (g_disallow_true_false_enum ? "1" : "0")
+		+ (g_flatten_behaviours ? "1" : "0"));
+}
+
+/*------------------------------------------------------------------------------
+	put
+
+	Appends the hash to a cache file.
+------------------------------------------------------------------------------*/
+void CacheHash::put(CacheWriter& writer) const
+{
+	writer.putInt((int)(std::uint32_t)value);
+	writer.putInt((int)(std::uint32_t)(value >> 32));
+}
+
+/*------------------------------------------------------------------------------
+	check
+
+	Reads a hash appended by put, returning true if it equals this hash.
+------------------------------------------------------------------------------*/
+const bool CacheHash::check(CacheReader& reader) const throw(std::string)
+{
+	std::uint32_t low = (std::uint32_t)reader.getInt();
+	std::uint32_t high = (std::uint32_t)reader.getInt();
+	return low == (std::uint32_t)value && high == (std::uint32_t)(value >> 32);
+}
+
+/*------------------------------------------------------------------------------
+	getFilename
+
+	Returns the name of a file in a directory, named by the hash.
+------------------------------------------------------------------------------*/
+const std::string CacheHash::getFilename(const std::string& directory,
+	const std::string& extension) const
+{
+	std::stringstream stream;
+	stream << directory;
+	if(!directory.empty() && directory.back() != '/'
+		&& directory.back() != '\\')
+	{
+		stream << "/";
+	}
+	stream << std::hex << std::setw(16) << std::setfill('0') << value
+		<< extension;
+	return stream.str();
+}
@@ -28,8 +28,11 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <algorithm>
+#include <cstddef>
 #include <iostream>
+#include <list>
 #include <locale>
+#include <vector>
 
 #include "global.h"
 #include "utility.h"
@@ -38,22 +41,7 @@
 #include "intermediate/action_execute_non_deterministic.h"
 #include "intermediate/behaviour.h"
 #include "intermediate/intermediate_form.h"
-
-IntermediateForm::~IntermediateForm()
-{
-	for(PropVariable* p : prop_variables)
-	{
-		delete p;
-	}
-	for(EnumVariable* e : enum_variables)
-	{
-		delete e;
-	}
-	for(Behaviour* b : behaviours)
-	{
-		delete b;
-	}
-}
+#include "resolution_policy/resolution_policy.h"
 
 /*------------------------------------------------------------------------------
 	getPropVariableByName
@@ -64,7 +52,7 @@ IntermediateForm::~IntermediateForm()
 PropVariable* IntermediateForm::getPropVariableByName(const std::string& name,
 		const std::string& info)
 {
-	return getByName<PropVariable>(prop_variables, name,
+	return getByName<PropVariable>(prop_variables, prop_variable_index, name,
 		"propositional variable", info);
 }
 
@@ -77,7 +65,7 @@ PropVariable* IntermediateForm::getPropVariableByName(const std::string& name,
 EnumVariable* IntermediateForm::getEnumVariableByName(const std::string& name,
 	const std::string& info)
 {
-	return getByName<EnumVariable>(enum_variables, name,
+	return getByName<EnumVariable>(enum_variables, enum_variable_index, name,
 		"enumerated variable", info);
 }
 
@@ -90,31 +78,77 @@ EnumVariable* IntermediateForm::getEnumVariableByName(const std::string& name,
 Behaviour* IntermediateForm::getBehaviourByName(const std::string& name,
 	const std::string& info)
 {
-	return getByName<Behaviour>(behaviours, name,
+	return getByName<Behaviour>(behaviours, behaviour_index, name,
 		"behaviour", info);
 }
 
+/*------------------------------------------------------------------------------
+	findPropVariable, findEnumVariable, findBehaviour
+
+	Return the propositional variable, enumerated variable or behaviour with
+	exactly the given name, or nullptr.
+------------------------------------------------------------------------------*/
+PropVariable* IntermediateForm::findPropVariable(const std::string& name)
+{
+	return prop_variable_index.getExactMatch(prop_variables, name);
+}
+
+EnumVariable* IntermediateForm::findEnumVariable(const std::string& name)
+{
+	return enum_variable_index.getExactMatch(enum_variables, name);
+}
+
+Behaviour* IntermediateForm::findBehaviour(const std::string& name)
+{
+	return behaviour_index.getExactMatch(behaviours, name);
+}
+
+/*------------------------------------------------------------------------------
+	addBehaviour
+
+	Adds a new behaviour.
+------------------------------------------------------------------------------*/
+void IntermediateForm::addBehaviour(Behaviour* b)
+{
+	b->setId(behaviours.size());
+	behaviours.push_back(b);
+	behaviour_index.insert(b);
+}
+
+/*------------------------------------------------------------------------------
+	replaceBehaviour
+
+	Replaces the behaviour with the given id.
+------------------------------------------------------------------------------*/
+void IntermediateForm::replaceBehaviour(const int id, Behaviour* b)
+{
+	b->setId(id);
+	behaviours[id] = b;
+	behaviour_index.invalidate();
+}
+
 /*------------------------------------------------------------------------------
 	disambiguationPrompt
 
 	Prompts the user to disambiguate the name of a given precondition,
 	action or behaviour.
 ------------------------------------------------------------------------------*/
-const int IntermediateForm::disambiguationPrompt(
+const int IntermediateForm::disambiguationPrompt(const std::string& name,
 	const std::string& existing_name, const std::string& type)
+		throw(std::string)
 {
 	std::cout << "existing " << type << " \'" << existing_name << "\'\n"
 		<< "\tr: replace existing " << type << " name\n"
 		<< "\tu: use existing " << type << " name\n"
 		<< "\ti: ignore match\n";
-	std::string input = "";
-	while(input != "r" && input != "u" && input != "i"
-		&& input != "R" && input != "U" && input != "I")
-	{
-		std::cout << "\tenter selection: ";
-		std::cin >> input;
-		std::cin.clear();
-	}
+	std::vector<std::string> key = {type, name, existing_name};
+	const std::string input = g_resolution_policy.prompt(
+		PROMPT_IDENTIFIER_MATCH, key, "\tenter selection: ",
+		[](const std::string& s)
+		{
+			return s == "r" || s == "u" || s == "i"
+				|| s == "R" || s == "U" || s == "I";
+		});
 	if(input == "r" || input == "R")
 	{
 		return DISAMBIGUATION_REPLACE_EXISTING;
@@ -136,21 +170,21 @@ const int IntermediateForm::disambiguationPrompt(
 		preconditions.
 ------------------------------------------------------------------------------*/
 const int IntermediateForm::noPreconditionPrompt(
-	const std::string& behaviour_name)
+	const std::string& behaviour_name) throw(std::string)
 {
 	std::cout << "schedulable behaviour \'" << behaviour_name
 		<< "\' has no preconditions\n"
 		<< "\ti: ignore and continue\n"
 		<< "\tr: remove behaviour\n"
 		<< "\tf: flag behaviour as non-schedulable\n";
-	std::string input = "";
-	while(input != "i" && input != "r" && input != "f"
-		&& input != "I" && input != "R" && input != "F")
-	{
-		std::cout << "\tenter selection: ";
-		std::cin >> input;
-		std::cin.clear();
-	}
+	std::vector<std::string> key = {behaviour_name};
+	const std::string input = g_resolution_policy.prompt(
+		PROMPT_NO_PRECONDITIONS, key, "\tenter selection: ",
+		[](const std::string& s)
+		{
+			return s == "i" || s == "r" || s == "f"
+				|| s == "I" || s == "R" || s == "F";
+		});
 	if(input == "i" || input == "I")
 	{
 		return NO_PRECONDITIONS_IGNORE;
@@ -173,30 +207,15 @@ const int IntermediateForm::noPreconditionPrompt(
 		prompted when ambiguity or case-insensitive matches are encountered.
 ------------------------------------------------------------------------------*/
 template<typename T>
-T* IntermediateForm::getByName(std::list<T*>& instances, const std::string& name,
-	const std::string& type, const std::string& info)
+T* IntermediateForm::getByName(std::vector<T*>& instances, NameIndex<T>& index,
+	const std::string& name, const std::string& type, const std::string& info)
 {
-	T* case_insensitive_match = nullptr;
+	T* case_insensitive_match = index.getCaseInsensitiveMatch(instances, name);
 	std::list<std::pair<T*, const int>> similarity_matches;
-	std::for_each(instances.begin(), instances.end(),
-		[&](T* variable)
-		{
-			if(caseInsensitiveCompare(variable->getName(), name))
-			{
-				// a case-insensitive match has been found
-				case_insensitive_match = variable;
-			}
-			else
-			{
-				auto pair = compareStrings(variable->getName(), name);
-				if(pair.second >= g_string_matching_threshhold)
-				{
-					// a match has been found
-					similarity_matches.push_back(std::pair<T*,
-						const int>(variable, pair.second));
-				}
-			}
-		});
+	if(case_insensitive_match == nullptr)
+	{
+		index.getSimilarityMatches(instances, name, similarity_matches);
+	}
 
 	if(case_insensitive_match != nullptr)
 	{
@@ -210,11 +229,12 @@ T* IntermediateForm::getByName(std::list<T*>& instances, const std::string& name
 					or to simply ignore the match and treat both
 					identifiers as being distinct */
 				displayTitle(DIVIDER_DISAMBIGUATION, DIVIDER_2, info);
-				switch(disambiguationPrompt(case_insensitive_match->getName(),
-					type))
+				switch(disambiguationPrompt(name,
+					case_insensitive_match->getName(), type))
 				{
 				case DISAMBIGUATION_REPLACE_EXISTING:
 					case_insensitive_match->setName(name);
+					index.invalidate();
 					return case_insensitive_match;
 					break;
 
@@ -276,11 +296,12 @@ T* IntermediateForm::getByName(std::list<T*>& instances, const std::string& name
 					std::cout << "match " << count << " of "
 						<< similarity_matches.size() << " ("
 						<< matched_pair.second << "% similarity)\n";
-					switch(disambiguationPrompt(matched_pair.first->getName(),
-						type))
+					switch(disambiguationPrompt(name,
+						matched_pair.first->getName(), type))
 					{
 					case DISAMBIGUATION_REPLACE_EXISTING:
 						matched_pair.first->setName(name);
+						index.invalidate();
 						return matched_pair.first;
 						break;
 
@@ -329,6 +350,7 @@ T* IntermediateForm::getByName(std::list<T*>& instances, const std::string& name
 					std::cout << "new identifier contains less whitespace: "
 						<< "replacing original identifier\n";
 					first_pair.first->setName(name);
+					index.invalidate();
 				}
 				return first_pair.first;
 			}
@@ -357,79 +379,103 @@ T* IntermediateForm::getByName(std::list<T*>& instances, const std::string& name
 ------------------------------------------------------------------------------*/
 void IntermediateForm::flattenNestedBehaviourExecutions()
 {
+	// the behaviours of higher id have not been flattened yet
+	const std::map<int, std::vector<Action*>> none;
 	for(Behaviour* behaviour : behaviours)
 	{
-		bool expanded;
-		do
+		flattenNestedBehaviourExecutions(behaviour, none);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	flattenNestedBehaviourExecutions
+
+	Flattens the nested executions of a single behaviour, as they are
+	flattened when every behaviour is flattened in order of id.
+------------------------------------------------------------------------------*/
+void IntermediateForm::flattenNestedBehaviourExecutions(Behaviour* behaviour,
+	const std::map<int, std::vector<Action*>>& unflattened_actions)
+{
+	std::vector<Action*>& actions = behaviour->actions;
+	bool expanded;
+	do
+	{
+		expanded = false;
+		std::size_t i = 0;
+		while(i < actions.size())
 		{
-			expanded = false;
-			auto action_it = behaviour->actions.begin();
-			auto action_end = behaviour->actions.end();
-			while(action_it != action_end)
+			Action* action = actions[i];
+			if(action->getActionType() == ActionType::EXECUTE)
 			{
-				Action* action = *action_it;
-				if(action->getActionType() == ActionType::EXECUTE)
+				ActionExecute* action_ex = (ActionExecute*)action;
+				Behaviour* behaviour_ex =
+					getBehaviour(action_ex->getBehaviourId());
+				/*	if this behaviour is not interruptible, or if
+					the executed behaviour is interruptible, then
+					we can substitute the actions of the executed
+					behaviour into this behaviour */
+				if(!behaviour->isInterruptible()
+					|| behaviour_ex->isInterruptible())
 				{
-					ActionExecute* action_ex = (ActionExecute*)action;
-					Behaviour* behaviour_ex = getBehaviourByName(
-						action_ex->getBehaviour(), "");
-					/*	if this behaviour is not interruptible, or if
-						the executed behaviour is interruptible, then
-						we can substitute the actions of the executed
-						behaviour into this behaviour */
-					if(!behaviour->isInterruptible()
-						|| behaviour_ex->isInterruptible())
+					expanded = true;
+					actions.erase(actions.begin() + i);
+					// copy the executed actions after the erasure, the
+					// executed behaviour may be this behaviour
+					std::vector<Action*> actions_ex =
+						behaviour_ex->getActions();
+					auto it = unflattened_actions.find(behaviour_ex->getId());
+					if(behaviour_ex->getId() > behaviour->getId()
+						&& it != unflattened_actions.end())
 					{
-						expanded = true;
-						action_it = behaviour->actions.erase(action_it);
-						std::list<Action*> actions_ex =
-							behaviour_ex->getActions();
-						int order = action_ex->getActionOrder();
-						int num_actions = actions_ex.size();
-						auto action_it_copy = action_it;
-						while(action_it_copy != action_end)
-						{
-							Action* a = *action_it_copy;
-							a->setActionOrder(a->getActionOrder()
-								+ num_actions);
-							action_it_copy++;
-						}
-						for(Action* a : actions_ex)
-						{
-							Action* copy = a->clone();
-							copy->setActionOrder(order++);
-							behaviour->addAction(copy);
-						}
-						delete action_ex;
+						actions_ex = it->second;
 					}
-					else
+					int order = action_ex->getActionOrder();
+					int num_actions = actions_ex.size();
+					for(std::size_t j = i; j < actions.size(); j++)
 					{
-						action_it++;
+						actions[j]->setActionOrder(
+							actions[j]->getActionOrder() + num_actions);
 					}
+					/*	the copies take the place of the erased action,
+						which keeps the actions sorted by action order */
+					std::vector<Action*> copies;
+					for(Action* a : actions_ex)
+					{
+						Action* copy = a->clone(arena);
+						copy->setActionOrder(order++);
+						copies.push_back(copy);
+					}
+					actions.insert(actions.begin() + i, copies.begin(),
+						copies.end());
+					i += copies.size();
 				}
 				else
 				{
-					action_it++;
+					i++;
 				}
 			}
-		} while (expanded);
-	}
+			else
+			{
+				i++;
+			}
+		}
+	} while (expanded);
 }
 
 /*------------------------------------------------------------------------------
 	validateBehaviours
 
-	Firstly, ensures that all behaviour executions reference existing
-	behaviours. Secondly, prompts the user to decide how to interpret
-	behaviours with no preconditions.
+	Firstly, prompts the user to decide how to interpret behaviours with no
+	preconditions. Secondly, ensures that all behaviour executions reference
+	existing behaviours, and resolves the id of each executed behaviour.
 ------------------------------------------------------------------------------*/
 void IntermediateForm::validateBehaviours() throw (std::string)
 {
 	auto b_it = behaviours.begin();
-	auto b_end = behaviours.end();
-	while(b_it != b_end)
+	while(b_it != behaviours.end())
 	{
 		Behaviour* b = *b_it;
+		bool removed = false;
 		if(b->isSchedulable() && b->getPreconditions().empty())
 		{
 			displayTitle(DIVIDER_NO_PRECONDITIONS, DIVIDER_2,
@@ -443,7 +489,8 @@ void IntermediateForm::validateBehaviours() throw (std::string)
 
 			case NO_PRECONDITIONS_REMOVE:
 				b_it = behaviours.erase(b_it);
-				delete b;
+				behaviour_index.invalidate();
+				removed = true;
 				break;
 
 			case NO_PRECONDITIONS_SET_NON_SCHEDULABLE:
@@ -451,16 +498,24 @@ void IntermediateForm::validateBehaviours() throw (std::string)
 				break;
 			}
 		}
-		b_it++;
+		if(!removed)
+		{
+			b_it++;
+		}
+	}
+	// removing behaviours shifts the position of any that follow them
+	for(std::size_t id = 0; id < behaviours.size(); id++)
+	{
+		behaviours[id]->setId(id);
 	}
 	b_it = behaviours.begin();
-	b_end = behaviours.end();
+	auto b_end = behaviours.end();
 	while(b_it != b_end)
 	{
 		Behaviour* b = *b_it;
 		try
 		{
-			auto actions = b->getActions();
+			const std::vector<Action*>& actions = b->getActions();
 			auto it = actions.begin();
 			auto end = actions.end();
 			if(actions.empty())
@@ -489,18 +544,17 @@ void IntermediateForm::validateBehaviours() throw (std::string)
 						throw(stream.str());
 					}
 					a_ex->setBehaviour(b->getName());
+					a_ex->setBehaviourId(b->getId());
 				}
 				else if(a->getActionType() == ActionType::EXECUTE_NON_D)
 				{
 					ActionExecuteNonDeterministic* a_ex_non_d =
 						(ActionExecuteNonDeterministic*)a;
-					std::list<std::string> behaviour_values =
+					const std::vector<std::string>& behaviour_values =
 						a_ex_non_d->getBehaviourValues();
-					auto b_it = behaviour_values.begin();
-					auto b_end = behaviour_values.end();
-					while(b_it != b_end)
+					for(std::size_t i = 0; i < behaviour_values.size(); i++)
 					{
-						std::string behaviour = *b_it;
+						std::string behaviour = behaviour_values[i];
 						std::stringstream info_stream;
 						info_stream	<< "disambiguation of executable behaviour name \'"
 							<< behaviour << "\' "
@@ -517,9 +571,8 @@ void IntermediateForm::validateBehaviours() throw (std::string)
 								<< *a_ex_non_d << std::endl;
 							throw(stream.str());
 						}
-						a_ex_non_d->updateBehaviourName(behaviour,
-							b->getName());
-						b_it++;
+						a_ex_non_d->resolveBehaviourValue(i, b->getName(),
+							b->getId());
 					}
 				}
 				it++;
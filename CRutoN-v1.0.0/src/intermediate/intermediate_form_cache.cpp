@@ -0,0 +1,518 @@
+/*==============================================================================
+	IntermediateFormCache
+
+	Implementation of intermediate_form_cache.h.
+
+	File			: intermediate_form_cache.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <list>
+#include <string>
+#include <vector>
+
+#include "global.h"
+#include "utility.h"
+#include "intermediate/action_enum_value_assignment.h"
+#include "intermediate/action_execute.h"
+#include "intermediate/action_execute_non_deterministic.h"
+#include "intermediate/action_prop_value_assignment.h"
+#include "intermediate/action_wait.h"
+#include "intermediate/behaviour.h"
+#include "intermediate/intermediate_form.h"
+#include "intermediate/intermediate_form_cache.h"
+#include "intermediate/precondition_enum_value_check.h"
+#include "intermediate/precondition_prop_value_check.h"
+#include "intermediate/precondition_timing_constraint.h"
+#include "intermediate_parser/file_source.h"
+
+const std::string IntermediateFormCache::MAGIC = "CRUTONIF";
+const int IntermediateFormCache::FORMAT_VERSION = 2;
+const std::string IntermediateFormCache::EXTENSION = ".ifc";
+
+/*------------------------------------------------------------------------------
+	encodePrecondition
+
+	Appends the encoding of a precondition to a cache file. Variables are
+	encoded by id.
+------------------------------------------------------------------------------*/
+void IntermediateFormCache::encodePrecondition(Precondition* precondition,
+	CacheWriter& writer)
+{
+	writer.putInt(precondition->getPreconditionType());
+	writer.putInt(precondition->getTimeConstraintType());
+	writer.putInt(precondition->getTimeConstraintSeconds());
+	writer.putInt(precondition->getPreconditionOrder());
+	writer.putInt(precondition->getAndOrConnector());
+	writer.putInt(precondition->getNotConnector());
+	switch(precondition->getPreconditionType())
+	{
+	case PROP_VALUE_CHECK:
+	{
+		PreconditionPropValueCheck* p =
+			static_cast<PreconditionPropValueCheck*>(precondition);
+		writer.putInt(p->getPropVariable()->getId());
+		writer.putBool(p->getTruthValue());
+		break;
+	}
+	case ENUM_VALUE_CHECK:
+	{
+		PreconditionEnumValueCheck* p =
+			static_cast<PreconditionEnumValueCheck*>(precondition);
+		writer.putInt(p->getEnumVariable()->getId());
+		writer.putString(p->getEnumValue());
+		break;
+	}
+	case TIMING_CONSTRAINT:
+	{
+		PreconditionTimingConstraint* p =
+			static_cast<PreconditionTimingConstraint*>(precondition);
+		writer.putString(p->getStartTime());
+		writer.putString(p->getEndTime());
+		break;
+	}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	decodePrecondition
+
+	Constructs a precondition from its encoding, in the arena of the given
+	intermediate form.
+------------------------------------------------------------------------------*/
+static Precondition* decodePrecondition(CacheReader& reader,
+	IntermediateForm* intermediate_form) throw(std::string)
+{
+	int type = reader.getIndex(TIMING_CONSTRAINT + 1);
+	TimeConstraintType time_constraint_type =
+		(TimeConstraintType)reader.getIndex(WAS_IN_STATE_WITHIN + 1);
+	int time_constraint_seconds = reader.getInt();
+	int order = reader.getInt();
+	int and_or_connector = reader.getInt();
+	int not_connector = reader.getInt();
+	Precondition* precondition = nullptr;
+	switch(type)
+	{
+	case PROP_VALUE_CHECK:
+	{
+		PropVariable* p = intermediate_form->getPropVariables()[
+			reader.getIndex(intermediate_form->getPropVariables().size())];
+		bool truth_value = reader.getBool();
+		precondition = intermediate_form->create<PreconditionPropValueCheck>(p,
+			truth_value, time_constraint_type, time_constraint_seconds);
+		break;
+	}
+	case ENUM_VALUE_CHECK:
+	{
+		EnumVariable* e = intermediate_form->getEnumVariables()[
+			reader.getIndex(intermediate_form->getEnumVariables().size())];
+		std::string value = reader.getString();
+		precondition = intermediate_form->create<PreconditionEnumValueCheck>(e,
+			value, time_constraint_type, time_constraint_seconds);
+		break;
+	}
+	default:
+	{
+		std::string start_time = reader.getString();
+		std::string end_time = reader.getString();
+		precondition =
+			intermediate_form->create<PreconditionTimingConstraint>(
+				start_time, end_time, time_constraint_type,
+				time_constraint_seconds);
+		break;
+	}
+	}
+	precondition->setPreconditionOrder(order);
+	precondition->setAndOrConnector(and_or_connector);
+	precondition->setNotConnector(not_connector);
+	return precondition;
+}
+
+/*------------------------------------------------------------------------------
+	encodeAction
+
+	Appends the encoding of an action to a cache file. Variables are encoded by
+	id, and executed behaviours by both name and id.
+------------------------------------------------------------------------------*/
+void IntermediateFormCache::encodeAction(Action* action, CacheWriter& writer)
+{
+	writer.putInt(action->getActionType());
+	writer.putInt(action->getActionOrder());
+	switch(action->getActionType())
+	{
+	case PROP_VALUE_ASSIGNMENT:
+	{
+		ActionPropValueAssignment* a =
+			static_cast<ActionPropValueAssignment*>(action);
+		writer.putInt(a->getPropVariable()->getId());
+		writer.putBool(a->getTruthValue());
+		break;
+	}
+	case ENUM_VALUE_ASSIGNMENT:
+	{
+		ActionEnumValueAssignment* a =
+			static_cast<ActionEnumValueAssignment*>(action);
+		writer.putInt(a->getEnumVariable()->getId());
+		writer.putString(a->getEnumValue());
+		break;
+	}
+	case EXECUTE_NON_D:
+	{
+		ActionExecuteNonDeterministic* a =
+			static_cast<ActionExecuteNonDeterministic*>(action);
+		writer.putInt(a->getBehaviourValues().size());
+		for(std::size_t i = 0; i < a->getBehaviourValues().size(); i++)
+		{
+			writer.putString(a->getBehaviourValues()[i]);
+			writer.putInt(a->getBehaviourIds()[i]);
+		}
+		break;
+	}
+	case EXECUTE:
+	{
+		ActionExecute* a = static_cast<ActionExecute*>(action);
+		writer.putString(a->getBehaviour());
+		writer.putInt(a->getBehaviourId());
+		break;
+	}
+	case WAIT:
+		writer.putFloat(static_cast<ActionWait*>(action)->getWaitSeconds());
+		break;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	decodeAction
+
+	Constructs an action from its encoding, in the arena of the given
+	intermediate form. Behaviour ids, which are -1 if unresolved, are checked
+	against the number of behaviours, as the behaviours executed may not
+	have been decoded yet.
+------------------------------------------------------------------------------*/
+Action* IntermediateFormCache::decodeAction(CacheReader& reader,
+	IntermediateForm* intermediate_form, const int num_behaviours)
+		throw(std::string)
+{
+	int type = reader.getIndex(WAIT + 1);
+	int order = reader.getInt();
+	switch(type)
+	{
+	case PROP_VALUE_ASSIGNMENT:
+	{
+		PropVariable* p = intermediate_form->getPropVariables()[
+			reader.getIndex(intermediate_form->getPropVariables().size())];
+		bool truth_value = reader.getBool();
+		return intermediate_form->create<ActionPropValueAssignment>(p,
+			truth_value, order);
+	}
+	case ENUM_VALUE_ASSIGNMENT:
+	{
+		EnumVariable* e = intermediate_form->getEnumVariables()[
+			reader.getIndex(intermediate_form->getEnumVariables().size())];
+		std::string value = reader.getString();
+		return intermediate_form->create<ActionEnumValueAssignment>(e, value,
+			order);
+	}
+	case EXECUTE_NON_D:
+	{
+		ActionExecuteNonDeterministic* a =
+			intermediate_form->create<ActionExecuteNonDeterministic>(order);
+		int num_values = reader.getInt();
+		std::vector<std::string> values;
+		std::vector<int> ids;
+		for(int i = 0; i < num_values; i++)
+		{
+			values.push_back(reader.getString());
+			ids.push_back(reader.getIndex(num_behaviours, -1));
+		}
+		a->setBehaviourValues(values, ids);
+		return a;
+	}
+	case EXECUTE:
+	{
+		std::string behaviour = reader.getString();
+		ActionExecute* a = intermediate_form->create<ActionExecute>(behaviour,
+			order);
+		a->setBehaviourId(reader.getIndex(num_behaviours, -1));
+		return a;
+	}
+	default:
+		return intermediate_form->create<ActionWait>(reader.getFloat(),
+			order);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	encodeIntermediateForm
+
+	Appends the encoding of the variables and behaviours of an intermediate
+	form to a cache file.
+------------------------------------------------------------------------------*/
+void IntermediateFormCache::encodeIntermediateForm(
+	const IntermediateForm& intermediate_form, CacheWriter& writer)
+{
+	writer.putInt(intermediate_form.getPropVariables().size());
+	for(PropVariable* p : intermediate_form.getPropVariables())
+	{
+		writer.putString(p->getName());
+		writer.putBool(p->isNonDeterministic());
+	}
+	writer.putInt(intermediate_form.getEnumVariables().size());
+	for(EnumVariable* e : intermediate_form.getEnumVariables())
+	{
+		writer.putString(e->getName());
+		std::list<std::string> values = e->getValues();
+		writer.putInt(values.size());
+		for(const std::string& value : values)
+		{
+			writer.putString(value);
+		}
+		writer.putBool(e->resets());
+		writer.putBool(e->hasNoneValue());
+		writer.putBool(e->isNonDeterministic());
+	}
+	writer.putInt(intermediate_form.getBehaviours().size());
+	for(Behaviour* b : intermediate_form.getBehaviours())
+	{
+		writer.putString(b->getName());
+		writer.putInt(b->getPriority());
+		writer.putBool(b->isInterruptible());
+		writer.putBool(b->isSchedulable());
+		writer.putInt(b->getPreconditions().size());
+		for(Precondition* precondition : b->getPreconditions())
+		{
+			encodePrecondition(precondition, writer);
+		}
+		writer.putInt(b->getActions().size());
+		for(Action* action : b->getActions())
+		{
+			encodeAction(action, writer);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	decodeIntermediateForm
+
+	Constructs an intermediate form from the encoding of its variables and
+	behaviours, and builds the logical expression trees of the behaviours.
+------------------------------------------------------------------------------*/
+IntermediateForm* IntermediateFormCache::decodeIntermediateForm(
+	CacheReader& reader) throw(std::string)
+{
+	IntermediateForm* intermediate_form = new IntermediateForm();
+	try
+	{
+		int num_prop_variables = reader.getInt();
+		for(int i = 0; i < num_prop_variables; i++)
+		{
+			std::string name = reader.getString();
+			bool non_deterministic = reader.getBool();
+			intermediate_form->addPropVariable(
+				intermediate_form->create<PropVariable>(name,
+					non_deterministic));
+		}
+		int num_enum_variables = reader.getInt();
+		for(int i = 0; i < num_enum_variables; i++)
+		{
+			EnumVariable* e = intermediate_form->create<EnumVariable>(
+				reader.getString());
+			int num_values = reader.getInt();
+			for(int j = 0; j < num_values; j++)
+			{
+				e->addValue(reader.getString());
+			}
+			if(reader.getBool())
+			{
+				e->setResets();
+			}
+			if(reader.getBool())
+			{
+				e->setHasNoneValue();
+			}
+			if(reader.getBool())
+			{
+				e->setNonDeterministic();
+			}
+			intermediate_form->addEnumVariable(e);
+		}
+		int num_behaviours = reader.getInt();
+		for(int i = 0; i < num_behaviours; i++)
+		{
+			std::string name = reader.getString();
+			int priority = reader.getInt();
+			bool interruptible = reader.getBool();
+			bool schedulable = reader.getBool();
+			Behaviour* b = intermediate_form->create<Behaviour>(name, priority,
+				interruptible, schedulable);
+			int num_preconditions = reader.getInt();
+			for(int j = 0; j < num_preconditions; j++)
+			{
+				b->addPrecondition(decodePrecondition(reader,
+					intermediate_form));
+			}
+			int num_actions = reader.getInt();
+			for(int j = 0; j < num_actions; j++)
+			{
+				b->addAction(decodeAction(reader, intermediate_form,
+					num_behaviours));
+			}
+			intermediate_form->addBehaviour(b);
+		}
+		// the trees are not stored, being built from the preconditions
+		for(Behaviour* b : intermediate_form->getBehaviours())
+		{
+			b->buildLogicalExpressionTree(intermediate_form->getArena());
+		}
+	}
+	catch(std::string& error)
+	{
+		delete intermediate_form;
+		throw(error);
+	}
+	return intermediate_form;
+}
+
+/*------------------------------------------------------------------------------
+	computeKey
+
+	Sets the key of the cache file from the contents of the given input
+	files, the resolution policy file, and the options affecting parsing.
+------------------------------------------------------------------------------*/
+void IntermediateFormCache::computeKey(const std::string& grammar_rule_file,
+	const std::string& data_rule_file, const std::string& control_rule_file)
+		throw(std::string)
+{
+	CacheHash hash;
+	hash.addString(MAGIC + integerToString(FORMAT_VERSION) + EXEC_VERSION);
+	hash.addFile(grammar_rule_file);
+	hash.addFile(data_rule_file);
+	hash.addFile(control_rule_file);
+	hash.addParseOptions();
+	key = hash;
+}
+
+/*------------------------------------------------------------------------------
+	getFilename
+
+	Returns the name of the cache file for the current key.
+------------------------------------------------------------------------------*/
+const std::string IntermediateFormCache::getFilename() const
+{
+	return key.getFilename(directory, EXTENSION);
+}
+
+/*------------------------------------------------------------------------------
+	load
+
+	Returns the intermediate form held in the cache file for the current key,
+	or nullptr if there is no such file.
+------------------------------------------------------------------------------*/
+IntermediateForm* IntermediateFormCache::load(
+	std::vector<std::pair<std::string, std::string>>& answers) const
+{
+	std::string filename = getFilename();
+	FileSource source(filename, true);
+	if(!source.isOpen())
+	{
+		return nullptr;
+	}
+	try
+	{
+		return decode(source.getData(), source.size(), answers);
+	}
+	catch(std::string& error)
+	{
+		displayWarning("ignoring invalid cache file \'" + filename + "\'\n"
+			+ error);
+		return nullptr;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	decode
+
+	Constructs the intermediate form held in the contents of a cache file.
+------------------------------------------------------------------------------*/
+IntermediateForm* IntermediateFormCache::decode(const char* data,
+	const std::size_t size,
+	std::vector<std::pair<std::string, std::string>>& answers) const
+		throw(std::string)
+{
+	CacheReader reader(data, size);
+	reader.expectBytes(MAGIC);
+	if(reader.getInt() != FORMAT_VERSION || !key.check(reader))
+	{
+		throw(std::string("cache file of a different version or key\n"));
+	}
+
+	IntermediateForm* intermediate_form = decodeIntermediateForm(reader);
+	try
+	{
+		answers.clear();
+		int num_answers = reader.getInt();
+		for(int i = 0; i < num_answers; i++)
+		{
+			std::string formatted_key = reader.getString();
+			answers.push_back(std::make_pair(formatted_key,
+				reader.getString()));
+		}
+		if(!reader.atEnd())
+		{
+			throw(std::string("unexpected data at end of file\n"));
+		}
+	}
+	catch(std::string& error)
+	{
+		delete intermediate_form;
+		throw(error);
+	}
+	return intermediate_form;
+}
+
+/*------------------------------------------------------------------------------
+	store
+
+	Writes an intermediate form, and the answers given while parsing it, to
+	the cache file for the current key.
+------------------------------------------------------------------------------*/
+void IntermediateFormCache::store(const IntermediateForm& intermediate_form,
+	const std::vector<std::pair<std::string, std::string>>& answers) const
+		throw(std::string)
+{
+	CacheWriter writer;
+	writer.putBytes(MAGIC);
+	writer.putInt(FORMAT_VERSION);
+	key.put(writer);
+	encodeIntermediateForm(intermediate_form, writer);
+	// the answers are recorded again when the cache file is loaded
+	writer.putInt(answers.size());
+	for(const std::pair<std::string, std::string>& answer : answers)
+	{
+		writer.putString(answer.first);
+		writer.putString(answer.second);
+	}
+	writer.writeToFile(getFilename());
+}
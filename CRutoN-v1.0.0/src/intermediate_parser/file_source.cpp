@@ -0,0 +1,130 @@
+/*==============================================================================
+	FileSource
+
+	File			: file_source.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "intermediate_parser/file_source.h"
+
+const std::string FileSource::STANDARD_INPUT = "-";
+
+FileSource::FileSource(const std::string& filename, const bool binary) :
+	is_open(false), mapped_data(nullptr), mapped_size(0)
+{
+	if(filename == STANDARD_INPUT)
+	{
+		buffer = std::string(std::istreambuf_iterator<char>(std::cin),
+			std::istreambuf_iterator<char>());
+		is_open = true;
+	}
+	else
+	{
+		is_open = mapFile(filename) || bufferFile(filename, binary);
+	}
+}
+
+FileSource::~FileSource()
+{
+#ifndef _WIN32
+	if(mapped_data != nullptr)
+	{
+		munmap(const_cast<char*>(mapped_data), mapped_size);
+	}
+#endif
+}
+
+/*------------------------------------------------------------------------------
+	mapFile
+
+	Attempts to memory map the given file. Returns true if successful.
+------------------------------------------------------------------------------*/
+bool FileSource::mapFile(const std::string& filename)
+{
+#ifndef _WIN32
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd == -1)
+	{
+		return false;
+	}
+	struct stat file_stat;
+	// only regular, non-empty files can be mapped
+	if(fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode)
+		|| file_stat.st_size == 0)
+	{
+		close(fd);
+		return false;
+	}
+	void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd,
+		0);
+	// the mapping remains valid after the descriptor is closed
+	close(fd);
+	if(data == MAP_FAILED)
+	{
+		return false;
+	}
+	madvise(data, file_stat.st_size, MADV_SEQUENTIAL);
+	mapped_data = static_cast<const char*>(data);
+	mapped_size = file_stat.st_size;
+	return true;
+#else
+	return false;
+#endif
+}
+
+/*------------------------------------------------------------------------------
+	bufferFile
+
+	Reads the given file into the buffer, in binary or text mode. Returns
+	true if successful.
+------------------------------------------------------------------------------*/
+bool FileSource::bufferFile(const std::string& filename, const bool binary)
+{
+	// text mode translates line endings where the platform does, e.g. CRLF
+	// on Windows. Files are only mapped where it changes nothing, so a mapped
+	// and a buffered rule file give the same lines
+	std::ifstream ifstream(filename,
+		binary ? std::ios::in | std::ios::binary : std::ios::in);
+	if(!ifstream)
+	{
+		return false;
+	}
+	buffer = std::string(std::istreambuf_iterator<char>(ifstream),
+		std::istreambuf_iterator<char>());
+	ifstream.close();
+	return true;
+}
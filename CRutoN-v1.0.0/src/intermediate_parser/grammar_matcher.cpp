@@ -0,0 +1,294 @@
+/*==============================================================================
+	GrammarMatcher
+
+	File			: grammar_matcher.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "intermediate_parser/any_text_symbol.h"
+#include "intermediate_parser/automaton.h"
+#include "intermediate_parser/grammar_matcher.h"
+#include "intermediate_parser/non_terminal_symbol.h"
+#include "intermediate_parser/terminal_symbol.h"
+#include "intermediate_parser/token_cursor.h"
+
+const int GrammarMatcher::ANY_TEXT = -1;
+
+/*------------------------------------------------------------------------------
+	addRule
+
+	Compiles the given grammar rule into the matcher.
+------------------------------------------------------------------------------*/
+void GrammarMatcher::addRule(NonTerminalSymbol* rule)
+{
+	int end = compileAutomaton(rule, 0);
+	nodes[end].accepting_rules.push_back(rule);
+}
+
+/*------------------------------------------------------------------------------
+	getCandidateRules
+
+	Returns the set of grammar rules that can accept the given line. This
+	is a superset of the rules that will accept the line when it is fed
+	to them token-by-token, so only these rules need to be fed the line.
+------------------------------------------------------------------------------*/
+const std::set<const NonTerminalSymbol*> GrammarMatcher::getCandidateRules(
+	const std::string& line) const
+{
+	std::set<const NonTerminalSymbol*> candidates;
+	std::vector<unsigned int> marks(nodes.size(), 0);
+	unsigned int mark = 1;
+	std::vector<int> states;
+	addEpsilonClosure(0, states, marks, mark);
+	TokenCursor cursor(line);
+	while(cursor.hasNextToken() && !states.empty())
+	{
+		std::string token = cursor.getNextToken().str();
+		// each typed edge is only checked once per token
+		std::vector<int> is_valid_for_prototype(prototypes.size(), -1);
+		std::vector<int> next_states;
+		mark++;
+		for(int state : states)
+		{
+			const Node& node = nodes[state];
+			auto it = node.terminal_edges.find(token);
+			if(it != node.terminal_edges.end())
+			{
+				addEpsilonClosure(it->second, next_states, marks, mark);
+			}
+			for(const std::pair<int, int>& edge : node.typed_edges)
+			{
+				bool is_valid = true;
+				if(edge.first != ANY_TEXT)
+				{
+					int& valid = is_valid_for_prototype[edge.first];
+					if(valid == -1)
+					{
+						valid = prototypes[edge.first]->wouldBeDead(token) ?
+							0 : 1;
+					}
+					is_valid = valid == 1;
+				}
+				if(is_valid)
+				{
+					addEpsilonClosure(edge.second, next_states, marks, mark);
+				}
+			}
+		}
+		states.swap(next_states);
+	}
+	for(int state : states)
+	{
+		candidates.insert(nodes[state].accepting_rules.begin(),
+			nodes[state].accepting_rules.end());
+	}
+	return candidates;
+}
+
+/*------------------------------------------------------------------------------
+	newNode
+
+	Adds a new state to the matcher and returns its index.
+------------------------------------------------------------------------------*/
+int GrammarMatcher::newNode(const bool is_trie_node)
+{
+	Node node;
+	node.is_trie_node = is_trie_node;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+/*------------------------------------------------------------------------------
+	compileAutomaton
+
+	Compiles the given automaton, including any repeats, starting from the
+	given state. Returns the index of the final state.
+------------------------------------------------------------------------------*/
+int GrammarMatcher::compileAutomaton(Automaton* automaton, const int from)
+{
+	int repeat = automaton->getRepeat();
+	if(repeat == Automaton::REPEAT_NONE)
+	{
+		return compileSingle(automaton, from);
+	}
+	else if(repeat == Automaton::REPEAT_ONE_OR_MORE)
+	{
+		// loop back through a state belonging only to this rule, so
+		// that no other rule sharing the trie can reach the loop
+		int loop = newNode(false);
+		nodes[from].epsilon_edges.push_back(loop);
+		int end = compileSingle(automaton, loop);
+		nodes[end].epsilon_edges.push_back(loop);
+		return end;
+	}
+	else
+	{
+		int end = from;
+		for(int i = 0; i < repeat; i++)
+		{
+			end = compileSingle(automaton, end);
+		}
+		return end;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	compileSingle
+
+	Compiles a single repetition of the given automaton starting from the
+	given state. Returns the index of the final state.
+------------------------------------------------------------------------------*/
+int GrammarMatcher::compileSingle(Automaton* automaton, const int from)
+{
+	NonTerminalSymbol* non_terminal =
+		dynamic_cast<NonTerminalSymbol*>(automaton);
+	if(non_terminal != nullptr)
+	{
+		// nested non-terminals are expanded in place
+		int end = from;
+		for(Automaton* sub_automaton : non_terminal->getAutomata())
+		{
+			end = compileAutomaton(sub_automaton, end);
+		}
+		return end;
+	}
+	else if(dynamic_cast<TerminalSymbol*>(automaton) != nullptr)
+	{
+		return addTerminalEdge(from, automaton->getName());
+	}
+	else if(dynamic_cast<AnyTextSymbol*>(automaton) != nullptr)
+	{
+		return addTypedEdge(from, ANY_TEXT);
+	}
+	else
+	{
+		return addTypedEdge(from, getPrototypeIndex(automaton));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	addTerminalEdge
+
+	Adds an edge labelled with the given terminal from the given state,
+	reusing an existing trie edge if possible. Returns the index of the
+	target state.
+------------------------------------------------------------------------------*/
+int GrammarMatcher::addTerminalEdge(const int from, const std::string& terminal)
+{
+	bool is_trie_node = nodes[from].is_trie_node;
+	if(is_trie_node)
+	{
+		auto it = nodes[from].terminal_edges.find(terminal);
+		if(it != nodes[from].terminal_edges.end())
+		{
+			return it->second;
+		}
+	}
+	int to = newNode(is_trie_node);
+	nodes[from].terminal_edges.insert(
+		std::pair<std::string, int>(terminal, to));
+	return to;
+}
+
+/*------------------------------------------------------------------------------
+	addTypedEdge
+
+	Adds an edge accepting tokens that are valid for the given prototype
+	from the given state, reusing an existing trie edge if possible.
+	Returns the index of the target state.
+------------------------------------------------------------------------------*/
+int GrammarMatcher::addTypedEdge(const int from, const int prototype)
+{
+	bool is_trie_node = nodes[from].is_trie_node;
+	if(is_trie_node)
+	{
+		for(const std::pair<int, int>& edge : nodes[from].typed_edges)
+		{
+			if(edge.first == prototype)
+			{
+				return edge.second;
+			}
+		}
+	}
+	int to = newNode(is_trie_node);
+	nodes[from].typed_edges.push_back(std::pair<int, int>(prototype, to));
+	return to;
+}
+
+/*------------------------------------------------------------------------------
+	getPrototypeIndex
+
+	Returns the index of the prototype for the given predefined automaton,
+	adding a new prototype if one does not already exist.
+------------------------------------------------------------------------------*/
+int GrammarMatcher::getPrototypeIndex(Automaton* automaton)
+{
+	for(unsigned int i = 0; i < prototypes.size(); i++)
+	{
+		if(prototypes[i]->getName() == automaton->getName())
+		{
+			return i;
+		}
+	}
+	Automaton* prototype = automaton->getCopy();
+	prototype->setRepeat(Automaton::REPEAT_NONE);
+	prototype->resetSymbol();
+	prototypes.push_back(prototype);
+	return prototypes.size() - 1;
+}
+
+/*------------------------------------------------------------------------------
+	addEpsilonClosure
+
+	Adds the given state, and all states reachable from it by epsilon
+	edges, to the set of states.
+------------------------------------------------------------------------------*/
+void GrammarMatcher::addEpsilonClosure(const int node,
+	std::vector<int>& states, std::vector<unsigned int>& marks,
+	const unsigned int mark) const
+{
+	std::vector<int> stack;
+	stack.push_back(node);
+	while(!stack.empty())
+	{
+		int state = stack.back();
+		stack.pop_back();
+		if(marks[state] == mark)
+		{
+			continue;
+		}
+		marks[state] = mark;
+		states.push_back(state);
+		for(int next : nodes[state].epsilon_edges)
+		{
+			stack.push_back(next);
+		}
+	}
+}
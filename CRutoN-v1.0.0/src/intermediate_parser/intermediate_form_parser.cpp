@@ -28,13 +28,16 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <algorithm>
-#include <fstream>
+#include <atomic>
 #include <iostream>
+#include <map>
+#include <set>
 #include <sstream>
-#include <streambuf>
 #include <string>
+#include <thread>
 #include <vector>
 
+#include "global.h"
 #include "utility.h"
 #include "enums/time_constraint_type.h"
 #include "enums/tree_node_type.h"
@@ -43,6 +46,7 @@
 #include "intermediate/action_execute_non_deterministic.h"
 #include "intermediate/action_enum_value_assignment.h"
 #include "intermediate/action_prop_value_assignment.h"
+#include "intermediate/intermediate_form_cache.h"
 #include "intermediate/precondition_prop_value_check.h"
 #include "intermediate/precondition_enum_value_check.h"
 #include "intermediate/precondition_timing_constraint.h"
@@ -50,9 +54,14 @@
 #include "intermediate/tree_node.h"
 #include "intermediate_parser/intermediate_form_parser.h"
 #include "intermediate_parser/automaton.h"
+#include "intermediate_parser/file_source.h"
 #include "intermediate_parser/non_terminal_symbol.h"
+#include "intermediate_parser/previous_run_cache.h"
 #include "intermediate_parser/terminal_symbol.h"
+#include "intermediate_parser/token_cursor.h"
 #include "intermediate_parser/tokenize.h"
+#include "resolution_policy/resolution_policy.h"
+#include "statistics/phase_timer.h"
 
 const int IntermediateFormParser::NO_TYPE = 0;
 const int IntermediateFormParser::PRECONDITION_PROP_VALUE_CHECK = 1;
@@ -65,6 +74,94 @@ const int IntermediateFormParser::ACTION_EXECUTE_BEHAVIOUR = 7;
 const int IntermediateFormParser::ACTION_DELAY = 8;
 const int IntermediateFormParser::STATE_N_SECONDS = 9;
 
+/*------------------------------------------------------------------------------
+	splitControlRule
+
+	Splits a line of the control rule file into the behaviour name, the
+	priority, interruptible, schedulable and rule order values, the rule
+	type, the and/or and not connectors, and the text of the rule. Throws an
+	error if a value is not valid.
+------------------------------------------------------------------------------*/
+static void splitControlRule(const std::string& line,
+	std::vector<std::string>& fields) throw(std::string)
+{
+	TokenCursor next_line(line);
+	fields.clear();
+	for(int i = 0; i < 8; i++)
+	{
+		fields.push_back(next_line.getNextToken().str());
+	}
+	fields.push_back(next_line.getRemaining().str());
+	if(!isInteger(fields[1]))
+	{
+		throw("priority value \'" + fields[1]
+			+ "\' must be an integer\n"
+			+ "at line:\n" + line + "\n");
+	}
+	if(fields[2] != "1" && fields[2] != "0")
+	{
+		throw("interruptible value \'"  + fields[2]
+			+ " \' must be 0 or 1\n"
+			+ "at line:\n" + line + "\n");
+	}
+	if(fields[3] != "1" && fields[3] != "0")
+	{
+		throw("schedulable value \'"  + fields[3]
+			+ " \' must be 0 or 1\n"
+			+ "at line:\n" + line + "\n");
+	}
+	if(!isInteger(fields[4]))
+	{
+		throw("rule order \'"  + fields[4]
+			+ " \' must be an integer\n"
+			+ "at line:\n" + line + "\n");
+	}
+	if(fields[5] != "R" && fields[5] != "A")
+	{
+		throw("rule type \'"  + fields[5]
+			+ " \' must be R or A\n"
+			+ "at line:\n" + line + "\n");
+	}
+	if(fields[6] != "0" && fields[6] != "1" && fields[6] != "2")
+	{
+		throw("anOrConnectorValue \'"  + fields[6]
+			+ " \' must be 0, 1 or 2\n"
+			+ "at line:\n" + line + "\n");
+	}
+	if(fields[7] != "0" && fields[7] != "1")
+	{
+		throw("notConnectorValue \'"  + fields[7]
+			+ " \' must be 0 or 1\n"
+			+ "at line:\n" + line + "\n");
+	}
+}
+
+/*------------------------------------------------------------------------------
+	copyUnflattenedActions
+
+	Records copies of the actions of a behaviour that executes another, as
+	they are before flattening, so that the behaviours executing it can be
+	flattened again when it changes. Behaviours executing no other are not
+	recorded.
+------------------------------------------------------------------------------*/
+static void copyUnflattenedActions(IntermediateForm* form, Behaviour* b,
+	std::map<int, std::vector<Action*>>& unflattened_actions)
+{
+	unflattened_actions.erase(b->getId());
+	for(Action* a : b->getActions())
+	{
+		if(a->getActionType() == ActionType::EXECUTE)
+		{
+			std::vector<Action*>& copies = unflattened_actions[b->getId()];
+			for(Action* action : b->getActions())
+			{
+				copies.push_back(action->clone(form->getArena()));
+			}
+			return;
+		}
+	}
+}
+
 /*------------------------------------------------------------------------------
 	parse
 
@@ -76,9 +173,42 @@ bool IntermediateFormParser::parse(const std::string grammar_rule_file,
 {
 	try
 	{
+		if(cache != nullptr)
+		{
+			// files that have been parsed before need not be parsed again
+			PhaseTimer timer(statistics, "loadCachedIntermediateForm");
+			cache->computeKey(grammar_rule_file, data_rule_file,
+				control_rule_file);
+			std::vector<std::pair<std::string, std::string>> answers;
+			intermediate_form = cache->load(answers);
+			if(intermediate_form != nullptr)
+			{
+				std::cout << "parsed rules loaded from cache file \'"
+					+ cache->getFilename() + "\'\n";
+				// the answers given while parsing are recorded as if they
+				// had been given again
+				for(const std::pair<std::string, std::string>& answer :
+					answers)
+				{
+					g_resolution_policy.replayAnswer(answer.first,
+						answer.second);
+				}
+				return true;
+			}
+		}
 		parseGrammarFile(grammar_rule_file);
 		parseDataExtractionFile(data_rule_file);
-		parseControlRuleFile(control_rule_file);
+		if(previous_run != nullptr)
+		{
+			previous_run->computeKey(grammar_rule_file, data_rule_file);
+		}
+		// an edited control rule file only has its changed behaviours
+		// parsed again
+		if(previous_run == nullptr
+			|| !parseChangedBehaviours(control_rule_file))
+		{
+			parseControlRuleFile(control_rule_file);
+		}
 	}
 	catch(std::string& error)
 	{
@@ -86,6 +216,34 @@ bool IntermediateFormParser::parse(const std::string grammar_rule_file,
 			+ error);
 		return false;
 	}
+	if(cache != nullptr)
+	{
+		PhaseTimer timer(statistics, "storeCachedIntermediateForm");
+		try
+		{
+			cache->store(*intermediate_form,
+				g_resolution_policy.getGivenAnswers());
+		}
+		catch(std::string& error)
+		{
+			// parsing succeeded, so only the next run is affected
+			displayWarning("the parsed rules were not cached\n" + error);
+		}
+	}
+	if(previous_run != nullptr && !control_rule_lines.empty())
+	{
+		PhaseTimer timer(statistics, "storePreviousRun");
+		try
+		{
+			previous_run->store(*intermediate_form, control_rule_lines,
+				unflattened_actions, g_resolution_policy.getGivenAnswers());
+		}
+		catch(std::string& error)
+		{
+			displayWarning("the parsed control rules were not recorded\n"
+				+ error);
+		}
+	}
 	return true;
 }
 
@@ -98,33 +256,31 @@ bool IntermediateFormParser::parse(const std::string grammar_rule_file,
 void IntermediateFormParser::parseGrammarFile(
 	const std::string filename) throw (std::string)
 {
-	std::ifstream ifstream(filename);
+	PhaseTimer timer(statistics, "parseGrammarFile");
+	FileSource file_source(filename);
 
 	try
 	{
-		if(!ifstream)
+		if(!file_source.isOpen())
 		{
 			throw("error loading file \'" + filename + "\'\n");
 		}
 
-		// read the file in as a string
-		std::string input_file_string = std::string(
-			std::istreambuf_iterator<char>(ifstream),
-			std::istreambuf_iterator<char>());
+		TokenCursor file_cursor(file_source.getSpan());
 
 		// do this while there is more to read
-		while(hasNextToken(input_file_string))
+		while(file_cursor.hasNextToken())
 		{
-			std::string line = getNextLine(input_file_string);
+			TokenCursor line(file_cursor.getNextLine());
 			// get the left hand side non-terminal symbol
-			std::string non_t = getNextToken(line);
+			std::string non_t = line.getNextToken().str();
 
 			NonTerminalSymbol* new_non_terminal;
 			if(!isNonTerminalSymbol(non_t))
 			{
 				throw("\'" + non_t + "\' bad non_terminal name on left\n");
 			}
-			if(getNextToken(line) != "::=")
+			if(line.getNextToken() != "::=")
 			{
 				throw("expected '::=' in file \'" + filename + "\'\n");
 			}
@@ -132,9 +288,9 @@ void IntermediateFormParser::parseGrammarFile(
 			new_non_terminal =
 				new NonTerminalSymbol(getSymbolText(non_t),
 					Automaton::REPEAT_NONE);
-			while(hasNextToken(line))
+			while(line.hasNextToken())
 			{
-				std::string token = getNextToken(line);
+				std::string token = line.getNextToken().str();
 				bool is_non_terminal = false;
 				bool is_terminal = false;
 				bool is_predefined = false;
@@ -242,6 +398,7 @@ void IntermediateFormParser::parseGrammarFile(
 				// list
 				non_terminal_symbols_by_type[type - 1].push_back(
 					new_non_terminal);
+				grammar_matcher.addRule(new_non_terminal);
 			}
 			// add the new non-terminal to the list of non-terminals
 			non_terminal_symbols.push_back(new_non_terminal);
@@ -253,7 +410,6 @@ void IntermediateFormParser::parseGrammarFile(
 			+ "error in file \'" + filename + "\'\n"
 			+ error);
 	}
-	ifstream.close();
 }
 
 /*------------------------------------------------------------------------------
@@ -433,19 +589,17 @@ Automaton* IntermediateFormParser::getPredefinedAutomatonByName(
 void IntermediateFormParser::parseDataExtractionFile(
 	const std::string filename) throw (std::string)
 {
-	std::ifstream ifstream(filename);
+	PhaseTimer timer(statistics, "parseDataExtractionFile");
+	FileSource file_source(filename);
 	std::vector<std::string>* values = nullptr;
 
 	try
 	{
-		if(!ifstream)
+		if(!file_source.isOpen())
 		{
 			throw("error loading file \'" + filename + "\'\n");
 		}
-		// read the file in as a string
-		std::string input_file_string(
-			(std::istreambuf_iterator<char>(ifstream)),
-			std::istreambuf_iterator<char>());
+		StringSpan input_file = file_source.getSpan();
 
 		for(int type = RULE_TYPE_LOWER_BOUND;
 			type <= RULE_TYPE_UPPER_BOUND; type++)
@@ -462,7 +616,7 @@ void IntermediateFormParser::parseDataExtractionFile(
 				std::string symbol_name = symbol->getName();
 				// find the corresponding data extraction rule in the input
 				// from the file
-				std::size_t pos = input_file_string.find(symbol_name);
+				std::size_t pos = input_file.find(symbol_name);
 				if(pos == std::string::npos)
 				{
 					throw(std::string("found no corresponding data extraction")
@@ -470,11 +624,11 @@ void IntermediateFormParser::parseDataExtractionFile(
 				}
 				else
 				{
-					std::string file_from_pos =
-						input_file_string.substr(pos + symbol_name.size());
+					TokenCursor file_from_pos(
+						input_file.substr(pos + symbol_name.size()));
 					// get the line defining the grammar rule
 					std::string grammar_rule =
-						getNextLine(file_from_pos);
+						file_from_pos.getNextLine().str();
 					try
 					{
 						// extract the data extraction rule parameters
@@ -509,7 +663,6 @@ void IntermediateFormParser::parseDataExtractionFile(
 			+ error);
 	}
 
-	ifstream.close();
 }
 
 /*------------------------------------------------------------------------------
@@ -530,19 +683,18 @@ std::vector<std::string>* IntermediateFormParser::getDataExtractionRuleValues(
 
 	auto it = data_extraction_rule_value_list.begin();
 	auto end = data_extraction_rule_value_list.end();
-	getShortestPrefixEndingWithChar(rule, ';');
+	TokenCursor rule_cursor(rule);
+	rule_cursor.getShortestPrefixEndingWithChar(';');
 	try
 	{
 		while(it != end)
 		{
 			std::string required_value = *it;
 			std::string value_assignment =
-				getShortestPrefixEndingWithChar(rule, ';');
-			std::string value_assignment_copy = value_assignment;
+				rule_cursor.getShortestPrefixEndingWithChar(';');
 			// get the name of the parameter
-			std::string value_name =
-				getShortestPrefixEndingWithChar(
-					value_assignment_copy, '=');
+			std::string value_name = TokenCursor(value_assignment)
+				.getShortestPrefixEndingWithChar('=');
 			if(value_name.empty())
 			{
 				throw(std::string("missing value name\n"));
@@ -750,77 +902,64 @@ const int IntermediateFormParser::getAutomatonType(
 void IntermediateFormParser::parseControlRuleFile(
 	const std::string filename) throw (std::string)
 {
-	std::ifstream ifstream(filename);
-	Behaviour* new_behaviour = nullptr;
+	PhaseTimer timer(statistics, "matchControlRules");
+	FileSource file_source(filename);
 	try
 	{
-		if(!ifstream)
+		if(!file_source.isOpen())
 		{
 			throw("error loading file \'" + filename + "\'\n");
 		}
-		// read the file in as a string
-		std::string input_file_string(
-			(std::istreambuf_iterator<char>(ifstream)),
-			std::istreambuf_iterator<char>());
-		getNextLine(input_file_string);
-		intermediate_form = new IntermediateForm();
-		while(hasNextToken(input_file_string))
+		// the text of each rule is matched in parallel first, and the
+		// variables and behaviours are then added in file order
+		std::vector<std::pair<std::string, std::string>> rules;
+		TokenCursor rule_cursor(file_source.getSpan());
+		rule_cursor.getNextLine();
+		while(rule_cursor.hasNextToken())
 		{
-			new_behaviour = nullptr;
-			std::string next_line = getNextLine(input_file_string);
-			std::string line_copy = next_line;
-			std::string behaviour_name = getNextToken(next_line);
-			std::string priority = getNextToken(next_line);
-			if(!isInteger(priority))
-			{
-				throw("priority value \'" + priority
-					+ "\' must be an integer\n"
-					+ "at line:\n" + line_copy + "\n");
-			}
-			std::string interruptible = getNextToken(next_line);
-			if(interruptible != "1" && interruptible != "0")
-			{
-				throw("interruptible value \'"  + interruptible
-					+ " \' must be 0 or 1\n"
-					+ "at line:\n" + line_copy + "\n");
-			}
-			std::string schedulable = getNextToken(next_line);
-			if(schedulable != "1" && schedulable != "0")
-			{
-				throw("schedulable value \'"  + schedulable
-					+ " \' must be 0 or 1\n"
-					+ "at line:\n" + line_copy + "\n");
-			}
-			std::string rule_order = getNextToken(next_line);
-			if(!isInteger(rule_order))
-			{
-				throw("rule order \'"  + rule_order
-					+ " \' must be an integer\n"
-					+ "at line:\n" + line_copy + "\n");
-			}
-			std::string rule_type = getNextToken(next_line);
-			if(rule_type != "R" && rule_type != "A")
-			{
-				throw("rule type \'"  + rule_type
-					+ " \' must be R or A\n"
-					+ "at line:\n" + line_copy + "\n");
-			}
-			std::string and_or_connector = getNextToken(next_line);
-			if(and_or_connector != "0" && and_or_connector != "1"
-				&& and_or_connector != "2")
-			{
-				throw("anOrConnectorValue \'"  + and_or_connector
-					+ " \' must be 0, 1 or 2\n"
-					+ "at line:\n" + line_copy + "\n");
-			}
-			std::string not_connector = getNextToken(next_line);
-			if(not_connector != "0" && not_connector != "1")
+			TokenCursor next_line(rule_cursor.getNextLine());
+			// the rule type is the sixth field, and the text follows the
+			// eighth
+			for(int i = 0; i < 5; i++)
 			{
-				throw("notConnectorValue \'"  + not_connector
-					+ " \' must be 0 or 1\n"
-					+ "at line:\n" + line_copy + "\n");
+				next_line.getNextToken();
 			}
-			std::string rule_text = next_line;
+			std::string rule_type = next_line.getNextToken().str();
+			next_line.getNextToken();
+			next_line.getNextToken();
+			rules.push_back(std::make_pair(rule_type,
+				next_line.getRemaining().str()));
+		}
+		intermediate_form = new IntermediateForm();
+		matchRulesInParallel(rules);
+		setSimilarVariableNames(rules);
+
+		timer.next("parseControlRuleFile");
+		control_rule_lines.clear();
+		unflattened_actions.clear();
+		// the behaviour each line was added to, whose id is only known once
+		// the behaviours have been validated
+		std::vector<Behaviour*> line_behaviours;
+		unsigned int num_behaviours = 0;
+		TokenCursor file_cursor(file_source.getSpan());
+		file_cursor.getNextLine();
+		while(file_cursor.hasNextToken())
+		{
+			ControlRuleLine record;
+			record.text = file_cursor.getNextLine().str();
+			const std::string& line_copy = record.text;
+			std::vector<std::string> fields;
+			splitControlRule(line_copy, fields);
+			std::string behaviour_name = fields[0];
+			std::string priority = fields[1];
+			std::string interruptible = fields[2];
+			std::string schedulable = fields[3];
+			std::string rule_order = fields[4];
+			std::string rule_type = fields[5];
+			std::string and_or_connector = fields[6];
+			std::string not_connector = fields[7];
+			std::string rule_text = fields[8];
+			Behaviour* line_behaviour = nullptr;
 			if(rule_type == "R")
 			{
 				std::stringstream info_stream;
@@ -861,7 +1000,8 @@ void IntermediateFormParser::parseControlRuleFile(
 							+ (behaviour->isSchedulable() ? "true" : "false")
 							+ ")\n");
 					}
-					Precondition* precondition = parsePrecondition(rule_text);
+					Precondition* precondition = parsePrecondition(rule_text,
+						record);
 					precondition->setAndOrConnector(stringToInteger(
 						and_or_connector));
 					precondition->setNotConnector(stringToInteger(
@@ -869,31 +1009,27 @@ void IntermediateFormParser::parseControlRuleFile(
 					precondition->setPreconditionOrder(
 						stringToInteger(rule_order));
 					behaviour->addPrecondition(precondition);
+					line_behaviour = behaviour;
 				}
 				else
 				{
-					new_behaviour =
-						new Behaviour(behaviour_name, stringToInteger(priority),
+					Behaviour* new_behaviour =
+						intermediate_form->create<Behaviour>(behaviour_name,
+							stringToInteger(priority),
 							(interruptible == "1" ?	true : false),
 							(schedulable == "1" ? true: false));
-					Precondition* precondition;
-					try
-					{
-						precondition = parsePrecondition(rule_text);
-						precondition->setAndOrConnector(stringToInteger(
-							and_or_connector));
-						precondition->setNotConnector(stringToInteger(
-							not_connector));
-						precondition->setPreconditionOrder(
-							stringToInteger(rule_order));
-					}
-					catch(std::string& error)
-					{
-						delete new_behaviour;
-						throw(error);
-					}
+					Precondition* precondition = parsePrecondition(rule_text,
+						record);
+					precondition->setAndOrConnector(stringToInteger(
+						and_or_connector));
+					precondition->setNotConnector(stringToInteger(
+						not_connector));
+					precondition->setPreconditionOrder(
+						stringToInteger(rule_order));
 					new_behaviour->addPrecondition(precondition);
 					intermediate_form->addBehaviour(new_behaviour);
+					line_behaviour = new_behaviour;
+					num_behaviours++;
 				}
 			}
 			else
@@ -937,54 +1073,636 @@ void IntermediateFormParser::parseControlRuleFile(
 							+ ")\n");
 					}
 					Action* action = parseAction(rule_text,
-							stringToInteger(rule_order));
+							stringToInteger(rule_order), record);
 					behaviour->addAction(action);
+					line_behaviour = behaviour;
 				}
 				else
 				{
-					new_behaviour =
-						new Behaviour(behaviour_name, stringToInteger(priority),
-								(interruptible == "1" ?	true : false),
-								(schedulable == "1" ? true: false));
-					Action* action;
-					try
-					{
-						action = parseAction(rule_text,
-							stringToInteger(rule_order));
-					}
-					catch(std::string& error)
-					{
-						delete new_behaviour;
-						throw(error);
-					}
+					Behaviour* new_behaviour =
+						intermediate_form->create<Behaviour>(behaviour_name,
+							stringToInteger(priority),
+							(interruptible == "1" ?	true : false),
+							(schedulable == "1" ? true: false));
+					Action* action = parseAction(rule_text,
+						stringToInteger(rule_order), record);
 					new_behaviour->addAction(action);
 					intermediate_form->addBehaviour(new_behaviour);
+					line_behaviour = new_behaviour;
+					num_behaviours++;
 				}
 			}
+			if(previous_run != nullptr)
+			{
+				control_rule_lines.push_back(record);
+				line_behaviours.push_back(line_behaviour);
+			}
 		}
 
+		timer.next("validateBehaviours");
 		intermediate_form->validateBehaviours();
+		if(previous_run != nullptr)
+		{
+			const std::vector<Behaviour*>& behaviours =
+				intermediate_form->getBehaviours();
+			if(behaviours.size() != num_behaviours)
+			{
+				// the lines of a behaviour that was removed cannot be
+				// parsed again on their own
+				control_rule_lines.clear();
+			}
+			for(std::size_t i = 0; i < control_rule_lines.size(); i++)
+			{
+				control_rule_lines[i].behaviour_id =
+					line_behaviours[i]->getId();
+			}
+			if(g_flatten_behaviours && !control_rule_lines.empty())
+			{
+				for(Behaviour* b : behaviours)
+				{
+					copyUnflattenedActions(intermediate_form, b,
+						unflattened_actions);
+				}
+			}
+		}
 		if(g_flatten_behaviours)
 		{
+			timer.next("flattenNestedBehaviourExecutions");
 			intermediate_form->flattenNestedBehaviourExecutions();
 		}
+		timer.next("buildLogicalExpressionTrees");
 		for(Behaviour* b : intermediate_form->getBehaviours())
 		{
-			b->buildLogicalExpressionTree();
+			b->buildLogicalExpressionTree(intermediate_form->getArena());
 		}
+		matched_rules.clear();
 	}
 	catch(std::string& error)
 	{
+		matched_rules.clear();
 		if(intermediate_form != nullptr)
 		{
+			// releases every behaviour, precondition and action parsed so far
 			delete intermediate_form;
+			intermediate_form = nullptr;
 		}
 		throw(std::string("[parseActionRuleSet]->\n")
 			+ "error in file \'" + filename + "\'\n"
 			+ error);
 	}
+}
+
+/*------------------------------------------------------------------------------
+	parseChangedBehaviours
+
+	Parses the control rule file against the last file parsed with the same
+	grammar and data extraction rules, parsing again only the behaviours
+	whose lines have changed, and flattening again only those behaviours and
+	the behaviours executing them. Returns false if the file must be parsed
+	in full.
+------------------------------------------------------------------------------*/
+bool IntermediateFormParser::parseChangedBehaviours(const std::string filename)
+{
+	PhaseTimer timer(statistics, "loadPreviousRun");
+	std::vector<ControlRuleLine> old_lines;
+	std::vector<std::pair<std::string, std::string>> answers;
+	intermediate_form = previous_run->load(old_lines, unflattened_actions,
+		answers);
+	if(intermediate_form == nullptr)
+	{
+		return false;
+	}
+	try
+	{
+		timer.next("diffControlRules");
+		FileSource file_source(filename);
+		if(!file_source.isOpen())
+		{
+			throw(std::string("the file could not be read\n"));
+		}
+		const std::vector<Behaviour*>& behaviours =
+			intermediate_form->getBehaviours();
+		const std::vector<PropVariable*>& prop_variables =
+			intermediate_form->getPropVariables();
+		const std::vector<EnumVariable*>& enum_variables =
+			intermediate_form->getEnumVariables();
+		// the lines of the last file are grouped by behaviour, in order of id
+		std::vector<std::size_t> old_starts;
+		for(std::size_t i = 0; i < old_lines.size(); i++)
+		{
+			const int id = old_lines[i].behaviour_id;
+			if(id == (int)old_starts.size())
+			{
+				old_starts.push_back(i);
+			}
+			else if(id + 1 != (int)old_starts.size())
+			{
+				throw(std::string("the lines of a behaviour were not ")
+					+ "consecutive\n");
+			}
+		}
+		// the lines of this file are grouped by the name of their behaviour
+		std::vector<std::string> texts;
+		std::vector<std::size_t> starts;
+		std::string last_name;
+		TokenCursor file_cursor(file_source.getSpan());
+		file_cursor.getNextLine();
+		while(file_cursor.hasNextToken())
+		{
+			StringSpan line = file_cursor.getNextLine();
+			std::string name = TokenCursor(line).getNextToken().str();
+			if(starts.empty() || name != last_name)
+			{
+				starts.push_back(texts.size());
+				last_name = name;
+			}
+			texts.push_back(line.str());
+		}
+		if(old_starts.size() != behaviours.size()
+			|| starts.size() != behaviours.size())
+		{
+			throw(std::string("behaviours were added, removed or moved\n"));
+		}
+		old_starts.push_back(old_lines.size());
+		starts.push_back(texts.size());
+		std::vector<int> changed;
+		for(std::size_t id = 0; id < behaviours.size(); id++)
+		{
+			const std::size_t num_lines = starts[id + 1] - starts[id];
+			bool is_changed =
+				num_lines != old_starts[id + 1] - old_starts[id];
+			for(std::size_t i = 0; !is_changed && i < num_lines; i++)
+			{
+				is_changed = texts[starts[id] + i]
+					!= old_lines[old_starts[id] + i].text;
+			}
+			if(is_changed)
+			{
+				changed.push_back(id);
+			}
+		}
+
+		timer.next("parseChangedBehaviours");
+		// every behaviour executed by a changed line must be named exactly,
+		// as a similar name could have prompted the user
+		auto check_executed = [&](const ParsedRule& rule)
+			{
+				if(rule.type != ACTION_EXECUTE_BEHAVIOUR
+					&& rule.type != ACTION_EXECUTE_BEHAVIOUR_NON_D)
+				{
+					return;
+				}
+				for(const std::string& executed : rule.fields)
+				{
+					if(intermediate_form->findBehaviour(executed) == nullptr)
+					{
+						throw("behaviour \'" + executed
+							+ "\' is not named exactly\n");
+					}
+				}
+			};
+		// the lines of each changed behaviour, split into fields
+		std::map<int, std::vector<ControlRuleLine>> changed_lines;
+		std::map<int, std::vector<std::vector<std::string>>> changed_fields;
+		std::vector<std::pair<std::string, std::string>> rules;
+		std::vector<std::string> fields;
+		for(int id : changed)
+		{
+			const std::string& name = behaviours[id]->getName();
+			if(intermediate_form->findBehaviour(name) != behaviours[id])
+			{
+				throw("behaviour \'" + name + "\' is not named exactly\n");
+			}
+			bool had_preconditions = false;
+			for(std::size_t i = old_starts[id]; i < old_starts[id + 1]; i++)
+			{
+				splitControlRule(old_lines[i].text, fields);
+				if(fields[0] != name)
+				{
+					throw("behaviour \'" + name + "\' is not named exactly\n");
+				}
+				had_preconditions |= fields[5] == "R";
+				// the rules of unchanged lines need not be matched again
+				matched_rules[fields[5] + fields[8]] = old_lines[i].rule;
+			}
+			// the user could have been prompted for a schedulable behaviour
+			// with no preconditions
+			if(fields[3] == "1" && !had_preconditions)
+			{
+				throw("behaviour \'" + name + "\' had no preconditions\n");
+			}
+			bool has_preconditions = false;
+			bool has_actions = false;
+			for(std::size_t i = starts[id]; i < starts[id + 1]; i++)
+			{
+				splitControlRule(texts[i], fields);
+				const std::vector<std::string>& first =
+					changed_fields[id].empty() ? fields : changed_fields[id][0];
+				if(fields[0] != name || fields[1] != first[1]
+					|| fields[2] != first[2] || fields[3] != first[3])
+				{
+					throw("the lines of behaviour \'" + name
+						+ "\' conflict\n");
+				}
+				has_preconditions |= fields[5] == "R";
+				has_actions |= fields[5] == "A";
+				ControlRuleLine line;
+				line.text = texts[i];
+				line.behaviour_id = id;
+				changed_lines[id].push_back(line);
+				changed_fields[id].push_back(fields);
+				rules.push_back(std::make_pair(fields[5], fields[8]));
+			}
+			if(!has_actions || (fields[3] == "1" && !has_preconditions))
+			{
+				throw("behaviour \'" + name + "\' has no preconditions or "
+					+ "no actions\n");
+			}
+		}
+		matchRulesInParallel(rules);
+		for(int id : changed)
+		{
+			for(std::size_t i = 0; i < changed_lines[id].size(); i++)
+			{
+				const std::vector<std::string>& f = changed_fields[id][i];
+				auto it = matched_rules.find(f[5] + f[8]);
+				if(it == matched_rules.end())
+				{
+					throw("rule \'" + trim(f[8]) + "\' could not be matched "
+						+ "without prompting\n");
+				}
+				changed_lines[id][i].rule = it->second;
+				check_executed(it->second);
+			}
+		}
+
+		// how each rule names and changes a variable, empty if it names none
+		auto get_effect = [&](const ParsedRule& rule) -> std::string
+			{
+				const std::vector<std::string>& f = rule.fields;
+				switch(rule.type)
+				{
+				case PRECONDITION_PROP_VALUE_CHECK:
+					return "p" + f[0] + '\n' + f[2];
+				case ACTION_PROP_VALUE_ASSIGNMENT:
+					return "p" + f[0] + '\n' + "0";
+				case PRECONDITION_ENUM_VALUE_CHECK:
+					return "e" + f[0] + '\n' + f[1] + '\n' + f[2] + f[3] + "0";
+				case ACTION_ENUM_VALUE_ASSIGNMENT:
+					return "e" + f[0] + '\n' + f[1] + '\n' + "00" + f[2];
+				}
+				return "";
+			};
+		auto is_prop = [&](const ParsedRule& rule) -> bool
+			{
+				return rule.type == PRECONDITION_PROP_VALUE_CHECK
+					|| rule.type == ACTION_PROP_VALUE_ASSIGNMENT;
+			};
+		// the name of the variable of a line of the last file
+		auto get_variable_name = [&](const ControlRuleLine& line)
+			-> std::string
+			{
+				const std::size_t num_variables = is_prop(line.rule)
+					? prop_variables.size() : enum_variables.size();
+				if(line.variable_id < 0
+					|| (std::size_t)line.variable_id >= num_variables)
+				{
+					throw(std::string("the variables were not recorded\n"));
+				}
+				return is_prop(line.rule)
+					? prop_variables[line.variable_id]->getName()
+					: enum_variables[line.variable_id]->getName();
+			};
+		bool same_effects = true;
+		for(int id : changed)
+		{
+			std::vector<std::string> old_effects;
+			std::vector<std::string> new_effects;
+			for(std::size_t i = old_starts[id]; i < old_starts[id + 1]; i++)
+			{
+				std::string effect = get_effect(old_lines[i].rule);
+				if(!effect.empty())
+				{
+					old_effects.push_back(effect);
+				}
+			}
+			for(const ControlRuleLine& line : changed_lines[id])
+			{
+				std::string effect = get_effect(line.rule);
+				if(!effect.empty())
+				{
+					new_effects.push_back(effect);
+				}
+			}
+			same_effects &= old_effects == new_effects;
+		}
+		if(same_effects)
+		{
+			// the variables are named and changed as before, so each takes
+			// the variable of the line it replaces
+			for(int id : changed)
+			{
+				std::size_t i = old_starts[id];
+				for(ControlRuleLine& line : changed_lines[id])
+				{
+					if(get_effect(line.rule).empty())
+					{
+						continue;
+					}
+					while(get_effect(old_lines[i].rule).empty())
+					{
+						i++;
+					}
+					get_variable_name(old_lines[i]);
+					line.variable_id = old_lines[i++].variable_id;
+				}
+			}
+		}
+		else
+		{
+			// the variables keep their ids if each was named exactly, and
+			// is first named in the same order as before
+			for(const ControlRuleLine& line : old_lines)
+			{
+				if(!get_effect(line.rule).empty()
+					&& get_variable_name(line) != line.rule.fields[0])
+				{
+					throw("variable \'" + line.rule.fields[0]
+						+ "\' is not named exactly\n");
+				}
+			}
+			std::size_t next_prop_id = 0;
+			std::size_t next_enum_id = 0;
+			std::vector<ControlRuleLine*> file_lines;
+			for(std::size_t id = 0; id < behaviours.size(); id++)
+			{
+				auto it = changed_lines.find(id);
+				if(it != changed_lines.end())
+				{
+					for(ControlRuleLine& line : it->second)
+					{
+						file_lines.push_back(&line);
+					}
+					continue;
+				}
+				for(std::size_t i = old_starts[id]; i < old_starts[id + 1];
+					i++)
+				{
+					file_lines.push_back(&old_lines[i]);
+				}
+			}
+			for(ControlRuleLine* line : file_lines)
+			{
+				if(get_effect(line->rule).empty())
+				{
+					continue;
+				}
+				const std::string& name = line->rule.fields[0];
+				Indexed* variable = nullptr;
+				if(is_prop(line->rule))
+				{
+					variable = intermediate_form->findPropVariable(name);
+				}
+				else
+				{
+					variable = intermediate_form->findEnumVariable(name);
+				}
+				if(variable == nullptr)
+				{
+					throw("variable \'" + name + "\' is new or not named "
+						+ "exactly\n");
+				}
+				std::size_t& next_id = is_prop(line->rule) ? next_prop_id
+					: next_enum_id;
+				if((std::size_t)variable->getId() > next_id)
+				{
+					throw("variable \'" + name + "\' is first named in a "
+						+ "different order\n");
+				}
+				else if((std::size_t)variable->getId() == next_id)
+				{
+					next_id++;
+				}
+				line->variable_id = variable->getId();
+			}
+			if(next_prop_id != prop_variables.size()
+				|| next_enum_id != enum_variables.size())
+			{
+				throw(std::string("a variable is no longer named\n"));
+			}
+			// the variables are updated again by every line in file order
+			std::vector<std::list<std::string>> old_values;
+			for(PropVariable* p : prop_variables)
+			{
+				const int id = p->getId();
+				*p = PropVariable(p->getName(), false);
+				p->setId(id);
+			}
+			for(EnumVariable* e : enum_variables)
+			{
+				const int id = e->getId();
+				old_values.push_back(e->getValues());
+				*e = EnumVariable(e->getName());
+				e->setId(id);
+			}
+			for(ControlRuleLine* line : file_lines)
+			{
+				if(!get_effect(line->rule).empty())
+				{
+					updateRuleVariable(line->rule, line->variable_id);
+				}
+			}
+			// the lines not parsed again spell each value as it was first
+			// added
+			for(std::size_t id = 0; id < enum_variables.size(); id++)
+			{
+				for(const std::string& value : enum_variables[id]->getValues())
+				{
+					for(const std::string& old_value : old_values[id])
+					{
+						if(toLower(value) == toLower(old_value)
+							&& value != old_value)
+						{
+							throw("value \'" + value + "\' is spelled "
+								+ "differently\n");
+						}
+					}
+				}
+			}
+		}
+
+		// the changed behaviours are built as in a full parse, executing
+		// the behaviours found by name
+		std::map<int, Behaviour*> changed_behaviours;
+		for(int id : changed)
+		{
+			const std::vector<std::string>& first = changed_fields[id][0];
+			Behaviour* b = intermediate_form->create<Behaviour>(first[0],
+				stringToInteger(first[1]), first[2] == "1", first[3] == "1");
+			for(std::size_t i = 0; i < changed_lines[id].size(); i++)
+			{
+				const std::vector<std::string>& f = changed_fields[id][i];
+				const ControlRuleLine& line = changed_lines[id][i];
+				if(f[5] == "R")
+				{
+					Precondition* precondition = buildPrecondition(line.rule,
+						line.variable_id);
+					precondition->setAndOrConnector(stringToInteger(f[6]));
+					precondition->setNotConnector(stringToInteger(f[7]));
+					precondition->setPreconditionOrder(stringToInteger(f[4]));
+					b->addPrecondition(precondition);
+					continue;
+				}
+				Action* action = buildAction(line.rule, stringToInteger(f[4]),
+					line.variable_id);
+				if(action->getActionType() == ActionType::EXECUTE)
+				{
+					ActionExecute* a_ex = (ActionExecute*)action;
+					Behaviour* executed = intermediate_form->findBehaviour(
+						a_ex->getBehaviour());
+					a_ex->setBehaviour(executed->getName());
+					a_ex->setBehaviourId(executed->getId());
+				}
+				else if(action->getActionType() == ActionType::EXECUTE_NON_D)
+				{
+					ActionExecuteNonDeterministic* a_ex_non_d =
+						(ActionExecuteNonDeterministic*)action;
+					for(std::size_t j = 0;
+						j < a_ex_non_d->getBehaviourValues().size(); j++)
+					{
+						Behaviour* executed = intermediate_form->findBehaviour(
+							a_ex_non_d->getBehaviourValues()[j]);
+						a_ex_non_d->resolveBehaviourValue(j,
+							executed->getName(), executed->getId());
+					}
+				}
+				b->addAction(action);
+			}
+			changed_behaviours[id] = b;
+		}
+		for(const std::pair<const int, Behaviour*>& pair : changed_behaviours)
+		{
+			intermediate_form->replaceBehaviour(pair.first, pair.second);
+			copyUnflattenedActions(intermediate_form, pair.second,
+				unflattened_actions);
+		}
+
+		timer.next("flattenChangedBehaviours");
+		std::set<int> affected(changed.begin(), changed.end());
+		if(g_flatten_behaviours)
+		{
+			// the behaviours executing each behaviour before flattening
+			std::map<int, std::vector<int>> executed_by;
+			for(const std::pair<const int, std::vector<Action*>>& pair :
+				unflattened_actions)
+			{
+				for(Action* a : pair.second)
+				{
+					if(a->getActionType() == ActionType::EXECUTE)
+					{
+						executed_by[((ActionExecute*)a)->getBehaviourId()]
+							.push_back(pair.first);
+					}
+				}
+			}
+			std::vector<int> pending(changed);
+			while(!pending.empty())
+			{
+				const int id = pending.back();
+				pending.pop_back();
+				for(int executing : executed_by[id])
+				{
+					if(affected.insert(executing).second)
+					{
+						pending.push_back(executing);
+					}
+				}
+			}
+			// a behaviour executing a changed behaviour is flattened again
+			// from its actions before flattening
+			for(int id : affected)
+			{
+				if(changed_behaviours.count(id) != 0)
+				{
+					continue;
+				}
+				Behaviour* old_b = behaviours[id];
+				Behaviour* b = intermediate_form->create<Behaviour>(
+					old_b->getName(), old_b->getPriority(),
+					old_b->isInterruptible(), old_b->isSchedulable());
+				for(Precondition* p : old_b->getPreconditions())
+				{
+					b->addPrecondition(p);
+				}
+				for(Action* a : unflattened_actions[id])
+				{
+					b->addAction(a->clone(intermediate_form->getArena()));
+				}
+				intermediate_form->replaceBehaviour(id, b);
+			}
+			for(int id : affected)
+			{
+				intermediate_form->flattenNestedBehaviourExecutions(
+					intermediate_form->getBehaviour(id), unflattened_actions);
+			}
+		}
+		for(int id : affected)
+		{
+			intermediate_form->getBehaviour(id)->buildLogicalExpressionTree(
+				intermediate_form->getArena());
+		}
 
-	ifstream.close();
+		std::vector<ControlRuleLine> lines;
+		lines.reserve(texts.size());
+		for(std::size_t id = 0; id < behaviours.size(); id++)
+		{
+			auto it = changed_lines.find(id);
+			if(it != changed_lines.end())
+			{
+				lines.insert(lines.end(), it->second.begin(), it->second.end());
+			}
+			else
+			{
+				lines.insert(lines.end(), old_lines.begin() + old_starts[id],
+					old_lines.begin() + old_starts[id + 1]);
+			}
+		}
+		control_rule_lines.swap(lines);
+		matched_rules.clear();
+		// the answers given while parsing the last file are recorded as if
+		// they had been given again
+		for(const std::pair<std::string, std::string>& answer : answers)
+		{
+			g_resolution_policy.replayAnswer(answer.first, answer.second);
+		}
+		std::cout << changed.size() << " of " << behaviours.size()
+			<< " behaviours parsed again and " << affected.size()
+			<< " flattened again, from cache file \'"
+			<< previous_run->getFilename() << "\'\n";
+		return true;
+	}
+	catch(std::string& reason)
+	{
+		// the rules matched for the last file are not matched again
+		for(const ControlRuleLine& line : old_lines)
+		{
+			TokenCursor next_line(line.text);
+			for(int i = 0; i < 5; i++)
+			{
+				next_line.getNextToken();
+			}
+			std::string rule_type = next_line.getNextToken().str();
+			next_line.getNextToken();
+			next_line.getNextToken();
+			matched_rules.insert(std::make_pair(rule_type
+				+ next_line.getRemaining().str(), line.rule));
+		}
+		delete intermediate_form;
+		intermediate_form = nullptr;
+		unflattened_actions.clear();
+		std::cout << "control rule file parsed in full, as " << reason;
+		return false;
+	}
 }
 
 /*------------------------------------------------------------------------------
@@ -992,22 +1710,29 @@ void IntermediateFormParser::parseControlRuleFile(
 
 	Given a string and an integer corresponding to the order of the action
 	in the corresponding behaviour, constructs and returns a new Action, or
-	throws an error if parsing was unsuccessful.
+	throws an error if parsing was unsuccessful. The rule matched and the
+	variable it assigns are recorded in the given line.
 ------------------------------------------------------------------------------*/
 Action*	IntermediateFormParser::parseAction(const std::string s,
-	const int order) throw(std::string)
+	const int order, ControlRuleLine& line) throw(std::string)
 {
-	Action* new_action = nullptr;
+	line.rule = matchRule("A", s);
+	line.variable_id = addRuleVariable(line.rule);
+	return buildAction(line.rule, order, line.variable_id);
+}
+
+/*------------------------------------------------------------------------------
+	matchAction
+
+	Given a string corresponding to an action, matches it against the grammar
+	and data extraction rules and returns the matched rule, or throws an
+	error if matching was unsuccessful.
+------------------------------------------------------------------------------*/
+const ParsedRule IntermediateFormParser::matchAction(const std::string s,
+	const MatchContext& context) throw(std::string)
+{
+	ParsedRule rule;
 	std::size_t pos = s.find(" and wait for completion");
-	std::string modified_s = s;
-	if(pos == std::string::npos)
-	{
-		modified_s = s;
-	}
-	else
-	{
-		modified_s = s.substr(0, pos);
-	}
 	auto type_info_list = getAcceptingGrammarRules(s.substr(0, pos),
 		std::vector<int>
 		{
@@ -1016,7 +1741,7 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 			ACTION_EXECUTE_BEHAVIOUR_NON_D,
 			ACTION_EXECUTE_BEHAVIOUR,
 			ACTION_DELAY
-		});
+		}, context);
 	validateAcceptingGrammarRules(&type_info_list);
 	try
 	{
@@ -1027,19 +1752,14 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 		else
 		{
 			std::pair<int, NonTerminalSymbol*>* type_info;
-			type_info = disambiguateCandidates(&type_info_list, s);
+			type_info = disambiguateCandidates(&type_info_list, s, context);
 			std::vector<std::string> values = getDataExtractionRuleValuesByName(
 				type_info->second->getName());
 			std::string string_var_1;
 			std::string string_var_2;
 			std::string string_var_3;
-			std::string string_var_4;
 			std::list<std::string> list_var;
-			bool bool_var;
-			PropVariable* prop_var;
-			EnumVariable* enum_var;
-			ActionExecuteNonDeterministic* new_ex_non_d;
-			std::stringstream info_stream;
+			rule.type = type_info->first;
 			switch(type_info->first)
 			{
 			case ACTION_PROP_VALUE_ASSIGNMENT:
@@ -1048,21 +1768,10 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 				string_var_2 = constructIdentifier(values[1], false,
 					type_info->second);
 				string_var_3 = constructString(values[2], false);
-				string_var_4 = constructString(values[3], false);
-
-				bool_var = toLower(string_var_2) ==
-					toLower(string_var_3) ? true : false;
-				info_stream	<< "disambiguation of propositional variable '"
-					<< string_var_1 << "\'";
-				prop_var = intermediate_form->getPropVariableByName(string_var_1,
-					info_stream.str());
-				if(prop_var == nullptr)
-				{
-					prop_var = new PropVariable(string_var_1, false);
-					intermediate_form->addPropVariable(prop_var);
-				}
-				new_action = new ActionPropValueAssignment(
-					prop_var, bool_var, order);
+
+				rule.fields.push_back(string_var_1);
+				rule.fields.push_back(toLower(string_var_2) ==
+					toLower(string_var_3) ? "1" : "0");
 
 				break;
 
@@ -1072,23 +1781,9 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 				string_var_2 = constructIdentifier(values[1], false,
 					type_info->second);
 
-				bool_var = toLower(values[2]) == "true" ? true : false;
-				info_stream	<< "disambiguation of enumerated variable '"
-					<< string_var_1 << "\'";
-				enum_var = intermediate_form->getEnumVariableByName(string_var_1,
-					info_stream.str());
-				if(enum_var == nullptr)
-				{
-					enum_var = new EnumVariable(string_var_1);
-					intermediate_form->addEnumVariable(enum_var);
-				}
-				if(bool_var)
-				{
-					enum_var->setResets();
-				}
-				string_var_2 = enum_var->addValue(string_var_2);
-				new_action = new ActionEnumValueAssignment(
-					enum_var, string_var_2, order);
+				rule.fields.push_back(string_var_1);
+				rule.fields.push_back(string_var_2);
+				rule.fields.push_back(toLower(values[2]) == "true" ? "1" : "0");
 
 				break;
 
@@ -1100,13 +1795,7 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 				list_var = constructBehaviourList(string_var_1,
 					string_var_2, string_var_3);
 
-				new_ex_non_d = new ActionExecuteNonDeterministic(order);
-				std::for_each(list_var.begin(), list_var.end(),
-					[&](std::string behaviour_value)
-					{
-						new_ex_non_d->addBehaviourValue(behaviour_value);
-					});
-				new_action = new_ex_non_d;
+				rule.fields.assign(list_var.begin(), list_var.end());
 
 				break;
 
@@ -1119,14 +1808,14 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 					string_var_1 =
 						string_var_1.substr(1, string_var_1.size() - 2);
 				}
-				new_action = new ActionExecute(string_var_1, order);
+				rule.fields.push_back(string_var_1);
 
 				break;
 
 			case ACTION_DELAY:
 				string_var_1 = constructIdentifier(values[0], false,
 					type_info->second);
-				new_action = new ActionWait(stringToFloat(string_var_1), order);
+				rule.fields.push_back(string_var_1);
 
 				break;
 			}
@@ -1145,9 +1834,281 @@ Action*	IntermediateFormParser::parseAction(const std::string s,
 	{
 		delete pair;
 	}
+	return rule;
+}
+
+/*------------------------------------------------------------------------------
+	buildAction
+
+	Given a matched action, an integer corresponding to the order of the
+	action in the corresponding behaviour, and the id of the variable it
+	assigns, constructs and returns a new Action.
+------------------------------------------------------------------------------*/
+Action* IntermediateFormParser::buildAction(const ParsedRule& rule,
+	const int order, const int variable_id)
+{
+	Action* new_action = nullptr;
+	EnumVariable* enum_var;
+	ActionExecuteNonDeterministic* new_ex_non_d;
+	switch(rule.type)
+	{
+	case ACTION_PROP_VALUE_ASSIGNMENT:
+		new_action = intermediate_form->create<ActionPropValueAssignment>(
+			intermediate_form->getPropVariables()[variable_id],
+			rule.fields[1] == "1", order);
+
+		break;
+
+	case ACTION_ENUM_VALUE_ASSIGNMENT:
+		enum_var = intermediate_form->getEnumVariables()[variable_id];
+		// the value is spelled as it was first added
+		new_action = intermediate_form->create<ActionEnumValueAssignment>(
+			enum_var, enum_var->addValue(rule.fields[1]), order);
+
+		break;
+
+	case ACTION_EXECUTE_BEHAVIOUR_NON_D:
+		new_ex_non_d = intermediate_form->
+			create<ActionExecuteNonDeterministic>(order);
+		for(const std::string& behaviour_value : rule.fields)
+		{
+			new_ex_non_d->addBehaviourValue(behaviour_value);
+		}
+		new_action = new_ex_non_d;
+
+		break;
+
+	case ACTION_EXECUTE_BEHAVIOUR:
+		new_action = intermediate_form->create<ActionExecute>(rule.fields[0],
+			order);
+
+		break;
+
+	case ACTION_DELAY:
+		new_action = intermediate_form->create<ActionWait>(
+			stringToFloat(rule.fields[0]), order);
+
+		break;
+	}
 	return new_action;
 }
 
+/*------------------------------------------------------------------------------
+	matchRule
+
+	Returns the rule matched for the text of a precondition or action,
+	reusing the rule matched for the same text in parallel.
+------------------------------------------------------------------------------*/
+const ParsedRule IntermediateFormParser::matchRule(const std::string rule_type,
+	const std::string s) throw(std::string)
+{
+	auto it = matched_rules.find(rule_type + s);
+	if(it != matched_rules.end())
+	{
+		return it->second;
+	}
+	// the rules not matched in parallel are matched in file order,
+	// prompting the user if need be
+	MatchContext context(non_terminal_symbols_by_type, true);
+	return (rule_type == "R" ? matchPrecondition(s, context)
+		: matchAction(s, context));
+}
+
+/*------------------------------------------------------------------------------
+	matchRulesInParallel
+
+	Matches the text of rules across a pool of threads, adding the rules
+	matched to matched_rules. Rules already in matched_rules are not matched
+	again, and rules that cannot be matched without prompting the user, or
+	that are not valid, are left to be matched in file order.
+------------------------------------------------------------------------------*/
+void IntermediateFormParser::matchRulesInParallel(
+	const std::vector<std::pair<std::string, std::string>>& rules)
+{
+	// each text is matched once, however many lines it is on
+	std::vector<const std::pair<std::string, std::string>*> pending;
+	std::set<std::string> keys;
+	for(const std::pair<std::string, std::string>& rule : rules)
+	{
+		if((rule.first != "R" && rule.first != "A")
+			|| !keys.insert(rule.first + rule.second).second
+			|| matched_rules.count(rule.first + rule.second) != 0)
+		{
+			continue;
+		}
+		pending.push_back(&rule);
+	}
+
+	std::vector<ParsedRule> results(pending.size());
+	// records whether each rule was matched, indexed as pending
+	std::vector<char> matched(pending.size(), false);
+	std::atomic<unsigned int> next(0);
+	auto work = [&]()
+		{
+			// the automata hold the state of the text being matched, so each
+			// thread feeds the text to its own copies of them
+			std::vector<std::list<NonTerminalSymbol*>> symbols_by_type;
+			for(const std::list<NonTerminalSymbol*>& symbols :
+				non_terminal_symbols_by_type)
+			{
+				std::list<NonTerminalSymbol*> copies;
+				for(NonTerminalSymbol* n : symbols)
+				{
+					copies.push_back((NonTerminalSymbol*)n->getCopy());
+				}
+				symbols_by_type.push_back(copies);
+			}
+			MatchContext context(symbols_by_type, false);
+			unsigned int i;
+			while((i = next++) < pending.size())
+			{
+				try
+				{
+					results[i] = (pending[i]->first == "R"
+						? matchPrecondition(pending[i]->second, context)
+						: matchAction(pending[i]->second, context));
+					matched[i] = true;
+				}
+				catch(std::string& error)
+				{
+					// matched again in file order, where the user can be
+					// prompted and errors are reported in order
+				}
+			}
+			for(const std::list<NonTerminalSymbol*>& copies : symbols_by_type)
+			{
+				for(NonTerminalSymbol* n : copies)
+				{
+					delete n;
+				}
+			}
+		};
+	std::vector<std::thread> workers;
+	for(unsigned int i = 1; i < (unsigned int)g_translation_threads
+		&& i < pending.size(); i++)
+	{
+		workers.push_back(std::thread(work));
+	}
+	// this thread is also a worker
+	work();
+	for(std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	for(unsigned int i = 0; i < pending.size(); i++)
+	{
+		if(matched[i])
+		{
+			matched_rules[pending[i]->first + pending[i]->second] = results[i];
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	setSimilarVariableNames
+
+	Finds the similarities between the variables named in the matched rules
+	in parallel, so that adding the rules in file order only has to look
+	them up.
+------------------------------------------------------------------------------*/
+void IntermediateFormParser::setSimilarVariableNames(
+	const std::vector<std::pair<std::string, std::string>>& rules)
+{
+	std::set<std::string> prop_names;
+	std::set<std::string> enum_names;
+	for(const std::pair<std::string, std::string>& rule : rules)
+	{
+		if(rule.first != "R" && rule.first != "A")
+		{
+			continue;
+		}
+		auto it = matched_rules.find(rule.first + rule.second);
+		if(it == matched_rules.end())
+		{
+			continue;
+		}
+		const ParsedRule* parsed_rule = &it->second;
+		if(parsed_rule->type == PRECONDITION_PROP_VALUE_CHECK
+			|| parsed_rule->type == ACTION_PROP_VALUE_ASSIGNMENT)
+		{
+			prop_names.insert(parsed_rule->fields[0]);
+		}
+		else if(parsed_rule->type == PRECONDITION_ENUM_VALUE_CHECK
+			|| parsed_rule->type == ACTION_ENUM_VALUE_ASSIGNMENT)
+		{
+			enum_names.insert(parsed_rule->fields[0]);
+		}
+	}
+	intermediate_form->setSimilarPropVariableNames(prop_names,
+		findSimilarNames(prop_names));
+	intermediate_form->setSimilarEnumVariableNames(enum_names,
+		findSimilarNames(enum_names));
+}
+
+/*------------------------------------------------------------------------------
+	findSimilarNames
+
+	Compares each name in a set with every other across a pool of threads,
+	finding the names similar to each name. Similarity is symmetric, so each
+	pair is only compared once.
+------------------------------------------------------------------------------*/
+const SimilarNames IntermediateFormParser::findSimilarNames(
+	const std::set<std::string>& names)
+{
+	std::vector<std::string> list(names.begin(), names.end());
+	// the later names similar to each name, indexed as list
+	std::vector<std::vector<std::pair<unsigned int, int>>> results(
+		list.size());
+	std::atomic<unsigned int> next(0);
+	auto work = [&]()
+		{
+			unsigned int i;
+			while((i = next++) < list.size())
+			{
+				for(unsigned int j = i + 1; j < list.size(); j++)
+				{
+					// only compute the LCS for names that could possibly
+					// reach the matching threshold
+					if(similarityUpperBound(list[i], list[j])
+						< g_string_matching_threshhold)
+					{
+						continue;
+					}
+					int similarity = stringSimilarity(list[i], list[j],
+						g_string_matching_threshhold);
+					if(similarity >= g_string_matching_threshhold)
+					{
+						results[i].push_back(std::make_pair(j, similarity));
+					}
+				}
+			}
+		};
+	std::vector<std::thread> workers;
+	for(unsigned int i = 1; i < (unsigned int)g_translation_threads
+		&& i < list.size(); i++)
+	{
+		workers.push_back(std::thread(work));
+	}
+	// this thread is also a worker
+	work();
+	for(std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	SimilarNames similar;
+	for(unsigned int i = 0; i < list.size(); i++)
+	{
+		for(const std::pair<unsigned int, int>& result : results[i])
+		{
+			similar[list[i]][list[result.first]] = result.second;
+			similar[list[result.first]][list[i]] = result.second;
+		}
+	}
+	return similar;
+}
+
 /*------------------------------------------------------------------------------
 	validateDataExtractionRuleIdentifier
 
@@ -1339,12 +2300,29 @@ std::list<std::string> IntermediateFormParser::constructBehaviourList(
 
 	Given a string corresponding to a precondition, possibly with a
 	state-n-seconds term, constructs and returns a new Precondition, or
-	throws an error if parsing was unsuccessful.
+	throws an error if parsing was unsuccessful. The rule matched and the
+	variable it checks are recorded in the given line.
 ------------------------------------------------------------------------------*/
-Precondition* IntermediateFormParser::parsePrecondition(const std::string s)
-	throw(std::string)
+Precondition* IntermediateFormParser::parsePrecondition(const std::string s,
+	ControlRuleLine& line) throw(std::string)
 {
-	Precondition* new_precondition = nullptr;
+	line.rule = matchRule("R", s);
+	line.variable_id = addRuleVariable(line.rule);
+	return buildPrecondition(line.rule, line.variable_id);
+}
+
+/*------------------------------------------------------------------------------
+	matchPrecondition
+
+	Given a string corresponding to a precondition, possibly with a
+	state-n-seconds term, matches it against the grammar and data extraction
+	rules and returns the matched rule, or throws an error if matching was
+	unsuccessful.
+------------------------------------------------------------------------------*/
+const ParsedRule IntermediateFormParser::matchPrecondition(const std::string s,
+	const MatchContext& context) throw(std::string)
+{
+	ParsedRule rule;
 	const std::size_t next_and = getLastAndConnective(s);
 	std::pair<const int, const std::pair<const bool, const bool>>*
 		state_info = nullptr;
@@ -1355,41 +2333,37 @@ Precondition* IntermediateFormParser::parsePrecondition(const std::string s)
 			std::string rest_of_s = s.substr(next_and + 5);
 			try
 			{
-				state_info = parseStateNSeconds(rest_of_s);
+				state_info = parseStateNSeconds(rest_of_s, context);
 			}
 			catch(std::string& error_state)
 			{
 				try
 				{
-					new_precondition = parsePreconditionNoStateNSeconds(s);
-					delete state_info;
-					return new_precondition;
+					return matchPreconditionNoStateNSeconds(s, context);
 				}
 				catch(std::string& error_precon)
 				{
 					throw(error_state + "OR\n" + error_precon);
 				}
 			}
-			new_precondition = parsePreconditionNoStateNSeconds(
-				s.substr(0, next_and));
+			rule = matchPreconditionNoStateNSeconds(s.substr(0, next_and),
+				context);
 			if(state_info->second.first)
 			{
-				new_precondition->setTimeConstraintType(
-					TimeConstraintType::BEEN_IN_STATE_FOR);
+				rule.time_constraint_type =
+					TimeConstraintType::BEEN_IN_STATE_FOR;
 			}
 			else
 			{
-				new_precondition->setTimeConstraintType(
-					TimeConstraintType::WAS_IN_STATE_WITHIN);
+				rule.time_constraint_type =
+					TimeConstraintType::WAS_IN_STATE_WITHIN;
 			}
-			new_precondition->setTimeConstraintSeconds(
-				state_info->first);
+			rule.time_constraint_seconds = state_info->first;
 			delete state_info;
 		}
 		else
 		{
-			new_precondition = parsePreconditionNoStateNSeconds(s);
-			delete state_info;
+			rule = matchPreconditionNoStateNSeconds(s, context);
 		}
 	}
 	catch(std::string& error)
@@ -1401,20 +2375,21 @@ Precondition* IntermediateFormParser::parsePrecondition(const std::string s)
 		throw(std::string("[parsePrecondition]->\n")
 			+ "error in precondition: " + trim(s) + "\n" + error);
 	}
-	return new_precondition;
+	return rule;
 }
 
 /*------------------------------------------------------------------------------
-	parsePreconditionNoStateNSeconds
+	matchPreconditionNoStateNSeconds
 
 	Given a string corresponding to a precondition, with no state-n-seconds
-	term, constructs and returns a new Precondition, or	throws an error if
-	parsing was unsuccessful.
+	term, matches it against the grammar and data extraction rules and
+	returns the matched rule, or throws an error if matching was
+	unsuccessful.
 ------------------------------------------------------------------------------*/
-Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
-	const std::string s) throw(std::string)
+const ParsedRule IntermediateFormParser::matchPreconditionNoStateNSeconds(
+	const std::string s, const MatchContext& context) throw(std::string)
 {
-	Precondition* new_precondition = nullptr;
+	ParsedRule rule;
 	std::vector<std::pair<int, NonTerminalSymbol*>*>
 		type_info_list;
 	try
@@ -1425,7 +2400,7 @@ Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
 				PRECONDITION_PROP_VALUE_CHECK,
 				PRECONDITION_ENUM_VALUE_CHECK,
 				PRECONDITION_TIME_CONSTRAINT
-			});
+			}, context);
 		validateAcceptingGrammarRules(&type_info_list);
 		if(type_info_list.empty())
 		{
@@ -1438,20 +2413,14 @@ Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
 		}
 		else
 		{
-			type_info = disambiguateCandidates(&type_info_list, s);
+			type_info = disambiguateCandidates(&type_info_list, s, context);
 		}
 		std::vector<std::string> values = getDataExtractionRuleValuesByName(
 			type_info->second->getName());
 		std::string string_var_1;
 		std::string string_var_2;
 		std::string string_var_3;
-		std::string string_var_4;
-		std::string string_var_5;
-		std::list<std::string> list_var;
-		bool bool_var;
-		PropVariable* prop_var;
-		EnumVariable* enum_var;
-		std::stringstream info_stream;
+		rule.type = type_info->first;
 		switch(type_info->first)
 		{
 		case PRECONDITION_PROP_VALUE_CHECK:
@@ -1460,27 +2429,11 @@ Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
 			string_var_2 = constructIdentifier(values[1], true,
 				type_info->second);
 			string_var_3 = constructString(values[2], true);
-			string_var_4 = constructString(values[3], true);
 
-			bool_var = toLower(string_var_2) ==
-				toLower(string_var_3) ? true : false;
-			info_stream	<< "disambiguation of propositional variable '"
-				<< string_var_1 << "'";
-			prop_var = intermediate_form->getPropVariableByName(string_var_1,
-				info_stream.str());
-
-			if(prop_var == nullptr)
-			{
-				prop_var = new PropVariable(string_var_1,
-					toLower(values[4]) == "true");
-				intermediate_form->addPropVariable(prop_var);
-			}
-			else if(toLower(values[4]) == "true")
-			{
-				prop_var->setNonDeterministic();
-			}
-			new_precondition = new PreconditionPropValueCheck(prop_var,
-				bool_var, TimeConstraintType::NONE, -1);
+			rule.fields.push_back(string_var_1);
+			rule.fields.push_back(toLower(string_var_2) ==
+				toLower(string_var_3) ? "1" : "0");
+			rule.fields.push_back(toLower(values[4]) == "true" ? "1" : "0");
 
 			break;
 
@@ -1490,26 +2443,10 @@ Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
 			string_var_2 = constructIdentifier(values[1], true,
 				type_info->second);
 
-			info_stream	<< "disambiguation of enumerated variable name '"
-				<< string_var_1 << '\'';
-			enum_var = intermediate_form->getEnumVariableByName(
-				string_var_1, info_stream.str());
-			if(enum_var == nullptr)
-			{
-				enum_var = new EnumVariable(string_var_1);
-				intermediate_form->addEnumVariable(enum_var);
-			}
-			if(toLower(values[2]) == "true")
-			{
-				enum_var->setHasNoneValue();
-			}
-			if(toLower(values[3]) == "true")
-			{
-				enum_var->setNonDeterministic();
-			}
-			string_var_2 = enum_var->addValue(string_var_2);
-			new_precondition = new PreconditionEnumValueCheck(enum_var,
-				string_var_2, TimeConstraintType::NONE, -1);
+			rule.fields.push_back(string_var_1);
+			rule.fields.push_back(string_var_2);
+			rule.fields.push_back(toLower(values[2]) == "true" ? "1" : "0");
+			rule.fields.push_back(toLower(values[3]) == "true" ? "1" : "0");
 
 			break;
 
@@ -1542,8 +2479,8 @@ Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
 			{
 				string_var_2 += ":00:00";
 			}
-			new_precondition = new PreconditionTimingConstraint(
-				string_var_1, string_var_2, TimeConstraintType::NONE, -1);
+			rule.fields.push_back(string_var_1);
+			rule.fields.push_back(string_var_2);
 
 			break;
 		}
@@ -1561,9 +2498,162 @@ Precondition* IntermediateFormParser::parsePreconditionNoStateNSeconds(
 	{
 		delete pair;
 	}
+	return rule;
+}
+
+/*------------------------------------------------------------------------------
+	buildPrecondition
+
+	Given a matched precondition and the id of the variable it checks,
+	constructs and returns a new Precondition.
+------------------------------------------------------------------------------*/
+Precondition* IntermediateFormParser::buildPrecondition(const ParsedRule& rule,
+	const int variable_id)
+{
+	Precondition* new_precondition = nullptr;
+	EnumVariable* enum_var;
+	switch(rule.type)
+	{
+	case PRECONDITION_PROP_VALUE_CHECK:
+		new_precondition =
+			intermediate_form->create<PreconditionPropValueCheck>(
+				intermediate_form->getPropVariables()[variable_id],
+				rule.fields[1] == "1", rule.time_constraint_type,
+				rule.time_constraint_seconds);
+
+		break;
+
+	case PRECONDITION_ENUM_VALUE_CHECK:
+		enum_var = intermediate_form->getEnumVariables()[variable_id];
+		// the value is spelled as it was first added
+		new_precondition =
+			intermediate_form->create<PreconditionEnumValueCheck>(enum_var,
+				enum_var->addValue(rule.fields[1]),
+				rule.time_constraint_type, rule.time_constraint_seconds);
+
+		break;
+
+	case PRECONDITION_TIME_CONSTRAINT:
+		new_precondition =
+			intermediate_form->create<PreconditionTimingConstraint>(
+				rule.fields[0], rule.fields[1], rule.time_constraint_type,
+				rule.time_constraint_seconds);
+
+		break;
+	}
 	return new_precondition;
 }
 
+/*------------------------------------------------------------------------------
+	addRuleVariable
+
+	Given a matched precondition or action, looks up or adds the variable it
+	checks or assigns, updates the variable as the rule requires, and
+	returns its id. Returns -1 if the rule names no variable.
+------------------------------------------------------------------------------*/
+const int IntermediateFormParser::addRuleVariable(const ParsedRule& rule)
+{
+	PropVariable* prop_var = nullptr;
+	EnumVariable* enum_var = nullptr;
+	std::stringstream info_stream;
+	switch(rule.type)
+	{
+	case PRECONDITION_PROP_VALUE_CHECK:
+		info_stream	<< "disambiguation of propositional variable '"
+			<< rule.fields[0] << "'";
+		break;
+
+	case ACTION_PROP_VALUE_ASSIGNMENT:
+		info_stream	<< "disambiguation of propositional variable '"
+			<< rule.fields[0] << "\'";
+		break;
+
+	case PRECONDITION_ENUM_VALUE_CHECK:
+		info_stream	<< "disambiguation of enumerated variable name '"
+			<< rule.fields[0] << '\'';
+		break;
+
+	case ACTION_ENUM_VALUE_ASSIGNMENT:
+		info_stream	<< "disambiguation of enumerated variable '"
+			<< rule.fields[0] << "\'";
+		break;
+
+	default:
+		return -1;
+	}
+	if(rule.type == PRECONDITION_PROP_VALUE_CHECK
+		|| rule.type == ACTION_PROP_VALUE_ASSIGNMENT)
+	{
+		prop_var = intermediate_form->getPropVariableByName(rule.fields[0],
+			info_stream.str());
+		if(prop_var == nullptr)
+		{
+			prop_var = intermediate_form->create<PropVariable>(rule.fields[0],
+				false);
+			intermediate_form->addPropVariable(prop_var);
+		}
+		updateRuleVariable(rule, prop_var->getId());
+		return prop_var->getId();
+	}
+	enum_var = intermediate_form->getEnumVariableByName(rule.fields[0],
+		info_stream.str());
+	if(enum_var == nullptr)
+	{
+		enum_var = intermediate_form->create<EnumVariable>(rule.fields[0]);
+		intermediate_form->addEnumVariable(enum_var);
+	}
+	updateRuleVariable(rule, enum_var->getId());
+	return enum_var->getId();
+}
+
+/*------------------------------------------------------------------------------
+	updateRuleVariable
+
+	Given a matched precondition or action and the id of the variable it
+	checks or assigns, marks the variable as non-deterministic, resetting,
+	or having a none value, and adds the value named, as the rule requires.
+------------------------------------------------------------------------------*/
+void IntermediateFormParser::updateRuleVariable(const ParsedRule& rule,
+	const int variable_id)
+{
+	EnumVariable* enum_var;
+	switch(rule.type)
+	{
+	case PRECONDITION_PROP_VALUE_CHECK:
+		if(rule.fields[2] == "1")
+		{
+			intermediate_form->getPropVariables()[variable_id]->
+				setNonDeterministic();
+		}
+
+		break;
+
+	case PRECONDITION_ENUM_VALUE_CHECK:
+		enum_var = intermediate_form->getEnumVariables()[variable_id];
+		if(rule.fields[2] == "1")
+		{
+			enum_var->setHasNoneValue();
+		}
+		if(rule.fields[3] == "1")
+		{
+			enum_var->setNonDeterministic();
+		}
+		enum_var->addValue(rule.fields[1]);
+
+		break;
+
+	case ACTION_ENUM_VALUE_ASSIGNMENT:
+		enum_var = intermediate_form->getEnumVariables()[variable_id];
+		if(rule.fields[2] == "1")
+		{
+			enum_var->setResets();
+		}
+		enum_var->addValue(rule.fields[1]);
+
+		break;
+	}
+}
+
 /*------------------------------------------------------------------------------
 	validateAcceptingGrammarRules
 
@@ -1692,12 +2782,13 @@ void IntermediateFormParser::validateAcceptingGrammarRules(
 	Prompts the user to select a matching grammar rule for a parsed term
 	if more than one match is found. A pair corresponding to the type
 	and accepting non-terminal symbol for the selected grammar rule is then
-	returned. Throws an error if no match is found.
+	returned. Throws an error if no match is found, if the selection cannot
+	be answered, or if a prompt is needed and the context does not allow one.
 ------------------------------------------------------------------------------*/
 std::pair<int, NonTerminalSymbol*>*
 	IntermediateFormParser::disambiguateCandidates(
 		std::vector<std::pair<int, NonTerminalSymbol*>*>* candidates,
-		const std::string s) throw(std::string)
+		const std::string s, const MatchContext& context) throw(std::string)
 {
 	if(candidates->size() == 0)
 	{
@@ -1708,6 +2799,11 @@ std::pair<int, NonTerminalSymbol*>*
 	{
 		return (*candidates)[0];
 	}
+	else if(!context.can_prompt)
+	{
+		throw(std::string("[disambiguateCandidates]->\n") +
+			"multiple matching data extraction rules\n");
+	}
 	else
 	{
 		displayTitle(DIVIDER_DISAMBIGUATION, DIVIDER_2,
@@ -1720,23 +2816,16 @@ std::pair<int, NonTerminalSymbol*>*
 				std::cout << "  " << index++ << ": " << pair->second->getName()
 					<< std::endl;
 			});
-		bool valid = false;
-		std::string selected_index;
-		int selected_index_int;
-		do
-		{
-			std::cout << "select a match by index: ";
-			std::cin >> selected_index;
-			if(isInteger(selected_index))
-			{
-				selected_index_int = stringToInteger(selected_index);
-				if(selected_index_int >= 1 && selected_index_int < index)
+		std::vector<std::string> key = {trim(s)};
+		const int selected_index_int = stringToInteger(
+			g_resolution_policy.prompt(PROMPT_DATA_EXTRACTION_RULE, key,
+				"select a match by index: ",
+				[&](const std::string& selected_index)
 				{
-					valid = true;
-				}
-			}
-
-		} while (!valid);
+					return isInteger(selected_index)
+						&& stringToInteger(selected_index) >= 1
+						&& stringToInteger(selected_index) < index;
+				}));
 		return (*candidates)[selected_index_int - 1];
 	}
 }
@@ -1774,8 +2863,8 @@ const std::size_t IntermediateFormParser::getLastAndConnective(
 	Throws an error if parsing was unsuccessful.
 ------------------------------------------------------------------------------*/
 std::pair<const int, const std::pair<const bool, const bool>>*
-	IntermediateFormParser::parseStateNSeconds(const std::string s)
-		throw (std::string)
+	IntermediateFormParser::parseStateNSeconds(const std::string s,
+		const MatchContext& context) throw (std::string)
 {
 	std::pair<const int, const std::pair<const bool, const bool>>*
 		state_info_pair = nullptr;
@@ -1786,7 +2875,7 @@ std::pair<const int, const std::pair<const bool, const bool>>*
 			std::vector<int>
 			{
 				STATE_N_SECONDS
-			});
+			}, context);
 
 		if(state_info_list.empty())
 		{
@@ -1803,7 +2892,8 @@ std::pair<const int, const std::pair<const bool, const bool>>*
 			}
 			else
 			{
-				state_info = *(disambiguateCandidates(&state_info_list, s));
+				state_info = *(disambiguateCandidates(&state_info_list, s,
+					context));
 			}
 			std::vector<std::string> values = getDataExtractionRuleValuesByName(
 				state_info.second->getName());
@@ -1844,27 +2934,40 @@ std::pair<const int, const std::pair<const bool, const bool>>*
 ------------------------------------------------------------------------------*/
 const std::vector<std::pair<int, NonTerminalSymbol*>*>
 	IntermediateFormParser::getAcceptingGrammarRules(const std::string s,
-		std::vector<int> types) const
+		std::vector<int> types, const MatchContext& context) const
 {
 	std::vector<std::pair<int, NonTerminalSymbol*>*> accepting_list;
+	// only rules that can accept the line need to be fed it
+	std::set<const NonTerminalSymbol*> candidates =
+		grammar_matcher.getCandidateRules(s);
 	for(int type: types)
 	{
 		if(type >= 1 && type <= NUM_TYPES)
 		{
+			// the automata of the context are in the same order as the
+			// symbols of the matcher
 			auto it = non_terminal_symbols_by_type[type - 1].begin();
 			auto end = non_terminal_symbols_by_type[type - 1].end();
+			auto context_it = context.symbols_by_type[type - 1].begin();
 			while(it != end)
 			{
-				NonTerminalSymbol* n = *it;
+				NonTerminalSymbol* n = *context_it;
+				if(candidates.find(*it) == candidates.end())
+				{
+					it++;
+					context_it++;
+					continue;
+				}
 				n->resetSymbol();
 				std::string input_string = s;
-				n->feedLine(input_string);
+				n->feedLine(input_string, context.can_prompt);
 				if(n->isAccepting())
 				{
 					accepting_list.push_back(
 						new std::pair<int, NonTerminalSymbol*>(type, n));
 				}
 				it++;
+				context_it++;
 			}
 		}
 	}
@@ -31,11 +31,14 @@
 #include <iostream>
 #include <list>
 #include <string>
+#include <vector>
 
 #include "define.h"
 #include "utility.h"
 #include "intermediate_parser/non_terminal_symbol.h"
+#include "intermediate_parser/token_cursor.h"
 #include "intermediate_parser/tokenize.h"
+#include "resolution_policy/resolution_policy.h"
 
 Automaton* NonTerminalSymbol::getCopy()
 {
@@ -133,15 +136,18 @@ const bool NonTerminalSymbol::isDead() const
 /*------------------------------------------------------------------------------
 	feedLine
 
-	Feeds a line, token by token, to the automaton.
+	Feeds a line, token by token, to the automaton. Throws an error if an
+	ambiguity in a +<any_text> symbol cannot be resolved, or if resolving it
+	needs a prompt that is not allowed.
 ------------------------------------------------------------------------------*/
-void NonTerminalSymbol::feedLine(const std::string line)
+void NonTerminalSymbol::feedLine(const std::string line, const bool can_prompt)
+	throw(std::string)
 {
-	std::string line_copy = line;
+	TokenCursor cursor(line);
 	// do this for each token in the line
-	while(hasNextToken(line_copy))
+	while(cursor.hasNextToken())
 	{
-		std::string token = getNextToken(line_copy);
+		std::string token = cursor.getNextToken().str();
 		Automaton* current_automaton = *current_automaton_it;
 		auto next_it = current_automaton_it;
 		next_it++;
@@ -153,14 +159,14 @@ void NonTerminalSymbol::feedLine(const std::string line)
 			&& current_automaton->getRepeat() == REPEAT_ONE_OR_MORE
 			&& current_automaton->isAccepting()
 			&& (*next_it)->getName() == token
-			&& hasNextToken(line_copy))
+			&& cursor.hasNextToken())
 		{
-			std::string line_copy_copy = line_copy;
+			TokenCursor rest_cursor(cursor.getRemaining());
 			std::list<std::string> rest_of_line;
 			// tokenize the rest of the input line
-			while(hasNextToken(line_copy_copy))
+			while(rest_cursor.hasNextToken())
 			{
-				rest_of_line.push_back(getNextToken(line_copy_copy));
+				rest_of_line.push_back(rest_cursor.getNextToken().str());
 			}
 			int count = 0;
 			for(std::string s : rest_of_line)
@@ -172,6 +178,11 @@ void NonTerminalSymbol::feedLine(const std::string line)
 					count++;
 				}
 			}
+			if(count > 0 && !can_prompt)
+			{
+				throw("[feedLine]->\nambiguity in input: " + trim(line)
+					+ "\n");
+			}
 			if(count > 0)
 			{
 				// prompt the user to choose the first occurrence of the token
@@ -192,24 +203,17 @@ void NonTerminalSymbol::feedLine(const std::string line)
 					std::cout << s << " ";
 				}
 				std::cout << std::endl;
-				std::string input;
-				int input_int;
-				bool valid = false;
-				while(!valid)
-				{
-					std::cout << "enter the first position of \'"
-						<< token << "\' not accepted by +<any_text> ["
-						<< "1" << "-" << integerToString(count + 1) << "]: ";
-					std::cin >> input;
-					if(isInteger(input))
-					{
-						input_int = stringToInteger(input);
-						if(input_int >= 1 && input_int <= count + 1)
+				std::vector<std::string> key = {trim(line), token};
+				const int input_int = stringToInteger(
+					g_resolution_policy.prompt(PROMPT_ANY_TEXT, key,
+						"enter the first position of \'" + token
+						+ "\' not accepted by +<any_text> [1-"
+						+ integerToString(count + 1) + "]: ",
+						[&](const std::string& s)
 						{
-							valid = true;
-						}
-					}
-				}
+							return isInteger(s) && stringToInteger(s) >= 1
+								&& stringToInteger(s) <= count + 1;
+						}));
 				rest_of_line.push_front(token);
 				index_count = 1;
 				auto it = rest_of_line.begin();
@@ -0,0 +1,239 @@
+/*==============================================================================
+	PreviousRunCache
+
+	The record of the last control rule file parsed with a set of grammar
+	and data extraction rule files.
+
+	File			: previous_run_cache.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "global.h"
+#include "utility.h"
+#include "intermediate/action.h"
+#include "intermediate/intermediate_form.h"
+#include "intermediate/intermediate_form_cache.h"
+#include "intermediate_parser/file_source.h"
+#include "intermediate_parser/previous_run_cache.h"
+
+const std::string PreviousRunCache::MAGIC = "CRUTONPR";
+const int PreviousRunCache::FORMAT_VERSION = 1;
+const std::string PreviousRunCache::EXTENSION = ".prc";
+
+/*------------------------------------------------------------------------------
+	computeKey
+
+	Sets the key of the cache file from the contents of the given grammar and
+	data extraction rule files, the resolution policy file, and the options
+	affecting parsing.
+------------------------------------------------------------------------------*/
+void PreviousRunCache::computeKey(const std::string& grammar_rule_file,
+	const std::string& data_rule_file) throw(std::string)
+{
+	CacheHash hash;
+	hash.addString(MAGIC + integerToString(FORMAT_VERSION) + EXEC_VERSION);
+	hash.addFile(grammar_rule_file);
+	hash.addFile(data_rule_file);
+	hash.addParseOptions();
+	key = hash;
+}
+
+/*------------------------------------------------------------------------------
+	getFilename
+
+	Returns the name of the cache file for the current key.
+------------------------------------------------------------------------------*/
+const std::string PreviousRunCache::getFilename() const
+{
+	return key.getFilename(directory, EXTENSION);
+}
+
+/*------------------------------------------------------------------------------
+	load
+
+	Returns the intermediate form held in the cache file for the current key,
+	or nullptr if there is no such file.
+------------------------------------------------------------------------------*/
+IntermediateForm* PreviousRunCache::load(std::vector<ControlRuleLine>& lines,
+	std::map<int, std::vector<Action*>>& unflattened_actions,
+	std::vector<std::pair<std::string, std::string>>& answers) const
+{
+	std::string filename = getFilename();
+	FileSource source(filename, true);
+	if(!source.isOpen())
+	{
+		return nullptr;
+	}
+	try
+	{
+		return decode(source.getData(), source.size(), lines,
+			unflattened_actions, answers);
+	}
+	catch(std::string& error)
+	{
+		displayWarning("ignoring invalid cache file \'" + filename + "\'\n"
+			+ error);
+		return nullptr;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	decode
+
+	Constructs the intermediate form held in the contents of a cache file,
+	and reads how it was parsed.
+------------------------------------------------------------------------------*/
+IntermediateForm* PreviousRunCache::decode(const char* data,
+	const std::size_t size, std::vector<ControlRuleLine>& lines,
+	std::map<int, std::vector<Action*>>& unflattened_actions,
+	std::vector<std::pair<std::string, std::string>>& answers) const
+		throw(std::string)
+{
+	CacheReader reader(data, size);
+	reader.expectBytes(MAGIC);
+	if(reader.getInt() != FORMAT_VERSION || !key.check(reader))
+	{
+		throw(std::string("cache file of a different version or key\n"));
+	}
+
+	IntermediateForm* intermediate_form =
+		IntermediateFormCache::decodeIntermediateForm(reader);
+	try
+	{
+		int num_behaviours = intermediate_form->getBehaviours().size();
+		// a variable id is checked against the larger of the two lists, the
+		// parser checks it against the list of the kind the rule names
+		int num_variables = std::max(
+			intermediate_form->getPropVariables().size(),
+			intermediate_form->getEnumVariables().size());
+		lines.clear();
+		int num_lines = reader.getInt();
+		for(int i = 0; i < num_lines; i++)
+		{
+			ControlRuleLine line;
+			line.text = reader.getString();
+			line.behaviour_id = reader.getIndex(num_behaviours);
+			line.variable_id = reader.getIndex(num_variables, -1);
+			line.rule.type = reader.getInt();
+			line.rule.time_constraint_type =
+				(TimeConstraintType)reader.getIndex(WAS_IN_STATE_WITHIN + 1);
+			line.rule.time_constraint_seconds = reader.getInt();
+			int num_fields = reader.getInt();
+			for(int j = 0; j < num_fields; j++)
+			{
+				line.rule.fields.push_back(reader.getString());
+			}
+			lines.push_back(line);
+		}
+		unflattened_actions.clear();
+		int num_unflattened = reader.getInt();
+		for(int i = 0; i < num_unflattened; i++)
+		{
+			std::vector<Action*>& actions =
+				unflattened_actions[reader.getIndex(num_behaviours)];
+			int num_actions = reader.getInt();
+			for(int j = 0; j < num_actions; j++)
+			{
+				actions.push_back(IntermediateFormCache::decodeAction(reader,
+					intermediate_form, num_behaviours));
+			}
+		}
+		answers.clear();
+		int num_answers = reader.getInt();
+		for(int i = 0; i < num_answers; i++)
+		{
+			std::string formatted_key = reader.getString();
+			answers.push_back(std::make_pair(formatted_key,
+				reader.getString()));
+		}
+		if(!reader.atEnd())
+		{
+			throw(std::string("unexpected data at end of file\n"));
+		}
+	}
+	catch(std::string& error)
+	{
+		delete intermediate_form;
+		throw(error);
+	}
+	return intermediate_form;
+}
+
+/*------------------------------------------------------------------------------
+	store
+
+	Writes an intermediate form, and how it was parsed, to the cache file for
+	the current key.
+------------------------------------------------------------------------------*/
+void PreviousRunCache::store(const IntermediateForm& intermediate_form,
+	const std::vector<ControlRuleLine>& lines,
+	const std::map<int, std::vector<Action*>>& unflattened_actions,
+	const std::vector<std::pair<std::string, std::string>>& answers) const
+		throw(std::string)
+{
+	CacheWriter writer;
+	writer.putBytes(MAGIC);
+	writer.putInt(FORMAT_VERSION);
+	key.put(writer);
+	IntermediateFormCache::encodeIntermediateForm(intermediate_form, writer);
+	writer.putInt(lines.size());
+	for(const ControlRuleLine& line : lines)
+	{
+		writer.putString(line.text);
+		writer.putInt(line.behaviour_id);
+		writer.putInt(line.variable_id);
+		writer.putInt(line.rule.type);
+		writer.putInt(line.rule.time_constraint_type);
+		writer.putInt(line.rule.time_constraint_seconds);
+		writer.putInt(line.rule.fields.size());
+		for(const std::string& field : line.rule.fields)
+		{
+			writer.putString(field);
+		}
+	}
+	writer.putInt(unflattened_actions.size());
+	for(auto& pair : unflattened_actions)
+	{
+		writer.putInt(pair.first);
+		writer.putInt(pair.second.size());
+		for(Action* action : pair.second)
+		{
+			IntermediateFormCache::encodeAction(action, writer);
+		}
+	}
+	writer.putInt(answers.size());
+	for(const std::pair<std::string, std::string>& answer : answers)
+	{
+		writer.putString(answer.first);
+		writer.putString(answer.second);
+	}
+	writer.writeToFile(getFilename());
+}
@@ -0,0 +1,163 @@
+/*==============================================================================
+	TokenCursor
+
+	File			: token_cursor.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <cstdio>
+#include <string>
+
+#include "intermediate_parser/token_cursor.h"
+
+/*------------------------------------------------------------------------------
+	hasNextToken
+
+	Returns true if there is a token available to read. Does not move
+	the cursor.
+------------------------------------------------------------------------------*/
+const bool TokenCursor::hasNextToken() const
+{
+	return skipWhitespace(pos) < length;
+}
+
+/*------------------------------------------------------------------------------
+	getNextToken
+
+	Returns the next available token and moves the cursor past it.
+------------------------------------------------------------------------------*/
+const StringSpan TokenCursor::getNextToken()
+{
+	StringSpan token = peekNextToken();
+	if(!token.empty())
+	{
+		pos = token.getOffset() - base_offset + token.size();
+	}
+	return token;
+}
+
+/*------------------------------------------------------------------------------
+	peekNextToken
+
+	Returns the next available token without moving the cursor.
+------------------------------------------------------------------------------*/
+const StringSpan TokenCursor::peekNextToken() const
+{
+	std::size_t start = skipWhitespace(pos);
+	std::size_t end = start;
+	while(end < length && !isWhitespace(data[end]))
+	{
+		end++;
+	}
+	return StringSpan(data + start, end - start, base_offset + start);
+}
+
+/*------------------------------------------------------------------------------
+	getNextLine
+
+	Returns the next line, without the terminating newline, and moves the
+	cursor to the start of the following line.
+------------------------------------------------------------------------------*/
+const StringSpan TokenCursor::getNextLine()
+{
+	std::size_t start = pos;
+	while(pos < length && data[pos] != '\n' && data[pos] != (char)EOF)
+	{
+		pos++;
+	}
+	StringSpan line(data + start, pos - start, base_offset + start);
+	if(pos < length)
+	{
+		// skip the terminating character
+		pos++;
+	}
+	return line;
+}
+
+/*------------------------------------------------------------------------------
+	getRemaining
+
+	Returns the input that has not yet been read, without moving the
+	cursor.
+------------------------------------------------------------------------------*/
+const StringSpan TokenCursor::getRemaining() const
+{
+	return StringSpan(data + pos, length - pos, base_offset + pos);
+}
+
+/*------------------------------------------------------------------------------
+	getShortestPrefixEndingWithChar
+
+	Returns the shortest prefix of the remaining input that terminates
+	with the given character, and moves the cursor past it. Whitespace
+	is removed from the prefix, so it is returned as a string.
+------------------------------------------------------------------------------*/
+const std::string TokenCursor::getShortestPrefixEndingWithChar(const char c)
+{
+	std::size_t remaining = length - pos;
+	if(remaining == 0)
+	{
+		return "";
+	}
+	else if(remaining == 1)
+	{
+		std::string prefix(data + pos, 1);
+		pos = length;
+		return prefix;
+	}
+
+	std::string prefix = "";
+	std::size_t end = skipWhitespace(pos);
+	char input_c;
+	while(end < length)
+	{
+		input_c = data[end++];
+		if(!isWhitespace(input_c))
+		{
+			prefix += input_c;
+		}
+		if(input_c == c)
+		{
+			break;
+		}
+	}
+	pos = end;
+	return prefix;
+}
+
+/*------------------------------------------------------------------------------
+	skipWhitespace
+
+	Returns the position of the first non-whitespace character at or
+	after the given position.
+------------------------------------------------------------------------------*/
+std::size_t TokenCursor::skipWhitespace(std::size_t from) const
+{
+	while(from < length && isWhitespace(data[from]))
+	{
+		from++;
+	}
+	return from;
+}
@@ -0,0 +1,259 @@
+/*==============================================================================
+	ConeOfInfluence
+
+	File			: cone_of_influence.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <string>
+#include <vector>
+
+#include "utility.h"
+#include "intermediate/action.h"
+#include "intermediate/action_execute.h"
+#include "intermediate/action_execute_non_deterministic.h"
+#include "intermediate/behaviour.h"
+#include "intermediate/enum_variable.h"
+#include "intermediate/intermediate_form.h"
+#include "intermediate/precondition.h"
+#include "intermediate/precondition_enum_value_check.h"
+#include "intermediate/precondition_prop_value_check.h"
+#include "intermediate/prop_variable.h"
+#include "intermediate_parser/file_source.h"
+#include "intermediate_parser/token_cursor.h"
+#include "nusmv_translator/cone_of_influence.h"
+#include "nusmv_translator/nusmv_definitions.h"
+#include "nusmv_translator/nusmv_translator.h"
+
+/*------------------------------------------------------------------------------
+	Constructor
+
+	Indexes the names of the behaviours and variables, both as they appear in
+	the rule files and as they appear in the NuSMV translation.
+------------------------------------------------------------------------------*/
+ConeOfInfluence::ConeOfInfluence(const IntermediateForm* inter) :
+	intermediate_form(inter),
+	behaviour_in_cone(inter->getBehaviours().size(), false),
+	prop_variable_in_cone(inter->getPropVariables().size(), false),
+	enum_variable_in_cone(inter->getEnumVariables().size(), false)
+{
+	for(Behaviour* b : intermediate_form->getBehaviours())
+	{
+		const std::string identifier =
+			NuSMVTranslator::validateIdentifier(b->getName());
+		behaviour_names.insert(std::make_pair(b->getName(), b->getId()));
+		behaviour_names.insert(std::make_pair(
+			std::string(SCHEDULE) + "_" + identifier, b->getId()));
+		behaviour_names.insert(std::make_pair(
+			std::string(BEHAVIOUR_PREFIX) + identifier, b->getId()));
+		behaviour_names.insert(std::make_pair(
+			std::string(PRECONDITION_PREFIX) + identifier, b->getId()));
+	}
+	for(PropVariable* p : intermediate_form->getPropVariables())
+	{
+		prop_variable_names.insert(std::make_pair(p->getName(), p->getId()));
+		prop_variable_names.insert(std::make_pair(
+			NuSMVTranslator::validateIdentifier(p->getName()), p->getId()));
+	}
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		enum_variable_names.insert(std::make_pair(e->getName(), e->getId()));
+		enum_variable_names.insert(std::make_pair(
+			NuSMVTranslator::validateIdentifier(e->getName()), e->getId()));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	loadTargets
+
+	Adds each target in the given file, one per line. Lines that are empty or
+	begin with # are ignored. Throws an error if the file cannot be read or a
+	target matches nothing.
+------------------------------------------------------------------------------*/
+void ConeOfInfluence::loadTargets(const std::string& filename)
+	throw(std::string)
+{
+	FileSource file_source(filename);
+	if(!file_source.isOpen())
+	{
+		throw("[loadTargets]->\nerror loading file \'" + filename + "\'\n");
+	}
+	TokenCursor file_cursor(file_source.getSpan());
+	int line_number = 0;
+	while(!file_cursor.atEnd())
+	{
+		std::string line = file_cursor.getNextLine().str();
+		line_number++;
+		const std::size_t first = line.find_first_not_of(" \t\r");
+		if(first == std::string::npos || line[first] == '#')
+		{
+			continue;
+		}
+		line = line.substr(first, line.find_last_not_of(" \t\r") + 1 - first);
+		try
+		{
+			addTarget(line);
+		}
+		catch(const std::string& error)
+		{
+			throw("[loadTargets]->\nerror on line "
+				+ integerToString(line_number) + " of file \'" + filename
+				+ "\'\n" + error);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	addTarget
+
+	Adds a target, which is either the name of a behaviour or variable, or a
+	NuSMV specification whose identifiers name behaviours or variables as
+	they appear in the translation. Throws an error if the target matches
+	nothing.
+------------------------------------------------------------------------------*/
+void ConeOfInfluence::addTarget(const std::string& target) throw(std::string)
+{
+	if(addTargetName(target))
+	{
+		return;
+	}
+	// split a specification into identifiers, ignoring operators, keywords
+	// and any identifiers that are not in the translation
+	bool found = false;
+	std::string identifier;
+	for(const char c : target + " ")
+	{
+		if(NuSMVTranslator::isValidCharacter(c))
+		{
+			identifier += c;
+		}
+		else if(!identifier.empty())
+		{
+			found = addTargetName(identifier) || found;
+			identifier.clear();
+		}
+	}
+	if(!found)
+	{
+		throw("[addTarget]->\ntarget \'" + target
+			+ "\' names no behaviour or variable\n");
+	}
+}
+
+/*------------------------------------------------------------------------------
+	compute
+
+	Computes the cone of influence of the targets added so far.
+------------------------------------------------------------------------------*/
+void ConeOfInfluence::compute()
+{
+	for(Behaviour* b : intermediate_form->getBehaviours())
+	{
+		if(b->isSchedulable())
+		{
+			addBehaviour(b);
+		}
+	}
+	for(int id : target_behaviours)
+	{
+		addBehaviour(intermediate_form->getBehaviour(id));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	addTargetName
+
+	Adds whatever the given name or identifier denotes to the targets.
+------------------------------------------------------------------------------*/
+const bool ConeOfInfluence::addTargetName(const std::string& name)
+{
+	bool found = false;
+	auto behaviour_range = behaviour_names.equal_range(name);
+	for(auto it = behaviour_range.first; it != behaviour_range.second; it++)
+	{
+		target_behaviours.push_back(it->second);
+		found = true;
+	}
+	auto prop_range = prop_variable_names.equal_range(name);
+	for(auto it = prop_range.first; it != prop_range.second; it++)
+	{
+		prop_variable_in_cone[it->second] = true;
+		found = true;
+	}
+	auto enum_range = enum_variable_names.equal_range(name);
+	for(auto it = enum_range.first; it != enum_range.second; it++)
+	{
+		enum_variable_in_cone[it->second] = true;
+		found = true;
+	}
+	return found;
+}
+
+/*------------------------------------------------------------------------------
+	addBehaviour
+
+	Adds the given behaviour to the cone, together with every behaviour it may
+	execute and the variables checked by their preconditions.
+------------------------------------------------------------------------------*/
+void ConeOfInfluence::addBehaviour(Behaviour* behaviour)
+{
+	if(behaviour_in_cone[behaviour->getId()])
+	{
+		return;
+	}
+	behaviour_in_cone[behaviour->getId()] = true;
+	for(Precondition* p : behaviour->getPreconditions())
+	{
+		if(p->getPreconditionType() == PreconditionType::PROP_VALUE_CHECK)
+		{
+			PropVariable* prop_var =
+				((PreconditionPropValueCheck*)p)->getPropVariable();
+			prop_variable_in_cone[prop_var->getId()] = true;
+		}
+		else if(p->getPreconditionType()
+			== PreconditionType::ENUM_VALUE_CHECK)
+		{
+			EnumVariable* enum_var =
+				((PreconditionEnumValueCheck*)p)->getEnumVariable();
+			enum_variable_in_cone[enum_var->getId()] = true;
+		}
+	}
+	for(Action* action : behaviour->getActions())
+	{
+		if(action->getActionType() == ActionType::EXECUTE)
+		{
+			addBehaviour(intermediate_form->getBehaviour(
+				((ActionExecute*)action)->getBehaviourId()));
+		}
+		else if(action->getActionType() == ActionType::EXECUTE_NON_D)
+		{
+			for(int id :
+				((ActionExecuteNonDeterministic*)action)->getBehaviourIds())
+			{
+				addBehaviour(intermediate_form->getBehaviour(id));
+			}
+		}
+	}
+}
@@ -0,0 +1,296 @@
+/*==============================================================================
+	ExpressionDag
+
+	File			: expression_dag.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+
+#include "utility.h"
+#include "nusmv_translator/expression_dag.h"
+
+/*------------------------------------------------------------------------------
+	Constructor
+
+	Creates a DAG holding only the constants TRUE and FALSE.
+------------------------------------------------------------------------------*/
+ExpressionDag::ExpressionDag()
+{
+	addNode(EXPRESSION_TRUE, "", -1, -1);
+	addNode(EXPRESSION_FALSE, "", -1, -1);
+}
+
+/*------------------------------------------------------------------------------
+	addAtom
+
+	Returns the node for an expression that is not simplified further.
+------------------------------------------------------------------------------*/
+const int ExpressionDag::addAtom(const std::string& text)
+{
+	return addNode(EXPRESSION_ATOM, text, -1, -1);
+}
+
+/*------------------------------------------------------------------------------
+	addNot
+
+	Returns the node for the negation of an expression.
+------------------------------------------------------------------------------*/
+const int ExpressionDag::addNot(const int operand)
+{
+	switch(nodes[operand].type)
+	{
+	case EXPRESSION_TRUE:
+		return addConstant(false);
+	case EXPRESSION_FALSE:
+		return addConstant(true);
+	case EXPRESSION_NOT:
+		// !!a = a
+		return nodes[operand].left;
+	default:
+		return addNode(EXPRESSION_NOT, "", operand, -1);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	addAnd
+
+	Returns the node for the conjunction of two expressions.
+------------------------------------------------------------------------------*/
+const int ExpressionDag::addAnd(const int left, const int right)
+{
+	if(nodes[left].type == EXPRESSION_FALSE
+		|| nodes[right].type == EXPRESSION_FALSE || isComplement(left, right))
+	{
+		return addConstant(false);
+	}
+	// TRUE & a = a, a & a = a, a & (a | b) = a
+	if(nodes[left].type == EXPRESSION_TRUE || left == right
+		|| hasOperand(left, EXPRESSION_OR, right))
+	{
+		return right;
+	}
+	if(nodes[right].type == EXPRESSION_TRUE
+		|| hasOperand(right, EXPRESSION_OR, left))
+	{
+		return left;
+	}
+	return addNode(EXPRESSION_AND, "", left, right);
+}
+
+/*------------------------------------------------------------------------------
+	addOr
+
+	Returns the node for the disjunction of two expressions.
+------------------------------------------------------------------------------*/
+const int ExpressionDag::addOr(const int left, const int right)
+{
+	if(nodes[left].type == EXPRESSION_TRUE
+		|| nodes[right].type == EXPRESSION_TRUE || isComplement(left, right))
+	{
+		return addConstant(true);
+	}
+	// FALSE | a = a, a | a = a, a | (a & b) = a
+	if(nodes[left].type == EXPRESSION_FALSE || left == right
+		|| hasOperand(left, EXPRESSION_AND, right))
+	{
+		return right;
+	}
+	if(nodes[right].type == EXPRESSION_FALSE
+		|| hasOperand(right, EXPRESSION_AND, left))
+	{
+		return left;
+	}
+	return addNode(EXPRESSION_OR, "", left, right);
+}
+
+/*------------------------------------------------------------------------------
+	nameSharedNodes
+
+	Names each conjunction and disjunction that is used more than once.
+------------------------------------------------------------------------------*/
+void ExpressionDag::nameSharedNodes(const std::string& prefix)
+{
+	std::vector<int> uses(nodes.size(), 0);
+	std::vector<bool> visited(nodes.size(), false);
+	std::vector<int> order;
+	for(int root : roots)
+	{
+		uses[root]++;
+		countUses(root, uses, visited, order);
+	}
+	names.assign(nodes.size(), "");
+	shared_nodes.clear();
+	for(int node : order)
+	{
+		if(uses[node] > 1 && (nodes[node].type == EXPRESSION_AND
+			|| nodes[node].type == EXPRESSION_OR))
+		{
+			shared_nodes.push_back(node);
+			names[node] = prefix + integerToString(shared_nodes.size());
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	getExpression
+
+	Returns the expression of a node, referring to shared nodes by name.
+------------------------------------------------------------------------------*/
+const std::string ExpressionDag::getExpression(const int node) const
+{
+	return buildExpression(node, false);
+}
+
+/*------------------------------------------------------------------------------
+	getDefinition
+
+	Returns the expression of a node, written out in full even if the node
+	itself is shared.
+------------------------------------------------------------------------------*/
+const std::string ExpressionDag::getDefinition(const int node) const
+{
+	return buildExpression(node, true);
+}
+
+/*------------------------------------------------------------------------------
+	addNode
+
+	Returns the node with the given contents, creating it if it does not
+	already exist.
+------------------------------------------------------------------------------*/
+const int ExpressionDag::addNode(const ExpressionNodeType type,
+	const std::string& text, const int left, const int right)
+{
+	// a & b and b & a share a node, which keeps the order it was created with
+	std::string key = integerToString(type) + ":";
+	if(type == EXPRESSION_ATOM)
+	{
+		key += text;
+	}
+	else
+	{
+		key += integerToString(left < right ? left : right) + ","
+			+ integerToString(left < right ? right : left);
+	}
+	auto it = node_index.find(key);
+	if(it != node_index.end())
+	{
+		return it->second;
+	}
+	ExpressionNode expression_node = {type, text, left, right};
+	nodes.push_back(expression_node);
+	names.push_back("");
+	node_index.insert(std::make_pair(key, nodes.size() - 1));
+	return nodes.size() - 1;
+}
+
+/*------------------------------------------------------------------------------
+	hasOperand
+
+	Returns true if a node is an operator of the given type with the given
+	operand.
+------------------------------------------------------------------------------*/
+const bool ExpressionDag::hasOperand(const int node,
+	const ExpressionNodeType type, const int operand) const
+{
+	return nodes[node].type == type
+		&& (nodes[node].left == operand || nodes[node].right == operand);
+}
+
+/*------------------------------------------------------------------------------
+	isComplement
+
+	Returns true if one of the given nodes is the negation of the other.
+------------------------------------------------------------------------------*/
+const bool ExpressionDag::isComplement(const int node_1, const int node_2)
+	const
+{
+	return hasOperand(node_1, EXPRESSION_NOT, node_2)
+		|| hasOperand(node_2, EXPRESSION_NOT, node_1);
+}
+
+/*------------------------------------------------------------------------------
+	countUses
+
+	Counts the uses of the operands of a node and of the nodes below it,
+	visiting each node once.
+------------------------------------------------------------------------------*/
+void ExpressionDag::countUses(const int node, std::vector<int>& uses,
+	std::vector<bool>& visited, std::vector<int>& order) const
+{
+	if(visited[node])
+	{
+		return;
+	}
+	visited[node] = true;
+	for(int operand : {nodes[node].left, nodes[node].right})
+	{
+		if(operand >= 0)
+		{
+			uses[operand]++;
+			countUses(operand, uses, visited, order);
+		}
+	}
+	order.push_back(node);
+}
+
+/*------------------------------------------------------------------------------
+	buildExpression
+
+	Builds the expression of a node.
+------------------------------------------------------------------------------*/
+const std::string ExpressionDag::buildExpression(const int node,
+	const bool expand) const
+{
+	const ExpressionNode& expression_node = nodes[node];
+	if(!expand && !names[node].empty())
+	{
+		return names[node];
+	}
+	switch(expression_node.type)
+	{
+	case EXPRESSION_TRUE:
+		return "TRUE";
+	case EXPRESSION_FALSE:
+		return "FALSE";
+	case EXPRESSION_ATOM:
+		return expression_node.text;
+	case EXPRESSION_NOT:
+		// ! binds more tightly than the operators within an atom
+		if(nodes[expression_node.left].type == EXPRESSION_ATOM
+			&& nodes[expression_node.left].text.find(' ')
+				!= std::string::npos)
+		{
+			return "!(" + nodes[expression_node.left].text + ")";
+		}
+		return "!" + buildExpression(expression_node.left, false);
+	case EXPRESSION_AND:
+		return "(" + buildExpression(expression_node.left, false) + " & "
+			+ buildExpression(expression_node.right, false) + ")";
+	default:
+		return "(" + buildExpression(expression_node.left, false) + " | "
+			+ buildExpression(expression_node.right, false) + ")";
+	}
+}
@@ -0,0 +1,251 @@
+/*==============================================================================
+	NuSMVModelStatistics
+
+	Measures the size of a NuSMV model as it is written: its variables, the
+	bits needed to encode its state, its definitions, the branches of its
+	case expressions, and the size of each section.
+
+	File			: nusmv_model_statistics.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+
+#include "nusmv_translator/nusmv_model_statistics.h"
+
+/*------------------------------------------------------------------------------
+	scan
+
+	Measures a block of the model's text.
+------------------------------------------------------------------------------*/
+void NuSMVModelStatistics::scan(const char* data, const std::size_t length)
+{
+	const char* end = data + length;
+	while(data != end)
+	{
+		const char* newline = std::find(data, end, '\n');
+		line.append(data, newline);
+		if(newline == end)
+		{
+			// the rest of the line is in the next block
+			return;
+		}
+		scanLine(line);
+		line.clear();
+		data = newline + 1;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	writeJson
+
+	Writes the measurements as a JSON object.
+------------------------------------------------------------------------------*/
+void NuSMVModelStatistics::writeJson(std::ostream& os, const int num_tabs)
+	const
+{
+	unsigned long long num_defines = 0;
+	unsigned long long num_case_branches = 0;
+	unsigned long long num_bytes = 0;
+	for(const Section& s : sections)
+	{
+		if(s.name == "DEFINE")
+		{
+			num_defines += s.num_statements;
+		}
+		num_case_branches += s.num_case_branches;
+		num_bytes += s.num_bytes;
+	}
+	std::string indent(num_tabs, '\t');
+	os << "{\n"
+		<< indent << "\"variables\": " << num_variables << ",\n"
+		<< indent << "\"module_instances\": " << num_module_instances << ",\n"
+		<< indent << "\"input_variables\": " << num_input_variables << ",\n"
+		<< indent << "\"state_bits\": " << num_state_bits << ",\n"
+		<< indent << "\"input_bits\": " << num_input_bits << ",\n"
+		<< indent << "\"defines\": " << num_defines << ",\n"
+		<< indent << "\"case_branches\": " << num_case_branches << ",\n"
+		<< indent << "\"bytes\": " << num_bytes << ",\n"
+		<< indent << "\"sections\": [";
+	for(unsigned int i = 0; i < sections.size(); i++)
+	{
+		// section names are keywords and module names, and need no escaping
+		os << (i == 0 ? "\n" : ",\n") << indent << "\t{\"name\": \""
+			<< sections[i].name << "\", \"bytes\": " << sections[i].num_bytes
+			<< ", \"lines\": " << sections[i].num_lines
+			<< ", \"statements\": " << sections[i].num_statements
+			<< ", \"case_branches\": " << sections[i].num_case_branches
+			<< "}";
+	}
+	os << "\n" << indent << "]\n" << std::string(num_tabs - 1, '\t') << "}";
+}
+
+/*------------------------------------------------------------------------------
+	addSection
+
+	Makes the section with the given name current, adding it if it has not
+	been seen before.
+------------------------------------------------------------------------------*/
+void NuSMVModelStatistics::addSection(const std::string& name)
+{
+	for(section = 0; section < sections.size(); section++)
+	{
+		if(sections[section].name == name)
+		{
+			return;
+		}
+	}
+	Section s;
+	s.name = name;
+	s.num_bytes = 0;
+	s.num_lines = 0;
+	s.num_statements = 0;
+	s.num_case_branches = 0;
+	sections.push_back(s);
+}
+
+/*------------------------------------------------------------------------------
+	scanLine
+
+	Measures a complete line of the model's text. The translator writes the
+	keywords that open a section, and those that open and close a case
+	expression, on lines of their own.
+------------------------------------------------------------------------------*/
+void NuSMVModelStatistics::scanLine(const std::string& text)
+{
+	std::size_t first = text.find_first_not_of(" \t");
+	std::string trimmed = first == std::string::npos ? "" :
+		text.substr(first, text.find_last_not_of(" \t") - first + 1);
+	if(trimmed.compare(0, 7, "MODULE ") == 0)
+	{
+		module = trimmed.substr(7, trimmed.find('(') - 7);
+		addSection("MODULE " + module);
+	}
+	else if(module == "main" && (trimmed == "VAR" || trimmed == "IVAR"
+		|| trimmed == "FROZENVAR" || trimmed == "ASSIGN" || trimmed == "DEFINE"
+		|| trimmed == "CONSTANTS"))
+	{
+		addSection(trimmed);
+	}
+	Section& s = sections[section];
+	s.num_bytes += text.size() + 1;
+	s.num_lines++;
+	if(trimmed.empty() || trimmed.compare(0, 2, "--") == 0)
+	{
+		return;
+	}
+	if(trimmed == "case")
+	{
+		case_depth++;
+	}
+	else if(trimmed.compare(0, 4, "esac") == 0)
+	{
+		case_depth--;
+		if(case_depth == 0)
+		{
+			s.num_statements++;
+		}
+	}
+	else if(trimmed.back() == ';')
+	{
+		if(case_depth > 0)
+		{
+			s.num_case_branches++;
+			return;
+		}
+		s.num_statements++;
+		if(s.name == "VAR" || s.name == "FROZENVAR" || s.name == "IVAR")
+		{
+			countDeclaration(trimmed);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	countDeclaration
+
+	Counts a variable declared in a VAR, FROZENVAR or IVAR section.
+------------------------------------------------------------------------------*/
+void NuSMVModelStatistics::countDeclaration(const std::string& declaration)
+{
+	std::size_t colon = declaration.find(':');
+	if(colon == std::string::npos)
+	{
+		return;
+	}
+	std::string type = declaration.substr(colon + 1,
+		declaration.size() - colon - 2);
+	type.erase(0, type.find_first_not_of(" \t"));
+	unsigned int bits = getTypeBits(type);
+	if(sections[section].name == "IVAR")
+	{
+		num_input_variables++;
+		num_input_bits += bits;
+	}
+	else if(type.find('(') != std::string::npos)
+	{
+		num_module_instances++;
+	}
+	else
+	{
+		num_variables++;
+		num_state_bits += bits;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	getTypeBits
+
+	Returns the number of bits needed to encode a variable of the given type,
+	which is 0 for a module instance.
+------------------------------------------------------------------------------*/
+const unsigned int NuSMVModelStatistics::getTypeBits(const std::string& type)
+{
+	unsigned long long num_values = 0;
+	std::size_t range = type.find("..");
+	if(type == "boolean")
+	{
+		num_values = 2;
+	}
+	else if(!type.empty() && type[0] == '{')
+	{
+		num_values = std::count(type.begin(), type.end(), ',') + 1;
+	}
+	else if(range != std::string::npos)
+	{
+		num_values = std::atoll(type.substr(range + 2).c_str())
+			- std::atoll(type.substr(0, range).c_str()) + 1;
+	}
+	unsigned int bits = 0;
+	while(((unsigned long long)1 << bits) < num_values)
+	{
+		bits++;
+	}
+	return bits;
+}
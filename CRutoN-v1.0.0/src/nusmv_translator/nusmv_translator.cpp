@@ -28,24 +28,34 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <cstdint>
 #include <ctime>
-#include <fstream>
+#include <functional>
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "define.h"
 #include "utility.h"
 #include "enums/action_type.h"
 #include "enums/precondition_type.h"
+#include "enums/section_input.h"
 #include "enums/time_constraint_type.h"
 #include "enums/tree_node_type.h"
+#include "enums/variable_class.h"
 #include "intermediate/behaviour.h"
+#include "intermediate/cache_file.h"
 #include "intermediate/enum_variable.h"
 #include "intermediate/intermediate_form.h"
+#include "intermediate/intermediate_form_cache.h"
 #include "intermediate/logical_expression_tree.h"
 #include "intermediate/tree_node.h"
 #include "intermediate/prop_variable.h"
@@ -59,9 +69,17 @@
 #include "intermediate/precondition_enum_value_check.h"
 #include "intermediate/precondition_prop_value_check.h"
 #include "intermediate/precondition_timing_constraint.h"
+#include "intermediate_parser/file_source.h"
+#include "intermediate_parser/token_cursor.h"
 #include "intermediate_parser/tokenize.h"
+#include "nusmv_translator/cone_of_influence.h"
+#include "nusmv_translator/expression_dag.h"
 #include "nusmv_translator/nusmv_definitions.h"
+#include "nusmv_translator/nusmv_string_writer.h"
 #include "nusmv_translator/nusmv_translator.h"
+#include "nusmv_translator/nusmv_writer.h"
+#include "nusmv_translator/translation_cache.h"
+#include "statistics/phase_timer.h"
 
 // build a string corresponding to the behaviour module
 const std::string NuSMVTranslator::MODULE_BEHAVIOUR =
@@ -88,229 +106,213 @@ NuSMVTranslator::~NuSMVTranslator()
 }
 
 /*------------------------------------------------------------------------------
-	translate
+	prepareTranslation
 
-	Translates the intermediate form into NuSMV input, which is returned as
-	a string. Initial values for variables can be specified in the initial
-	value file.
+	Analyses the intermediate form before it is translated. The given initial
+	values are assigned to variables.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::translate(std::string& initial_value_file)
+const bool NuSMVTranslator::prepareTranslation(
+	const std::map<std::string, std::string>& initial_values)
 {
-	if(buildInitialVariableValueMap(initial_value_file))
-	{
-		return translate();
-	}
-	else
-	{
-		// there was an error in the initial value file, return the empty string
-		return "";
-	}
+	initial_variable_values = initial_values;
+	return prepareTranslation();
 }
 
 /*------------------------------------------------------------------------------
-	translate
+	prepareTranslation
 
-	Translates the intermediate form into NuSMV input, which is returned as
-	a string.
+	Analyses the intermediate form before it is translated.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::translate()
+const bool NuSMVTranslator::prepareTranslation()
 {
+	PhaseTimer timer(statistics, "buildBehaviourLists");
 	buildBehaviourLists();
-	if(g_time_of_day == "")
+	timer.next("classifyVariables");
+	classifyVariables();
+	// the inputs of the sections that are built, the maps built from an
+	// input are only needed if a section built from it is
+	int built_inputs = ~0;
+	if(translation_cache != nullptr)
+	{
+		timer.next("loadTranslationCache");
+		computeInputDigests();
+		translation_cache->computeKey(options);
+		std::vector<Section> sections;
+		getSections(sections);
+		built_inputs = 0;
+		unsigned int num_built = 0;
+		for(const Section& section : sections)
+		{
+			if(translation_cache->find(section.name,
+				getSectionDigest(section.inputs)) == nullptr)
+			{
+				built_inputs |= section.inputs;
+				num_built++;
+			}
+		}
+		if(num_built < sections.size())
+		{
+			std::cout << integerToString(num_built) + " of "
+				+ integerToString(sections.size())
+				+ " sections translated again, from the cache\n";
+		}
+	}
+	if(options.time_of_day == "" && (built_inputs & INPUT_PRECONDITIONS))
 	{
 		// only build this if a specific time of not day has not been set
 		// with the -tod command line parameter
+		timer.next("buildTimingConstraintMap");
 		buildTimingConstraintMap();
 	}
-	buildBeenInWasInStateMaps();
-
-	std::string schedule_var = buildScheduleVar();
-	if(schedule_var == "")
-	{
-		// we need at least one behaviour to do anything
-		displayError("no behaviours were parsed");
-		return "";
-	}
-	std::string step_var = buildStepVar();
-	if(step_var == "")
-	{
-		// we need at least one action to do anything
-		displayError("no action rules were parsed");
-		return "";
-	}
-	std::string last_schedule_var = buildLastScheduleVar();
-	std::list<std::string> bool_vars = buildBoolsVar();
-	if(bool_vars.empty())
-	{
-		// just let the user know no boolean variables are present
-		// in the intermediate form
-		displayWarning("no boolean variables were present");
-	}
-	std::list<std::string> enum_vars = buildEnumsVar();
-	if(enum_vars.empty())
+	if(built_inputs & INPUT_PRECONDITIONS)
 	{
-		// just let the user know no enumerated variables are present
-		// in the intermediate form
-		displayWarning("no enumerated variables were present");
+		timer.next("buildBeenInWasInStateMaps");
+		buildBeenInWasInStateMaps();
 	}
-	std::list<std::string> precondition_defines =
-		buildPreconditionDefines();
-	if(precondition_defines.empty())
-	{
-		// just let the user know no preconditions are present
-		// in the intermediate form
-		displayWarning("no precondition rules were parsed");
-	}
-
-	std::list<std::string> been_in_state_vars = buildBeenInStatesVar();
-	std::string been_in_state_assigns = buildBeenInStateAssigns();
-	std::list<std::string> was_in_state_vars = buildWasInStatesVar();
-	std::string was_in_state_assigns = buildWasInStateAssigns();
-	std::string executed_behaviour_execute_next =
-		buildExecutedBehaviourExecuteNextDefine();
-	std::list<std::string> interrupt_defines = buildCanInterruptDefines();
-	std::string a_behaviour_can_be_executed =
-		buildABehaviourCanBeScheduledDefine();
-	std::string a_behaviour_is_ending = buildABehaviourIsEndingDefine();
-	std::string an_executed_behaviour_is_ending =
-		buildAnExecutedBehaviourIsEndingDefine();
-	std::string an_executed_behaviour_is_executing =
-		buildAnExecutedBehaviourIsScheduledDefine();
-	std::string an_executed_behaviour_is_ending_as_a_last_action =
-		buildAnExecutedBehaviourIsEndingAsALastActionDefine();
-	std::list<std::string> behaviour_module_instances =
-		buildBehaviourModuleInstances();
-	std::string step_assign = buildStepAssign();
-	std::string last_schedule_assign = buildLastScheduleAssign();
-	std::string schedule_assign = buildScheduleAssign();
-	std::string variable_assigns = buildVariableAssigns();
-
-	// build the VAR section
-	std::string section_var = "";
-	addLine(section_var, "VAR", 1, false);
-	if(g_time_of_day == "")
+	if(built_inputs & INPUT_ACTIONS)
 	{
-		// only build the time variable if a specific time of not day has not
-		// been set with the -tod command line parameter
-		std::string time_var;
-		if((time_var = buildTimeVar()) != "")
-		{
-			addLine(section_var, time_var, 2, true);
-		}
+		timer.next("buildVariableAssignmentMaps");
+		buildVariableAssignmentMaps();
 	}
-	addLine(section_var, step_var, 2, true);
-	addLine(section_var, schedule_var, 2, true);
-	addLine(section_var, last_schedule_var, 2, true);
-	addLine(section_var, "", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-	addLine(section_var, "--\tBehaviour Module Instances", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-	for(std::string s : behaviour_module_instances)
+	for(PropVariable* p : intermediate_form->getPropVariables())
 	{
-		addLine(section_var, s, 2, true);
+		countVariable(2, !isTranslated(p));
 	}
-	addLine(section_var, "", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-	addLine(section_var, "--\tBoolean Variables", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-	for(std::string s : bool_vars)
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
 	{
-		addLine(section_var, s, 2, true);
+		countVariable(e->getValues().size(), !isTranslated(e));
 	}
-	addLine(section_var, "", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-	addLine(section_var, "--\tEnumerated Types", 2, false);
-	addLine(section_var, H_LINE, 2, false);
 
-	for(std::string s : enum_vars)
+	if(intermediate_form->getBehaviours().empty())
 	{
-		addLine(section_var, s, 2, true);
+		// we need at least one behaviour to do anything
+		displayError("no behaviours were parsed");
+		return false;
 	}
-	addLine(section_var, "", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-	addLine(section_var, "--\tBeen in State/Was in State Counters", 2, false);
-	addLine(section_var, H_LINE, 2, false);
-
-	for(std::string s : been_in_state_vars)
+	// get the maximum number of actions in a behaviour
+	max_num_actions = 0;
+	for(Behaviour* b : behaviours)
 	{
-		addLine(section_var, s, 2, true);
+		max_num_actions = max_num_actions > b->getActions().size() ?
+			max_num_actions : b->getActions().size();
 	}
-	for(std::string s : was_in_state_vars)
+	if(max_num_actions == 0)
 	{
-		addLine(section_var, s, 2, true);
+		// we need at least one action to do anything
+		displayError("no action rules were parsed");
+		return false;
 	}
-
-	// build the DEFINE section
-	std::string section_define = "";
-	addLine(section_define, "DEFINE", 1, false);
-	for(std::string s : precondition_defines)
+	if(intermediate_form->getPropVariables().empty())
 	{
-		addLine(section_define, s, 2, true);
+		// just let the user know no boolean variables are present
+		// in the intermediate form
+		displayWarning("no boolean variables were present");
 	}
-	addLine(section_define, "", 2, false);
-	for(std::string s : interrupt_defines)
+	if(intermediate_form->getEnumVariables().empty())
 	{
-		addLine(section_define, s, 2, true);
+		// just let the user know no enumerated variables are present
+		// in the intermediate form
+		displayWarning("no enumerated variables were present");
 	}
-	addLine(section_define, "", 2, false);
-	addLine(section_define, executed_behaviour_execute_next, 2, true);
-	addLine(section_define, a_behaviour_can_be_executed, 2, true);
-	addLine(section_define, a_behaviour_is_ending, 2, true);
-	addLine(section_define, an_executed_behaviour_is_ending_as_a_last_action,
-		2, true);
-	addLine(section_define, an_executed_behaviour_is_ending, 2, true);
-	addLine(section_define, an_executed_behaviour_is_executing, 2, true);
 
-	// build the ASSIGN section
-	std::string section_assign = "";
-	addLine(section_assign, "ASSIGN", 1, false);
-	if(g_time_of_day == "")
+	// sort the schedulable behaviours into priority order, highest first
+	std::sort(schedulable_behaviours.begin(), schedulable_behaviours.end(),
+		[&](Behaviour* this_b, Behaviour* that_b)
+		{
+			return this_b->getPriority() > that_b->getPriority();
+		});
+	if(options.true_non_determinism)
 	{
-		addLine(section_assign, buildTimeAssign(), 0, false);
+		timer.next("buildEqualPriorityGroups");
+		buildEqualPriorityGroups();
 	}
-	addLine(section_assign, step_assign, 0, false);
-	addLine(section_assign, last_schedule_assign, 0, false);
-	addLine(section_assign, schedule_assign, 0, false);
-	addLine(section_assign, variable_assigns, 0, false);
-	addLine(section_assign, been_in_state_assigns, 0, false);
-	addLine(section_assign, was_in_state_assigns, 0, false);
-
-	// build the main module
+	return true;
+}
 
-	std::string main_module = "";
+/*------------------------------------------------------------------------------
+	translate
 
+	Translates the intermediate form into NuSMV input, which is written to
+	the given writer. Everything after the header is built as a list of
+	sections, see writeSections.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::translate(NuSMVWriter& writer,
+	const unsigned int num_threads)
+{
+	PhaseTimer timer(statistics, "buildHeader");
 	// add some information about what settings were used to generate
 	// the NuSMV file
 	time_t t;
 	time(&t);
-	std::string date_string = ctime(&t);
+	std::string date_string;
+	{
+		// ctime returns a shared buffer, translators may run concurrently
+		static std::mutex ctime_mutex;
+		std::lock_guard<std::mutex> lock(ctime_mutex);
+		date_string = ctime(&t);
+	}
 	date_string = date_string.substr(0, date_string.size() - 1);
-	addLine(main_module, H_LINE, 0, false);
-	addLine(main_module, std::string("--\tfile generated ") + date_string
+	writer.addLine(H_LINE, 0, false);
+	writer.addLine(std::string("--\tfile generated ") + date_string
 		+ " using " + EXEC_NAME + " v" + EXEC_VERSION, 0, false);
-	addLine(main_module, "--", 0, false);
-	addLine(main_module, std::string("--  true non-determinism: ")
-		+ (g_true_non_determinism ? "yes" : "no"), 0, false);
-	addLine(main_module,
+	writer.addLine("--", 0, false);
+	writer.addLine(std::string("--  true non-determinism: ")
+		+ (options.true_non_determinism ? "yes" : "no"), 0, false);
+	writer.addLine(
 		std::string("--  minimum one state for state_n_seconds: ")
-		+ (g_minimum_one_state_state_n_seconds ? "yes" : "no"), 0, false);
-	addLine(main_module, "--  seconds per state: "
-		+ integerToString(g_state_time_seconds), 0, false);
-	addLine(main_module, "--  max seconds for state_n_seconds: "
-		+ integerToString(g_max_seconds_per_state_n_seconds), 0, false);
-	if(g_time_of_day != "")
-	{
-		addLine(main_module, "--  time of day set to: " + g_time_of_day, 0,
+		+ (options.minimum_one_state_state_n_seconds ? "yes" : "no"), 0,
+		false);
+	writer.addLine("--  seconds per state: "
+		+ integerToString(options.state_time_seconds), 0, false);
+	writer.addLine("--  max seconds for state_n_seconds: "
+		+ integerToString(options.max_seconds_per_state_n_seconds), 0, false);
+	writer.addLine(std::string("--  integer counters for state_n_seconds: ")
+		+ (options.integer_counters ? "yes" : "no"), 0, false);
+	writer.addLine("--  max equal priority behaviours scheduled by subsets: "
+		+ integerToString(options.max_power_set_group_size), 0, false);
+	writer.addLine(std::string("--  unassigned variables frozen: ")
+		+ (options.freeze_unassigned_variables ? "yes" : "no"), 0, false);
+	if(options.time_of_day != "")
+	{
+		writer.addLine("--  time of day set to: " + options.time_of_day, 0,
+			false);
+	}
+	if(options.cone_of_influence != nullptr)
+	{
+		writer.addLine("--  cone of influence: " + getSliceSummary(), 0,
 			false);
 	}
+	// count the translated variables of each class
+	int num_variables_of_class[] = {0, 0, 0};
+	for(PropVariable* p : intermediate_form->getPropVariables())
+	{
+		if(isTranslated(p))
+		{
+			num_variables_of_class[prop_variable_classes[p->getId()]]++;
+		}
+	}
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		if(isTranslated(e))
+		{
+			num_variables_of_class[enum_variable_classes[e->getId()]]++;
+		}
+	}
+	writer.addLine("--  variables: "
+		+ integerToString(num_variables_of_class[VARIABLE_DYNAMIC])
+		+ " dynamic, "
+		+ integerToString(num_variables_of_class[VARIABLE_FROZEN])
+		+ " frozen, "
+		+ integerToString(num_variables_of_class[VARIABLE_CONSTANT])
+		+ " constant", 0, false);
 	// add some information about the behaviours constituting the
 	// intermediate form
-	addLine(main_module, H_LINE, 0, false);
-	addLine(main_module, "--\tbehaviours:", 0, false);
-	addLine(main_module, "--", 0, false);
-	for(Behaviour* behaviour : intermediate_form->getBehaviours())
+	writer.addLine(H_LINE, 0, false);
+	writer.addLine("--\tbehaviours:", 0, false);
+	writer.addLine("--", 0, false);
+	for(Behaviour* behaviour : behaviours)
 	{
-		addLine(main_module, "--\t\t"
+		writer.addLine("--\t\t"
 			+ validateIdentifier(behaviour->getName()) + "\t\t"
 			+ " [priority: " + integerToString(behaviour->getPriority())
 			+ "][" + (behaviour->isInterruptible() ? "" : "not ")
@@ -319,40 +321,492 @@ const std::string NuSMVTranslator::translate()
 			+ "schedulable]"
 			, 0, false);
 	}
-	addLine(main_module, H_LINE, 0, false);
-	addLine(main_module, "MODULE main", 0, false);
-	addLine(main_module, H_LINE, 1, false);
-	addLine(main_module, "--\tVariables", 1, false);
-	addLine(main_module, H_LINE, 1, false);
-	addLine(main_module, section_var, 0, false);
-	addLine(main_module, H_LINE, 1, false);
-	addLine(main_module, "--\tAssignments", 1, false);
-	addLine(main_module, H_LINE, 1, false);
-	addLine(main_module, section_assign, 0, false);
-	addLine(main_module, H_LINE, 1, false);
-	addLine(main_module, "--\tDefinitions", 1, false);
-	addLine(main_module, H_LINE, 1, false);
-	addLine(main_module, section_define, 0, false);
-	addLine(main_module, "", 0, false);
+	writer.addLine(H_LINE, 0, false);
+	writer.addLine("MODULE main", 0, false);
+	writer.addLine(H_LINE, 1, false);
+	writer.addLine("--\tVariables", 1, false);
+	writer.addLine(H_LINE, 1, false);
+
+	// write the VAR section
+	writer.addLine("VAR", 1, false);
+
+	// the sections from here on only read the intermediate form and the maps
+	// built by prepareTranslation, so they can be built concurrently, each
+	// into its own buffer, and written in this order, see writeSections
+	std::vector<Section> sections;
+	getSections(sections);
+	writeSections(sections, writer, num_threads, timer);
+	writer.addLine("", 0, false);
+	writer.addLine("", 0, false);
 
 	// add this to generate some specifications that can be used
 	// to determine if there is some world in which a behaviour can
 	// be scheduled
 	/*
-	addLine(main_module, "LTLSPEC", 1, false);
+	writer.addLine("LTLSPEC", 1, false);
 	for(Behaviour* b : intermediate_form->getBehaviours())
 	{
-		addLine(main_module, "--G(schedule != schedule_"
+		writer.addLine("--G(schedule != schedule_"
 			+ validateIdentifier(b->getName()) + ")", 2, true);
 	}
 	*/
-	addLine(main_module, H_LINE, 0, false);
-	addLine(main_module, "--\tBehaviour Module", 0, false);
-	addLine(main_module, H_LINE, 0, false);
+	writer.addLine(H_LINE, 0, false);
+	writer.addLine("--\tBehaviour Module", 0, false);
+	writer.addLine(H_LINE, 0, false);
+
+	writer.addLine(MODULE_BEHAVIOUR, 0, false);
+	writer.flush();
+}
+
+/*------------------------------------------------------------------------------
+	getSections
+
+	Lists the sections of the model written after the header, in the order
+	they are written, with the inputs each is built from.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::getSections(std::vector<Section>& sections)
+{
+	if(options.time_of_day == "")
+	{
+		// only build the time variable if a specific time of not day has not
+		// been set with the -tod command line parameter
+		sections.push_back(Section("buildTimeVar", INPUT_PRECONDITIONS,
+			[this](NuSMVWriter& w) {buildTimeVar(w);}));
+	}
+	sections.push_back(Section("buildStepVar", INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w) {buildStepVar(w);}));
+	sections.push_back(Section("buildScheduleVar", INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w) {buildScheduleVar(w);}));
+	sections.push_back(Section("buildLastScheduleVar", INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w) {buildLastScheduleVar(w);}));
+	sections.push_back(Section("buildBehaviourModuleInstances",
+		INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w)
+		{
+			w.addLine("", 2, false);
+			w.addLine(H_LINE, 2, false);
+			w.addLine("--\tBehaviour Module Instances", 2, false);
+			w.addLine(H_LINE, 2, false);
+			buildBehaviourModuleInstances(w);
+		}));
+	sections.push_back(Section("buildBoolsVar", INPUT_VARIABLES | INPUT_CLASSES,
+		[this](NuSMVWriter& w)
+		{
+			w.addLine("", 2, false);
+			w.addLine(H_LINE, 2, false);
+			w.addLine("--\tBoolean Variables", 2, false);
+			w.addLine(H_LINE, 2, false);
+			buildBoolsVar(w);
+		}));
+	sections.push_back(Section("buildEnumsVar", INPUT_VARIABLES | INPUT_CLASSES,
+		[this](NuSMVWriter& w)
+		{
+			w.addLine("", 2, false);
+			w.addLine(H_LINE, 2, false);
+			w.addLine("--\tEnumerated Types", 2, false);
+			w.addLine(H_LINE, 2, false);
+			buildEnumsVar(w);
+		}));
+	sections.push_back(Section("buildCounterReport",
+		INPUT_BEHAVIOURS | INPUT_PRECONDITIONS | INPUT_VARIABLES,
+		[this](NuSMVWriter& w)
+		{
+			w.addLine("", 2, false);
+			w.addLine(H_LINE, 2, false);
+			w.addLine("--\tBeen in State/Was in State Counters", 2, false);
+			w.addLine(H_LINE, 2, false);
+			buildCounterReport(w);
+		}));
+	if(options.integer_counters)
+	{
+		sections.push_back(Section("buildIntegerCountersVar",
+			INPUT_PRECONDITIONS | INPUT_VARIABLES,
+			[this](NuSMVWriter& w) {buildIntegerCountersVar(w);}));
+	}
+	else
+	{
+		sections.push_back(Section("buildBeenInStatesVar",
+			INPUT_PRECONDITIONS | INPUT_VARIABLES,
+			[this](NuSMVWriter& w) {buildBeenInStatesVar(w);}));
+		sections.push_back(Section("buildWasInStatesVar",
+			INPUT_PRECONDITIONS | INPUT_VARIABLES,
+			[this](NuSMVWriter& w) {buildWasInStatesVar(w);}));
+	}
+	sections.push_back(Section("buildFrozenVars",
+		INPUT_VARIABLES | INPUT_CLASSES,
+		[this](NuSMVWriter& w)
+		{
+			w.addLine("", 0, false);
+			buildFrozenVars(w);
+		}));
+	sections.push_back(Section("buildScheduleChoiceIvars", INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w)
+		{
+			buildScheduleChoiceIvars(w);
+			// write the ASSIGN section, each block of assignments is
+			// followed by an empty line
+			w.addLine(H_LINE, 1, false);
+			w.addLine("--\tAssignments", 1, false);
+			w.addLine(H_LINE, 1, false);
+			w.addLine("ASSIGN", 1, false);
+		}));
+	if(options.time_of_day == "")
+	{
+		sections.push_back(Section("buildTimeAssign", INPUT_PRECONDITIONS,
+			[this](NuSMVWriter& w)
+			{
+				buildTimeAssign(w);
+				w.addLine("", 0, false);
+			}));
+	}
+	sections.push_back(Section("buildStepAssign",
+		INPUT_BEHAVIOURS | INPUT_EXECUTIONS,
+		[this](NuSMVWriter& w)
+		{
+			buildStepAssign(w);
+			w.addLine("", 0, false);
+		}));
+	sections.push_back(Section("buildLastScheduleAssign", 0,
+		[this](NuSMVWriter& w)
+		{
+			buildLastScheduleAssign(w);
+			w.addLine("", 0, false);
+		}));
+	sections.push_back(Section("buildScheduleAssign",
+		INPUT_BEHAVIOURS | INPUT_EXECUTIONS,
+		[this](NuSMVWriter& w)
+		{
+			buildScheduleAssign(w);
+			w.addLine("", 0, false);
+		}));
+	sections.push_back(Section("buildVariableAssigns",
+		INPUT_BEHAVIOURS | INPUT_ACTIONS | INPUT_VARIABLES | INPUT_CLASSES
+			| INPUT_INITIAL_VALUES,
+		[this](NuSMVWriter& w)
+		{
+			buildVariableAssigns(w);
+			w.addLine("", 0, false);
+		}));
+	if(options.integer_counters)
+	{
+		sections.push_back(Section("buildIntegerCounterAssigns",
+			INPUT_PRECONDITIONS | INPUT_VARIABLES,
+			[this](NuSMVWriter& w)
+			{
+				buildIntegerCounterAssigns(w);
+				w.addLine("", 0, false);
+			}));
+	}
+	else
+	{
+		sections.push_back(Section("buildBeenInStateAssigns",
+			INPUT_PRECONDITIONS | INPUT_VARIABLES,
+			[this](NuSMVWriter& w)
+			{
+				buildBeenInStateAssigns(w);
+				w.addLine("", 0, false);
+			}));
+		sections.push_back(Section("buildWasInStateAssigns",
+			INPUT_PRECONDITIONS | INPUT_VARIABLES,
+			[this](NuSMVWriter& w)
+			{
+				buildWasInStateAssigns(w);
+				w.addLine("", 0, false);
+			}));
+	}
+
+	// write the DEFINE section
+	sections.push_back(Section("buildConstantsDeclaration",
+		INPUT_VARIABLES | INPUT_CLASSES,
+		[this](NuSMVWriter& w)
+		{
+			w.addLine("", 0, false);
+			w.addLine(H_LINE, 1, false);
+			w.addLine("--\tDefinitions", 1, false);
+			w.addLine(H_LINE, 1, false);
+			buildConstantsDeclaration(w);
+			w.addLine("DEFINE", 1, false);
+		}));
+	sections.push_back(Section("buildConstantDefines",
+		INPUT_VARIABLES | INPUT_CLASSES,
+		[this](NuSMVWriter& w) {buildConstantDefines(w);}));
+	sections.push_back(Section("buildPreconditionDefines",
+		INPUT_BEHAVIOURS | INPUT_PRECONDITIONS | INPUT_VARIABLES
+			| INPUT_CLASSES,
+		[this](NuSMVWriter& w)
+		{
+			buildPreconditionDefines(w);
+			w.addLine("", 2, false);
+		}));
+	sections.push_back(Section("buildCanInterruptDefines", INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w)
+		{
+			buildCanInterruptDefines(w);
+			w.addLine("", 2, false);
+		}));
+	sections.push_back(Section("buildExecutedBehaviourExecuteNextDefine",
+		INPUT_BEHAVIOURS | INPUT_EXECUTIONS,
+		[this](NuSMVWriter& w) {buildExecutedBehaviourExecuteNextDefine(w);}));
+	sections.push_back(Section("buildABehaviourCanBeScheduledDefine",
+		INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w) {buildABehaviourCanBeScheduledDefine(w);}));
+	sections.push_back(Section("buildABehaviourIsEndingDefine",
+		INPUT_BEHAVIOURS,
+		[this](NuSMVWriter& w) {buildABehaviourIsEndingDefine(w);}));
+	sections.push_back(Section(
+		"buildAnExecutedBehaviourIsEndingAsALastActionDefine",
+		INPUT_BEHAVIOURS | INPUT_EXECUTIONS,
+		[this](NuSMVWriter& w)
+		{
+			buildAnExecutedBehaviourIsEndingAsALastActionDefine(w);
+		}));
+	sections.push_back(Section("buildAnExecutedBehaviourIsEndingDefine",
+		INPUT_BEHAVIOURS | INPUT_EXECUTIONS,
+		[this](NuSMVWriter& w) {buildAnExecutedBehaviourIsEndingDefine(w);}));
+	sections.push_back(Section("buildAnExecutedBehaviourIsScheduledDefine",
+		INPUT_BEHAVIOURS | INPUT_EXECUTIONS,
+		[this](NuSMVWriter& w)
+		{
+			buildAnExecutedBehaviourIsScheduledDefine(w);
+		}));
+}
+
+/*------------------------------------------------------------------------------
+	computeInputDigests
+
+	Computes the digest of each input of the sections. Each input is encoded
+	as it is read by the sections, and the digest is the hash of the
+	encoding.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::computeInputDigests()
+{
+	CacheWriter behaviours_writer;
+	CacheWriter executions_writer;
+	CacheWriter actions_writer;
+	CacheWriter preconditions_writer;
+	for(Behaviour* b : behaviours)
+	{
+		behaviours_writer.putString(b->getName());
+		behaviours_writer.putInt(b->getPriority());
+		behaviours_writer.putBool(b->isInterruptible());
+		behaviours_writer.putBool(b->isSchedulable());
+		behaviours_writer.putInt(b->getActions().size());
+		// the executions are placed by their position among the actions
+		executions_writer.putInt(b->getActions().size());
+		actions_writer.putInt(b->getActions().size());
+		for(Action* action : b->getActions())
+		{
+			if(action->getActionType() == ActionType::EXECUTE
+				|| action->getActionType() == ActionType::EXECUTE_NON_D)
+			{
+				IntermediateFormCache::encodeAction(action, executions_writer);
+			}
+			else
+			{
+				executions_writer.putInt(-1);
+			}
+			IntermediateFormCache::encodeAction(action, actions_writer);
+		}
+		preconditions_writer.putInt(b->getPreconditions().size());
+		for(Precondition* p : b->getPreconditions())
+		{
+			IntermediateFormCache::encodePrecondition(p,
+				preconditions_writer);
+		}
+	}
+	CacheWriter variables_writer;
+	CacheWriter classes_writer;
+	for(PropVariable* p : intermediate_form->getPropVariables())
+	{
+		variables_writer.putString(p->getName());
+		variables_writer.putBool(p->isNonDeterministic());
+		classes_writer.putInt(prop_variable_classes[p->getId()]);
+		classes_writer.putString(prop_variable_constants[p->getId()]);
+	}
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		variables_writer.putString(e->getName());
+		variables_writer.putInt(e->getValues().size());
+		for(const std::string& value : e->getValues())
+		{
+			variables_writer.putString(value);
+		}
+		variables_writer.putBool(e->resets());
+		variables_writer.putBool(e->hasNoneValue());
+		variables_writer.putBool(e->isNonDeterministic());
+		classes_writer.putInt(enum_variable_classes[e->getId()]);
+		classes_writer.putString(enum_variable_constants[e->getId()]);
+	}
+	CacheWriter initial_values_writer;
+	for(auto& pair : initial_variable_values)
+	{
+		initial_values_writer.putString(pair.first);
+		initial_values_writer.putString(pair.second);
+	}
+	// in the order of the bits of the SectionInput flags
+	const CacheWriter* writers[] = {&behaviours_writer, &executions_writer,
+		&actions_writer, &preconditions_writer, &variables_writer,
+		&classes_writer, &initial_values_writer};
+	input_digests.clear();
+	for(const CacheWriter* writer : writers)
+	{
+		CacheHash hash;
+		hash.addString(writer->getData());
+		input_digests.push_back(hash.getValue());
+	}
+}
+
+/*------------------------------------------------------------------------------
+	getSectionDigest
+
+	Returns the digest of the given inputs of a section, the hash of the
+	inputs and of the digest of each.
+------------------------------------------------------------------------------*/
+const std::uint64_t NuSMVTranslator::getSectionDigest(const int inputs) const
+{
+	CacheHash hash;
+	hash.addString(integerToString(inputs));
+	for(unsigned int i = 0; i < input_digests.size(); i++)
+	{
+		if(inputs & (1 << i))
+		{
+			CacheWriter writer;
+			writer.putInt((int)(std::uint32_t)input_digests[i]);
+			writer.putInt((int)(std::uint32_t)(input_digests[i] >> 32));
+			hash.addString(writer.getData());
+		}
+	}
+	return hash.getValue();
+}
+
+/*------------------------------------------------------------------------------
+	writeSections
+
+	Builds the given sections and writes them to the writer in order. With
+	one thread and no translation cache each section is written as it is
+	built. Otherwise each section is built into its own buffer, concurrently
+	if there is more than one thread, unless its text is taken from the
+	cache, and the buffers are then written in order, so that the output does
+	not depend on the number of threads or on the cache.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::writeSections(const std::vector<Section>& sections,
+	NuSMVWriter& writer, const unsigned int num_threads, PhaseTimer& timer)
+{
+	if(num_threads <= 1 && translation_cache == nullptr)
+	{
+		for(const Section& section : sections)
+		{
+			timer.next(section.name);
+			section.build(writer);
+		}
+		return;
+	}
+	// the digest of the inputs of each section, and its text held in the
+	// cache, or null if the section is built
+	std::vector<std::uint64_t> digests(sections.size(), 0);
+	std::vector<const std::string*> cached_texts(sections.size(), nullptr);
+	if(translation_cache != nullptr)
+	{
+		for(unsigned int i = 0; i < sections.size(); i++)
+		{
+			digests[i] = getSectionDigest(sections[i].inputs);
+			cached_texts[i] = translation_cache->find(sections[i].name,
+				digests[i]);
+		}
+	}
+	std::vector<std::string> buffers(sections.size());
+	if(num_threads <= 1)
+	{
+		for(unsigned int i = 0; i < sections.size(); i++)
+		{
+			if(cached_texts[i] == nullptr)
+			{
+				timer.next(sections[i].name);
+				NuSMVStringWriter buffer_writer(buffers[i]);
+				sections[i].build(buffer_writer);
+			}
+		}
+	}
+	else
+	{
+		timer.next("buildSections");
+		std::atomic<unsigned int> next(0);
+		auto work = [&]()
+			{
+				unsigned int i;
+				while((i = next++) < sections.size())
+				{
+					if(cached_texts[i] == nullptr)
+					{
+						NuSMVStringWriter buffer_writer(buffers[i]);
+						sections[i].build(buffer_writer);
+					}
+				}
+			};
+		std::vector<std::thread> workers;
+		for(unsigned int i = 1; i < num_threads && i < sections.size(); i++)
+		{
+			workers.push_back(std::thread(work));
+		}
+		// this thread is also a worker
+		work();
+		for(std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+	if(translation_cache != nullptr)
+	{
+		// only the sections that were built are written to the cache
+		timer.next("storeTranslationCache");
+		for(unsigned int i = 0; i < sections.size(); i++)
+		{
+			if(cached_texts[i] != nullptr)
+			{
+				continue;
+			}
+			try
+			{
+				translation_cache->store(sections[i].name, digests[i],
+					buffers[i]);
+			}
+			catch(std::string& error)
+			{
+				displayWarning("section \'" + sections[i].name
+					+ "\' was not recorded\n" + error);
+			}
+		}
+	}
+	timer.next("writeSections");
+	for(unsigned int i = 0; i < sections.size(); i++)
+	{
+		if(cached_texts[i] != nullptr)
+		{
+			writer.addText(*cached_texts[i]);
+			continue;
+		}
+		writer.addText(buffers[i]);
+		// release each buffer once it has been written
+		std::string().swap(buffers[i]);
+	}
+}
 
-	addLine(main_module, MODULE_BEHAVIOUR, 0, false);
+/*------------------------------------------------------------------------------
+	getSliceSummary
 
-	return main_module;
+	Describes how much of the intermediate form was left out of the
+	translation by the cone of influence.
+------------------------------------------------------------------------------*/
+const std::string NuSMVTranslator::getSliceSummary() const
+{
+	return "removed " + integerToString(num_removed_variables) + " of "
+		+ integerToString(num_variables) + " variables ("
+		+ integerToString(num_removed_bits) + " of "
+		+ integerToString(num_bits) + " bits) and "
+		+ integerToString(intermediate_form->getBehaviours().size()
+			- behaviours.size()) + " of "
+		+ integerToString(intermediate_form->getBehaviours().size())
+		+ " behaviours";
 }
 
 /*------------------------------------------------------------------------------
@@ -362,7 +816,16 @@ const std::string NuSMVTranslator::translate()
 ------------------------------------------------------------------------------*/
 void NuSMVTranslator::buildBehaviourLists()
 {
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
+	for(Behaviour* behaviour : intermediate_form->getBehaviours())
+	{
+		if(isTranslated(behaviour))
+		{
+			behaviours.push_back(behaviour);
+		}
+	}
+	// marks the ids of behaviours that are executed by another behaviour
+	std::vector<bool> is_executable(
+		intermediate_form->getBehaviours().size(), false);
 	if(!behaviours.empty())
 	{
 		auto it = behaviours.begin();
@@ -377,7 +840,7 @@ void NuSMVTranslator::buildBehaviourLists()
 				schedulable_behaviours.push_back(behaviour);
 			}
 			bool executes_another = false;
-			std::list<Action*> actions = behaviour->getActions();
+			const std::vector<Action*>& actions = behaviour->getActions();
 			auto action_it = actions.begin();
 			auto action_end = actions.end();
 			while(action_it != action_end)
@@ -388,9 +851,7 @@ void NuSMVTranslator::buildBehaviourLists()
 					ActionExecute* action_ex = (ActionExecute*)action;
 					// add the executed behaviour to the list of
 					// executable behaviours
-					executable_behaviours.insert(
-						intermediate_form->getBehaviourByName(
-							action_ex->getBehaviour(), ""));
+					is_executable[action_ex->getBehaviourId()] = true;
 					executes_another = true;
 				}
 				else if(action->getActionType() == ActionType::EXECUTE_NON_D)
@@ -399,12 +860,9 @@ void NuSMVTranslator::buildBehaviourLists()
 						(ActionExecuteNonDeterministic*)action;
 					// add the executable behaviours to the list of
 					// executable behaviours
-					for(std::string behaviour_name :
-						action_ex_non_d->getBehaviourValues())
+					for(int behaviour_id : action_ex_non_d->getBehaviourIds())
 					{
-						executable_behaviours.insert(
-							intermediate_form->getBehaviourByName(
-								behaviour_name, ""));
+						is_executable[behaviour_id] = true;
 					}
 					executes_another = true;
 				}
@@ -419,16 +877,140 @@ void NuSMVTranslator::buildBehaviourLists()
 			it++;
 		}
 	}
+	for(Behaviour* behaviour : behaviours)
+	{
+		if(is_executable[behaviour->getId()])
+		{
+			executable_behaviours.push_back(behaviour);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildEqualPriorityGroups
+
+	Groups the names of the schedulable behaviours by equal priority.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildEqualPriorityGroups()
+{
+	/*	sort a copy of the schedulable behaviours, so that the order used
+		by the definitions is unaffected */
+	std::vector<Behaviour*> prioritised_behaviours = schedulable_behaviours;
+	std::sort(prioritised_behaviours.begin(), prioritised_behaviours.end(),
+		[&](Behaviour* this_behaviour, Behaviour* that_behaviour)
+		{
+			return this_behaviour->getPriority()
+				> that_behaviour->getPriority();
+		});
+	unsigned int index = 0;
+	while(index < prioritised_behaviours.size())
+	{
+		Behaviour* behaviour = prioritised_behaviours[index];
+		std::vector<std::string> equal_priority_behaviours;
+		equal_priority_behaviours.push_back(
+			validateIdentifier(behaviour->getName()));
+		while(++index < prioritised_behaviours.size()
+			&& prioritised_behaviours[index]->getPriority() ==
+				behaviour->getPriority())
+		{
+			if(prioritised_behaviours[index]->isSchedulable())
+			{
+				equal_priority_behaviours.push_back(validateIdentifier(
+					prioritised_behaviours[index]->getName()));
+			}
+		}
+		equal_priority_groups.push_back(equal_priority_behaviours);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	isTranslated
+
+	Returns true if the given behaviour is in the cone of influence, or if no
+	cone of influence was given.
+------------------------------------------------------------------------------*/
+const bool NuSMVTranslator::isTranslated(Behaviour* behaviour) const
+{
+	return options.cone_of_influence == nullptr
+		|| options.cone_of_influence->containsBehaviour(behaviour->getId());
+}
+
+/*------------------------------------------------------------------------------
+	isTranslated
+
+	Returns true if the given propositional variable is in the cone of
+	influence, or if no cone of influence was given.
+------------------------------------------------------------------------------*/
+const bool NuSMVTranslator::isTranslated(PropVariable* prop_variable) const
+{
+	return options.cone_of_influence == nullptr
+		|| options.cone_of_influence->containsPropVariable(
+			prop_variable->getId());
+}
+
+/*------------------------------------------------------------------------------
+	isTranslated
+
+	Returns true if the given enumerated variable is in the cone of
+	influence, or if no cone of influence was given.
+------------------------------------------------------------------------------*/
+const bool NuSMVTranslator::isTranslated(EnumVariable* enum_variable) const
+{
+	return options.cone_of_influence == nullptr
+		|| options.cone_of_influence->containsEnumVariable(
+			enum_variable->getId());
+}
+
+/*------------------------------------------------------------------------------
+	isDynamic
+
+	Returns true if the given propositional variable is translated and its
+	value may change.
+------------------------------------------------------------------------------*/
+const bool NuSMVTranslator::isDynamic(PropVariable* prop_variable) const
+{
+	return isTranslated(prop_variable)
+		&& prop_variable_classes[prop_variable->getId()] == VARIABLE_DYNAMIC;
+}
+
+/*------------------------------------------------------------------------------
+	isDynamic
+
+	Returns true if the given enumerated variable is translated and its value
+	may change.
+------------------------------------------------------------------------------*/
+const bool NuSMVTranslator::isDynamic(EnumVariable* enum_variable) const
+{
+	return isTranslated(enum_variable)
+		&& enum_variable_classes[enum_variable->getId()] == VARIABLE_DYNAMIC;
+}
+
+/*------------------------------------------------------------------------------
+	countVariable
+
+	Adds a variable with the given number of values to the counts of
+	variables and bits.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::countVariable(const unsigned int num_values,
+	const bool removed)
+{
+	num_variables++;
+	num_bits += numBits(num_values);
+	if(removed)
+	{
+		num_removed_variables++;
+		num_removed_bits += numBits(num_values);
+	}
 }
 
 /*------------------------------------------------------------------------------
 	buildTimingConstraintMap
 
-	Builds the timing constraint map.
+	Builds the timing constraint map by sweeping over the sorted endpoints of
+	the intervals during which each timing constraint holds.
 ------------------------------------------------------------------------------*/
 void NuSMVTranslator::buildTimingConstraintMap()
 {
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
 	std::list<PreconditionTimingConstraint*> timing_constraints;
 	if(!behaviours.empty())
 	{
@@ -437,7 +1019,7 @@ void NuSMVTranslator::buildTimingConstraintMap()
 		while(it != end)
 		{
 			Behaviour* behaviour = *it;
-			std::list<Precondition*> preconditions =
+			const std::vector<Precondition*>& preconditions =
 				behaviour->getPreconditions();
 			auto precondition_it = preconditions.begin();
 			auto precondition_end = preconditions.end();
@@ -469,126 +1051,85 @@ void NuSMVTranslator::buildTimingConstraintMap()
 		PreconditionTimingConstraint* p = timing_constraints.front();
 		std::string value = validateIdentifier("_" + p->getStartTime() + "_to_"
 			+ p->getEndTime());
-		auto pair = *(timing_constraint_map.find(p));
-		pair.second->push_back(value);
+		timing_constraint_map.find(p)->second->push_back(value);
 		time_intervals.push_back(value);
 		time_intervals.push_back("no_time_constraints_hold");
 	}
 	else if(!timing_constraints.empty())
 	{
-		std::string time = "00:00:00";
+		const int minute = 60;
+		const int day = 24 * 60 * minute;
+		// an endpoint is the moment a timing constraint starts or stops
+		// holding, stops being ordered before starts at the same moment
+		std::vector<std::pair<std::pair<int, bool>,
+			PreconditionTimingConstraint*>> endpoints;
+		for(PreconditionTimingConstraint* p : timing_constraints)
+		{
+			int start = timeToSeconds(p->getStartTime());
+			int end = timeToSeconds(p->getEndTime()) + minute;
+			if(start < end)
+			{
+				endpoints.push_back(std::make_pair(std::make_pair(start, true),
+					p));
+				endpoints.push_back(std::make_pair(std::make_pair(end, false),
+					p));
+			}
+			else
+			{
+				// the constraint wraps past midnight, it holds until its end
+				// time and again from its start time until the end of the day
+				endpoints.push_back(std::make_pair(std::make_pair(0, true),
+					p));
+				endpoints.push_back(std::make_pair(std::make_pair(end, false),
+					p));
+				endpoints.push_back(std::make_pair(std::make_pair(start, true),
+					p));
+				endpoints.push_back(std::make_pair(std::make_pair(day, false),
+					p));
+			}
+		}
+		std::sort(endpoints.begin(), endpoints.end());
 		bool added_none_accepting_interval = false;
-		std::list<PreconditionTimingConstraint*> accepting;
-		// remove any time constraints from the list that hold
-		// at the current time, and add them to the accepting list
-		timing_constraints.remove_if(
-			[&](PreconditionTimingConstraint* p)
-			{
-				bool remove_if = timeConstraintHoldsAtTime(p, time);
-				if(remove_if)
+		std::set<PreconditionTimingConstraint*> accepting;
+		int time = 0;
+		auto it = endpoints.begin();
+		auto end = endpoints.end();
+		while(time < day)
+		{
+			// update the accepting constraints for every endpoint at the
+			// current time
+			while(it != end && it->first.first == time)
+			{
+				if(it->first.second)
 				{
-					accepting.push_back(p);
+					accepting.insert(it->second);
 				}
-				return remove_if;
-			});
-		// do this while there are still some time constraints that
-		// are yet to be accepting, or are still accepting
-		while(!timing_constraints.empty() || !accepting.empty())
-		{
-			PreconditionTimingConstraint* earliest_starting = nullptr;
-			PreconditionTimingConstraint* earliest_finishing = nullptr;
-			std::for_each(timing_constraints.begin(), timing_constraints.end(),
-				[&](PreconditionTimingConstraint* p)
+				else
 				{
-					// get the timing constraint with the earliest
-					// start time
-					if(earliest_starting == nullptr ||
-						timeIsBefore(p->getStartTime(),
-							earliest_starting->getStartTime()))
-					{
-						earliest_starting = p;
-					}
-				});
-			std::for_each(accepting.begin(), accepting.end(),
-				[&](PreconditionTimingConstraint* p)
-				{
-					// get the timing constraint with the earliest
-					// finishing time
-					if(earliest_finishing == nullptr ||
-						timeIsBefore(p->getEndTime(),
-							earliest_finishing->getEndTime()))
-					{
-						earliest_finishing = p;
-					}
-				});
-			if(earliest_starting == nullptr || (earliest_finishing != nullptr
-				&& timeIsBefore(earliest_finishing->getEndTime(),
-					earliest_starting->getStartTime())))
-			{
-				std::string value = validateIdentifier("_" + time + "_to_" +
-					earliest_finishing->getEndTime());
-				if(accepting.empty())
-				{
-					if(!added_none_accepting_interval)
-					{
-						time_intervals.push_back(
-							"no_time_constraints_hold");
-						added_none_accepting_interval = true;
-					}
+					accepting.erase(it->second);
 				}
-				else
+				it++;
+			}
+			int next_time = (it == end ? day : it->first.first);
+			if(accepting.empty())
+			{
+				if(!added_none_accepting_interval)
 				{
-					time_intervals.push_back(value);
+					time_intervals.push_back("no_time_constraints_hold");
+					added_none_accepting_interval = true;
 				}
-				accepting.remove_if(
-					[&](PreconditionTimingConstraint* p)
-					{
-						bool remove_if = p->getEndTime() ==
-							earliest_finishing->getEndTime();
-						auto pair = *(timing_constraint_map.find(p));
-						pair.second->push_back(value);
-						return remove_if;
-					});
-				time = momentAfter(earliest_finishing->getEndTime());
 			}
 			else
 			{
-				if(timeIsBefore(time, earliest_starting->getStartTime()))
+				std::string value = validateIdentifier("_" + secondsToTime(time)
+					+ "_to_" + secondsToTime(next_time - minute));
+				time_intervals.push_back(value);
+				for(PreconditionTimingConstraint* p : accepting)
 				{
-					std::string value = validateIdentifier("_" + time + "_to_"
-						+ momentBefore(earliest_starting->getStartTime()));
-					if(accepting.empty())
-					{
-						if(!added_none_accepting_interval)
-						{
-							time_intervals.push_back(
-								"no_time_constraints_hold");
-							added_none_accepting_interval = true;
-						}
-					}
-					else
-					{
-						time_intervals.push_back(value);
-					}
-					for(PreconditionTimingConstraint* p : accepting)
-					{
-						auto pair = *(timing_constraint_map.find(p));
-						pair.second->push_back(value);
-					}
+					timing_constraint_map.find(p)->second->push_back(value);
 				}
-				timing_constraints.remove_if(
-					[&](PreconditionTimingConstraint* p)
-					{
-						bool remove_if = p->getStartTime() ==
-							earliest_starting->getStartTime();
-						if(remove_if)
-						{
-							accepting.push_back(p);
-						}
-						return remove_if;
-					});
-				time = earliest_starting->getStartTime();
 			}
+			time = next_time;
 		}
 	}
 }
@@ -598,54 +1139,53 @@ void NuSMVTranslator::buildTimingConstraintMap()
 
 	Builds the initial variable value map.
 ------------------------------------------------------------------------------*/
-bool NuSMVTranslator::buildInitialVariableValueMap(std::string filename)
+const bool NuSMVTranslator::buildInitialVariableValueMap(
+	IntermediateForm* intermediate_form, const std::string& filename,
+	std::map<std::string, std::string>& initial_variable_values)
 {
 	bool successfully_parsed = true;
-	std::ifstream ifstream(filename);
+	FileSource file_source(filename);
 	try
 	{
-		if(!ifstream)
+		if(!file_source.isOpen())
 		{
 			throw("error loading file \'" + filename + "\'");
 		}
-		// read in the input file as a string
-		std::string input_file_string = std::string(
-			std::istreambuf_iterator<char>(ifstream),
-			std::istreambuf_iterator<char>());
-		if(!hasNextToken(input_file_string))
+		TokenCursor file_cursor(file_source.getSpan());
+		if(!file_cursor.hasNextToken())
 		{
 			// the file is empty
 			throw("file \'" + filename + "\' is empty");
 		}
-		while(hasNextToken(input_file_string))
+		while(file_cursor.hasNextToken())
 		{
-			std::string line = getNextLine(input_file_string);
+			TokenCursor line(file_cursor.getNextLine());
 			std::string var_name = "";
-			while(hasNextToken(line) &&
-				(peekNextToken(line) != "="))
+			while(line.hasNextToken() &&
+				(line.peekNextToken() != "="))
 			{
 				// read in tokens until '=' is found
-				var_name += getNextToken(line);
-				if(hasNextToken(line)
-					&& (peekNextToken(line) != "="))
+				var_name += line.getNextToken().str();
+				if(line.hasNextToken()
+					&& (line.peekNextToken() != "="))
 				{
 					var_name += " ";
 				}
 			}
-			if(!hasNextToken(line))
+			if(!line.hasNextToken())
 			{
 				// no '=' was found
 				throw("missing '=' in file \'" + filename + "\'");
 			}
-			getNextToken(line);
-			if(!hasNextToken(line))
+			line.getNextToken();
+			if(!line.hasNextToken())
 			{
 				// no assignment was found
 				throw("missing initial variable value in file \'" + filename
 					+ "\'");
 			}
 			// trim the enclosing whitespace
-			std::string value_name = trim(line);
+			std::string value_name = trim(line.getRemaining().str());
 			if(value_name.size() < 3)
 			{
 				throw(std::string("initial values must have the form")
@@ -739,7 +1279,6 @@ bool NuSMVTranslator::buildInitialVariableValueMap(std::string filename)
 			+ error);
 		successfully_parsed = false;
 	}
-	ifstream.close();
 	return successfully_parsed;
 }
 
@@ -750,25 +1289,53 @@ bool NuSMVTranslator::buildInitialVariableValueMap(std::string filename)
 ------------------------------------------------------------------------------*/
 void NuSMVTranslator::buildBeenInWasInStateMaps()
 {
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
-	for(Behaviour* b : behaviours)
+	// maps the names of the counters of removed behaviours to their numbers
+	// of values
+	std::map<std::string, unsigned int> removed_counters;
+	// preconditions over the same variable and value share one counter,
+	// which takes the values of the largest threshold
+	auto add_counter = [&](decltype(been_in_state_map)& counter_map,
+		Behaviour* b, Precondition* p, const std::list<std::string>& values)
+		{
+			std::string counter_name = getCounterName(p);
+			if(!isTranslated(b))
+			{
+				unsigned int& num_values = removed_counters[counter_name];
+				num_values = std::max(num_values,
+					(unsigned int)values.size());
+				return;
+			}
+			counter_steps[p] = values.size() - 1;
+			auto it = counter_map.find(counter_name);
+			if(it == counter_map.end())
+			{
+				counter_map.insert(std::make_pair(counter_name,
+					std::make_pair(p, values)));
+			}
+			else if(values.size() > it->second.second.size())
+			{
+				it->second = std::make_pair(p, values);
+			}
+		};
+	for(Behaviour* b : intermediate_form->getBehaviours())
 	{
-		std::list<Precondition*> preconditions = b->getPreconditions();
-		for(Precondition* p : preconditions)
+		for(Precondition* p : b->getPreconditions())
 		{
 			if(p->getTimeConstraintType() ==
 				TimeConstraintType::BEEN_IN_STATE_FOR)
 			{
 				int time_constraint_seconds = p->getTimeConstraintSeconds();
 				// bound the number of seconds
-				if(time_constraint_seconds > g_max_seconds_per_state_n_seconds)
+				if(time_constraint_seconds
+					> options.max_seconds_per_state_n_seconds)
 				{
-					time_constraint_seconds = g_max_seconds_per_state_n_seconds;
+					time_constraint_seconds =
+						options.max_seconds_per_state_n_seconds;
 				}
 				double num_steps_double = (double)time_constraint_seconds
-					/(double)g_state_time_seconds;
+					/(double)options.state_time_seconds;
 				int num_steps = static_cast<int>(round(num_steps_double));
-				if(g_minimum_one_state_state_n_seconds && num_steps == 0)
+				if(options.minimum_one_state_state_n_seconds && num_steps == 0)
 				{
 					num_steps = 1;
 				}
@@ -795,26 +1362,26 @@ void NuSMVTranslator::buildBeenInWasInStateMaps()
 								+ integerToString(num_secs));
 						}
 						num_steps--;
-						num_secs -=	g_state_time_seconds;
+						num_secs -=	options.state_time_seconds;
 					}
 					// add the values to the map
-					been_in_state_map.insert(
-						std::pair<Precondition*, std::list<std::string>>(
-							p, values));
+					add_counter(been_in_state_map, b, p, values);
 				}
 			}
 			else if(p->getTimeConstraintType() ==
 					TimeConstraintType::WAS_IN_STATE_WITHIN)
 			{
 				int time_constraint_seconds = p->getTimeConstraintSeconds();
-				if(time_constraint_seconds > g_max_seconds_per_state_n_seconds)
+				if(time_constraint_seconds
+					> options.max_seconds_per_state_n_seconds)
 				{
-					time_constraint_seconds = g_max_seconds_per_state_n_seconds;
+					time_constraint_seconds =
+						options.max_seconds_per_state_n_seconds;
 				}
 				double num_steps_double = (double)time_constraint_seconds
-					/(double)g_state_time_seconds;
+					/(double)options.state_time_seconds;
 				int num_steps = static_cast<int>(round(num_steps_double));
-				if(g_minimum_one_state_state_n_seconds && num_steps == 0)
+				if(options.minimum_one_state_state_n_seconds && num_steps == 0)
 				{
 					num_steps = 1;
 				}
@@ -840,212 +1407,561 @@ void NuSMVTranslator::buildBeenInWasInStateMaps()
 								+ integerToString(num_secs));
 						}
 						num_steps--;
-						num_secs -=	g_state_time_seconds;
+						num_secs -=	options.state_time_seconds;
 					}
-					was_in_state_map.insert(
-						std::pair<Precondition*, std::list<std::string>>(
-							p, values));
+					add_counter(was_in_state_map, b, p, values);
 				}
 			}
 		}
 	}
+	// count each shared counter once
+	for(auto& pair : been_in_state_map)
+	{
+		countVariable(pair.second.second.size(), false);
+		removed_counters.erase(pair.first);
+	}
+	for(auto& pair : was_in_state_map)
+	{
+		countVariable(pair.second.second.size(), false);
+		removed_counters.erase(pair.first);
+	}
+	for(auto& pair : removed_counters)
+	{
+		countVariable(pair.second, true);
+	}
 }
 
 /*------------------------------------------------------------------------------
-	buildEnumsVar
+	getCounterExpression
 
-	Builds the variable definitions for	the enumerated variables.
+	Returns an expression over the counter of a been_in_state or was_in_state
+	suffixed precondition that holds when its time constraint is met.
 ------------------------------------------------------------------------------*/
-std::list<std::string> NuSMVTranslator::buildEnumsVar()
+const std::string NuSMVTranslator::getCounterExpression(Precondition* p) const
 {
-	std::list<std::string> enum_vars;
-	std::list<EnumVariable*> enum_variables =
-		intermediate_form->getEnumVariables();
-	for(EnumVariable* e : enum_variables)
+	std::string counter_name = getCounterName(p);
+	int steps = counter_steps.find(p)->second;
+	if(p->getTimeConstraintType() == TimeConstraintType::BEEN_IN_STATE_FOR)
+	{
+		const std::list<std::string>& values =
+			been_in_state_map.find(counter_name)->second.second;
+		if(options.integer_counters)
+		{
+			return counter_name + " >= " + integerToString(steps);
+		}
+		if(steps == (int)values.size() - 1)
+		{
+			return counter_name + " = " + BEEN_IN_WAS_IN_PREFIX
+				+ BEEN_IN_WAS_IN_FINAL;
+		}
+		// the shared counter has reached at least this threshold
+		return counter_name + " in "
+			+ getValueSet(values, steps, values.size() - 1);
+	}
+	const std::list<std::string>& values =
+		was_in_state_map.find(counter_name)->second.second;
+	if(options.integer_counters)
+	{
+		return "(" + counter_name + " != 0 & " + counter_name + " <= "
+			+ integerToString(steps) + ")";
+	}
+	if(steps == (int)values.size() - 1)
 	{
-		// add the definition for this variable to the list
-		enum_vars.push_back(buildEnumVar(validateIdentifier(e->getName()),
-			e->getValues()));
+		return counter_name + " != " + BEEN_IN_WAS_IN_PREFIX
+			+ BEEN_IN_WAS_IN_START;
 	}
-	return enum_vars;
+	// the shared counter has not yet passed this threshold
+	return counter_name + " in " + getValueSet(values, 1, steps);
 }
 
 /*------------------------------------------------------------------------------
-	buildBoolsVar
+	classifyVariables
 
-	Builds the variable definitions for	the boolean variables.
+	Classifies each variable as dynamic, frozen or constant, and records the
+	value of each constant variable.
 ------------------------------------------------------------------------------*/
-std::list<std::string> NuSMVTranslator::buildBoolsVar()
+void NuSMVTranslator::classifyVariables()
 {
-	std::list<std::string> bool_vars;
-	std::list<PropVariable*> prop_variables =
+	const std::vector<PropVariable*>& prop_variables =
 		intermediate_form->getPropVariables();
+	const std::vector<EnumVariable*>& enum_variables =
+		intermediate_form->getEnumVariables();
+	// the values assigned by the translated behaviours, indexed by id
+	std::vector<std::set<std::string>> prop_values(prop_variables.size());
+	std::vector<std::set<std::string>> enum_values(enum_variables.size());
+	// marks the propositional variables assigned by any behaviour, which
+	// are initially false unless an initial value was given
+	std::vector<bool> prop_is_assigned(prop_variables.size(), false);
+	for(Behaviour* b : intermediate_form->getBehaviours())
+	{
+		for(Action* action : b->getActions())
+		{
+			if(action->getActionType() == ActionType::PROP_VALUE_ASSIGNMENT)
+			{
+				ActionPropValueAssignment* action_prop =
+					(ActionPropValueAssignment*)action;
+				int id = action_prop->getPropVariable()->getId();
+				prop_is_assigned[id] = true;
+				if(isTranslated(b))
+				{
+					prop_values[id].insert(
+						action_prop->getTruthValue() ? "TRUE" : "FALSE");
+				}
+			}
+			else if(action->getActionType() ==
+				ActionType::ENUM_VALUE_ASSIGNMENT && isTranslated(b))
+			{
+				ActionEnumValueAssignment* action_enum =
+					(ActionEnumValueAssignment*)action;
+				enum_values[action_enum->getEnumVariable()->getId()].insert(
+					validateIdentifier(action_enum->getEnumValue()));
+			}
+		}
+	}
+
+	prop_variable_classes.assign(prop_variables.size(), VARIABLE_DYNAMIC);
+	prop_variable_constants.assign(prop_variables.size(), "");
 	for(PropVariable* p : prop_variables)
 	{
-		// add the definition for this variable to the list
-		bool_vars.push_back(buildBoolVar(validateIdentifier(p->getName())));
+		if(p->isNonDeterministic())
+		{
+			continue;
+		}
+		std::string initial_value = prop_is_assigned[p->getId()] ?
+			"FALSE" : "";
+		auto it = initial_variable_values.find(
+			validateIdentifier(p->getName()));
+		if(it != initial_variable_values.end())
+		{
+			initial_value = (*it).second == "true" ? "TRUE" : "FALSE";
+		}
+		prop_variable_classes[p->getId()] =
+			classifyVariable(prop_values[p->getId()], initial_value,
+				options.freeze_unassigned_variables);
+		prop_variable_constants[p->getId()] = initial_value;
+	}
+
+	enum_variable_classes.assign(enum_variables.size(), VARIABLE_DYNAMIC);
+	enum_variable_constants.assign(enum_variables.size(), "");
+	for(EnumVariable* e : enum_variables)
+	{
+		if(e->isNonDeterministic())
+		{
+			continue;
+		}
+		std::string initial_value = "";
+		if(e->resets())
+		{
+			// a resetting variable is also assigned none in every state
+			initial_value = "none";
+			enum_values[e->getId()].insert(initial_value);
+		}
+		else
+		{
+			auto it = initial_variable_values.find(
+				validateIdentifier(e->getName()));
+			if(it != initial_variable_values.end())
+			{
+				// the value is compared as it is written in the model, with
+				// the values it is assigned and checked against
+				initial_value = validateIdentifier((*it).second);
+			}
+			if(!initial_value.empty() && !isDeclaredValue(e, initial_value))
+			{
+				// a value the variable cannot hold is never folded
+				continue;
+			}
+		}
+		enum_variable_classes[e->getId()] =
+			classifyVariable(enum_values[e->getId()], initial_value,
+				options.freeze_unassigned_variables);
+		enum_variable_constants[e->getId()] = initial_value;
 	}
-	return bool_vars;
 }
 
 /*------------------------------------------------------------------------------
-	buildBeenInStatesVar
+	buildVariableAssignmentMaps
 
-	Builds the the definitions for the enumerated variables used for
-	been_in_state suffixed preconditions.
------------------------------------------------------------------------------*/
-std::list<std::string> NuSMVTranslator::buildBeenInStatesVar()
-{
-	std::list<std::string> been_in_state_vars;
-	for(auto pair : been_in_state_map)
-	{
-		std::string been_in_state_var = "";
-		Precondition* p = pair.first;
-		std::list<std::string> values = pair.second;
-		PreconditionType t = p->getPreconditionType();
-		if(t == PreconditionType::PROP_VALUE_CHECK)
-		{
-			PreconditionPropValueCheck* p_prop =
-				(PreconditionPropValueCheck*)p;
-			PropVariable* prop_var = p_prop->getPropVariable();
-			been_in_state_var += validateIdentifier(prop_var->getName()
-				+ "_" + (p_prop->getTruthValue() ? "TRUE" : "FALSE"))
-				+ "_" + BEEN_IN_STATE + ": {";
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+	Builds the propositional and enumerated variable assignment maps.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildVariableAssignmentMaps()
+{
+	for(Behaviour* b : intermediate_form->getBehaviours())
+	{
+		std::string behaviour_name = validateIdentifier(b->getName());
+		int action_num = 1;
+		for(Action* action : b->getActions())
+		{
+			if(action->getActionType() == ActionType::PROP_VALUE_ASSIGNMENT
+				&& isDynamic(((ActionPropValueAssignment*)action)
+					->getPropVariable()))
 			{
-				been_in_state_var += *it;
-				if(++it != end)
+				ActionPropValueAssignment* action_prop =
+					(ActionPropValueAssignment*)action;
+				std::string prop_var_name = validateIdentifier(
+					action_prop->getPropVariable()->getName());
+				std::string prop_var_assign = "";
+				prop_var_assign += "(" + std::string(BEHAVIOUR_PREFIX)
+					+ behaviour_name + "." + B_IS_SCHEDULED + " & "
+					+ STEP + " = " + STEP + "_"
+					+ integerToString(action_num) + "): "
+					+ (action_prop->getTruthValue() ? "TRUE" : "FALSE");
+				auto it = prop_variable_assignment_map.find(prop_var_name);
+				if(it == prop_variable_assignment_map.end())
 				{
-					been_in_state_var += ", ";
+					it = prop_variable_assignment_map.insert(
+						std::pair<std::string, std::list<std::string>>(
+							prop_var_name, std::list<std::string>())).first;
+				}
+				// a behaviour outside of the cone of influence is never
+				// scheduled, but the variable still keeps its initial value
+				if(isTranslated(b))
+				{
+					(*it).second.push_back(prop_var_assign);
 				}
 			}
-			been_in_state_var += "}";
-		}
-		else if(t == PreconditionType::ENUM_VALUE_CHECK)
-		{
-			PreconditionEnumValueCheck* p_enum =
-				(PreconditionEnumValueCheck*)p;
-			EnumVariable* enum_var = p_enum->getEnumVariable();
-			been_in_state_var += validateIdentifier(enum_var->getName()
-				+ "_" + validateIdentifier(p_enum->getEnumValue()))
-				+ "_" + BEEN_IN_STATE + ": {";
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+			else if(action->getActionType() ==
+				ActionType::ENUM_VALUE_ASSIGNMENT
+				&& isDynamic(((ActionEnumValueAssignment*)action)
+					->getEnumVariable()))
 			{
-				been_in_state_var += *it;
-				if(++it != end)
+				ActionEnumValueAssignment* action_enum =
+					(ActionEnumValueAssignment*)action;
+				std::string enum_var_name =
+					action_enum->getEnumVariable()->getName();
+				std::string enum_var_assign = "";
+				enum_var_assign += "(" + std::string(BEHAVIOUR_PREFIX)
+					+ behaviour_name + "." + B_IS_SCHEDULED + " & "
+					+ STEP + " = " + STEP + "_"
+					+ integerToString(action_num) + "): "
+					+ validateIdentifier(action_enum->getEnumValue());
+				auto it = enum_variable_assignment_map.find(enum_var_name);
+				if(it == enum_variable_assignment_map.end())
+				{
+					it = enum_variable_assignment_map.insert(
+						std::make_pair(enum_var_name, std::make_pair(
+							action_enum->getEnumVariable(),
+							std::list<std::string>()))).first;
+				}
+				if(isTranslated(b))
 				{
-					been_in_state_var += ", ";
+					(*it).second.second.push_back(enum_var_assign);
 				}
 			}
-			been_in_state_var += "}";
-			been_in_state_var += "}";
+			action_num++;
 		}
-		else
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildEnumsVar
+
+	Builds the variable definitions for	the enumerated variables.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildEnumsVar(NuSMVWriter& writer) const
+{
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		if(!isDynamic(e))
 		{
+			continue;
+		}
+		// write the definition for this variable
+		writer.beginLine(2);
+		buildEnumVar(writer, validateIdentifier(e->getName()),
+			e->getValues());
+		writer.endLine(true);
+	}
+}
 
+/*------------------------------------------------------------------------------
+	buildBoolsVar
+
+	Builds the variable definitions for	the boolean variables.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildBoolsVar(NuSMVWriter& writer) const
+{
+	for(PropVariable* p : intermediate_form->getPropVariables())
+	{
+		if(!isDynamic(p))
+		{
+			continue;
 		}
-		been_in_state_vars.push_back(been_in_state_var);
+		// write the definition for this variable
+		writer.beginLine(2);
+		buildBoolVar(writer, validateIdentifier(p->getName()));
+		writer.endLine(true);
 	}
-	return been_in_state_vars;
 }
 
 /*------------------------------------------------------------------------------
-	buildWasInStatesVar
+	buildFrozenVars
 
-	Builds the the definitions for the enumerated variables used for
-	was_in_state suffixed preconditions.
+	Builds the FROZENVAR section declaring the frozen variables, if there are
+	any.
 ------------------------------------------------------------------------------*/
-std::list<std::string> NuSMVTranslator::buildWasInStatesVar()
+void NuSMVTranslator::buildFrozenVars(NuSMVWriter& writer) const
 {
-	std::list<std::string> was_in_state_vars;
-	for(auto pair : was_in_state_map)
+	std::vector<PropVariable*> frozen_prop_variables;
+	for(PropVariable* p : intermediate_form->getPropVariables())
 	{
-		std::string was_in_state_var = "";
-		Precondition* p = pair.first;
-		std::list<std::string> values = pair.second;
-		PreconditionType t = p->getPreconditionType();
-		if(t == PreconditionType::PROP_VALUE_CHECK)
+		if(isTranslated(p)
+			&& prop_variable_classes[p->getId()] == VARIABLE_FROZEN)
 		{
-			PreconditionPropValueCheck* p_prop =
-				(PreconditionPropValueCheck*)p;
-			PropVariable* prop_var = p_prop->getPropVariable();
-			was_in_state_var += validateIdentifier(prop_var->getName()
-				+ "_" + (p_prop->getTruthValue() ? "TRUE" : "FALSE"))
-				+ "_" + WAS_IN_STATE + ": {";
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
-			{
-				was_in_state_var += *it;
-				if(++it != end)
-				{
-					was_in_state_var += ", ";
-				}
-			}
-			was_in_state_var += "}";
+			frozen_prop_variables.push_back(p);
 		}
-		else if(t == PreconditionType::ENUM_VALUE_CHECK)
+	}
+	std::vector<EnumVariable*> frozen_enum_variables;
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		if(isTranslated(e)
+			&& enum_variable_classes[e->getId()] == VARIABLE_FROZEN)
 		{
-			PreconditionEnumValueCheck* p_enum =
-				(PreconditionEnumValueCheck*)p;
-			EnumVariable* enum_var = p_enum->getEnumVariable();
-			was_in_state_var += validateIdentifier(enum_var->getName()
-				+ "_" + validateIdentifier(p_enum->getEnumValue()))
-				+ "_" + WAS_IN_STATE + ": {";
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+			frozen_enum_variables.push_back(e);
+		}
+	}
+	if(frozen_prop_variables.empty() && frozen_enum_variables.empty())
+	{
+		return;
+	}
+	writer.addLine(H_LINE, 1, false);
+	writer.addLine("--\tFrozen Variables", 1, false);
+	writer.addLine(H_LINE, 1, false);
+	writer.addLine("FROZENVAR", 1, false);
+	for(PropVariable* p : frozen_prop_variables)
+	{
+		writer.beginLine(2);
+		buildBoolVar(writer, validateIdentifier(p->getName()));
+		writer.endLine(true);
+	}
+	for(EnumVariable* e : frozen_enum_variables)
+	{
+		writer.beginLine(2);
+		buildEnumVar(writer, validateIdentifier(e->getName()),
+			e->getValues());
+		writer.endLine(true);
+	}
+	writer.addLine("", 0, false);
+}
+
+/*------------------------------------------------------------------------------
+	buildScheduleChoiceIvars
+
+	Builds the IVAR section declaring an input variable for each group of
+	equal priority behaviours that is too large to be scheduled by
+	enumerating its subsets, if there are any.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildScheduleChoiceIvars(NuSMVWriter& writer) const
+{
+	int choice_num = 0;
+	for(const std::vector<std::string>& group : equal_priority_groups)
+	{
+		if(group.size() <= (unsigned int)options.max_power_set_group_size)
+		{
+			continue;
+		}
+		if(choice_num++ == 0)
+		{
+			writer.addLine(H_LINE, 1, false);
+			writer.addLine("--\tSchedule Choices", 1, false);
+			writer.addLine(H_LINE, 1, false);
+			writer.addLine("IVAR", 1, false);
+		}
+		std::list<std::string> values;
+		for(const std::string& behaviour_name : group)
+		{
+			values.push_back(std::string(SCHEDULE) + "_" + behaviour_name);
+		}
+		writer.beginLine(2);
+		buildEnumVar(writer, std::string(SCHEDULE_CHOICE) + "_"
+			+ integerToString(choice_num), values);
+		writer.endLine(true);
+	}
+	if(choice_num > 0)
+	{
+		writer.addLine("", 0, false);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildConstantsDeclaration
+
+	Builds the CONSTANTS section declaring the values of the constant
+	enumerated variables, which no longer appear in any variable's type, if
+	there are any.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildConstantsDeclaration(NuSMVWriter& writer) const
+{
+	std::set<std::string> values;
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		if(isTranslated(e)
+			&& enum_variable_classes[e->getId()] == VARIABLE_CONSTANT)
+		{
+			for(const std::string& value : e->getValues())
 			{
-				was_in_state_var += *it;
-				if(++it != end)
-				{
-					was_in_state_var += ", ";
-				}
+				values.insert(validateIdentifier(value));
 			}
-			was_in_state_var += "}";
 		}
-		else
+	}
+	if(values.empty())
+	{
+		return;
+	}
+	writer.addLine("CONSTANTS", 1, false);
+	writer.beginLine(2);
+	auto it = values.begin();
+	auto end = values.end();
+	while(it != end)
+	{
+		writer << *it;
+		if(++it != end)
 		{
+			writer << ", ";
+		}
+	}
+	writer.endLine(true);
+	writer.addLine("", 0, false);
+}
 
+/*------------------------------------------------------------------------------
+	buildConstantDefines
+
+	Builds a definition giving the value of each constant variable.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildConstantDefines(NuSMVWriter& writer) const
+{
+	bool is_empty = true;
+	for(PropVariable* p : intermediate_form->getPropVariables())
+	{
+		if(isTranslated(p)
+			&& prop_variable_classes[p->getId()] == VARIABLE_CONSTANT)
+		{
+			writer.addLine(validateIdentifier(p->getName()) + ":= "
+				+ prop_variable_constants[p->getId()], 2, true);
+			is_empty = false;
+		}
+	}
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		if(isTranslated(e)
+			&& enum_variable_classes[e->getId()] == VARIABLE_CONSTANT)
+		{
+			writer.addLine(validateIdentifier(e->getName()) + ":= "
+				+ enum_variable_constants[e->getId()], 2, true);
+			is_empty = false;
 		}
-		was_in_state_vars.push_back(was_in_state_var);
 	}
-	return was_in_state_vars;
+	if(!is_empty)
+	{
+		writer.addLine("", 2, false);
+	}
 }
 
 /*------------------------------------------------------------------------------
-	buildEnumVar
+	buildBeenInStatesVar
 
-	Builds the the definition for a given enumerated variable.
+	Builds the the definitions for the enumerated variables used for
+	been_in_state suffixed preconditions.
+-----------------------------------------------------------------------------*/
+void NuSMVTranslator::buildBeenInStatesVar(NuSMVWriter& writer) const
+{
+	for(auto& pair : been_in_state_map)
+	{
+		writer.beginLine(2);
+		buildEnumVar(writer, pair.first, pair.second.second);
+		writer.endLine(true);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildWasInStatesVar
+
+	Builds the the definitions for the enumerated variables used for
+	was_in_state suffixed preconditions.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildEnumVar(const std::string name,
-	std::list<std::string> values)
+void NuSMVTranslator::buildWasInStatesVar(NuSMVWriter& writer) const
 {
-	std::string enum_var = "";
-	if(values.empty())
+	for(auto& pair : was_in_state_map)
 	{
-		return enum_var;
+		writer.beginLine(2);
+		buildEnumVar(writer, pair.first, pair.second.second);
+		writer.endLine(true);
 	}
-	else
+}
+
+/*------------------------------------------------------------------------------
+	buildIntegerCountersVar
+
+	Builds the definitions for the bounded integer counters used for
+	been_in_state and was_in_state suffixed preconditions.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildIntegerCountersVar(NuSMVWriter& writer) const
+{
+	for(auto& pair : been_in_state_map)
+	{
+		writer.addLine(pair.first + ": 0.."
+			+ integerToString(pair.second.second.size() - 1), 2, true);
+	}
+	for(auto& pair : was_in_state_map)
 	{
-		enum_var += name + ": {";
+		writer.addLine(pair.first + ": 0.."
+			+ integerToString(pair.second.second.size() - 1), 2, true);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildCounterReport
+
+	Builds a comment for each been_in_state or was_in_state suffixed
+	precondition, giving the check made against its counter and the number
+	of bits needed to encode the counter.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildCounterReport(NuSMVWriter& writer) const
+{
+	for(Behaviour* b : behaviours)
+	{
+		for(Precondition* p : b->getPreconditions())
+		{
+			if(counter_steps.find(p) == counter_steps.end())
+			{
+				continue;
+			}
+			const std::string counter_name = getCounterName(p);
+			unsigned int num_values = p->getTimeConstraintType()
+				== TimeConstraintType::BEEN_IN_STATE_FOR ?
+				been_in_state_map.find(counter_name)->second.second.size() :
+				was_in_state_map.find(counter_name)->second.second.size();
+			writer.addLine("--\t" + validateIdentifier(b->getName()) + ": "
+				+ getCounterExpression(p) + " ["
+				+ integerToString(numBits(num_values)) + " bits]", 2, false);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildEnumVar
+
+	Builds the the definition for a given enumerated variable.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildEnumVar(NuSMVWriter& writer,
+	const std::string& name, const std::list<std::string>& values) const
+{
+	if(!values.empty())
+	{
+		writer << name << ": {";
 		auto it = values.begin();
 		auto end = values.end();
 		while(it != end)
 		{
-			enum_var += validateIdentifier(*it);
+			writer << validateIdentifier(*it);
 			if(++it != end)
 			{
-				enum_var += ", ";
+				writer << ", ";
 			}
 		}
-		enum_var += "}";
+		writer << "}";
 	}
-	return enum_var;
 }
 
 /*------------------------------------------------------------------------------
@@ -1053,11 +1969,10 @@ const std::string NuSMVTranslator::buildEnumVar(const std::string name,
 
 	Builds the the definition for a given boolean variable.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildBoolVar(const std::string name)
+void NuSMVTranslator::buildBoolVar(NuSMVWriter& writer,
+	const std::string& name) const
 {
-	std::string bool_var = "";
-	bool_var += validateIdentifier(name) + ": boolean";
-	return bool_var;
+	writer << validateIdentifier(name) << ": boolean";
 }
 
 /*------------------------------------------------------------------------------
@@ -1066,25 +1981,25 @@ const std::string NuSMVTranslator::buildBoolVar(const std::string name)
 	Builds the variable definition for the time variable which indicates
 	the time of day.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildTimeVar()
+void NuSMVTranslator::buildTimeVar(NuSMVWriter& writer) const
 {
-	std::string time = "";
 	if(!time_intervals.empty())
 	{
-		time += std::string(TIME) + ": {";
+		writer.beginLine(2);
+		writer << TIME << ": {";
 		auto it = time_intervals.begin();
 		auto end = time_intervals.end();
 		while(it != end)
 		{
-			time += *it;
+			writer << *it;
 			if(++it != end)
 			{
-				time += ", ";
+				writer << ", ";
 			}
 		}
-		time += "}";
+		writer << "}";
+		writer.endLine(true);
 	}
-	return time;
 }
 
 /*------------------------------------------------------------------------------
@@ -1093,32 +2008,20 @@ const std::string NuSMVTranslator::buildTimeVar()
 	Builds the variable definition for the step variable, this records
 	which action is currently being performed by a behaviour.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildStepVar()
+void NuSMVTranslator::buildStepVar(NuSMVWriter& writer) const
 {
-	std::string steps = "";
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
-	max_num_actions = 0;
-	// get the maximum number of actions in a behaviour
-	std::for_each(behaviours.begin(), behaviours.end(),
-		[&](Behaviour* b)
-		{
-			max_num_actions = max_num_actions > b->getActions().size() ?
-				max_num_actions : b->getActions().size();
-		});
-	if(max_num_actions > 0)
+	writer.beginLine(2);
+	writer << STEP << ": {" << STEP << "_" << "none, ";
+	for(unsigned int i = 1; i <= max_num_actions; i++)
 	{
-		steps = std::string(STEP) +  ": {" + STEP + "_" + "none, ";
-		for(unsigned int i = 1; i <= max_num_actions; i++)
+		writer << STEP << "_" << integerToString(i);
+		if(i < max_num_actions)
 		{
-			steps += std::string(STEP) + "_" + integerToString(i);
-			if(i < max_num_actions)
-			{
-				steps += ", ";
-			}
+			writer << ", ";
 		}
-		steps += "}";
 	}
-	return steps;
+	writer << "}";
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1127,28 +2030,23 @@ const std::string NuSMVTranslator::buildStepVar()
 	Builds the variable definition for the schedule variable, this records
 	which behaviour is currently scheduled for execution.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildScheduleVar()
+void NuSMVTranslator::buildScheduleVar(NuSMVWriter& writer) const
 {
-	std::string schedule = "";
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
-	if(!behaviours.empty())
+	writer.beginLine(2);
+	writer << SCHEDULE << ": {" << SCHEDULE << "_none, ";
+	auto it = behaviours.begin();
+	auto end = behaviours.end();
+	while(it != end)
 	{
-		schedule += std::string(SCHEDULE) + ": {" + SCHEDULE + "_none, ";
-		auto it = behaviours.begin();
-		auto end = behaviours.end();
-		while(it != end)
+		Behaviour* b = *it;
+		writer << SCHEDULE << "_" << validateIdentifier(b->getName());
+		if(++it != end)
 		{
-			Behaviour* b = *it;
-			schedule += std::string(SCHEDULE) + "_"
-				+ validateIdentifier(b->getName());
-			if(++it != end)
-			{
-				schedule += ", ";
-			}
+			writer << ", ";
 		}
-		schedule += "}";
 	}
-	return schedule;
+	writer << "}";
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1158,214 +2056,154 @@ const std::string NuSMVTranslator::buildScheduleVar()
 	is used to 'remember' any previous behaviour that may have executed the
 	current behaviour.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildLastScheduleVar()
+void NuSMVTranslator::buildLastScheduleVar(NuSMVWriter& writer) const
 {
-	std::string last_schedule = "";
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
-	if(!behaviours.empty())
+	writer.beginLine(2);
+	writer << LAST_SCHEDULE << ": {" << SCHEDULE << "_none, ";
+	auto it = behaviours.begin();
+	auto end = behaviours.end();
+	while(it != end)
 	{
-		last_schedule += std::string(LAST_SCHEDULE) + ": {" + SCHEDULE
-			+ "_none, ";
-		auto it = behaviours.begin();
-		auto end = behaviours.end();
-		while(it != end)
+		Behaviour* b = *it;
+		writer << SCHEDULE << "_" << validateIdentifier(b->getName());
+		if(++it != end)
 		{
-			Behaviour* b = *it;
-			last_schedule += std::string(SCHEDULE) + "_"
-				+ validateIdentifier(b->getName());
-			if(++it != end)
-			{
-				last_schedule += ", ";
-			}
+			writer << ", ";
 		}
-		last_schedule += "}";
 	}
-	return last_schedule;
+	writer << "}";
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
 	buildPreconditionDefines
 
 	For all behaviours, builds an expression that evaluates to true if all
-	of the behaviour's preconditions hold.
+	of the behaviour's preconditions hold. The expressions are built into one
+	DAG, and the subexpressions shared by several behaviours are defined once.
 ------------------------------------------------------------------------------*/
-std::list<std::string> NuSMVTranslator::buildPreconditionDefines()
+void NuSMVTranslator::buildPreconditionDefines(NuSMVWriter& writer) const
 {
-	std::list<std::string> precondition_defines;
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
-	if(!behaviours.empty())
+	ExpressionDag dag;
+	std::vector<int> roots;
+	for(Behaviour* behaviour : behaviours)
 	{
-		auto it = behaviours.begin();
-		auto end = behaviours.end();
-		while(it != end)
-		{
-			std::string behaviour_precondition;
-			Behaviour* behaviour = *it;
-			LogicalExpressionTree* logical_expression_tree =
-				behaviour->getLogicalExpressionTree();
-			if(logical_expression_tree != nullptr)
-			{
-				behaviour_precondition += PRECONDITION_PREFIX
-					+ validateIdentifier(behaviour->getName()) + ":= ";
-				behaviour_precondition += buildPreconditionDefine(
-					logical_expression_tree->getRoot());
-				precondition_defines.push_back(behaviour_precondition);
-			}
-			else
-			{
-				behaviour_precondition += PRECONDITION_PREFIX
-					+ validateIdentifier(behaviour->getName()) + ":= TRUE";
-				precondition_defines.push_back(behaviour_precondition);
-			}
-			it++;
-		}
+		LogicalExpressionTree* logical_expression_tree =
+			behaviour->getLogicalExpressionTree();
+		roots.push_back(logical_expression_tree != nullptr ?
+			addPreconditionExpression(dag,
+				logical_expression_tree->getRoot()) :
+			dag.addConstant(true));
+		dag.addRoot(roots.back());
+	}
+	dag.nameSharedNodes(SHARED_PRECONDITION_PREFIX);
+	for(int node : dag.getSharedNodes())
+	{
+		writer.addLine(dag.getName(node) + ":= " + dag.getDefinition(node), 2,
+			true);
+	}
+	if(!dag.getSharedNodes().empty())
+	{
+		writer.addLine("", 2, false);
+	}
+	for(unsigned int i = 0; i < behaviours.size(); i++)
+	{
+		writer.addLine(PRECONDITION_PREFIX
+			+ validateIdentifier(behaviours[i]->getName()) + ":= "
+			+ dag.getExpression(roots[i]), 2, true);
 	}
-	return precondition_defines;
 }
 
 /*------------------------------------------------------------------------------
-	buildPreconditionDefine
+	addPreconditionExpression
 
-	Given the root node of a logical expression tree, recursively builds an
-	expression that evaluates to true if all of the tree's preconditions hold.
+	Given the root node of a logical expression tree, recursively adds an
+	expression that evaluates to true if all of the tree's preconditions hold
+	to the given DAG.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildPreconditionDefine(
-	const TreeNode* node)
+const int NuSMVTranslator::addPreconditionExpression(ExpressionDag& dag,
+	const TreeNode* node) const
 {
-	std::string precondition_define;
 	if(node->getNodeType() == TreeNodeType::INTERNAL_AND)
 	{
-		precondition_define =  "(" + buildPreconditionDefine(node->getLeft())
-			+ " & " + buildPreconditionDefine(node->getRight()) + ")";
+		return dag.addAnd(addPreconditionExpression(dag, node->getLeft()),
+			addPreconditionExpression(dag, node->getRight()));
 	}
 	else if(node->getNodeType() == TreeNodeType::INTERNAL_OR)
 	{
-		precondition_define =  "(" + buildPreconditionDefine(node->getLeft())
-			+ " | " + buildPreconditionDefine(node->getRight()) + ")";
+		return dag.addOr(addPreconditionExpression(dag, node->getLeft()),
+			addPreconditionExpression(dag, node->getRight()));
 	}
 	else if(node->getNodeType() == TreeNodeType::INTERNAL_NOT)
 	{
-		precondition_define =  "!" + buildPreconditionDefine(node->getLeft());
+		return dag.addNot(addPreconditionExpression(dag, node->getLeft()));
 	}
-	else
+	Precondition* p = node->getPrecondition();
+	int check;
+	if(p->getPreconditionType() == PreconditionType::PROP_VALUE_CHECK)
 	{
-		Precondition* p = node->getPrecondition();
-		if(p->getPreconditionType() == PreconditionType::PROP_VALUE_CHECK)
+		PreconditionPropValueCheck* p_cast = (PreconditionPropValueCheck*)p;
+		PropVariable* prop_var = p_cast->getPropVariable();
+		if(prop_variable_classes[prop_var->getId()] == VARIABLE_CONSTANT)
 		{
-			PreconditionPropValueCheck* p_cast = (PreconditionPropValueCheck*)p;
-			PropVariable* prop_var = p_cast->getPropVariable();
-			if(prop_var->isNonDeterministic())
-			{
-				precondition_define = validateIdentifier(prop_var->getName());
-			}
-			else
-			{
-				precondition_define = (p_cast->getTruthValue() ? "" : "!")
-					+ validateIdentifier(prop_var->getName());
-			}
-			// if this has a time constraint add the additional conditions
-			if(p_cast->getTimeConstraintType() ==
-				TimeConstraintType::BEEN_IN_STATE_FOR)
-			{
-				auto it = been_in_state_map.find(p);
-				if(it != been_in_state_map.end())
-				{
-					auto pair = *it;
-					std::string been_in_var_name =
-						validateIdentifier(prop_var->getName()) + "_"
-							+ (p_cast->getTruthValue() ? "TRUE" : "FALSE")
-							+ "_" + BEEN_IN_STATE;
-					precondition_define += " & " + been_in_var_name + " = "
-						+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_FINAL;
-				}
-			}
-			else if(p_cast->getTimeConstraintType() ==
-					TimeConstraintType::WAS_IN_STATE_WITHIN)
-			{
-				auto it = was_in_state_map.find(p);
-				if(it != was_in_state_map.end())
-				{
-					auto pair = *it;
-					std::string been_in_var_name =
-						validateIdentifier(prop_var->getName()) + "_"
-							+ (p_cast->getTruthValue() ? "TRUE" : "FALSE")
-							+ "_" + WAS_IN_STATE;
-					precondition_define += " & " + been_in_var_name + " != "
-						+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START;
-				}
-			}
+			// fold the check against the constant value
+			check = dag.addConstant((prop_variable_constants[prop_var->getId()]
+				== "TRUE") == p_cast->getTruthValue());
 		}
-		else if(p->getPreconditionType() == PreconditionType::ENUM_VALUE_CHECK)
+		else if(prop_var->isNonDeterministic())
 		{
-			PreconditionEnumValueCheck* p_cast = (PreconditionEnumValueCheck*)p;
-			EnumVariable* enum_var = p_cast->getEnumVariable();
-			precondition_define = validateIdentifier(enum_var->getName())
-				+ " = " + validateIdentifier(p_cast->getEnumValue());
-			if(p_cast->getTimeConstraintType() ==
-				TimeConstraintType::BEEN_IN_STATE_FOR)
-			{
-				auto it = been_in_state_map.find(p);
-				if(it != been_in_state_map.end())
-				{
-					auto pair = *it;
-					std::string been_in_var_name =
-						validateIdentifier(enum_var->getName()) + "_"
-							+ p_cast->getEnumValue() + "_" + BEEN_IN_STATE;
-					precondition_define += " & " + been_in_var_name + " = "
-						+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_FINAL;
-				}
-			}
-			else if(p_cast->getTimeConstraintType() ==
-					TimeConstraintType::WAS_IN_STATE_WITHIN)
-			{
-				auto it = was_in_state_map.find(p);
-				if(it != was_in_state_map.end())
-				{
-					auto pair = *it;
-					std::string been_in_var_name =
-						validateIdentifier(enum_var->getName()) + "_"
-							+ p_cast->getEnumValue() + "_" + WAS_IN_STATE;
-					precondition_define += " & " + been_in_var_name + " != "
-						+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START;
-				}
-			}
+			check = dag.addAtom(validateIdentifier(prop_var->getName()));
 		}
 		else
 		{
-			PreconditionTimingConstraint* p_cast =
-				(PreconditionTimingConstraint*)p;
-			if(g_time_of_day == "")
+			check = dag.addAtom(validateIdentifier(prop_var->getName()));
+			if(!p_cast->getTruthValue())
 			{
-				// if no time of day has been set with -tod
-				auto pair = *(timing_constraint_map.find(p_cast));
-				if(pair.second->size() > 1)
-				{
-					precondition_define += "(";
-				}
-				auto it = pair.second->begin();
-				auto end = pair.second->end();
-				while(it != end)
-				{
-					precondition_define += std::string(TIME) + " = " + *it;
-					if(++it != end)
-					{
-						precondition_define += " | ";
-					}
-				}
-				if(pair.second->size() > 1)
-				{
-					precondition_define += ")";
-				}
-			}
-			else
-			{
-				precondition_define +=
-					(timeConstraintHoldsAtTime(p_cast, g_time_of_day) ?
-						"TRUE" : "FALSE");
+				check = dag.addNot(check);
 			}
 		}
 	}
-	return precondition_define;
+	else if(p->getPreconditionType() == PreconditionType::ENUM_VALUE_CHECK)
+	{
+		PreconditionEnumValueCheck* p_cast = (PreconditionEnumValueCheck*)p;
+		EnumVariable* enum_var = p_cast->getEnumVariable();
+		if(enum_variable_classes[enum_var->getId()] == VARIABLE_CONSTANT)
+		{
+			// fold the check against the constant value
+			check = dag.addConstant(enum_variable_constants[enum_var->getId()]
+				== validateIdentifier(p_cast->getEnumValue()));
+		}
+		else
+		{
+			check = dag.addAtom(validateIdentifier(enum_var->getName())
+				+ " = " + validateIdentifier(p_cast->getEnumValue()));
+		}
+	}
+	else
+	{
+		PreconditionTimingConstraint* p_cast =
+			(PreconditionTimingConstraint*)p;
+		if(options.time_of_day != "")
+		{
+			// the time of day has been set with -tod
+			return dag.addConstant(timeConstraintHoldsAtTime(p_cast,
+				options.time_of_day));
+		}
+		check = dag.addConstant(false);
+		for(const std::string& time : *timing_constraint_map.find(p_cast)
+			->second)
+		{
+			check = dag.addOr(check, dag.addAtom(std::string(TIME) + " = "
+				+ time));
+		}
+		return check;
+	}
+	// if this has a time constraint add the additional conditions
+	if(counter_steps.find(p) != counter_steps.end())
+	{
+		check = dag.addAnd(check, dag.addAtom(getCounterExpression(p)));
+	}
+	return check;
 }
 
 /*------------------------------------------------------------------------------
@@ -1375,9 +2213,8 @@ const std::string NuSMVTranslator::buildPreconditionDefine(
 	that behaviour can interrupt a currently scheduled behaviour in the next
 	moment in time.
 ------------------------------------------------------------------------------*/
-const std::list<std::string> NuSMVTranslator::buildCanInterruptDefines()
+void NuSMVTranslator::buildCanInterruptDefines(NuSMVWriter& writer) const
 {
-	std::list<std::string> can_interrupt_defines;
 	std::set<int> priorities;
 	// get the priorities
 	std::for_each(schedulable_behaviours.begin(), schedulable_behaviours.end(),
@@ -1385,27 +2222,17 @@ const std::list<std::string> NuSMVTranslator::buildCanInterruptDefines()
 		{
 			priorities.insert(b->getPriority());
 		});
-	// sort the list into priority order, highest first
-	std::sort(schedulable_behaviours.begin(), schedulable_behaviours.end(),
-		[&](Behaviour* this_b, Behaviour* that_b)
-		{
-			return this_b->getPriority() > that_b->getPriority();
-		});
 	int priority = *(priorities.begin());
 	priorities.erase(priority);
-	std::string interrupt_string = CAN_INTERRUPT_PREFIX;
-	interrupt_string += integerToString(priority);
-	std::string previous_interrupt_string = interrupt_string;
-	interrupt_string += ":= FALSE";
-	can_interrupt_defines.push_back(interrupt_string);
+	std::string previous_interrupt_string = CAN_INTERRUPT_PREFIX
+		+ integerToString(priority);
+	writer.addLine(previous_interrupt_string + ":= FALSE", 2, true);
 	unsigned int index = schedulable_behaviours.size() - 1;
 	while(!priorities.empty())
 	{
 		std::list<Behaviour*> lower_priority_behaviours;
 		int priority = *(priorities.begin());
 		priorities.erase(priority);
-		std::string interrupt_string = CAN_INTERRUPT_PREFIX;
-		interrupt_string += integerToString(priority) + ":= (";
 		// build the list of lower priority behaviours
 		while(index >= 0
 			&& (schedulable_behaviours[index]->getPriority() < priority))
@@ -1416,63 +2243,25 @@ const std::list<std::string> NuSMVTranslator::buildCanInterruptDefines()
 		}
 		if(!lower_priority_behaviours.empty())
 		{
-			std::string interruptibles = "";
-			interrupt_string += previous_interrupt_string;
-			auto it = lower_priority_behaviours.begin();
-			auto end = lower_priority_behaviours.end();
-			while(it != end)
+			writer.beginLine(2);
+			writer << CAN_INTERRUPT_PREFIX << integerToString(priority)
+				<< ":= (" << previous_interrupt_string;
+			bool is_first = true;
+			for(Behaviour* b : lower_priority_behaviours)
 			{
-				Behaviour* b = *it;
 				if(b->isInterruptible())
 				{
-					interruptibles += SCHEDULE;
-					interruptibles += " = ";
-					interruptibles += SCHEDULE;
-					interruptibles += "_" + validateIdentifier(b->getName());
-					if(++it != end)
-					{
-						auto it_copy = it;
-						bool is_another = false;
-						while(it_copy != end)
-						{
-							if((*it_copy)->isInterruptible())
-							{
-								is_another = true;
-								break;
-							}
-							else
-							{
-								it_copy++;
-							}
-						}
-						if(is_another)
-						{
-							interruptibles += " | ";
-						}
-					}
-				}
-				else
-				{
-					it++;
+					writer << (is_first ? " | (" : " | ") << SCHEDULE << " = "
+						<< SCHEDULE << "_" << validateIdentifier(b->getName());
+					is_first = false;
 				}
 			}
-			if(interruptibles != "")
-			{
-				interrupt_string += " | ";
-				interrupt_string += "(";
-				interrupt_string += interruptibles;
-				interrupt_string += "))";
-			}
-			else
-			{
-				interrupt_string += ")";
-			}
-			can_interrupt_defines.push_back(interrupt_string);
-			previous_interrupt_string = CAN_INTERRUPT_PREFIX;
-			previous_interrupt_string += integerToString(priority);
+			writer << (is_first ? ")" : "))");
+			writer.endLine(true);
+			previous_interrupt_string = CAN_INTERRUPT_PREFIX
+				+ integerToString(priority);
 		}
 	}
-	return can_interrupt_defines;
 }
 
 /*------------------------------------------------------------------------------
@@ -1482,26 +2271,25 @@ const std::list<std::string> NuSMVTranslator::buildCanInterruptDefines()
 	true if there is a behaviour that can be scheduled for execution in the
 	next moment in time.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildABehaviourCanBeScheduledDefine()
+void NuSMVTranslator::buildABehaviourCanBeScheduledDefine(
+	NuSMVWriter& writer) const
 {
-	std::string a_behaviour_can_be_executed;
-	a_behaviour_can_be_executed += A_BEHAVIOUR_CAN_BE_SCHEDULED;
-	a_behaviour_can_be_executed += ":= (";
+	writer.beginLine(2);
+	writer << A_BEHAVIOUR_CAN_BE_SCHEDULED << ":= (";
 	auto it = schedulable_behaviours.begin();
 	auto end = schedulable_behaviours.end();
 	while(it != end)
 	{
 		Behaviour* b = *it;
-		a_behaviour_can_be_executed += BEHAVIOUR_PREFIX
-			+ validateIdentifier(b->getName())
-			+ "." + B_CAN_BE_SCHEDULED;
+		writer << BEHAVIOUR_PREFIX << validateIdentifier(b->getName())
+			<< "." << B_CAN_BE_SCHEDULED;
 		if(++it != end)
 		{
-			a_behaviour_can_be_executed += " | ";
+			writer << " | ";
 		}
 	}
-	a_behaviour_can_be_executed += ")";
-	return a_behaviour_can_be_executed;
+	writer << ")";
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1510,26 +2298,24 @@ const std::string NuSMVTranslator::buildABehaviourCanBeScheduledDefine()
 	Builds the a_behaviour_is_ending definition, which evaluates to
 	true if the currently scheduled behaviour is executing its last action.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildABehaviourIsEndingDefine()
+void NuSMVTranslator::buildABehaviourIsEndingDefine(NuSMVWriter& writer) const
 {
-	std::string a_behaviour_is_ending;
-	a_behaviour_is_ending += A_BEHAVIOUR_IS_ENDING;
-	a_behaviour_is_ending += ":= (";
+	writer.beginLine(2);
+	writer << A_BEHAVIOUR_IS_ENDING << ":= (";
 	auto it = schedulable_behaviours.begin();
 	auto end = schedulable_behaviours.end();
 	while(it != end)
 	{
 		Behaviour* b = *it;
-		a_behaviour_is_ending += BEHAVIOUR_PREFIX
-			+ validateIdentifier(b->getName())
-			+ "." + B_IS_LAST_STEP;
+		writer << BEHAVIOUR_PREFIX << validateIdentifier(b->getName())
+			<< "." << B_IS_LAST_STEP;
 		if(++it != end)
 		{
-			a_behaviour_is_ending += " | ";
+			writer << " | ";
 		}
 	}
-	a_behaviour_is_ending += ")";
-	return a_behaviour_is_ending;
+	writer << ")";
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1539,34 +2325,33 @@ const std::string NuSMVTranslator::buildABehaviourIsEndingDefine()
 	to true if the currently scheduled behaviour is executing its last
 	action, and this scheduled behaviour was executed by another behaviour.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildAnExecutedBehaviourIsEndingDefine()
+void NuSMVTranslator::buildAnExecutedBehaviourIsEndingDefine(
+	NuSMVWriter& writer) const
 {
-	std::string an_executed_behaviour_is_ending = "";
-	an_executed_behaviour_is_ending += AN_EXECUTED_BEHAVIOUR_IS_ENDING;
-	an_executed_behaviour_is_ending += ":= ";
+	writer.beginLine(2);
+	writer << AN_EXECUTED_BEHAVIOUR_IS_ENDING << ":= ";
 	if(executable_behaviours.empty())
 	{
-		an_executed_behaviour_is_ending += "FALSE";
+		writer << "FALSE";
 	}
 	else
 	{
-		an_executed_behaviour_is_ending += "(";
+		writer << "(";
 		auto it = executable_behaviours.begin();
 		auto end = executable_behaviours.end();
 		while(it != end)
 		{
 			Behaviour* b = *it;
-			an_executed_behaviour_is_ending += BEHAVIOUR_PREFIX
-				+ validateIdentifier(b->getName())
-				+ "." + B_IS_LAST_STEP;
+			writer << BEHAVIOUR_PREFIX << validateIdentifier(b->getName())
+				<< "." << B_IS_LAST_STEP;
 			if(++it != end)
 			{
-				an_executed_behaviour_is_ending += " | ";
+				writer << " | ";
 			}
 		}
-		an_executed_behaviour_is_ending += ")";
+		writer << ")";
 	}
-	return an_executed_behaviour_is_ending;
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1578,112 +2363,80 @@ const std::string NuSMVTranslator::buildAnExecutedBehaviourIsEndingDefine()
 	another behaviour, and the action that executed this behaviour was the
 	last action in the ordered list of actions in the executing behaviour.
 ------------------------------------------------------------------------------*/
-const std::string
-	NuSMVTranslator::buildAnExecutedBehaviourIsEndingAsALastActionDefine()
+void NuSMVTranslator::buildAnExecutedBehaviourIsEndingAsALastActionDefine(
+	NuSMVWriter& writer) const
 {
-	std::string an_executed_behaviour_is_ending_as_a_last_action_define = "";
-	an_executed_behaviour_is_ending_as_a_last_action_define +=
-		AN_EXECUTED_BEHAVIOUR_IS_ENDING_AS_A_LAST_ACTION;
-	an_executed_behaviour_is_ending_as_a_last_action_define += ":= ";
+	writer.beginLine(2);
+	writer << AN_EXECUTED_BEHAVIOUR_IS_ENDING_AS_A_LAST_ACTION << ":= ";
 	if(executing_behaviours.empty())
 	{
-		an_executed_behaviour_is_ending_as_a_last_action_define += "FALSE";
+		writer << "FALSE";
 	}
 	else
 	{
-		an_executed_behaviour_is_ending_as_a_last_action_define += "(";
-		auto it = executing_behaviours.begin();
-		auto end = executing_behaviours.end();
+		writer << "(";
 		bool this_is_the_first = true;
-		bool exists_an_executable_behaviour_as_a_last_action = false;
-		while(it != end)
+		for(Behaviour* executing_behaviour : executing_behaviours)
 		{
-			Behaviour* executing_behaviour = *it;
-			Action* last_action = *executing_behaviour->getActions().rbegin();
+			Action* last_action = executing_behaviour->getActions().back();
 			if(last_action->getActionType() == ActionType::EXECUTE)
 			{
-				if(this_is_the_first)
-				{
-					this_is_the_first = false;
-				}
-				else
+				if(!this_is_the_first)
 				{
-					an_executed_behaviour_is_ending_as_a_last_action_define +=
-						" | ";
+					writer << " | ";
 				}
+				this_is_the_first = false;
 				ActionExecute* last_action_ex = (ActionExecute*)last_action;
-				Behaviour* executed_behaviour =
-					intermediate_form->getBehaviourByName(
-						last_action_ex->getBehaviour(), "");
-				an_executed_behaviour_is_ending_as_a_last_action_define += "(";
-				an_executed_behaviour_is_ending_as_a_last_action_define +=
-					BEHAVIOUR_PREFIX + validateIdentifier(
-						executed_behaviour->getName()) + "." + B_IS_LAST_STEP;
-				an_executed_behaviour_is_ending_as_a_last_action_define +=
-					" & " + std::string(LAST_SCHEDULE) + " = "
-					+ SCHEDULE + "_"
-					+ validateIdentifier(executing_behaviour->getName()) + ")";
-				exists_an_executable_behaviour_as_a_last_action = true;
-				it++;
+				Behaviour* executed_behaviour = intermediate_form->getBehaviour(
+					last_action_ex->getBehaviourId());
+				writer << "(" << BEHAVIOUR_PREFIX
+					<< validateIdentifier(executed_behaviour->getName())
+					<< "." << B_IS_LAST_STEP << " & " << LAST_SCHEDULE
+					<< " = " << SCHEDULE << "_"
+					<< validateIdentifier(executing_behaviour->getName())
+					<< ")";
 			}
 			else if(last_action->getActionType() == ActionType::EXECUTE_NON_D)
 			{
-				if(this_is_the_first)
-				{
-					this_is_the_first = false;
-				}
-				else
+				if(!this_is_the_first)
 				{
-					an_executed_behaviour_is_ending_as_a_last_action_define +=
-						" | ";
+					writer << " | ";
 				}
+				this_is_the_first = false;
 				ActionExecuteNonDeterministic* last_action_ex_non_d =
 					(ActionExecuteNonDeterministic*)last_action;
-				std::list<std::string> executed_behaviours =
-					last_action_ex_non_d->getBehaviourValues();
-				auto it_name = executed_behaviours.begin();
-				auto end_name = executed_behaviours.end();
-				while(it_name != end_name)
+				const std::vector<int>& executed_behaviours =
+					last_action_ex_non_d->getBehaviourIds();
+				auto it_id = executed_behaviours.begin();
+				auto end_id = executed_behaviours.end();
+				while(it_id != end_id)
 				{
-					std::string behaviour_name = *it_name;
 					Behaviour* executed_behaviour =
-						intermediate_form->getBehaviourByName(behaviour_name,
-							"");
-					an_executed_behaviour_is_ending_as_a_last_action_define
-						+= "(";
-					an_executed_behaviour_is_ending_as_a_last_action_define
-						+=	BEHAVIOUR_PREFIX + validateIdentifier(
-							executed_behaviour->getName()) + "."
-								+ B_IS_LAST_STEP;
-					an_executed_behaviour_is_ending_as_a_last_action_define
-						+= " & " + std::string(LAST_SCHEDULE) + " = "
-						+ SCHEDULE + "_"
-						+ validateIdentifier(executing_behaviour->getName())
-						+ ")";
-					if(++it_name != end_name)
+						intermediate_form->getBehaviour(*it_id);
+					writer << "(" << BEHAVIOUR_PREFIX
+						<< validateIdentifier(executed_behaviour->getName())
+						<< "." << B_IS_LAST_STEP << " & " << LAST_SCHEDULE
+						<< " = " << SCHEDULE << "_"
+						<< validateIdentifier(executing_behaviour->getName())
+						<< ")";
+					if(++it_id != end_id)
 					{
-						an_executed_behaviour_is_ending_as_a_last_action_define
-							+= " | ";
+						writer << " | ";
 					}
 				}
-				it++;
-				exists_an_executable_behaviour_as_a_last_action = true;
-			}
-			else
-			{
-				it++;
 			}
 		}
-		if(!exists_an_executable_behaviour_as_a_last_action)
+		if(this_is_the_first)
 		{
-			an_executed_behaviour_is_ending_as_a_last_action_define += "FALSE";
+			// no behaviour executes another behaviour as its last action
+			writer << "FALSE";
 		}
 		else
 		{
-			an_executed_behaviour_is_ending_as_a_last_action_define += ")";
+			writer << ")";
 		}
 	}
-	return an_executed_behaviour_is_ending_as_a_last_action_define;
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1693,33 +2446,32 @@ const std::string
 	evaluates to true if the currently scheduled behaviour was executed by
 	another behaviour.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildAnExecutedBehaviourIsScheduledDefine()
+void NuSMVTranslator::buildAnExecutedBehaviourIsScheduledDefine(
+	NuSMVWriter& writer) const
 {
-	std::string an_executed_behaviour_is_executing = "";
-	an_executed_behaviour_is_executing += AN_EXECUTED_BEHAVIOUR_IS_SCHEDULED;
-	an_executed_behaviour_is_executing += ":= ";
+	writer.beginLine(2);
+	writer << AN_EXECUTED_BEHAVIOUR_IS_SCHEDULED << ":= ";
 	if(executable_behaviours.empty())
 	{
-		an_executed_behaviour_is_executing += "FALSE";
+		writer << "FALSE";
 	}
 	else
 	{
-		an_executed_behaviour_is_executing += "(";
+		writer << "(";
 		auto it = executable_behaviours.begin();
 		auto end = executable_behaviours.end();
 		while(it != end)
 		{
-			an_executed_behaviour_is_executing += BEHAVIOUR_PREFIX
-				+ validateIdentifier((*it)->getName()) + "."
-				+ B_IS_SCHEDULED;
+			writer << BEHAVIOUR_PREFIX << validateIdentifier((*it)->getName())
+				<< "." << B_IS_SCHEDULED;
 			if(++it != end)
 			{
-				an_executed_behaviour_is_executing += " | ";
+				writer << " | ";
 			}
 		}
-		an_executed_behaviour_is_executing += ")";
+		writer << ")";
 	}
-	return an_executed_behaviour_is_executing;
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1728,17 +2480,14 @@ const std::string NuSMVTranslator::buildAnExecutedBehaviourIsScheduledDefine()
 	Builds the instances of the	behaviour modules. One instance is created
 	for each behaviour in the intermediate form.
 ------------------------------------------------------------------------------*/
-std::list<std::string> NuSMVTranslator::buildBehaviourModuleInstances()
+void NuSMVTranslator::buildBehaviourModuleInstances(NuSMVWriter& writer) const
 {
-	std::list<std::string> behaviour_module_instances;
-	std::list<Behaviour*> behaviours = intermediate_form->getBehaviours();
-	std::for_each(behaviours.begin(), behaviours.end(),
-		[&](Behaviour* behaviour)
-		{
-			behaviour_module_instances.push_back(
-				buildBehaviourModuleInstance(behaviour));
-		});
-	return behaviour_module_instances;
+	for(Behaviour* behaviour : behaviours)
+	{
+		writer.beginLine(2);
+		buildBehaviourModuleInstance(writer, behaviour);
+		writer.endLine(true);
+	}
 }
 
 /*------------------------------------------------------------------------------
@@ -1746,65 +2495,39 @@ std::list<std::string> NuSMVTranslator::buildBehaviourModuleInstances()
 
 	Builds an instance of a behaviour module for the given behaviour.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildBehaviourModuleInstance(
-	Behaviour* behaviour)
+void NuSMVTranslator::buildBehaviourModuleInstance(NuSMVWriter& writer,
+	Behaviour* behaviour) const
 {
-	std::string behaviour_module_instance = "";
 	std::string behaviour_name = validateIdentifier(behaviour->getName());
-	behaviour_module_instance += BEHAVIOUR_PREFIX + behaviour_name + ": ";
-	behaviour_module_instance += MODULE_B;
-	behaviour_module_instance += "(";
-	behaviour_module_instance += PRECONDITION_PREFIX + behaviour_name
-		+ ", ";
+	writer << BEHAVIOUR_PREFIX << behaviour_name << ": " << MODULE_B << "("
+		<< PRECONDITION_PREFIX << behaviour_name << ", ";
 	if(!behaviour->isSchedulable())
 	{
-		behaviour_module_instance += "FALSE, ";
+		writer << "FALSE, ";
 	}
 	else
 	{
-		behaviour_module_instance += CAN_INTERRUPT_PREFIX
-			+ integerToString(behaviour->getPriority()) + ", ";
-	}
-	std::list<std::string> higher_priority_behaviours;
-	for(Behaviour* b : schedulable_behaviours)
-	{
-		if(b->getPriority() > behaviour->getPriority())
-		{
-			higher_priority_behaviours.push_back(BEHAVIOUR_PREFIX
-				+ validateIdentifier(b->getName()));
-		}
-	}
-	if(higher_priority_behaviours.empty() || !behaviour->isInterruptible())
-	{
-		behaviour_module_instance += "FALSE, ";
+		writer << CAN_INTERRUPT_PREFIX
+			<< integerToString(behaviour->getPriority()) << ", ";
 	}
-	else
+	bool is_first = true;
+	if(behaviour->isInterruptible())
 	{
-		std::string can_be_interrupted = "(";
-		auto it = higher_priority_behaviours.begin();
-		auto end = higher_priority_behaviours.end();
-		while(it != end)
+		for(Behaviour* b : schedulable_behaviours)
 		{
-			can_be_interrupted += *it + "."+ B_CAN_BE_SCHEDULED;
-			if(++it != end)
+			if(b->getPriority() > behaviour->getPriority())
 			{
-				can_be_interrupted += " | ";
+				writer << (is_first ? "(" : " | ") << BEHAVIOUR_PREFIX
+					<< validateIdentifier(b->getName()) << "."
+					<< B_CAN_BE_SCHEDULED;
+				is_first = false;
 			}
 		}
-		can_be_interrupted += "), ";
-		behaviour_module_instance += can_be_interrupted;
 	}
-	behaviour_module_instance += SCHEDULE;
-	behaviour_module_instance += ", " ;
-	behaviour_module_instance += SCHEDULE;
-	behaviour_module_instance += "_" + behaviour_name + ", ";
-	behaviour_module_instance += STEP;
-	behaviour_module_instance += ", ";
-	behaviour_module_instance += STEP;
-	behaviour_module_instance += "_"
-		+ integerToString(behaviour->getActions().size());
-	behaviour_module_instance += ")";
-	return behaviour_module_instance;
+	writer << (is_first ? "FALSE, " : "), ");
+	writer << SCHEDULE << ", " << SCHEDULE << "_" << behaviour_name << ", "
+		<< STEP << ", " << STEP << "_"
+		<< integerToString(behaviour->getActions().size()) << ")";
 }
 
 /*------------------------------------------------------------------------------
@@ -1814,18 +2537,18 @@ const std::string NuSMVTranslator::buildBehaviourModuleInstance(
 	if an executed behaviour will be scheduled for execution in the next
 	moment in time,
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildExecutedBehaviourExecuteNextDefine()
+void NuSMVTranslator::buildExecutedBehaviourExecuteNextDefine(
+	NuSMVWriter& writer) const
 {
-	std::string executed_behaviour_execute_next_define =
-		std::string(EXECUTED_BEHAVIOUR_EXECUTE_NEXT) + ":= ";
+	writer.beginLine(2);
+	writer << EXECUTED_BEHAVIOUR_EXECUTE_NEXT << ":= ";
 	if(executing_behaviours.empty())
 	{
-		return executed_behaviour_execute_next_define + "FALSE";
-	}
-	else
-	{
-		executed_behaviour_execute_next_define += "(";
+		writer << "FALSE";
+		writer.endLine(true);
+		return;
 	}
+	writer << "(";
 	bool is_first = true;
 	for(Behaviour* behaviour : executing_behaviours)
 	{
@@ -1836,30 +2559,22 @@ const std::string NuSMVTranslator::buildExecutedBehaviourExecuteNextDefine()
 			if(action->getActionType() == ActionType::EXECUTE
 				|| action->getActionType() == ActionType::EXECUTE_NON_D)
 			{
-				std::string s = "(!"
-					+ std::string(BEHAVIOUR_PREFIX)
-					+ behaviour_name + "."
-					+ B_CAN_BE_INTERRUPTED + " & "
-					+ std::string(BEHAVIOUR_PREFIX)
-					+ behaviour_name + "."
-					+ std::string(B_IS_SCHEDULED) + " & " + std::string(STEP)
-					+ " = " + std::string(STEP) + "_"
-					+ integerToString(action_num) + ")";
 				if(!is_first)
 				{
-					executed_behaviour_execute_next_define += " | " + s;
-				}
-				else
-				{
-					executed_behaviour_execute_next_define += s;
-					is_first = false;
+					writer << " | ";
 				}
+				is_first = false;
+				writer << "(!" << BEHAVIOUR_PREFIX << behaviour_name << "."
+					<< B_CAN_BE_INTERRUPTED << " & " << BEHAVIOUR_PREFIX
+					<< behaviour_name << "." << B_IS_SCHEDULED << " & "
+					<< STEP << " = " << STEP << "_"
+					<< integerToString(action_num) << ")";
 			}
 			action_num++;
 		}
 	}
-	executed_behaviour_execute_next_define += ")";
-	return executed_behaviour_execute_next_define;
+	writer << ")";
+	writer.endLine(true);
 }
 
 /*------------------------------------------------------------------------------
@@ -1868,118 +2583,49 @@ const std::string NuSMVTranslator::buildExecutedBehaviourExecuteNextDefine()
 	Builds the assignments for the enumerated variables used for
 	been_in_state suffixed preconditions.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildBeenInStateAssigns()
-{
-	std::string been_in_state_assigns;
-	for(auto pair : been_in_state_map)
-	{
-		Precondition* p = pair.first;
-		std::list<std::string> values = pair.second;
-		std::string been_in_state_assign = "";
-		PreconditionType t = p->getPreconditionType();
-		if(t == PreconditionType::PROP_VALUE_CHECK)
-		{
-			PreconditionPropValueCheck* p_prop =
-				(PreconditionPropValueCheck*)p;
-			PropVariable* prop_var = p_prop->getPropVariable();
-			std::string prop_var_name = validateIdentifier(
-				prop_var->getName());
-			std::string var_name = prop_var_name + "_"
-				+ (p_prop->getTruthValue() ? "TRUE" : "FALSE")
-				+ "_" + BEEN_IN_STATE;
-			addLine(been_in_state_assign, "init(" + var_name + "):= "
-				+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START, 2, true);
-			addLine(been_in_state_assign, "next(" + var_name + "):=", 2, false);
-			addLine(been_in_state_assign, "case", 3, false);
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+void NuSMVTranslator::buildBeenInStateAssigns(NuSMVWriter& writer) const
+{
+	for(auto& pair : been_in_state_map)
+	{
+		const std::string& var_name = pair.first;
+		Precondition* p = pair.second.first;
+		const std::list<std::string>& values = pair.second.second;
+		writer.addLine("init(" + var_name + "):= "
+			+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START, 2, true);
+		writer.addLine("next(" + var_name + "):=", 2, false);
+		writer.addLine("case", 3, false);
+		auto it = values.begin();
+		auto end = values.end();
+		while(it != end)
+		{
+			if(it == values.begin())
 			{
-				if(it == values.begin())
-				{
-					auto next = it;
-					next++;
-					addLine(been_in_state_assign, prop_var_name
-						+ " = " + (!p_prop->getTruthValue() ? "TRUE" : "FALSE")
-						+ ": " + *(values.begin()), 4, true);
-					addLine(been_in_state_assign, "(" + var_name + " = "
-						+ BEEN_IN_WAS_IN_PREFIX + "0 & " + prop_var_name
-						+ " = " + (p_prop->getTruthValue() ? "TRUE" : "FALSE")
-						+ "): " + *next, 4, true);
-				}
-				else if(*it == *values.rbegin())
-				{
-					addLine(been_in_state_assign, var_name + " = " + *it
-						+ ": " + *it, 4, true);
-				}
-				else
-				{
-					auto next = it;
-					next++;
-					addLine(been_in_state_assign, var_name + " = " + *it
-						+ ": " + *next, 4, true);
-				}
-				it++;
+				auto next = it;
+				next++;
+				writer.addLine(getCounterCheck(p, false) + ": "
+					+ *(values.begin()), 4, true);
+				writer.addLine("(" + var_name + " = "
+					+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START + " & "
+					+ getCounterCheck(p, true) + "): " + *next, 4, true);
 			}
-			addLine(been_in_state_assign, "", 4, false);
-			addLine(been_in_state_assign, "TRUE: " + var_name, 4, true);
-			addLine(been_in_state_assign, "esac", 3, true);
-		}
-		else if(t == PreconditionType::ENUM_VALUE_CHECK)
-		{
-			PreconditionEnumValueCheck* p_enum =
-				(PreconditionEnumValueCheck*)p;
-			EnumVariable* enum_var = p_enum->getEnumVariable();
-			std::string enum_var_name = validateIdentifier(
-				enum_var->getName());
-			std::string var_name = enum_var_name + "_"
-				+ validateIdentifier(p_enum->getEnumValue())
-				+ "_" + BEEN_IN_STATE;
-			addLine(been_in_state_assign, "init(" + var_name + "):= "
-				+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START, 2, true);
-			addLine(been_in_state_assign, "next(" + var_name + "):=", 2, false);
-			addLine(been_in_state_assign, "case", 3, false);
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+			else if(*it == *values.rbegin())
 			{
-				if(it == values.begin())
-				{
-					auto next = it;
-					next++;
-					addLine(been_in_state_assign, enum_var_name
-						+ " != " + validateIdentifier(p_enum->getEnumValue())
-						+ ": " + *(values.begin()), 4, true);
-					addLine(been_in_state_assign, "(" + var_name + " = "
-						+ BEEN_IN_WAS_IN_PREFIX + "0 & " + enum_var_name
-						+ " = " + validateIdentifier(p_enum->getEnumValue())
-						+ "): " + *next, 4, true);
-				}
-				else if(*it == *values.rbegin())
-				{
-					addLine(been_in_state_assign, var_name + " = " + *it
-						+ ": " + *it, 4, true);
-				}
-				else
-				{
-					auto next = it;
-					next++;
-					addLine(been_in_state_assign, var_name + " = " + *it
-						+ ": " + *next, 4, true);
-				}
-				it++;
+				writer.addLine(var_name + " = " + *it + ": " + *it, 4, true);
 			}
-			addLine(been_in_state_assign, "", 4, false);
-			addLine(been_in_state_assign, "TRUE: " + var_name, 4, true);
-			addLine(been_in_state_assign, "esac", 3, true);
-		}
-		else
-		{
-
+			else
+			{
+				auto next = it;
+				next++;
+				writer.addLine(var_name + " = " + *it + ": " + *next, 4,
+					true);
+			}
+			it++;
 		}
-		addLine(been_in_state_assigns, been_in_state_assign, 0, false);
+		writer.addLine("", 4, false);
+		writer.addLine("TRUE: " + var_name, 4, true);
+		writer.addLine("esac", 3, true);
+		writer.addLine("", 0, false);
 	}
-	return been_in_state_assigns;
 }
 
 /*------------------------------------------------------------------------------
@@ -1988,110 +2634,93 @@ const std::string NuSMVTranslator::buildBeenInStateAssigns()
 	Builds the assignments for the enumerated variables used for
 	was_in_state suffixed preconditions.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildWasInStateAssigns()
-{
-	std::string was_in_state_assigns;
-	for(auto pair : was_in_state_map)
-	{
-		Precondition* p = pair.first;
-		std::list<std::string> values = pair.second;
-		std::string was_in_state_assign = "";
-		PreconditionType t = p->getPreconditionType();
-		if(t == PreconditionType::PROP_VALUE_CHECK)
-		{
-			PreconditionPropValueCheck* p_prop =
-				(PreconditionPropValueCheck*)p;
-			PropVariable* prop_var = p_prop->getPropVariable();
-			std::string prop_var_name = validateIdentifier(
-				prop_var->getName());
-			std::string var_name = prop_var_name + "_"
-				+ (p_prop->getTruthValue() ? "TRUE" : "FALSE")
-				+ "_" + WAS_IN_STATE;
-			addLine(was_in_state_assign, "init(" + var_name + "):= "
-				+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START, 2, true);
-			addLine(was_in_state_assign, "next(" + var_name + "):=", 2, false);
-			addLine(was_in_state_assign, "case", 3, false);
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+void NuSMVTranslator::buildWasInStateAssigns(NuSMVWriter& writer) const
+{
+	for(auto& pair : was_in_state_map)
+	{
+		const std::string& var_name = pair.first;
+		Precondition* p = pair.second.first;
+		const std::list<std::string>& values = pair.second.second;
+		writer.addLine("init(" + var_name + "):= "
+			+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START, 2, true);
+		writer.addLine("next(" + var_name + "):=", 2, false);
+		writer.addLine("case", 3, false);
+		auto it = values.begin();
+		auto end = values.end();
+		while(it != end)
+		{
+			if(it == values.begin())
 			{
-				if(it == values.begin())
-				{
-					auto next = it;
-					next++;
-					addLine(was_in_state_assign, prop_var_name
-						+ " = " + (p_prop->getTruthValue() ? "TRUE" : "FALSE")
-						+ ": " + *next, 4, true);
-				}
-				else if(*it == *values.rbegin())
-				{
-					addLine(was_in_state_assign, var_name + " = " + *it
-						+ ": " + *(values.begin()), 4, true);
-				}
-				else
-				{
-					auto next = it;
-					next++;
-					addLine(was_in_state_assign, var_name + " = " + *it
-						+ ": " + *next, 4, true);
-				}
-				it++;
+				auto next = it;
+				next++;
+				writer.addLine(getCounterCheck(p, true) + ": " + *next, 4,
+					true);
 			}
-			addLine(was_in_state_assign, "", 4, false);
-			addLine(was_in_state_assign, "TRUE: " + var_name, 4, true);
-			addLine(was_in_state_assign, "esac", 3, true);
-		}
-		else if(t == PreconditionType::ENUM_VALUE_CHECK)
-		{
-			PreconditionEnumValueCheck* p_enum =
-				(PreconditionEnumValueCheck*)p;
-			EnumVariable* enum_var = p_enum->getEnumVariable();
-			std::string enum_var_name = validateIdentifier(
-				enum_var->getName());
-			std::string var_name = enum_var_name + "_"
-				+ validateIdentifier(p_enum->getEnumValue())
-				+ "_" + WAS_IN_STATE;
-			addLine(was_in_state_assign, "init(" + var_name + "):= "
-				+ BEEN_IN_WAS_IN_PREFIX + BEEN_IN_WAS_IN_START, 2, true);
-			addLine(was_in_state_assign, "next(" + var_name + "):=", 2, false);
-			addLine(was_in_state_assign, "case", 3, false);
-			auto it = values.begin();
-			auto end = values.end();
-			while(it != end)
+			else if(*it == *values.rbegin())
 			{
-				if(it == values.begin())
-				{
-					auto next = it;
-					next++;
-					addLine(was_in_state_assign, enum_var_name
-						+ " = " + validateIdentifier(p_enum->getEnumValue())
-						+ ": " + *next, 4, true);
-				}
-				else if(*it == *values.rbegin())
-				{
-					addLine(was_in_state_assign, var_name + " = " + *it
-						+ ": " + *(values.begin()), 4, true);
-				}
-				else
-				{
-					auto next = it;
-					next++;
-					addLine(was_in_state_assign, var_name + " = " + *it
-						+ ": " + *next, 4, true);
-				}
-				it++;
+				writer.addLine(var_name + " = " + *it + ": "
+					+ *(values.begin()), 4, true);
+			}
+			else
+			{
+				auto next = it;
+				next++;
+				writer.addLine(var_name + " = " + *it + ": " + *next, 4,
+					true);
 			}
-			addLine(was_in_state_assign, "", 4, false);
-			addLine(was_in_state_assign, "TRUE: " + var_name, 4, true);
-			addLine(was_in_state_assign, "esac", 3, true);
+			it++;
 		}
-		else
-		{
+		writer.addLine("", 4, false);
+		writer.addLine("TRUE: " + var_name, 4, true);
+		writer.addLine("esac", 3, true);
+		writer.addLine("", 0, false);
+	}
+}
 
-		}
-		addLine(was_in_state_assigns, was_in_state_assign, 0, false);
+/*------------------------------------------------------------------------------
+	buildIntegerCounterAssigns
+
+	Builds the assignments for the bounded integer counters used for
+	been_in_state and was_in_state suffixed preconditions.
+------------------------------------------------------------------------------*/
+void NuSMVTranslator::buildIntegerCounterAssigns(NuSMVWriter& writer) const
+{
+	// been in state counters count the steps the check has held for,
+	// saturating at the bound
+	for(auto& pair : been_in_state_map)
+	{
+		const std::string& var_name = pair.first;
+		Precondition* p = pair.second.first;
+		std::string bound = integerToString(pair.second.second.size() - 1);
+		writer.addLine("init(" + var_name + "):= 0", 2, true);
+		writer.addLine("next(" + var_name + "):=", 2, false);
+		writer.addLine("case", 3, false);
+		writer.addLine(getCounterCheck(p, false) + ": 0", 4, true);
+		writer.addLine(var_name + " < " + bound + ": " + var_name + " + 1", 4,
+			true);
+		writer.addLine("", 4, false);
+		writer.addLine("TRUE: " + var_name, 4, true);
+		writer.addLine("esac", 3, true);
+		writer.addLine("", 0, false);
+	}
+	// was in state counters count the steps since the check last held,
+	// returning to 0 once the bound is passed
+	for(auto& pair : was_in_state_map)
+	{
+		const std::string& var_name = pair.first;
+		Precondition* p = pair.second.first;
+		std::string bound = integerToString(pair.second.second.size() - 1);
+		writer.addLine("init(" + var_name + "):= 0", 2, true);
+		writer.addLine("next(" + var_name + "):=", 2, false);
+		writer.addLine("case", 3, false);
+		writer.addLine(getCounterCheck(p, true) + ": 1", 4, true);
+		writer.addLine("(" + var_name + " != 0 & " + var_name + " < "
+			+ bound + "): " + var_name + " + 1", 4, true);
+		writer.addLine("", 4, false);
+		writer.addLine("TRUE: 0", 4, true);
+		writer.addLine("esac", 3, true);
+		writer.addLine("", 0, false);
 	}
-	return was_in_state_assigns;
 }
 
 /*------------------------------------------------------------------------------
@@ -2099,26 +2728,25 @@ const std::string NuSMVTranslator::buildWasInStateAssigns()
 
 	Builds the assignments for the time variable.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildTimeAssign()
+void NuSMVTranslator::buildTimeAssign(NuSMVWriter& writer) const
 {
-	std::string time_assign = "";
 	if(!time_intervals.empty())
 	{
-		std::string value_list = "";
+		writer.beginLine(2);
+		writer << "init(" << TIME << "):= {";
 		auto it = time_intervals.begin();
 		auto end = time_intervals.end();
 		while(it != end)
 		{
-			value_list += *it;
+			writer << *it;
 			if(++it != end)
 			{
-				value_list += ", ";
+				writer << ", ";
 			}
 		}
-		addLine(time_assign, "init(" + std::string(TIME)
-			+ "):= {" + value_list + "}", 2, true);
+		writer << "}";
+		writer.endLine(true);
 	}
-	return time_assign;
 }
 
 /*------------------------------------------------------------------------------
@@ -2126,17 +2754,16 @@ const std::string NuSMVTranslator::buildTimeAssign()
 
 	Builds the assignments for the step variable.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildStepAssign()
+void NuSMVTranslator::buildStepAssign(NuSMVWriter& writer) const
 {
-	std::string step_assign = "";
-	addLine(step_assign, "init(" + std::string(STEP)
+	writer.addLine("init(" + std::string(STEP)
 		+ "):= " + STEP + "_none", 2, true);
-	addLine(step_assign, "next(" + std::string(STEP)
+	writer.addLine("next(" + std::string(STEP)
 		+ "):=", 2, false);
-	addLine(step_assign, "case", 3, false);
-	addLine(step_assign, std::string(A_BEHAVIOUR_CAN_BE_SCHEDULED)
+	writer.addLine("case", 3, false);
+	writer.addLine(std::string(A_BEHAVIOUR_CAN_BE_SCHEDULED)
 		+ ": " + std::string(STEP) + "_1", 4, true);
-	addLine(step_assign, "", 4, false);
+	writer.addLine("", 4, false);
 	for(Behaviour* behaviour : executing_behaviours)
 	{
 		int action_num = 1;
@@ -2145,7 +2772,7 @@ const std::string NuSMVTranslator::buildStepAssign()
 			if(action->getActionType() == ActionType::EXECUTE)
 			{
 				ActionExecute* action_ex = (ActionExecute*)action;
-				addLine(step_assign, std::string("(")
+				writer.addLine(std::string("(")
 					+ BEHAVIOUR_PREFIX
 					+ validateIdentifier(behaviour->getName()) + "."
 					+ B_IS_SCHEDULED + " & "+ STEP + " = " + STEP + "_"
@@ -2157,7 +2784,7 @@ const std::string NuSMVTranslator::buildStepAssign()
 			}
 			else if(action->getActionType() == ActionType::EXECUTE_NON_D)
 			{
-				addLine(step_assign, std::string("(")
+				writer.addLine(std::string("(")
 					+ BEHAVIOUR_PREFIX
 					+ validateIdentifier(behaviour->getName()) + "."
 					+ B_IS_SCHEDULED + " & "+ STEP + " = " + STEP + "_"
@@ -2172,7 +2799,8 @@ const std::string NuSMVTranslator::buildStepAssign()
 	while(it != end)
 	{
 		Behaviour* executing_behaviour = *it;
-		std::list<Action*> actions = executing_behaviour->getActions();
+		const std::vector<Action*>& actions =
+			executing_behaviour->getActions();
 		unsigned int action_num = 1;
 		for(Action* action : actions)
 		{
@@ -2183,9 +2811,9 @@ const std::string NuSMVTranslator::buildStepAssign()
 				{
 					ActionExecute* action_ex = (ActionExecute*)action;
 					Behaviour* executed_behaviour =
-						intermediate_form->getBehaviourByName(
-							action_ex->getBehaviour(), "");
-					addLine(step_assign, std::string("(")
+						intermediate_form->getBehaviour(
+							action_ex->getBehaviourId());
+					writer.addLine(std::string("(")
 						+ BEHAVIOUR_PREFIX + validateIdentifier(
 							executed_behaviour->getName()) + "."
 						+ B_IS_LAST_STEP + " & " + LAST_SCHEDULE + " = "
@@ -2197,17 +2825,11 @@ const std::string NuSMVTranslator::buildStepAssign()
 				{
 					ActionExecuteNonDeterministic* action_ex_non_d =
 						(ActionExecuteNonDeterministic*)action;
-					std::list<std::string> executed_behaviours =
-						action_ex_non_d->getBehaviourValues();
-					auto it_name = executed_behaviours.begin();
-					auto end_name = executed_behaviours.end();
-					while(it_name != end_name)
+					for(int behaviour_id : action_ex_non_d->getBehaviourIds())
 					{
-						std::string behaviour_name = *it_name;
 						Behaviour* executed_behaviour =
-							intermediate_form->getBehaviourByName(
-								behaviour_name, "");
-						addLine(step_assign, std::string("(")
+							intermediate_form->getBehaviour(behaviour_id);
+						writer.addLine(std::string("(")
 							+ BEHAVIOUR_PREFIX + validateIdentifier(
 								executed_behaviour->getName()) + "."
 							+ B_IS_LAST_STEP + " & " + LAST_SCHEDULE
@@ -2215,7 +2837,6 @@ const std::string NuSMVTranslator::buildStepAssign()
 							+ validateIdentifier(executing_behaviour->getName())
 							+ "): " + STEP + "_" + integerToString(
 								action_num + 1), 4, true);
-						it_name++;
 					}
 				}
 			}
@@ -2223,26 +2844,25 @@ const std::string NuSMVTranslator::buildStepAssign()
 		}
 		it++;
 	}
-	addLine(step_assign, "", 4, false);
-	addLine(step_assign, std::string(A_BEHAVIOUR_IS_ENDING)
+	writer.addLine("", 4, false);
+	writer.addLine(std::string(A_BEHAVIOUR_IS_ENDING)
 		+ ": " + STEP + "_none", 4, true);
-	addLine(step_assign,
+	writer.addLine(
 		std::string(AN_EXECUTED_BEHAVIOUR_IS_ENDING_AS_A_LAST_ACTION)
 		+ ": " + STEP + "_none", 4, true);
-	addLine(step_assign, "", 4, false);
+	writer.addLine("", 4, false);
 	for(unsigned int i = 1; i < max_num_actions; i++)
 	{
-		addLine(step_assign, std::string(STEP) + " = " + STEP +
+		writer.addLine(std::string(STEP) + " = " + STEP +
 			+ "_" + integerToString(i) + ": " + STEP + "_"
 			+ integerToString(i + 1), 4, true);
 	}
-	addLine(step_assign, std::string(STEP) + " = " + STEP +
+	writer.addLine(std::string(STEP) + " = " + STEP +
 		+ "_" + integerToString(max_num_actions) + ": " + STEP + "_none",
 		4, true);
-	addLine(step_assign, "", 4, false);
-	addLine(step_assign, "TRUE: " + std::string(STEP) + "_none", 4, true);
-	addLine(step_assign, "esac", 3, true);
-	return step_assign;
+	writer.addLine("", 4, false);
+	writer.addLine("TRUE: " + std::string(STEP) + "_none", 4, true);
+	writer.addLine("esac", 3, true);
 }
 
 /*------------------------------------------------------------------------------
@@ -2250,24 +2870,22 @@ const std::string NuSMVTranslator::buildStepAssign()
 
 	Builds the assignments for the last_schedule variable.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildLastScheduleAssign()
+void NuSMVTranslator::buildLastScheduleAssign(NuSMVWriter& writer) const
 {
-	std::string last_schedule_assign = "";
-	addLine(last_schedule_assign, "init(" + std::string(LAST_SCHEDULE)
+	writer.addLine("init(" + std::string(LAST_SCHEDULE)
 		+ "):= " + SCHEDULE + "_" + "none", 2, true);
-	addLine(last_schedule_assign, "next(" + std::string(LAST_SCHEDULE)
+	writer.addLine("next(" + std::string(LAST_SCHEDULE)
 		+ "):=", 2, false);
-	addLine(last_schedule_assign, "case", 3, false);
-	addLine(last_schedule_assign, std::string(EXECUTED_BEHAVIOUR_EXECUTE_NEXT)
+	writer.addLine("case", 3, false);
+	writer.addLine(std::string(EXECUTED_BEHAVIOUR_EXECUTE_NEXT)
 		+ ": " + LAST_SCHEDULE, 4, true);
-	//addLine(last_schedule_assign, std::string(AN_EXECUTED_BEHAVIOUR_IS_ENDING)
+	//writer.addLine(std::string(AN_EXECUTED_BEHAVIOUR_IS_ENDING)
 		//+ ": FALSE", 4, true);
-	addLine(last_schedule_assign,
+	writer.addLine(
 		std::string(AN_EXECUTED_BEHAVIOUR_IS_SCHEDULED)
 		+ ": " + LAST_SCHEDULE, 4, true);
-	addLine(last_schedule_assign, "TRUE: " + std::string(SCHEDULE), 4, true);
-	addLine(last_schedule_assign, "esac", 3, true);
-	return last_schedule_assign;
+	writer.addLine("TRUE: " + std::string(SCHEDULE), 4, true);
+	writer.addLine("esac", 3, true);
 }
 
 /*------------------------------------------------------------------------------
@@ -2275,55 +2893,59 @@ const std::string NuSMVTranslator::buildLastScheduleAssign()
 
 	Builds the assignments for the schedule variable.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildScheduleAssign()
+void NuSMVTranslator::buildScheduleAssign(NuSMVWriter& writer) const
 {
-	std::string schedule_assign = "";
-	addLine(schedule_assign, "init(" + std::string(SCHEDULE) + "):= "
+	writer.addLine("init(" + std::string(SCHEDULE) + "):= "
 		+ SCHEDULE + "_none", 2, true);
-	addLine(schedule_assign, "next(" + std::string(SCHEDULE) + "):=", 2, false);
-	addLine(schedule_assign, "case", 3, false);
-	std::sort(schedulable_behaviours.begin(), schedulable_behaviours.end(),
-		[&](Behaviour* this_behaviour, Behaviour* that_behaviour)
-		{
-			return this_behaviour->getPriority()
-				> that_behaviour->getPriority();
-		});
-	if(g_true_non_determinism)
+	writer.addLine("next(" + std::string(SCHEDULE) + "):=", 2, false);
+	writer.addLine("case", 3, false);
+	if(options.true_non_determinism)
 	{
-		unsigned int index = 0;
-		while(index < schedulable_behaviours.size())
+		int choice_num = 0;
+		for(const std::vector<std::string>& equal_priority_behaviours :
+			equal_priority_groups)
 		{
-			Behaviour* behaviour = schedulable_behaviours[index];
-			std::vector<std::string> equal_priority_behaviours;
-			equal_priority_behaviours.push_back(
-				validateIdentifier(behaviour->getName()));
-			while(++index < schedulable_behaviours.size()
-				&& schedulable_behaviours[index]->getPriority() ==
-					behaviour->getPriority())
-			{
-				if(schedulable_behaviours[index]->isSchedulable())
-				{
-					equal_priority_behaviours.push_back(validateIdentifier(
-						schedulable_behaviours[index]->getName()));
-				}
-			}
 			if(equal_priority_behaviours.size() == 1)
 			{
-				addLine(schedule_assign, BEHAVIOUR_PREFIX
+				writer.addLine(BEHAVIOUR_PREFIX
 					+ equal_priority_behaviours[0] + "."
 					+ B_CAN_BE_SCHEDULED + ": " + SCHEDULE + "_"
 					+ equal_priority_behaviours[0], 4, true);
 			}
+			else if(equal_priority_behaviours.size()
+				> (unsigned int)options.max_power_set_group_size)
+			{
+				// schedule the chosen behaviour if it can be scheduled, and
+				// otherwise the first behaviour that can be, so that any of
+				// the behaviours that can be scheduled may be
+				std::string choice = std::string(SCHEDULE_CHOICE) + "_"
+					+ integerToString(++choice_num);
+				for(const std::string& behaviour_name :
+					equal_priority_behaviours)
+				{
+					writer.addLine("(" + choice + " = " + SCHEDULE + "_"
+						+ behaviour_name + " & " + BEHAVIOUR_PREFIX
+						+ behaviour_name + "." + B_CAN_BE_SCHEDULED + "): "
+						+ SCHEDULE + "_" + behaviour_name, 4, true);
+				}
+				for(const std::string& behaviour_name :
+					equal_priority_behaviours)
+				{
+					writer.addLine(BEHAVIOUR_PREFIX + behaviour_name + "."
+						+ B_CAN_BE_SCHEDULED + ": " + SCHEDULE + "_"
+						+ behaviour_name, 4, true);
+				}
+			}
 			else
 			{
 				std::vector<std::vector<std::string>> power_set =
 						vectorPowerSet<std::string>(
 							equal_priority_behaviours, false);
-				for(std::vector<std::string> v : power_set)
+				for(std::vector<std::string>& v : power_set)
 				{
 					if(v.size() == 1)
 					{
-						addLine(schedule_assign, BEHAVIOUR_PREFIX
+						writer.addLine(BEHAVIOUR_PREFIX
 							+ v.front() + "." + B_CAN_BE_SCHEDULED + ": "
 							+ SCHEDULE + "_" + v.front(),
 							4, true);
@@ -2349,7 +2971,7 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 						}
 						premises += ")";
 						next_value += "}";
-						addLine(schedule_assign, premises + ": " + next_value,
+						writer.addLine(premises + ": " + next_value,
 							4, true);
 					}
 				}
@@ -2358,11 +2980,21 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 	}
 	else
 	{
-		for(Behaviour* behaviour : schedulable_behaviours)
+		/*	sort a copy of the schedulable behaviours, so that the order used
+			by the definitions is unaffected */
+		std::vector<Behaviour*> prioritised_behaviours = schedulable_behaviours;
+		std::sort(prioritised_behaviours.begin(),
+			prioritised_behaviours.end(),
+			[&](Behaviour* this_behaviour, Behaviour* that_behaviour)
+			{
+				return this_behaviour->getPriority()
+					> that_behaviour->getPriority();
+			});
+		for(Behaviour* behaviour : prioritised_behaviours)
 		{
 			std::string behaviour_name = validateIdentifier(
 				behaviour->getName());
-			addLine(schedule_assign, BEHAVIOUR_PREFIX
+			writer.addLine(BEHAVIOUR_PREFIX
 				+ behaviour_name + "."
 				+ B_CAN_BE_SCHEDULED + ": " + SCHEDULE + "_"
 				+ behaviour_name, 4, true);
@@ -2379,7 +3011,7 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 				ActionExecute* action_ex = (ActionExecute*)action;
 				std::string executed_behaviour_name =
 					validateIdentifier(action_ex->getBehaviour());
-				addLine(schedule_assign, "("
+				writer.addLine("("
 					+ std::string(BEHAVIOUR_PREFIX)
 					+ behaviour_name + "." + B_IS_SCHEDULED + " & "+ STEP
 					+ " = " + STEP + "_" + integerToString(action_num) + " & "
@@ -2392,7 +3024,7 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 			{
 				ActionExecuteNonDeterministic* action_ex_non_d =
 					(ActionExecuteNonDeterministic*)action;
-				std::list<std::string> executed_behaviours =
+				const std::vector<std::string>& executed_behaviours =
 					action_ex_non_d->getBehaviourValues();
 				std::string behaviour_list = "";
 				auto it_name = executed_behaviours.begin();
@@ -2408,7 +3040,7 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 						behaviour_list += ", ";
 					}
 				}
-				addLine(schedule_assign, "("
+				writer.addLine("("
 					+ std::string(BEHAVIOUR_PREFIX) + behaviour_name + "."
 					+ B_IS_SCHEDULED + " & "+ STEP + " = " + STEP + "_"
 					+ integerToString(action_num)
@@ -2418,22 +3050,21 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 			action_num++;
 		}
 	}
-	addLine(schedule_assign, "", 4, false);
-	addLine(schedule_assign, std::string(A_BEHAVIOUR_IS_ENDING)
+	writer.addLine("", 4, false);
+	writer.addLine(std::string(A_BEHAVIOUR_IS_ENDING)
 		+ ": " + SCHEDULE + "_none", 4, true);
-	addLine(schedule_assign,
+	writer.addLine(
 		std::string(AN_EXECUTED_BEHAVIOUR_IS_ENDING_AS_A_LAST_ACTION)
 		+ ": " + SCHEDULE + "_none", 4, true);
-	addLine(schedule_assign, std::string("(") +
+	writer.addLine(std::string("(") +
 		AN_EXECUTED_BEHAVIOUR_IS_ENDING + " & " + LAST_SCHEDULE + " != "
 		+ SCHEDULE + "): " + LAST_SCHEDULE, 4, true);
-	addLine(schedule_assign, std::string(AN_EXECUTED_BEHAVIOUR_IS_ENDING)
+	writer.addLine(std::string(AN_EXECUTED_BEHAVIOUR_IS_ENDING)
 		+ ": " + SCHEDULE + "_none", 4, true);
 
-	addLine(schedule_assign, "", 4, false);
-	addLine(schedule_assign, "TRUE: " + std::string(SCHEDULE), 4, true);
-	addLine(schedule_assign, "esac", 3, true);
-	return schedule_assign;
+	writer.addLine("", 4, false);
+	writer.addLine("TRUE: " + std::string(SCHEDULE), 4, true);
+	writer.addLine("esac", 3, true);
 }
 
 /*------------------------------------------------------------------------------
@@ -2441,89 +3072,26 @@ const std::string NuSMVTranslator::buildScheduleAssign()
 
 	Builds the assignments for the boolean and enumerated variables.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::buildVariableAssigns()
+void NuSMVTranslator::buildVariableAssigns(NuSMVWriter& writer) const
 {
-	std::string variable_assigns = "";
-	for(Behaviour* b : intermediate_form->getBehaviours())
-	{
-		std::string behaviour_name = validateIdentifier(b->getName());
-		int action_num = 1;
-		for(Action* action : b->getActions())
-		{
-			if(action->getActionType() == ActionType::PROP_VALUE_ASSIGNMENT)
-			{
-				ActionPropValueAssignment* action_prop =
-					(ActionPropValueAssignment*)action;
-				std::string prop_var_name = validateIdentifier(
-					action_prop->getPropVariable()->getName());
-				std::string prop_var_assign = "";
-				prop_var_assign += "(" + std::string(BEHAVIOUR_PREFIX)
-					+ behaviour_name + "." + B_IS_SCHEDULED + " & "
-					+ STEP + " = " + STEP + "_"
-					+ integerToString(action_num) + "): "
-					+ (action_prop->getTruthValue() ? "TRUE" : "FALSE");
-				auto it = prop_variable_assignment_map.find(prop_var_name);
-				if(it == prop_variable_assignment_map.end())
-				{
-					std::list<std::string> new_prop_list;
-					new_prop_list.push_back(prop_var_assign);
-					prop_variable_assignment_map.insert(
-						std::pair<std::string, std::list<std::string>>(
-							prop_var_name, new_prop_list));
-				}
-				else
-				{
-					(*it).second.push_back(prop_var_assign);
-				}
-			}
-			else if(action->getActionType() ==
-				ActionType::ENUM_VALUE_ASSIGNMENT)
-			{
-				ActionEnumValueAssignment* action_enum =
-					(ActionEnumValueAssignment*)action;
-				std::string enum_var_name =
-					action_enum->getEnumVariable()->getName();
-				std::string enum_var_assign = "";
-				enum_var_assign += "(" + std::string(BEHAVIOUR_PREFIX)
-					+ behaviour_name + "." + B_IS_SCHEDULED + " & "
-					+ STEP + " = " + STEP + "_"
-					+ integerToString(action_num) + "): "
-					+ validateIdentifier(action_enum->getEnumValue());
-				auto it = enum_variable_assignment_map.find(enum_var_name);
-				if(it == enum_variable_assignment_map.end())
-				{
-					std::list<std::string> new_enum_list;
-					new_enum_list.push_back(enum_var_assign);
-					enum_variable_assignment_map.insert(
-						std::pair<std::string, std::list<std::string>>(
-							enum_var_name, new_enum_list));
-				}
-				else
-				{
-					(*it).second.push_back(enum_var_assign);
-				}
-			}
-			action_num++;
-		}
-	}
 	for(PropVariable* prop_variable : intermediate_form->getPropVariables())
 	{
 		std::string prop_variable_name = validateIdentifier(
 			prop_variable->getName());
-		if(prop_variable->isNonDeterministic())
+		if(prop_variable->isNonDeterministic() && isTranslated(prop_variable))
 		{
-			addLine(variable_assigns, "init(" + prop_variable_name
+			writer.addLine("init(" + prop_variable_name
 				+ "):= {TRUE, FALSE}", 2, true);
-			addLine(variable_assigns, "next(" + prop_variable_name
+			writer.addLine("next(" + prop_variable_name
 				+ "):= {TRUE, FALSE}", 2, true);
-			addLine(variable_assigns, "", 2, false);
+			writer.addLine("", 2, false);
 		}
 	}
 	for(EnumVariable* enum_variable : intermediate_form->getEnumVariables())
 	{
 		std::string enum_variable_name = validateIdentifier(
 			enum_variable->getName());
-		if(enum_variable->isNonDeterministic())
+		if(enum_variable->isNonDeterministic() && isTranslated(enum_variable))
 		{
 			std::string enum_values = "";
 			std::list<std::string> values = enum_variable->getValues();
@@ -2537,50 +3105,47 @@ const std::string NuSMVTranslator::buildVariableAssigns()
 					enum_values += ", ";
 				}
 			}
-			addLine(variable_assigns, "init(" + enum_variable_name
+			writer.addLine("init(" + enum_variable_name
 				+ "):= {" + enum_values + "}", 2, true);
-			addLine(variable_assigns, "next(" + enum_variable_name
+			writer.addLine("next(" + enum_variable_name
 				+ "):= {" + enum_values + "}", 2, true);
-			addLine(variable_assigns, "", 2, false);
+			writer.addLine("", 2, false);
 		}
 	}
 	for(auto pair : prop_variable_assignment_map)
 	{
 		std::string prop_var_name = validateIdentifier(pair.first);
-		std::string prop_var_assign = "";
 		auto it = initial_variable_values.find(prop_var_name);
 		if(it != initial_variable_values.end())
 		{
-			addLine(prop_var_assign, "init(" + prop_var_name
+			writer.addLine("init(" + prop_var_name
 				+ "):= " + ((*it).second == "true" ? "TRUE" : "FALSE"),
 				2, true);
 		}
 		else
 		{
-			addLine(prop_var_assign, "init(" + prop_var_name
+			writer.addLine("init(" + prop_var_name
 				+ "):= FALSE", 2, true);
 		}
-		addLine(prop_var_assign, "next(" + prop_var_name
+		writer.addLine("next(" + prop_var_name
 			+ "):=", 2, false);
-		addLine(prop_var_assign, "case", 3, false);
+		writer.addLine("case", 3, false);
 		for(std::string s : pair.second)
 		{
-			addLine(prop_var_assign, s, 4, true);
+			writer.addLine(s, 4, true);
 		}
-		addLine(prop_var_assign, "", 4, false);
-		addLine(prop_var_assign, "TRUE: " + prop_var_name, 4, true);
-		addLine(prop_var_assign, "esac", 3, true);
-		addLine(variable_assigns, prop_var_assign, 0, false);
+		writer.addLine("", 4, false);
+		writer.addLine("TRUE: " + prop_var_name, 4, true);
+		writer.addLine("esac", 3, true);
+		writer.addLine("", 0, false);
 	}
-	for(auto pair : enum_variable_assignment_map)
+	for(const auto& pair : enum_variable_assignment_map)
 	{
-		EnumVariable* enum_var = intermediate_form->getEnumVariableByName(
-			pair.first, "");
+		EnumVariable* enum_var = pair.second.first;
 		std::string enum_var_name = validateIdentifier(pair.first);
-		std::string enum_var_assign = "";
 		if(enum_var->resets())
 		{
-			addLine(enum_var_assign, "init(" + enum_var_name
+			writer.addLine("init(" + enum_var_name
 				+ "):= none", 2, true);
 		}
 		else
@@ -2588,8 +3153,8 @@ const std::string NuSMVTranslator::buildVariableAssigns()
 			auto it = initial_variable_values.find(enum_var_name);
 			if(it != initial_variable_values.end())
 			{
-				addLine(enum_var_assign, "init(" + enum_var_name
-					+ "):= " + (*it).second, 2, true);
+				writer.addLine("init(" + enum_var_name
+					+ "):= " + validateIdentifier((*it).second), 2, true);
 			}
 			else
 			{
@@ -2605,30 +3170,29 @@ const std::string NuSMVTranslator::buildVariableAssigns()
 						value_list += ", ";
 					}
 				}
-				addLine(enum_var_assign, "init(" + enum_var_name
+				writer.addLine("init(" + enum_var_name
 					+ "):= {" + value_list + "}", 2, true);
 			}
 		}
-		addLine(enum_var_assign, "next(" + enum_var_name
+		writer.addLine("next(" + enum_var_name
 			+ "):=", 2, false);
-		addLine(enum_var_assign, "case", 3, false);
-		for(std::string s : pair.second)
+		writer.addLine("case", 3, false);
+		for(std::string s : pair.second.second)
 		{
-			addLine(enum_var_assign, s, 4, true);
+			writer.addLine(s, 4, true);
 		}
-		addLine(enum_var_assign, "", 4, false);
+		writer.addLine("", 4, false);
 		if(enum_var->resets())
 		{
-			addLine(enum_var_assign, "TRUE: none", 4, true);
+			writer.addLine("TRUE: none", 4, true);
 		}
 		else
 		{
-			addLine(enum_var_assign, "TRUE: " + enum_var_name, 4, true);
+			writer.addLine("TRUE: " + enum_var_name, 4, true);
 		}
-		addLine(enum_var_assign, "esac", 3, true);
-		addLine(variable_assigns, enum_var_assign, 0, false);
+		writer.addLine("esac", 3, true);
+		writer.addLine("", 0, false);
 	}
-	return variable_assigns;
 }
 
 /*------------------------------------------------------------------------------
@@ -2688,126 +3252,177 @@ const bool NuSMVTranslator::isValidCharacter(const char c)
 }
 
 /*------------------------------------------------------------------------------
-	addLine
+	timeConstraintHoldsAtTime
 
-	Adds a new line to the string s, prefixed with num_tabs tabs, and
-	possibly terminating with a semi-colon.
+	Returns true if the giving time constraint holds at the given time,
+	taking into account constraints that wrap past midnight.
 ------------------------------------------------------------------------------*/
-void NuSMVTranslator::addLine(std::string& s, const std::string& line,
-	const int num_tabs, const bool terminating_semi_colon)
+const bool NuSMVTranslator::timeConstraintHoldsAtTime(
+	PreconditionTimingConstraint* p, const std::string& time)
 {
-	for(int i = 0; i < num_tabs; i++)
+	int seconds = timeToSeconds(time);
+	int start = timeToSeconds(p->getStartTime());
+	int end = timeToSeconds(p->getEndTime());
+	if(start <= end)
 	{
-		s += TAB;
+		return start <= seconds && seconds <= end;
 	}
-	s += line;
-	if(terminating_semi_colon)
-	{
-		s += ";";
-	}
-	s += "\n";
+	return seconds >= start || seconds <= end;
 }
 
 /*------------------------------------------------------------------------------
-	timeConstraintHoldsAtTime
+	timeToSeconds
 
-	Returns true if the giving time constraint holds at the given time.
+	Given a time as a string, returns the number of seconds since midnight,
+	truncated to the minute.
 ------------------------------------------------------------------------------*/
-const bool NuSMVTranslator::timeConstraintHoldsAtTime(
-	PreconditionTimingConstraint* p, const std::string& time)
+const int NuSMVTranslator::timeToSeconds(const std::string& time)
 {
-	return timeIsBefore(time, momentAfter(p->getEndTime()))
-		&& timeIsAfter(time, momentBefore(p->getStartTime()));
+	return stringToInteger(time.substr(0, 2)) * 3600
+		+ stringToInteger(time.substr(3, 2)) * 60;
 }
 
 /*------------------------------------------------------------------------------
-	momentAfter
+	secondsToTime
 
-	Given a time as a string, returns a string corresponding the next minute
-	in time. For instance, given the string 11:23:00, this function would
-	return the string 11:24:00.
+	Given a number of seconds since midnight, returns the corresponding time
+	as a string.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::momentAfter(const std::string& time)
+const std::string NuSMVTranslator::secondsToTime(const int seconds)
 {
-	int time_hours = stringToInteger(time.substr(0, 2));
-	int time_minutes = stringToInteger(time.substr(3, 2));
-	if(++time_minutes == 60)
+	int values[] = {seconds / 3600, (seconds / 60) % 60, seconds % 60};
+	std::string time;
+	for(int value : values)
 	{
-		time_minutes = 0;
-		time_hours++;
+		if(!time.empty())
+		{
+			time += ":";
+		}
+		time += (value < 10 ? "0" : "") + integerToString(value);
 	}
-	std::string time_hours_string = (time_hours < 10 ? "0"
-		+ integerToString(time_hours) : integerToString(time_hours));
-	std::string time_minutes_string = (time_minutes < 10 ? "0"
-		+ integerToString(time_minutes) : integerToString(time_minutes));
-	return time_hours_string + ":" + time_minutes_string + ":00";
+	return time;
 }
 
 /*------------------------------------------------------------------------------
-	momentBefore
+	numBits
 
-	Given a time as a string, returns a string corresponding the previous
-	minute in time. For instance, given the string 11:23:00, this function
-	would return the string 11:22:00.
+	Returns the number of bits needed to encode a variable with the given
+	number of values.
 ------------------------------------------------------------------------------*/
-const std::string NuSMVTranslator::momentBefore(const std::string& time)
+const unsigned int NuSMVTranslator::numBits(const unsigned int num_values)
 {
-	int time_hours = stringToInteger(time.substr(0, 2));
-	int time_minutes = stringToInteger(time.substr(3, 2));
-	if(--time_minutes == -1)
+	unsigned int bits = 0;
+	while((1u << bits) < num_values)
 	{
-		time_minutes = 59;
-		time_hours--;
+		bits++;
 	}
-	std::string time_hours_string = ((time_hours < 10 && time_hours >= 0) ? "0"
-		+ integerToString(time_hours) : integerToString(time_hours));
-	std::string time_minutes_string = (time_minutes < 10 ? "0"
-		+ integerToString(time_minutes) : integerToString(time_minutes));
-	return time_hours_string + ":" + time_minutes_string + ":00";
+	return bits;
 }
 
 /*------------------------------------------------------------------------------
-	timeIsAfter
+	classifyVariable
 
-	Returns true if time_1 is later than time_2.
+	Classifies a deterministic variable. A variable that is never assigned and
+	has no known initial value is frozen if such variables are to be frozen,
+	and a variable that can only ever hold its initial value is constant.
 ------------------------------------------------------------------------------*/
-const bool NuSMVTranslator::timeIsAfter(const std::string& time_1,
-	const std::string& time_2)
+const VariableClass NuSMVTranslator::classifyVariable(
+	const std::set<std::string>& assigned_values,
+	const std::string& initial_value, const bool freeze_unassigned)
 {
-	int time_1_hours = stringToInteger(time_1.substr(0, 2));
-	int time_1_minutes = stringToInteger(time_1.substr(3, 2));
-	int time_2_hours = stringToInteger(time_2.substr(0, 2));
-	int time_2_minutes = stringToInteger(time_2.substr(3, 2));
-	if(time_1_hours == time_2_hours)
+	if(initial_value.empty())
 	{
-		return time_1_minutes > time_2_minutes;
+		return assigned_values.empty() && freeze_unassigned
+			? VARIABLE_FROZEN : VARIABLE_DYNAMIC;
 	}
-	else
+	if(assigned_values.empty() || (assigned_values.size() == 1
+		&& *(assigned_values.begin()) == initial_value))
 	{
-		return time_1_hours > time_2_hours;
+		return VARIABLE_CONSTANT;
 	}
+	return VARIABLE_DYNAMIC;
 }
 
 /*------------------------------------------------------------------------------
-	timeIsBefore
+	isDeclaredValue
 
-	Returns true if time_1 is earlier than time_2.
+	Returns true if the given value, as it is written in the model, is one of
+	the values of the given enumerated variable.
 ------------------------------------------------------------------------------*/
-const bool NuSMVTranslator::timeIsBefore(const std::string& time_1,
-	const std::string& time_2)
+const bool NuSMVTranslator::isDeclaredValue(EnumVariable* enum_variable,
+	const std::string& value)
 {
-	int time_1_hours = stringToInteger(time_1.substr(0, 2));
-	int time_1_minutes = stringToInteger(time_1.substr(3, 2));
-	int time_2_hours = stringToInteger(time_2.substr(0, 2));
-	int time_2_minutes = stringToInteger(time_2.substr(3, 2));
-	if(time_1_hours == time_2_hours)
+	for(const std::string& declared_value : enum_variable->getValues())
 	{
-		return time_1_minutes < time_2_minutes;
+		if(validateIdentifier(declared_value) == value)
+		{
+			return true;
+		}
 	}
-	else
+	return false;
+}
+
+/*------------------------------------------------------------------------------
+	getCounterName
+
+	Returns the name of the counter used for a been_in_state or was_in_state
+	suffixed precondition.
+------------------------------------------------------------------------------*/
+const std::string NuSMVTranslator::getCounterName(Precondition* p)
+{
+	std::string suffix = p->getTimeConstraintType()
+		== TimeConstraintType::BEEN_IN_STATE_FOR ?
+		BEEN_IN_STATE : WAS_IN_STATE;
+	if(p->getPreconditionType() == PreconditionType::PROP_VALUE_CHECK)
+	{
+		PreconditionPropValueCheck* p_prop = (PreconditionPropValueCheck*)p;
+		return validateIdentifier(p_prop->getPropVariable()->getName()) + "_"
+			+ (p_prop->getTruthValue() ? "TRUE" : "FALSE") + "_" + suffix;
+	}
+	PreconditionEnumValueCheck* p_enum = (PreconditionEnumValueCheck*)p;
+	return validateIdentifier(p_enum->getEnumVariable()->getName()) + "_"
+		+ validateIdentifier(p_enum->getEnumValue()) + "_" + suffix;
+}
+
+/*------------------------------------------------------------------------------
+	getCounterCheck
+
+	Returns an expression that checks the variable and value counted for a
+	been_in_state or was_in_state suffixed precondition.
+------------------------------------------------------------------------------*/
+const std::string NuSMVTranslator::getCounterCheck(Precondition* p,
+	const bool holds)
+{
+	if(p->getPreconditionType() == PreconditionType::PROP_VALUE_CHECK)
+	{
+		PreconditionPropValueCheck* p_prop = (PreconditionPropValueCheck*)p;
+		return validateIdentifier(p_prop->getPropVariable()->getName())
+			+ " = " + (p_prop->getTruthValue() == holds ? "TRUE" : "FALSE");
+	}
+	PreconditionEnumValueCheck* p_enum = (PreconditionEnumValueCheck*)p;
+	return validateIdentifier(p_enum->getEnumVariable()->getName())
+		+ (holds ? " = " : " != ") + validateIdentifier(p_enum->getEnumValue());
+}
+
+/*------------------------------------------------------------------------------
+	getValueSet
+
+	Returns a set expression holding a range of the given values.
+------------------------------------------------------------------------------*/
+const std::string NuSMVTranslator::getValueSet(
+	const std::list<std::string>& values, const int first, const int last)
+{
+	std::string value_set = "{";
+	int index = 0;
+	for(const std::string& value : values)
 	{
-		return time_1_hours < time_2_hours;
+		if(index >= first && index <= last)
+		{
+			value_set += (index > first ? ", " : "") + value;
+		}
+		index++;
 	}
+	return value_set + "}";
 }
 
 /*------------------------------------------------------------------------------
@@ -2817,8 +3432,8 @@ const bool NuSMVTranslator::timeIsBefore(const std::string& time_1,
 	corresponding to the power set of the vector v.
 ------------------------------------------------------------------------------*/
 template<typename T>
-std::vector<std::vector<T>> NuSMVTranslator::vectorPowerSet(std::vector<T>& v,
-	const bool sort_increasing_size)
+std::vector<std::vector<T>> NuSMVTranslator::vectorPowerSet(
+	const std::vector<T>& v, const bool sort_increasing_size)
 {
 	std::vector<std::vector<T>> power_set;
 	int num_items = v.size();
@@ -2833,7 +3448,7 @@ std::vector<std::vector<T>> NuSMVTranslator::vectorPowerSet(std::vector<T>& v,
 	if(sort_increasing_size)
 	{
 		std::sort(power_set.begin(), power_set.end(),
-			[&](std::vector<T> this_v, std::vector<T> that_v)
+			[&](const std::vector<T>& this_v, const std::vector<T>& that_v)
 			{
 				return that_v.size() < this_v.size();
 			});
@@ -2841,7 +3456,7 @@ std::vector<std::vector<T>> NuSMVTranslator::vectorPowerSet(std::vector<T>& v,
 	else
 	{
 		std::sort(power_set.begin(), power_set.end(),
-			[&](std::vector<T> this_v, std::vector<T> that_v)
+			[&](const std::vector<T>& this_v, const std::vector<T>& that_v)
 			{
 				return this_v.size() > that_v.size();
 			});
@@ -2858,7 +3473,7 @@ std::vector<std::vector<T>> NuSMVTranslator::vectorPowerSet(std::vector<T>& v,
 ------------------------------------------------------------------------------*/
 template<typename T>
 std::vector<T> NuSMVTranslator::filterVectorByCharacteristicVector(
-	std::vector<T>& v, int characteristic_vector)
+	const std::vector<T>& v, int characteristic_vector)
 {
 	std::vector<T> subset;
 	int index = 0;
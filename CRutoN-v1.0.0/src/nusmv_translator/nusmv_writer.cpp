@@ -0,0 +1,136 @@
+/*==============================================================================
+	File			: nusmv_writer.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include "nusmv_translator/nusmv_definitions.h"
+#include "nusmv_translator/nusmv_model_statistics.h"
+#include "nusmv_translator/nusmv_writer.h"
+
+/*------------------------------------------------------------------------------
+	beginLine
+
+	Begins a new line, prefixed with num_tabs tabs.
+------------------------------------------------------------------------------*/
+void NuSMVWriter::beginLine(const int num_tabs)
+{
+	for(int i = 0; i < num_tabs; i++)
+	{
+		buffer += TAB;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	endLine
+
+	Ends the current line, possibly terminating it with a semi-colon.
+------------------------------------------------------------------------------*/
+void NuSMVWriter::endLine(const bool terminating_semi_colon)
+{
+	if(terminating_semi_colon)
+	{
+		buffer += ';';
+	}
+	buffer += '\n';
+	flushIfFull();
+}
+
+/*------------------------------------------------------------------------------
+	addLine
+
+	Writes a complete line, prefixed with num_tabs tabs, and possibly
+	terminating with a semi-colon.
+------------------------------------------------------------------------------*/
+void NuSMVWriter::addLine(const std::string& line, const int num_tabs,
+	const bool terminating_semi_colon)
+{
+	beginLine(num_tabs);
+	buffer += line;
+	endLine(terminating_semi_colon);
+}
+
+/*------------------------------------------------------------------------------
+	addText
+
+	Writes a block of complete lines. A block larger than the buffer is
+	passed straight on to the underlying output.
+------------------------------------------------------------------------------*/
+void NuSMVWriter::addText(const std::string& text)
+{
+	if(text.size() < BUFFER_SIZE)
+	{
+		buffer += text;
+		flushIfFull();
+		return;
+	}
+	// write what is buffered first, so that the text stays in order
+	flush();
+	if(statistics != nullptr)
+	{
+		statistics->scan(text.data(), text.size());
+	}
+	writeBuffer(text.data(), text.size());
+}
+
+/*------------------------------------------------------------------------------
+	flush
+
+	Passes any buffered text on to the underlying output.
+------------------------------------------------------------------------------*/
+void NuSMVWriter::flush()
+{
+	if(!buffer.empty())
+	{
+		if(statistics != nullptr)
+		{
+			statistics->scan(buffer.data(), buffer.size());
+		}
+		writeBuffer(buffer.data(), buffer.size());
+		buffer.clear();
+	}
+}
+
+/*------------------------------------------------------------------------------
+	<< operator overloads
+------------------------------------------------------------------------------*/
+NuSMVWriter& NuSMVWriter::operator<<(const std::string& s)
+{
+	buffer += s;
+	flushIfFull();
+	return *this;
+}
+
+NuSMVWriter& NuSMVWriter::operator<<(const char* s)
+{
+	buffer += s;
+	flushIfFull();
+	return *this;
+}
+
+NuSMVWriter& NuSMVWriter::operator<<(const char c)
+{
+	buffer += c;
+	return *this;
+}
@@ -0,0 +1,163 @@
+/*==============================================================================
+	TranslationCache
+
+	The sections of the NuSMV models last translated with a set of
+	translator options.
+
+	File			: translation_cache.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include "global.h"
+#include "utility.h"
+#include "intermediate_parser/file_source.h"
+#include "nusmv_translator/translation_cache.h"
+
+const std::string TranslationCache::MAGIC = "CRUTONTC";
+const int TranslationCache::FORMAT_VERSION = 1;
+const std::string TranslationCache::EXTENSION = ".ntc";
+
+/*------------------------------------------------------------------------------
+	computeKey
+
+	Sets the key of the cache files from the given translator options.
+------------------------------------------------------------------------------*/
+void TranslationCache::computeKey(const TranslatorOptions& options)
+{
+	CacheHash hash;
+	hash.addString(MAGIC + integerToString(FORMAT_VERSION) + EXEC_VERSION);
+	hash.addString(std::string()
+		+ (options.true_non_determinism ? "1" : "0")
+		+ (options.minimum_one_state_state_n_seconds ? "1" : "0")
+		+ (options.integer_counters ? "1" : "0")
+		+ (options.freeze_unassigned_variables ? "1" : "0"));
+	hash.addString(integerToString(options.state_time_seconds));
+	hash.addString(integerToString(options.max_seconds_per_state_n_seconds));
+	hash.addString(integerToString(options.max_power_set_group_size));
+	hash.addString(options.time_of_day);
+	key = hash;
+}
+
+/*------------------------------------------------------------------------------
+	getFilename
+
+	Returns the name of the cache file of a section for the current key.
+------------------------------------------------------------------------------*/
+const std::string TranslationCache::getFilename(const std::string& name) const
+{
+	CacheHash hash = key;
+	hash.addString(name);
+	return hash.getFilename(directory, EXTENSION);
+}
+
+/*------------------------------------------------------------------------------
+	find
+
+	Returns the text of a section, or nullptr if the section is not held or
+	was built from different inputs.
+------------------------------------------------------------------------------*/
+const std::string* TranslationCache::find(const std::string& name,
+	const std::uint64_t digest)
+{
+	auto it = sections.find(name);
+	if(it == sections.end())
+	{
+		std::string filename = getFilename(name);
+		FileSource source(filename, true);
+		if(!source.isOpen())
+		{
+			return nullptr;
+		}
+		try
+		{
+			decode(name, source.getData(), source.size());
+		}
+		catch(std::string& error)
+		{
+			displayWarning("ignoring invalid cache file \'" + filename
+				+ "\'\n" + error);
+			return nullptr;
+		}
+		it = sections.find(name);
+	}
+	if(it->second.first != digest)
+	{
+		return nullptr;
+	}
+	return &it->second.second;
+}
+
+/*------------------------------------------------------------------------------
+	decode
+
+	Reads the digest and the text of a section from the contents of its
+	cache file.
+------------------------------------------------------------------------------*/
+void TranslationCache::decode(const std::string& name, const char* data,
+	const std::size_t size) throw(std::string)
+{
+	CacheReader reader(data, size);
+	reader.expectBytes(MAGIC);
+	if(reader.getInt() != FORMAT_VERSION || !key.check(reader)
+		|| reader.getString() != name)
+	{
+		throw(std::string("cache file of a different version or key\n"));
+	}
+	// the digest is written as two halves, low first
+	std::uint64_t digest = (std::uint32_t)reader.getInt();
+	digest |= (std::uint64_t)(std::uint32_t)reader.getInt() << 32;
+	std::string text = reader.getString();
+	if(!reader.atEnd())
+	{
+		throw(std::string("unexpected data at end of file\n"));
+	}
+	sections[name] = std::make_pair(digest, text);
+}
+
+/*------------------------------------------------------------------------------
+	store
+
+	Holds the text of a section and writes it to the cache file of the
+	section.
+------------------------------------------------------------------------------*/
+void TranslationCache::store(const std::string& name,
+	const std::uint64_t digest, const std::string& text) throw(std::string)
+{
+	sections[name] = std::make_pair(digest, text);
+	CacheWriter writer;
+	writer.putBytes(MAGIC);
+	writer.putInt(FORMAT_VERSION);
+	key.put(writer);
+	writer.putString(name);
+	writer.putInt((int)(std::uint32_t)digest);
+	writer.putInt((int)(std::uint32_t)(digest >> 32));
+	writer.putString(text);
+	writer.writeToFile(getFilename(name));
+}
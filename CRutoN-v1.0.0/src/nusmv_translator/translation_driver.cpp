@@ -0,0 +1,159 @@
+/*==============================================================================
+	TranslationDriver
+
+	File			: translation_driver.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "utility.h"
+#include "intermediate/intermediate_form.h"
+#include "nusmv_translator/nusmv_file_writer.h"
+#include "nusmv_translator/nusmv_translator.h"
+#include "nusmv_translator/translation_cache.h"
+#include "nusmv_translator/translation_driver.h"
+
+/*------------------------------------------------------------------------------
+	addConfiguration
+
+	Adds a translation to be written to the given file.
+------------------------------------------------------------------------------*/
+void TranslationDriver::addConfiguration(const TranslatorOptions& options,
+	const std::string& file)
+{
+	configurations.push_back(
+		std::pair<TranslatorOptions, std::string>(options, file));
+}
+
+/*------------------------------------------------------------------------------
+	run
+
+	Prepares and writes every translation, returning true if all of them were
+	written successfully.
+------------------------------------------------------------------------------*/
+const bool TranslationDriver::run(const unsigned int num_threads)
+{
+	std::vector<NuSMVTranslator*> translators;
+	std::vector<TranslationCache*> caches;
+	// configurations with the same options share their cache files, which
+	// only the first of them uses
+	std::set<std::uint64_t> cache_keys;
+	bool prepared = true;
+	// prepare on this thread, so that messages are not interleaved
+	for(auto& configuration : configurations)
+	{
+		NuSMVTranslator* translator = new NuSMVTranslator(intermediate_form,
+			configuration.first);
+		translators.push_back(translator);
+		if(!cache_directory.empty()
+			&& configuration.first.cone_of_influence == nullptr)
+		{
+			TranslationCache* cache = new TranslationCache(cache_directory);
+			caches.push_back(cache);
+			cache->computeKey(configuration.first);
+			if(cache_keys.insert(cache->getKey()).second)
+			{
+				translator->setTranslationCache(cache);
+			}
+		}
+		if(!translator->prepareTranslation(initial_values))
+		{
+			prepared = false;
+			break;
+		}
+	}
+
+	// records whether each translation was written, indexed as translators
+	std::vector<char> written(translators.size(), false);
+	if(prepared)
+	{
+		// threads left over when there are fewer translations than threads
+		// build the sections of each translation
+		unsigned int section_threads = !translators.empty()
+			&& translators.size() < num_threads ?
+				num_threads / translators.size() : 1;
+		std::atomic<unsigned int> next(0);
+		auto work = [&]()
+			{
+				unsigned int i;
+				while((i = next++) < translators.size())
+				{
+					NuSMVFileWriter writer(configurations[i].second);
+					if(writer.isOpen())
+					{
+						translators[i]->translate(writer, section_threads);
+						written[i] = true;
+					}
+				}
+			};
+		std::vector<std::thread> workers;
+		for(unsigned int i = 1; i < num_threads && i < translators.size(); i++)
+		{
+			workers.push_back(std::thread(work));
+		}
+		// this thread is also a worker
+		work();
+		for(std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	bool successful = prepared;
+	for(unsigned int i = 0; prepared && i < written.size(); i++)
+	{
+		if(written[i])
+		{
+			std::cout << "NuSMV code written to file \'"
+				+ configurations[i].second + "\' successfully\n";
+			if(configurations[i].first.cone_of_influence != nullptr)
+			{
+				std::cout << "cone of influence: "
+					<< translators[i]->getSliceSummary() << "\n";
+			}
+		}
+		else
+		{
+			displayError("could not open file \'" + configurations[i].second
+				+ "\'");
+			successful = false;
+		}
+	}
+	for(NuSMVTranslator* translator : translators)
+	{
+		delete translator;
+	}
+	for(TranslationCache* cache : caches)
+	{
+		delete cache;
+	}
+	return successful;
+}
@@ -0,0 +1,304 @@
+/*==============================================================================
+	ResolutionPolicy
+
+	File			: resolution_policy.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <iostream>
+
+#include "global.h"
+#include "utility.h"
+#include "intermediate_parser/file_source.h"
+#include "intermediate_parser/token_cursor.h"
+#include "intermediate_parser/tokenize.h"
+#include "resolution_policy/resolution_policy.h"
+
+ResolutionPolicy g_resolution_policy;
+
+/*------------------------------------------------------------------------------
+	The name of each kind of prompt in a policy file, indexed by PromptType.
+------------------------------------------------------------------------------*/
+static const std::string PROMPT_TYPE_NAMES[] =
+{
+	"identifier", "no_preconditions", "any_text", "data_extraction_rule",
+	"overwrite"
+};
+
+/*------------------------------------------------------------------------------
+	load
+
+	Loads the answers in the given policy file. Throws an error if the file
+	cannot be read or contains a malformed line.
+------------------------------------------------------------------------------*/
+void ResolutionPolicy::load(const std::string& filename) throw(std::string)
+{
+	FileSource file_source(filename);
+	if(!file_source.isOpen())
+	{
+		throw("[load]->\nerror loading file \'" + filename + "\'\n");
+	}
+	policy_file = filename;
+
+	TokenCursor file_cursor(file_source.getSpan());
+	int line_number = 0;
+	while(!file_cursor.atEnd())
+	{
+		std::string line = file_cursor.getNextLine().str();
+		line_number++;
+		if(!line.empty() && line.back() == '\r')
+		{
+			line.pop_back();
+		}
+		const std::size_t first = line.find_first_not_of(" \t");
+		if(first == std::string::npos || line[first] == '#')
+		{
+			continue;
+		}
+		std::vector<std::string> fields;
+		std::size_t start = 0;
+		std::size_t tab;
+		while((tab = line.find('\t', start)) != std::string::npos)
+		{
+			fields.push_back(line.substr(start, tab - start));
+			start = tab + 1;
+		}
+		fields.push_back(line.substr(start));
+		if(fields.size() < 3)
+		{
+			throw("[load]->\nerror on line " + integerToString(line_number)
+				+ " of file \'" + filename + "\'\n"
+				+ "expected a kind, a key and an answer separated by tabs\n");
+		}
+		int type = 0;
+		while(type <= PROMPT_FILE_OVERWRITE
+			&& PROMPT_TYPE_NAMES[type] != trim(fields.front()))
+		{
+			type++;
+		}
+		if(type > PROMPT_FILE_OVERWRITE)
+		{
+			throw("[load]->\nerror on line " + integerToString(line_number)
+				+ " of file \'" + filename + "\'\n"
+				+ "unknown kind of prompt \'" + fields.front() + "\'\n");
+		}
+		std::vector<std::string> key;
+		for(std::size_t i = 1; i < fields.size() - 1; i++)
+		{
+			key.push_back(unescape(fields[i]));
+		}
+		std::string answer = unescape(fields.back());
+		answer.erase(0, answer.find_first_not_of(' '));
+		answer.erase(answer.find_last_not_of(' ') + 1);
+		// a later answer to the same prompt replaces an earlier one
+		answers[formatKey(static_cast<PromptType>(type), key)] =
+			std::pair<std::string, int>(answer, line_number);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	setRecordFile
+
+	Sets the file to which every answer given is written in the policy file
+	format. The file is checked by opening it for appending, which leaves its
+	contents as they are, and is only replaced when the first answer is
+	recorded.
+------------------------------------------------------------------------------*/
+void ResolutionPolicy::setRecordFile(const std::string& filename)
+	throw(std::string)
+{
+	std::ofstream check_stream(filename, std::ios::app);
+	if(!check_stream.good())
+	{
+		throw("[setRecordFile]->\nerror opening file \'" + filename + "\'\n");
+	}
+	record_file = filename;
+}
+
+/*------------------------------------------------------------------------------
+	prompt
+
+	Returns the answer to a prompt. The answer is taken from the policy if one
+	is given, otherwise the question is asked on standard output until a valid
+	answer is read from standard input.
+------------------------------------------------------------------------------*/
+const std::string ResolutionPolicy::prompt(const PromptType type,
+	const std::vector<std::string>& key, const std::string& question,
+	const std::function<bool(const std::string&)>& is_valid)
+		throw(std::string)
+{
+	const std::string formatted_key = formatKey(type, key);
+	auto it = answers.find(formatted_key);
+	if(it == answers.end())
+	{
+		// fall back to the answer for every prompt of this kind
+		it = answers.find(formatKey(type, std::vector<std::string>(1, "*")));
+	}
+
+	std::string answer;
+	if(it != answers.end())
+	{
+		answer = it->second.first;
+		std::cout << question << answer << "\n";
+		if(!is_valid(answer))
+		{
+			throw("[prompt]->\ninvalid answer \'" + answer + "\' on line "
+				+ integerToString(it->second.second) + " of file \'"
+				+ policy_file + "\'\n");
+		}
+	}
+	else if(strict)
+	{
+		std::cout << question << "\n";
+		throw("[prompt]->\nno answer was given for the prompt:\n"
+			+ formatted_key + "\n");
+	}
+	else
+	{
+		do
+		{
+			std::cout << question;
+			if(!(std::cin >> answer))
+			{
+				throw(std::string("[prompt]->\n")
+					+ "standard input was closed before an answer was given\n");
+			}
+		} while(!is_valid(answer));
+	}
+
+	record(formatted_key, answer);
+	return answer;
+}
+
+/*------------------------------------------------------------------------------
+	replayAnswer
+
+	Records an answer given to a prompt in an earlier run as if it had been
+	given again.
+------------------------------------------------------------------------------*/
+void ResolutionPolicy::replayAnswer(const std::string& formatted_key,
+	const std::string& answer) throw(std::string)
+{
+	record(formatted_key, answer);
+}
+
+/*------------------------------------------------------------------------------
+	record
+
+	Records the first answer given to a prompt, writing it to the record file
+	if one was set. The record file is only replaced when the first answer is
+	written to it, so a run that answers no prompts leaves it as it was.
+------------------------------------------------------------------------------*/
+void ResolutionPolicy::record(const std::string& formatted_key,
+	const std::string& answer) throw(std::string)
+{
+	if(!recorded.insert(formatted_key).second)
+	{
+		return;
+	}
+	given_answers.push_back(std::make_pair(formatted_key, answer));
+	if(record_file.empty())
+	{
+		return;
+	}
+	if(!record_stream.is_open())
+	{
+		record_stream.open(record_file);
+		if(!record_stream.good())
+		{
+			throw("[record]->\nerror opening file \'" + record_file
+				+ "\'\n");
+		}
+		record_stream << "# answers recorded by " << EXEC_NAME << " "
+			<< EXEC_VERSION << "\n";
+	}
+	record_stream << formatted_key << "\t" << escape(answer) << "\n";
+	record_stream.flush();
+}
+
+/*------------------------------------------------------------------------------
+	formatKey
+
+	Returns the kind and key of a prompt in the policy file format.
+------------------------------------------------------------------------------*/
+const std::string ResolutionPolicy::formatKey(const PromptType type,
+	const std::vector<std::string>& key)
+{
+	std::string formatted_key = PROMPT_TYPE_NAMES[type];
+	for(const std::string& field : key)
+	{
+		formatted_key += "\t" + escape(field);
+	}
+	return formatted_key;
+}
+
+/*------------------------------------------------------------------------------
+	escape
+
+	Escapes the tabs and backslashes in a field.
+------------------------------------------------------------------------------*/
+const std::string ResolutionPolicy::escape(const std::string& field)
+{
+	std::string escaped;
+	for(char c : field)
+	{
+		if(c == '\t')
+		{
+			escaped += "\\t";
+		}
+		else if(c == '\\')
+		{
+			escaped += "\\\\";
+		}
+		else
+		{
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+/*------------------------------------------------------------------------------
+	unescape
+
+	Reverses escape.
+------------------------------------------------------------------------------*/
+const std::string ResolutionPolicy::unescape(const std::string& field)
+{
+	std::string unescaped;
+	for(std::size_t i = 0; i < field.size(); i++)
+	{
+		if(field[i] == '\\' && i + 1 < field.size())
+		{
+			i++;
+			unescaped += (field[i] == 't') ? '\t' : field[i];
+		}
+		else
+		{
+			unescaped += field[i];
+		}
+	}
+	return unescaped;
+}
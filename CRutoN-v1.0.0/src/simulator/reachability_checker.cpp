@@ -0,0 +1,436 @@
+/*==============================================================================
+	ReachabilityChecker
+
+	Finds the behaviours that can be scheduled in some reachable state of
+	the intermediate form's NuSMV translation, by an explicit-state breadth
+	first search over the states of a simulator.
+
+	File			: reachability_checker.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "simulator/reachability_checker.h"
+#include "simulator/simulator.h"
+
+const unsigned int ReachabilityChecker::SLOT_EMPTY = 0;
+const unsigned int ReachabilityChecker::NO_STATE = (unsigned int)-1;
+const unsigned int ReachabilityChecker::CHUNK_SIZE = 64;
+
+/*------------------------------------------------------------------------------
+	check
+
+	Explores the reachable states, until every reachable state has been found
+	or the largest number of states is reached.
+------------------------------------------------------------------------------*/
+const bool ReachabilityChecker::check()
+{
+	auto start = std::chrono::steady_clock::now();
+	num_words = simulator.num_words;
+	// at most half of the slots are used, keeping the probe sequences short
+	capacity = 1;
+	while(capacity < 2 * max_states)
+	{
+		capacity *= 2;
+	}
+	slots = std::vector<std::atomic<unsigned int>>(capacity);
+	for(std::atomic<unsigned int>& slot : slots)
+	{
+		slot.store(SLOT_EMPTY, std::memory_order_relaxed);
+	}
+	// each worker may go past the largest number of states by one state,
+	// and may hold one unused number
+	size_t max_numbers = (size_t)max_states + 2 * num_threads;
+	words.assign(max_numbers * num_words, 0);
+	parents.assign(max_numbers, NO_STATE);
+	witnesses = std::vector<std::atomic<unsigned int>>(
+		simulator.behaviours.size());
+	for(std::atomic<unsigned int>& witness : witnesses)
+	{
+		witness.store(NO_STATE, std::memory_order_relaxed);
+	}
+	num_states = 0;
+	num_numbers = 0;
+	is_full = false;
+	depth = 0;
+	std::vector<Simulator::SimulatorContext> contexts(num_threads);
+	for(Simulator::SimulatorContext& c : contexts)
+	{
+		simulator.prepareContext(c);
+		c.is_enumerating = true;
+	}
+	// the unused state number held by each worker, see insert
+	std::vector<unsigned int> spares(num_threads, NO_STATE);
+
+	// the initial states
+	std::vector<unsigned int> level;
+	std::vector<uint64_t> current(num_words, 0);
+	std::vector<uint64_t> next(num_words, 0);
+	do
+	{
+		simulator.initialise(contexts[0], current);
+		bool is_new;
+		unsigned int number = insert(current, NO_STATE, spares[0], is_new);
+		if(is_new)
+		{
+			level.push_back(number);
+			recordWitness(current, number);
+		}
+	}
+	while(simulator.nextChoices(contexts[0]));
+
+	while(!level.empty() && !is_full)
+	{
+		// deal the chunks of the level to the workers in turn
+		unsigned int num_chunks = (level.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+		unsigned int num_workers = std::min(num_threads, num_chunks);
+		std::vector<WorkQueue> queues(num_workers);
+		for(unsigned int i = 0; i < num_chunks; i++)
+		{
+			queues[i % num_workers].chunks.push_back(std::make_pair(
+				i * CHUNK_SIZE, std::min((unsigned int)level.size(),
+				(i + 1) * CHUNK_SIZE)));
+		}
+		for(WorkQueue& queue : queues)
+		{
+			// published to the workers when they are started
+			queue.top.store(0, std::memory_order_relaxed);
+			queue.bottom.store(queue.chunks.size(), std::memory_order_relaxed);
+		}
+		std::vector<std::vector<unsigned int>> next_levels(num_workers);
+		auto work = [&](const unsigned int worker)
+		{
+			Simulator::SimulatorContext& c = contexts[worker];
+			std::vector<uint64_t> state(num_words, 0);
+			std::vector<uint64_t> successor(num_words, 0);
+			std::pair<unsigned int, unsigned int> chunk;
+			while(takeChunk(queues, worker, chunk))
+			{
+				for(unsigned int i = chunk.first; i < chunk.second; i++)
+				{
+					unsigned int number = level[i];
+					std::copy(words.begin() + (size_t)number * num_words,
+						words.begin() + (size_t)(number + 1) * num_words,
+						state.begin());
+					// take every combination of choices from the state
+					do
+					{
+						simulator.step(c, state, successor);
+						bool is_new;
+						unsigned int successor_number = insert(successor,
+							number, spares[worker], is_new);
+						if(is_new)
+						{
+							next_levels[worker].push_back(successor_number);
+							recordWitness(successor, successor_number);
+						}
+					}
+					while(simulator.nextChoices(c));
+				}
+			}
+		};
+		std::vector<std::thread> workers;
+		for(unsigned int i = 1; i < num_workers; i++)
+		{
+			workers.push_back(std::thread(work, i));
+		}
+		// this thread is also a worker
+		work(0);
+		for(std::thread& worker : workers)
+		{
+			worker.join();
+		}
+		level.clear();
+		for(std::vector<unsigned int>& next_level : next_levels)
+		{
+			level.insert(level.end(), next_level.begin(), next_level.end());
+		}
+		depth++;
+	}
+	elapsed_seconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+	return !is_full;
+}
+
+/*------------------------------------------------------------------------------
+	writeResults
+
+	Writes the number of states explored and the rate at which they were
+	explored, and for each behaviour the length of the shortest trace to a
+	state in which it is scheduled, if there is one.
+------------------------------------------------------------------------------*/
+void ReachabilityChecker::writeResults(std::ostream& os) const
+{
+	os << "explored " << num_states << " states to a depth of " << depth
+		<< " steps using " << num_threads
+		<< (num_threads == 1 ? " thread" : " threads");
+	if(elapsed_seconds > 0)
+	{
+		os << ", " << (unsigned long long)(num_states / elapsed_seconds)
+			<< " states per second";
+	}
+	os << "\n";
+	for(unsigned int i = 1; i < simulator.behaviours.size(); i++)
+	{
+		os << "behaviour \'" << simulator.behaviours[i].name << "\': ";
+		unsigned int witness = witnesses[i];
+		if(witness != NO_STATE)
+		{
+			os << "reachable in " << getTrace(witness).size() - 1
+				<< " steps\n";
+		}
+		else
+		{
+			// with the search cut short, the behaviour may still be reachable
+			os << (is_full ? "not reached\n" : "unreachable\n");
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	writeWitnesses
+
+	Writes a trace for each reachable behaviour, ending in a state in which it
+	is scheduled, in the format of NuSMV so that it can be replayed by the
+	simulator.
+------------------------------------------------------------------------------*/
+void ReachabilityChecker::writeWitnesses(std::ostream& os) const
+{
+	unsigned int trace_num = 0;
+	for(unsigned int i = 1; i < simulator.behaviours.size(); i++)
+	{
+		unsigned int witness = witnesses[i];
+		if(witness == NO_STATE)
+		{
+			continue;
+		}
+		trace_num++;
+		os << "Trace Description: behaviour \'"
+			<< simulator.behaviours[i].name << "\' is scheduled\n";
+		os << "Trace Type: Example\n";
+		std::vector<unsigned int> trace = getTrace(witness);
+		std::vector<uint64_t> state(num_words, 0);
+		std::vector<int> previous_values;
+		for(unsigned int j = 0; j < trace.size(); j++)
+		{
+			std::copy(words.begin() + (size_t)trace[j] * num_words,
+				words.begin() + (size_t)(trace[j] + 1) * num_words,
+				state.begin());
+			os << "  -> State: " << trace_num << "." << j + 1 << " <-\n";
+			// as in NuSMV, only the values that change are written after the
+			// first state
+			for(unsigned int field = 0; field < simulator.fields.size();
+				field++)
+			{
+				int value = simulator.getField(state, field);
+				if(j == 0 || value != previous_values[field])
+				{
+					os << "    " << simulator.fields[field].name << " = "
+						<< simulator.fields[field].values[value] << "\n";
+				}
+			}
+			previous_values.clear();
+			for(unsigned int field = 0; field < simulator.fields.size();
+				field++)
+			{
+				previous_values.push_back(simulator.getField(state, field));
+			}
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	hash
+
+	Returns the hash of a state.
+------------------------------------------------------------------------------*/
+const uint64_t ReachabilityChecker::hash(const std::vector<uint64_t>& state)
+{
+	uint64_t h = 0x9e3779b97f4a7c15ULL;
+	for(uint64_t word : state)
+	{
+		h ^= word;
+		h *= 0xff51afd7ed558ccdULL;
+		h ^= h >> 33;
+	}
+	return h;
+}
+
+/*------------------------------------------------------------------------------
+	insert
+
+	Adds a state to the hash table if it is not already there. The state is
+	written under a number before the number is published in an empty slot
+	with a compare and swap, so the state in any slot that is not empty can
+	be read at once. If the swap fails the number stays unused, and is kept
+	by the caller for its next state.
+------------------------------------------------------------------------------*/
+const unsigned int ReachabilityChecker::insert(
+	const std::vector<uint64_t>& state, const unsigned int parent,
+	unsigned int& spare, bool& is_new)
+{
+	is_new = false;
+	unsigned int slot = hash(state) & (capacity - 1);
+	while(true)
+	{
+		unsigned int entry = slots[slot].load(std::memory_order_acquire);
+		if(entry == SLOT_EMPTY)
+		{
+			if(num_states.load(std::memory_order_relaxed) >= max_states)
+			{
+				is_full = true;
+				return NO_STATE;
+			}
+			if(spare == NO_STATE)
+			{
+				spare = num_numbers++;
+			}
+			std::copy(state.begin(), state.end(),
+				words.begin() + (size_t)spare * num_words);
+			parents[spare] = parent;
+			if(slots[slot].compare_exchange_strong(entry, spare + 1,
+				std::memory_order_acq_rel, std::memory_order_acquire))
+			{
+				unsigned int number = spare;
+				spare = NO_STATE;
+				num_states++;
+				is_new = true;
+				return number;
+			}
+			// another state was published in the slot, and entry is now it
+		}
+		if(std::equal(state.begin(), state.end(),
+			words.begin() + (size_t)(entry - 1) * num_words))
+		{
+			return entry - 1;
+		}
+		slot = (slot + 1) & (capacity - 1);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	recordWitness
+
+	Records a new state as the witness of the behaviour scheduled in it, if no
+	witness has been found for that behaviour.
+------------------------------------------------------------------------------*/
+void ReachabilityChecker::recordWitness(const std::vector<uint64_t>& state,
+	const unsigned int number)
+{
+	int schedule = simulator.getField(state, simulator.schedule_field);
+	if(schedule != 0)
+	{
+		unsigned int witness = NO_STATE;
+		witnesses[schedule].compare_exchange_strong(witness, number);
+	}
+}
+
+/*------------------------------------------------------------------------------
+	takeChunk
+
+	Takes a chunk for a worker, from the back of its own queue or otherwise
+	from the front of another worker's queue, without locking. These are the
+	take and steal of the deque of Chase and Lev, which only need to agree
+	on who takes the last chunk of a deque. As no chunk is added once the
+	workers have started, a deque that is found empty stays empty.
+------------------------------------------------------------------------------*/
+const bool ReachabilityChecker::takeChunk(std::vector<WorkQueue>& queues,
+	const unsigned int worker, std::pair<unsigned int, unsigned int>& chunk)
+	const
+{
+	WorkQueue& own = queues[worker];
+	long long bottom = own.bottom.load(std::memory_order_relaxed) - 1;
+	own.bottom.store(bottom, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	long long top = own.top.load(std::memory_order_relaxed);
+	if(top <= bottom)
+	{
+		chunk = own.chunks[bottom];
+		if(top < bottom)
+		{
+			return true;
+		}
+		// the last chunk, which a thief may be taking
+		bool is_taken = own.top.compare_exchange_strong(top, top + 1,
+			std::memory_order_seq_cst, std::memory_order_relaxed);
+		own.bottom.store(bottom + 1, std::memory_order_relaxed);
+		if(is_taken)
+		{
+			return true;
+		}
+	}
+	else
+	{
+		own.bottom.store(bottom + 1, std::memory_order_relaxed);
+	}
+	for(unsigned int i = 1; i < queues.size(); i++)
+	{
+		WorkQueue& queue = queues[(worker + i) % queues.size()];
+		while(true)
+		{
+			top = queue.top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if(top >= queue.bottom.load(std::memory_order_acquire))
+			{
+				break;
+			}
+			chunk = queue.chunks[top];
+			if(queue.top.compare_exchange_strong(top, top + 1,
+				std::memory_order_seq_cst, std::memory_order_relaxed))
+			{
+				return true;
+			}
+			// the chunk was taken by its owner or another thief, try the next
+		}
+	}
+	return false;
+}
+
+/*------------------------------------------------------------------------------
+	getTrace
+
+	Returns the numbers of the states on the path found from an initial state
+	to a state.
+------------------------------------------------------------------------------*/
+const std::vector<unsigned int> ReachabilityChecker::getTrace(
+	unsigned int number) const
+{
+	std::vector<unsigned int> trace;
+	while(number != NO_STATE)
+	{
+		trace.push_back(number);
+		number = parents[number];
+	}
+	std::reverse(trace.begin(), trace.end());
+	return trace;
+}
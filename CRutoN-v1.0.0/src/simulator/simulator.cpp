@@ -0,0 +1,1087 @@
+/*==============================================================================
+	Simulator
+
+	File			: simulator.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "utility.h"
+#include "enums/action_type.h"
+#include "enums/precondition_type.h"
+#include "enums/simulator_node_type.h"
+#include "enums/time_constraint_type.h"
+#include "enums/tree_node_type.h"
+#include "enums/variable_class.h"
+#include "intermediate/action.h"
+#include "intermediate/action_enum_value_assignment.h"
+#include "intermediate/action_execute.h"
+#include "intermediate/action_execute_non_deterministic.h"
+#include "intermediate/action_prop_value_assignment.h"
+#include "intermediate/behaviour.h"
+#include "intermediate/enum_variable.h"
+#include "intermediate/intermediate_form.h"
+#include "intermediate/logical_expression_tree.h"
+#include "intermediate/precondition.h"
+#include "intermediate/precondition_enum_value_check.h"
+#include "intermediate/precondition_prop_value_check.h"
+#include "intermediate/precondition_timing_constraint.h"
+#include "intermediate/prop_variable.h"
+#include "intermediate/tree_node.h"
+#include "intermediate_parser/file_source.h"
+#include "intermediate_parser/token_cursor.h"
+#include "nusmv_translator/nusmv_definitions.h"
+#include "nusmv_translator/nusmv_translator.h"
+#include "simulator/simulator.h"
+
+/*------------------------------------------------------------------------------
+	prepareSimulation
+
+	Analyses the intermediate form as it is analysed for translation, and
+	compiles the behaviours and variables.
+------------------------------------------------------------------------------*/
+const bool Simulator::prepareSimulation(
+	const std::map<std::string, std::string>& initial_values)
+{
+	if(!translator.prepareTranslation(initial_values))
+	{
+		return false;
+	}
+	max_step = translator.max_num_actions;
+	buildFields();
+	// the counters are built first, as the preconditions refer to them
+	buildCounters();
+	buildBehaviours();
+	prepareContext(context);
+	return true;
+}
+
+/*------------------------------------------------------------------------------
+	simulate
+
+	Simulates a number of random steps, restarting from a random initial state
+	after each run of the given length.
+------------------------------------------------------------------------------*/
+void Simulator::simulate(const unsigned long long steps,
+	const unsigned int run_length)
+{
+	std::vector<uint64_t> current(num_words, 0);
+	std::vector<uint64_t> next(num_words, 0);
+	auto start = std::chrono::steady_clock::now();
+	for(unsigned long long i = 0; i < steps; i++)
+	{
+		if(i % run_length == 0)
+		{
+			initialise(context, current);
+			num_runs++;
+		}
+		step(context, current, next);
+		current.swap(next);
+	}
+	elapsed_seconds += std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start).count();
+}
+
+/*------------------------------------------------------------------------------
+	replayTrace
+
+	Replays a trace written by NuSMV, checking every state of the trace
+	against the simulated state.
+------------------------------------------------------------------------------*/
+const unsigned int Simulator::replayTrace(const std::string& filename)
+	throw(std::string)
+{
+	std::vector<TraceState> states;
+	parseTrace(filename, states);
+	if(states.empty())
+	{
+		throw("no states were found in trace file \'" + filename + "\'");
+	}
+	std::vector<uint64_t> current(num_words, 0);
+	std::vector<uint64_t> next(num_words, 0);
+	try
+	{
+		for(unsigned int i = 0; i < states.size(); i++)
+		{
+			context.target = &states[i].values;
+			if(states[i].is_initial)
+			{
+				initialise(context, current);
+				checkState(current, states[i]);
+				num_runs++;
+				continue;
+			}
+			step(context, current, next);
+			checkState(next, states[i]);
+			current.swap(next);
+		}
+	}
+	catch(std::string& error)
+	{
+		// the following simulations make random choices again
+		context.target = nullptr;
+		throw;
+	}
+	context.target = nullptr;
+	return states.size();
+}
+
+/*------------------------------------------------------------------------------
+	writeStatistics
+
+	Writes the statistics of the simulated steps.
+------------------------------------------------------------------------------*/
+void Simulator::writeStatistics(std::ostream& os) const
+{
+	os << "simulated " << context.num_steps << " steps in " << num_runs
+		<< " runs";
+	if(elapsed_seconds > 0)
+	{
+		os << ", " << (unsigned long long)(context.num_steps / elapsed_seconds)
+			<< " steps per second";
+	}
+	os << "\n";
+	for(unsigned int i = 1; i < behaviours.size(); i++)
+	{
+		os << "behaviour \'" << behaviours[i].name << "\': started "
+			<< context.num_started[i] << ", completed "
+			<< context.num_completed[i] << ", interrupted "
+			<< context.num_interrupted[i] << ", scheduled for "
+			<< context.num_scheduled_steps[i] << " steps\n";
+	}
+	os << "no behaviour scheduled for " << context.num_scheduled_steps[0]
+		<< " steps\n";
+}
+
+/*------------------------------------------------------------------------------
+	addField
+
+	Adds a field to the state vector.
+------------------------------------------------------------------------------*/
+const int Simulator::addField(const std::string& name,
+	const std::vector<std::string>& values, const int initial_value)
+{
+	SimulatorField field;
+	field.name = name;
+	field.values = values;
+	unsigned int bits = NuSMVTranslator::numBits(values.size());
+	field.mask = ((uint64_t)1 << bits) - 1;
+	// fields are packed one after another, and never straddle two words
+	int shift = 0;
+	if(!fields.empty())
+	{
+		shift = fields.back().shift
+			+ NuSMVTranslator::numBits(fields.back().values.size());
+	}
+	if(fields.empty() || shift + bits > 64)
+	{
+		num_words++;
+		shift = 0;
+	}
+	field.word = num_words - 1;
+	field.shift = shift;
+	fields.push_back(field);
+	field_index[name] = fields.size() - 1;
+	initial_field_values.push_back(initial_value);
+	return fields.size() - 1;
+}
+
+/*------------------------------------------------------------------------------
+	addNode
+
+	Adds a node to the compiled expressions.
+------------------------------------------------------------------------------*/
+const int Simulator::addNode(const SimulatorNodeType type, const int field,
+	const int low, const int high, const int left, const int right)
+{
+	SimulatorNode node;
+	node.type = type;
+	node.field = field;
+	node.low = low;
+	node.high = high;
+	node.left = left;
+	node.right = right;
+	nodes.push_back(node);
+	return nodes.size() - 1;
+}
+
+/*------------------------------------------------------------------------------
+	buildFields
+
+	Adds the fields of the time, step, schedule and last_schedule variables
+	and of the translated variables that are not constant.
+------------------------------------------------------------------------------*/
+void Simulator::buildFields()
+{
+	const IntermediateForm* intermediate_form = translator.intermediate_form;
+	if(!translator.time_intervals.empty())
+	{
+		// the time of day is chosen freely in every state
+		time_field = addField(TIME, std::vector<std::string>(
+			translator.time_intervals.begin(),
+			translator.time_intervals.end()), -1);
+		random_fields.push_back(time_field);
+	}
+	std::vector<std::string> step_values(1, std::string(STEP) + "_none");
+	for(int i = 1; i <= max_step; i++)
+	{
+		step_values.push_back(std::string(STEP) + "_" + integerToString(i));
+	}
+	step_field = addField(STEP, step_values, 0);
+	std::vector<std::string> schedule_names(1,
+		std::string(SCHEDULE) + "_none");
+	for(Behaviour* b : translator.behaviours)
+	{
+		schedule_names.push_back(std::string(SCHEDULE) + "_"
+			+ NuSMVTranslator::validateIdentifier(b->getName()));
+	}
+	schedule_field = addField(SCHEDULE, schedule_names, 0);
+	last_schedule_field = addField(LAST_SCHEDULE, schedule_names, 0);
+
+	const std::vector<std::string> truth_values = {"FALSE", "TRUE"};
+	for(PropVariable* p : intermediate_form->getPropVariables())
+	{
+		VariableClass variable_class =
+			translator.prop_variable_classes[p->getId()];
+		if(!translator.isTranslated(p) || variable_class == VARIABLE_CONSTANT)
+		{
+			// constant variables are folded into the preconditions
+			continue;
+		}
+		// frozen and non-deterministic variables start with any value
+		int initial_value = -1;
+		if(!p->isNonDeterministic() && variable_class == VARIABLE_DYNAMIC)
+		{
+			initial_value =
+				translator.prop_variable_constants[p->getId()] == "TRUE";
+		}
+		int field = addField(NuSMVTranslator::validateIdentifier(
+			p->getName()), truth_values, initial_value);
+		if(p->isNonDeterministic())
+		{
+			random_fields.push_back(field);
+		}
+	}
+	for(EnumVariable* e : intermediate_form->getEnumVariables())
+	{
+		VariableClass variable_class =
+			translator.enum_variable_classes[e->getId()];
+		if(!translator.isTranslated(e) || variable_class == VARIABLE_CONSTANT)
+		{
+			continue;
+		}
+		std::vector<std::string> values;
+		for(const std::string& value : e->getValues())
+		{
+			values.push_back(NuSMVTranslator::validateIdentifier(value));
+		}
+		const std::string& initial_name =
+			translator.enum_variable_constants[e->getId()];
+		bool is_resetting = !e->isNonDeterministic() && e->resets();
+		if(is_resetting
+			&& std::find(values.begin(), values.end(), initial_name)
+				== values.end())
+		{
+			values.push_back(initial_name);
+		}
+		int initial_value = -1;
+		if(!e->isNonDeterministic() && variable_class == VARIABLE_DYNAMIC
+			&& !initial_name.empty())
+		{
+			initial_value = std::find(values.begin(), values.end(),
+				initial_name) - values.begin();
+			if(initial_value == (int)values.size())
+			{
+				initial_value = -1;
+			}
+		}
+		int field = addField(NuSMVTranslator::validateIdentifier(
+			e->getName()), values, initial_value);
+		if(e->isNonDeterministic())
+		{
+			random_fields.push_back(field);
+		}
+		else if(is_resetting)
+		{
+			resetting_fields.push_back(std::make_pair(field, initial_value));
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildCounters
+
+	Adds the fields of the been_in_state and was_in_state counters, and
+	compiles the checks that they count.
+------------------------------------------------------------------------------*/
+void Simulator::buildCounters()
+{
+	for(int is_been_in_state = 1; is_been_in_state >= 0; is_been_in_state--)
+	{
+		const auto& counter_map = is_been_in_state ?
+			translator.been_in_state_map : translator.was_in_state_map;
+		for(const auto& pair : counter_map)
+		{
+			const std::list<std::string>& counter_values = pair.second.second;
+			std::vector<std::string> values;
+			for(const std::string& value : counter_values)
+			{
+				// integer counters are written as their index
+				values.push_back(translator.options.integer_counters ?
+					integerToString(values.size()) : value);
+			}
+			SimulatorCounter counter;
+			counter.field = addField(pair.first, values, 0);
+			counter.check = addCheckNode(pair.second.first, true);
+			counter.is_been_in_state = is_been_in_state;
+			counter.bound = values.size() - 1;
+			counters.push_back(counter);
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	buildBehaviours
+
+	Compiles the preconditions and actions of the translated behaviours, and
+	the order in which they are scheduled.
+------------------------------------------------------------------------------*/
+void Simulator::buildBehaviours()
+{
+	const std::vector<Behaviour*>& translated_behaviours =
+		translator.behaviours;
+	schedule_values.assign(
+		translator.intermediate_form->getBehaviours().size(), 0);
+	for(unsigned int i = 0; i < translated_behaviours.size(); i++)
+	{
+		schedule_values[translated_behaviours[i]->getId()] = i + 1;
+	}
+	// schedule_none has no preconditions or actions
+	SimulatorBehaviour none;
+	none.name = std::string(SCHEDULE) + "_none";
+	none.precondition = addNode(SIMULATOR_CONSTANT, -1, 0, 0, -1, -1);
+	none.priority = 0;
+	none.schedulable = false;
+	none.interruptible = false;
+	none.executable = false;
+	behaviours.assign(1, none);
+	for(Behaviour* b : translated_behaviours)
+	{
+		SimulatorBehaviour behaviour;
+		behaviour.name = b->getName();
+		LogicalExpressionTree* logical_expression_tree =
+			b->getLogicalExpressionTree();
+		behaviour.precondition = logical_expression_tree != nullptr ?
+			addPreconditionNode(logical_expression_tree->getRoot()) :
+			addNode(SIMULATOR_CONSTANT, -1, 1, 0, -1, -1);
+		behaviour.priority = b->getPriority();
+		behaviour.schedulable = b->isSchedulable();
+		behaviour.interruptible = b->isInterruptible();
+		behaviour.executable = std::find(
+			translator.executable_behaviours.begin(),
+			translator.executable_behaviours.end(), b)
+				!= translator.executable_behaviours.end();
+		for(Action* action : b->getActions())
+		{
+			SimulatorAction simulator_action;
+			simulator_action.type = action->getActionType();
+			simulator_action.field = -1;
+			simulator_action.value = -1;
+			if(action->getActionType() == ActionType::PROP_VALUE_ASSIGNMENT)
+			{
+				ActionPropValueAssignment* action_prop =
+					(ActionPropValueAssignment*)action;
+				PropVariable* prop_var = action_prop->getPropVariable();
+				if(translator.isDynamic(prop_var))
+				{
+					simulator_action.field = field_index.find(
+						NuSMVTranslator::validateIdentifier(
+							prop_var->getName()))->second;
+					simulator_action.value = action_prop->getTruthValue();
+				}
+			}
+			else if(action->getActionType() ==
+				ActionType::ENUM_VALUE_ASSIGNMENT)
+			{
+				ActionEnumValueAssignment* action_enum =
+					(ActionEnumValueAssignment*)action;
+				EnumVariable* enum_var = action_enum->getEnumVariable();
+				if(translator.isDynamic(enum_var))
+				{
+					int field = field_index.find(
+						NuSMVTranslator::validateIdentifier(
+							enum_var->getName()))->second;
+					simulator_action.value = getValueIndex(field,
+						NuSMVTranslator::validateIdentifier(
+							action_enum->getEnumValue()));
+					simulator_action.field =
+						simulator_action.value != -1 ? field : -1;
+				}
+			}
+			else if(action->getActionType() == ActionType::EXECUTE)
+			{
+				simulator_action.behaviours.push_back(schedule_values[
+					((ActionExecute*)action)->getBehaviourId()]);
+			}
+			else if(action->getActionType() == ActionType::EXECUTE_NON_D)
+			{
+				for(int behaviour_id : ((ActionExecuteNonDeterministic*)
+					action)->getBehaviourIds())
+				{
+					simulator_action.behaviours.push_back(
+						schedule_values[behaviour_id]);
+				}
+			}
+			behaviour.actions.push_back(simulator_action);
+		}
+		if(!behaviour.actions.empty())
+		{
+			behaviour.last_action_behaviours =
+				behaviour.actions.back().behaviours;
+		}
+		if(behaviour.interruptible)
+		{
+			for(Behaviour* s : translator.schedulable_behaviours)
+			{
+				if(s->getPriority() > behaviour.priority)
+				{
+					behaviour.interrupting_behaviours.push_back(
+						schedule_values[s->getId()]);
+				}
+			}
+		}
+		behaviours.push_back(behaviour);
+	}
+
+	if(translator.options.true_non_determinism)
+	{
+		// the schedulable behaviours are already sorted by priority, each
+		// group holds the behaviours of one priority
+		for(Behaviour* s : translator.schedulable_behaviours)
+		{
+			if(schedule_groups.empty() || behaviours[schedule_groups.back()
+				.front()].priority != s->getPriority())
+			{
+				schedule_groups.push_back(std::vector<int>());
+			}
+			schedule_groups.back().push_back(schedule_values[s->getId()]);
+		}
+	}
+	else
+	{
+		// the behaviours are scheduled in the order of the NuSMV model
+		std::vector<Behaviour*> prioritised_behaviours =
+			translator.schedulable_behaviours;
+		std::sort(prioritised_behaviours.begin(),
+			prioritised_behaviours.end(),
+			[&](Behaviour* this_behaviour, Behaviour* that_behaviour)
+			{
+				return this_behaviour->getPriority()
+					> that_behaviour->getPriority();
+			});
+		for(Behaviour* s : prioritised_behaviours)
+		{
+			schedule_groups.push_back(
+				std::vector<int>(1, schedule_values[s->getId()]));
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	addPreconditionNode
+
+	Recursively compiles an expression that evaluates to true if all of a
+	logical expression tree's preconditions hold.
+------------------------------------------------------------------------------*/
+const int Simulator::addPreconditionNode(const TreeNode* node)
+{
+	if(node->getNodeType() == TreeNodeType::INTERNAL_AND)
+	{
+		int left = addPreconditionNode(node->getLeft());
+		return addNode(SIMULATOR_AND, -1, 0, 0, left,
+			addPreconditionNode(node->getRight()));
+	}
+	else if(node->getNodeType() == TreeNodeType::INTERNAL_OR)
+	{
+		int left = addPreconditionNode(node->getLeft());
+		return addNode(SIMULATOR_OR, -1, 0, 0, left,
+			addPreconditionNode(node->getRight()));
+	}
+	else if(node->getNodeType() == TreeNodeType::INTERNAL_NOT)
+	{
+		return addNode(SIMULATOR_NOT, -1, 0, 0,
+			addPreconditionNode(node->getLeft()), -1);
+	}
+	Precondition* p = node->getPrecondition();
+	if(p->getPreconditionType() == PreconditionType::TIMING_CONSTRAINT)
+	{
+		PreconditionTimingConstraint* p_cast =
+			(PreconditionTimingConstraint*)p;
+		if(translator.options.time_of_day != "")
+		{
+			// the time of day has been set with -tod
+			return addNode(SIMULATOR_CONSTANT, -1,
+				NuSMVTranslator::timeConstraintHoldsAtTime(p_cast,
+					translator.options.time_of_day), 0, -1, -1);
+		}
+		int check = addNode(SIMULATOR_FIELD_IN_SET, time_field, 0, 0, -1,
+			-1);
+		nodes[check].values.assign(fields[time_field].values.size(), false);
+		for(const std::string& time :
+			*translator.timing_constraint_map.find(p_cast)->second)
+		{
+			nodes[check].values[getValueIndex(time_field, time)] = true;
+		}
+		return check;
+	}
+	int check = addCheckNode(p, false);
+	// if this has a time constraint add the check against its counter
+	auto it = translator.counter_steps.find(p);
+	if(it != translator.counter_steps.end())
+	{
+		int steps = it->second;
+		int field = field_index.find(
+			NuSMVTranslator::getCounterName(p))->second;
+		int counter = p->getTimeConstraintType() ==
+			TimeConstraintType::BEEN_IN_STATE_FOR ?
+			addNode(SIMULATOR_FIELD_IN_RANGE, field, steps,
+				fields[field].values.size() - 1, -1, -1) :
+			addNode(SIMULATOR_FIELD_IN_RANGE, field, 1, steps, -1, -1);
+		check = addNode(SIMULATOR_AND, -1, 0, 0, check, counter);
+	}
+	return check;
+}
+
+/*------------------------------------------------------------------------------
+	addCheckNode
+
+	Compiles the check that a variable has the value given by a propositional
+	or enumerated value check.
+------------------------------------------------------------------------------*/
+const int Simulator::addCheckNode(Precondition* p, const bool is_counted)
+{
+	std::string variable_name;
+	std::string value_name;
+	if(p->getPreconditionType() == PreconditionType::PROP_VALUE_CHECK)
+	{
+		PreconditionPropValueCheck* p_cast = (PreconditionPropValueCheck*)p;
+		PropVariable* prop_var = p_cast->getPropVariable();
+		if(translator.prop_variable_classes[prop_var->getId()]
+			== VARIABLE_CONSTANT)
+		{
+			// fold the check against the constant value
+			return addNode(SIMULATOR_CONSTANT, -1,
+				(translator.prop_variable_constants[prop_var->getId()]
+					== "TRUE") == p_cast->getTruthValue(), 0, -1, -1);
+		}
+		variable_name = prop_var->getName();
+		// the model checks that a non-deterministic variable is true,
+		// whatever the truth value of the precondition
+		value_name = p_cast->getTruthValue()
+			|| (prop_var->isNonDeterministic() && !is_counted) ?
+				"TRUE" : "FALSE";
+	}
+	else
+	{
+		PreconditionEnumValueCheck* p_cast = (PreconditionEnumValueCheck*)p;
+		EnumVariable* enum_var = p_cast->getEnumVariable();
+		value_name = NuSMVTranslator::validateIdentifier(
+			p_cast->getEnumValue());
+		if(translator.enum_variable_classes[enum_var->getId()]
+			== VARIABLE_CONSTANT)
+		{
+			return addNode(SIMULATOR_CONSTANT, -1,
+				translator.enum_variable_constants[enum_var->getId()]
+					== value_name, 0, -1, -1);
+		}
+		variable_name = enum_var->getName();
+	}
+	auto it = field_index.find(
+		NuSMVTranslator::validateIdentifier(variable_name));
+	int value = it != field_index.end() ?
+		getValueIndex(it->second, value_name) : -1;
+	if(value == -1)
+	{
+		// the variable can never hold the value
+		return addNode(SIMULATOR_CONSTANT, -1, 0, 0, -1, -1);
+	}
+	return addNode(SIMULATOR_FIELD_IN_RANGE, it->second, value, value, -1,
+		-1);
+}
+
+/*------------------------------------------------------------------------------
+	getValueIndex
+
+	Returns the index of a value of a field, or -1 if the field has no such
+	value.
+------------------------------------------------------------------------------*/
+const int Simulator::getValueIndex(const int field,
+	const std::string& value) const
+{
+	const std::vector<std::string>& values = fields[field].values;
+	auto it = std::find(values.begin(), values.end(), value);
+	return it != values.end() ? it - values.begin() : -1;
+}
+
+/*------------------------------------------------------------------------------
+	prepareContext
+
+	Sizes the working state of a context for the compiled behaviours.
+------------------------------------------------------------------------------*/
+void Simulator::prepareContext(SimulatorContext& c) const
+{
+	c.node_values.assign(nodes.size(), 0);
+	c.can_be_scheduled.assign(behaviours.size(), 0);
+	c.num_started.assign(behaviours.size(), 0);
+	c.num_completed.assign(behaviours.size(), 0);
+	c.num_interrupted.assign(behaviours.size(), 0);
+	c.num_scheduled_steps.assign(behaviours.size(), 0);
+}
+
+/*------------------------------------------------------------------------------
+	evaluate
+
+	Evaluates every compiled node in a state, the operands of each node
+	being evaluated before it.
+------------------------------------------------------------------------------*/
+void Simulator::evaluate(SimulatorContext& c,
+	const std::vector<uint64_t>& state) const
+{
+	for(unsigned int i = 0; i < nodes.size(); i++)
+	{
+		const SimulatorNode& node = nodes[i];
+		switch(node.type)
+		{
+			case SIMULATOR_CONSTANT:
+				c.node_values[i] = node.low;
+				break;
+			case SIMULATOR_FIELD_IN_RANGE:
+			{
+				int value = getField(state, node.field);
+				c.node_values[i] = node.low <= value && value <= node.high;
+				break;
+			}
+			case SIMULATOR_FIELD_IN_SET:
+				c.node_values[i] = node.values[getField(state, node.field)];
+				break;
+			case SIMULATOR_NOT:
+				c.node_values[i] = !c.node_values[node.left];
+				break;
+			case SIMULATOR_AND:
+				c.node_values[i] = c.node_values[node.left]
+					&& c.node_values[node.right];
+				break;
+			case SIMULATOR_OR:
+				c.node_values[i] = c.node_values[node.left]
+					|| c.node_values[node.right];
+				break;
+		}
+	}
+}
+
+/*------------------------------------------------------------------------------
+	choose
+
+	Chooses one of a number of options. When every combination of choices is
+	enumerated, a choice that has not been made before in this combination
+	takes its first option.
+------------------------------------------------------------------------------*/
+const int Simulator::choose(SimulatorContext& c, const int num) const
+{
+	if(!c.is_enumerating)
+	{
+		return c.random_engine() % num;
+	}
+	if(c.choice_num == c.choices.size())
+	{
+		c.choices.push_back(0);
+		c.num_options.push_back(num);
+	}
+	return c.choices[c.choice_num++];
+}
+
+/*------------------------------------------------------------------------------
+	nextChoices
+
+	Moves on to the next combination of choices, taking the next option of
+	the last choice that has one left, and forgetting the choices after it.
+------------------------------------------------------------------------------*/
+const bool Simulator::nextChoices(SimulatorContext& c) const
+{
+	c.choice_num = 0;
+	while(!c.choices.empty())
+	{
+		if(++c.choices.back() < c.num_options.back())
+		{
+			return true;
+		}
+		c.choices.pop_back();
+		c.num_options.pop_back();
+	}
+	return false;
+}
+
+/*------------------------------------------------------------------------------
+	chooseValue
+
+	Chooses any value of a field, taking the value from the trace being
+	replayed if there is one.
+------------------------------------------------------------------------------*/
+const int Simulator::chooseValue(SimulatorContext& c, const int field) const
+{
+	if(c.target != nullptr && (*c.target)[field] != -1)
+	{
+		return (*c.target)[field];
+	}
+	return choose(c, fields[field].values.size());
+}
+
+/*------------------------------------------------------------------------------
+	chooseCandidate
+
+	Chooses one of the given values of a field, taking the value from the
+	trace being replayed if it is one of them. Otherwise the state differs
+	from the trace whichever value is chosen.
+------------------------------------------------------------------------------*/
+const int Simulator::chooseCandidate(SimulatorContext& c, const int field,
+	const std::vector<int>& values) const
+{
+	if(c.target != nullptr && std::find(values.begin(), values.end(),
+		(*c.target)[field]) != values.end())
+	{
+		return (*c.target)[field];
+	}
+	return values[choose(c, values.size())];
+}
+
+/*------------------------------------------------------------------------------
+	initialise
+
+	Sets a state to an initial state of the NuSMV model.
+------------------------------------------------------------------------------*/
+void Simulator::initialise(SimulatorContext& c,
+	std::vector<uint64_t>& state) const
+{
+	std::fill(state.begin(), state.end(), 0);
+	for(unsigned int field = 0; field < fields.size(); field++)
+	{
+		setField(state, field, initial_field_values[field] != -1 ?
+			initial_field_values[field] : chooseValue(c, field));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	step
+
+	Sets a state to a successor of the current state, following the
+	assignments of the NuSMV model case by case.
+------------------------------------------------------------------------------*/
+void Simulator::step(SimulatorContext& c,
+	const std::vector<uint64_t>& current, std::vector<uint64_t>& next) const
+{
+	evaluate(c, current);
+	const int schedule = getField(current, schedule_field);
+	const int step_num = getField(current, step_field);
+	const int last_schedule = getField(current, last_schedule_field);
+	const SimulatorBehaviour& scheduled = behaviours[schedule];
+	// the action of the scheduled behaviour at the current step
+	const SimulatorAction* action = schedule != 0 && step_num >= 1
+		&& step_num <= (int)scheduled.actions.size() ?
+			&scheduled.actions[step_num - 1] : nullptr;
+
+	bool a_behaviour_can_be_scheduled = false;
+	for(const std::vector<int>& group : schedule_groups)
+	{
+		for(int b : group)
+		{
+			// a behaviour can interrupt an interruptible schedulable
+			// behaviour of lower priority
+			c.can_be_scheduled[b] = c.node_values[behaviours[b].precondition]
+				&& (schedule == 0 || (scheduled.schedulable
+					&& scheduled.interruptible
+					&& scheduled.priority < behaviours[b].priority));
+			a_behaviour_can_be_scheduled |= c.can_be_scheduled[b];
+		}
+	}
+	const bool is_ending = schedule != 0 && !scheduled.actions.empty()
+		&& step_num == (int)scheduled.actions.size();
+	const bool a_behaviour_is_ending = is_ending && scheduled.schedulable;
+	const bool an_executed_behaviour_is_ending =
+		is_ending && scheduled.executable;
+	const std::vector<int>& last_action_behaviours =
+		behaviours[last_schedule].last_action_behaviours;
+	const bool is_ending_as_a_last_action = is_ending
+		&& std::find(last_action_behaviours.begin(),
+			last_action_behaviours.end(), schedule)
+				!= last_action_behaviours.end();
+	const bool executes = action != nullptr
+		&& (action->type == ActionType::EXECUTE
+			|| action->type == ActionType::EXECUTE_NON_D);
+	bool can_be_interrupted = false;
+	for(int b : scheduled.interrupting_behaviours)
+	{
+		can_be_interrupted |= c.can_be_scheduled[b];
+	}
+
+	next = current;
+	for(const std::pair<int, int>& pair : resetting_fields)
+	{
+		setField(next, pair.first, pair.second);
+	}
+	if(action != nullptr && action->field != -1)
+	{
+		setField(next, action->field, action->value);
+	}
+	for(int field : random_fields)
+	{
+		setField(next, field, chooseValue(c, field));
+	}
+	for(const SimulatorCounter& counter : counters)
+	{
+		int value = getField(current, counter.field);
+		if(counter.is_been_in_state)
+		{
+			// count the steps the check has held for, up to the bound
+			value = c.node_values[counter.check] ?
+				std::min(value + 1, counter.bound) : 0;
+		}
+		else
+		{
+			// count the steps since the check last held, until the bound
+			// is passed
+			value = c.node_values[counter.check] ? 1 :
+				(value != 0 && value < counter.bound ? value + 1 : 0);
+		}
+		setField(next, counter.field, value);
+	}
+
+	int next_schedule;
+	int next_step;
+	if(a_behaviour_can_be_scheduled)
+	{
+		// schedule a behaviour of the highest priority group that has one
+		next_schedule = 0;
+		for(const std::vector<int>& group : schedule_groups)
+		{
+			c.candidates.clear();
+			for(int b : group)
+			{
+				if(c.can_be_scheduled[b])
+				{
+					c.candidates.push_back(b);
+				}
+			}
+			if(!c.candidates.empty())
+			{
+				next_schedule = chooseCandidate(c, schedule_field,
+					c.candidates);
+				break;
+			}
+		}
+		next_step = 1;
+		c.num_started[next_schedule]++;
+		if(schedule != 0 && !is_ending)
+		{
+			c.num_interrupted[schedule]++;
+		}
+	}
+	else if(executes && !action->behaviours.empty()
+		&& (action->type == ActionType::EXECUTE_NON_D
+			|| c.node_values[behaviours[action->behaviours[0]].precondition]))
+	{
+		// an executed behaviour is scheduled, without checking the
+		// preconditions of a non-deterministic choice
+		next_schedule = action->type == ActionType::EXECUTE ?
+			action->behaviours[0] :
+			chooseCandidate(c, schedule_field, action->behaviours);
+		next_step = 1;
+		c.num_started[next_schedule]++;
+	}
+	else
+	{
+		next_step = is_ending && last_schedule != 0 ?
+			getResumeStep(schedule, last_schedule) : 0;
+		if(next_step == 0 && !a_behaviour_is_ending
+			&& !is_ending_as_a_last_action && step_num >= 1
+			&& step_num < max_step)
+		{
+			next_step = step_num + 1;
+		}
+		if(a_behaviour_is_ending || is_ending_as_a_last_action)
+		{
+			next_schedule = 0;
+		}
+		else if(an_executed_behaviour_is_ending)
+		{
+			// return to the executing behaviour
+			next_schedule = last_schedule != schedule ? last_schedule : 0;
+		}
+		else
+		{
+			next_schedule = schedule;
+		}
+	}
+	setField(next, schedule_field, next_schedule);
+	setField(next, step_field, next_step);
+	setField(next, last_schedule_field,
+		(executes && !can_be_interrupted) || scheduled.executable ?
+			last_schedule : schedule);
+
+	c.num_scheduled_steps[schedule]++;
+	if(is_ending)
+	{
+		c.num_completed[schedule]++;
+	}
+	c.num_steps++;
+}
+
+/*------------------------------------------------------------------------------
+	getResumeStep
+
+	Returns the step at which an executing behaviour resumes after the
+	behaviour it executed ends, or 0 if there is no such step.
+------------------------------------------------------------------------------*/
+const int Simulator::getResumeStep(const int schedule,
+	const int last_schedule) const
+{
+	const std::vector<SimulatorAction>& actions =
+		behaviours[last_schedule].actions;
+	// executions by the last action end the executing behaviour instead
+	for(unsigned int i = 0; i + 1 < actions.size(); i++)
+	{
+		if((actions[i].type == ActionType::EXECUTE
+			|| actions[i].type == ActionType::EXECUTE_NON_D)
+			&& std::find(actions[i].behaviours.begin(),
+				actions[i].behaviours.end(), schedule)
+					!= actions[i].behaviours.end())
+		{
+			return i + 2;
+		}
+	}
+	return 0;
+}
+
+/*------------------------------------------------------------------------------
+	parseTrace
+
+	Parses the traces written by NuSMV. Each state gives the values of the
+	variables that have changed since the previous state of its trace, and
+	each trace begins with a description.
+------------------------------------------------------------------------------*/
+void Simulator::parseTrace(const std::string& filename,
+	std::vector<TraceState>& states) const throw(std::string)
+{
+	FileSource file_source(filename);
+	if(!file_source.isOpen())
+	{
+		throw("error loading file \'" + filename + "\'");
+	}
+	TokenCursor file_cursor(file_source.getSpan());
+	int line_number = 0;
+	// false while reading the values of inputs
+	bool is_state = false;
+	// true until the first state of a trace has been read
+	bool is_new_trace = true;
+	while(!file_cursor.atEnd())
+	{
+		TokenCursor line(file_cursor.getNextLine());
+		line_number++;
+		if(!line.hasNextToken())
+		{
+			continue;
+		}
+		std::string name = line.getNextToken().str();
+		if(name == "Trace" && line.hasNextToken()
+			&& line.getNextToken() == "Description:")
+		{
+			is_new_trace = true;
+			continue;
+		}
+		if(name == "->")
+		{
+			// a header such as "-> State: 1.2 <-" or "-> Input: 1.2 <-"
+			is_state = line.hasNextToken()
+				&& line.getNextToken() == "State:";
+			if(is_state)
+			{
+				TraceState state;
+				state.name = line.hasNextToken() ?
+					line.getNextToken().str() : "";
+				state.is_initial = is_new_trace;
+				state.values = is_new_trace ?
+					std::vector<int>(fields.size(), -1) :
+					states.back().values;
+				states.push_back(state);
+				is_new_trace = false;
+			}
+			continue;
+		}
+		auto it = field_index.find(name);
+		if(!is_state || it == field_index.end() || !line.hasNextToken()
+			|| line.getNextToken() != "=" || !line.hasNextToken())
+		{
+			// not the value of a field
+			continue;
+		}
+		std::string value = line.getNextToken().str();
+		int index = getValueIndex(it->second, value);
+		if(index == -1)
+		{
+			throw("\'" + value + "\' is not a value of \'" + name
+				+ "\' on line " + integerToString(line_number)
+				+ " of trace file \'" + filename + "\'");
+		}
+		states.back().values[it->second] = index;
+	}
+}
+
+/*------------------------------------------------------------------------------
+	checkState
+
+	Throws an error if a simulated state differs from a state of a trace.
+------------------------------------------------------------------------------*/
+void Simulator::checkState(const std::vector<uint64_t>& state,
+	const TraceState& trace_state) const throw(std::string)
+{
+	for(unsigned int field = 0; field < fields.size(); field++)
+	{
+		int value = getField(state, field);
+		int trace_value = trace_state.values[field];
+		if(trace_value != -1 && trace_value != value)
+		{
+			throw("in state " + trace_state.name + " the simulated value of \'"
+				+ fields[field].name + "\' is \'" + fields[field].values[value]
+				+ "\' but the trace gives \'"
+				+ fields[field].values[trace_value] + "\'");
+		}
+	}
+}
@@ -0,0 +1,240 @@
+/*==============================================================================
+	AllocationCounter
+
+	Counts the memory allocated through the global operator new, so that the
+	peak memory use of each phase of a translation can be reported.
+
+	File			: allocation_counter.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+#include "statistics/allocation_counter.h"
+
+/*------------------------------------------------------------------------------
+	True once counting has been enabled. Until then the allocation functions
+	only call malloc and free, and touch no shared counters.
+------------------------------------------------------------------------------*/
+static std::atomic<bool> is_counting(false);
+
+/*------------------------------------------------------------------------------
+	The bytes are signed, since a block allocated before counting was
+	enabled may be released after it.
+------------------------------------------------------------------------------*/
+static std::atomic<unsigned long long> num_allocations(0);
+static std::atomic<long long> allocated_bytes(0);
+static std::atomic<long long> peak_allocated_bytes(0);
+
+/*------------------------------------------------------------------------------
+	getBlockSize
+
+	Returns the size of a block returned by malloc, so that no header is
+	needed to remember the size that was asked for.
+------------------------------------------------------------------------------*/
+static long long getBlockSize(void* block)
+{
+#ifdef _WIN32
+	return _msize(block);
+#else
+	return malloc_usable_size(block);
+#endif
+}
+
+/*------------------------------------------------------------------------------
+	allocate
+
+	Allocates a block of memory, counting it if counting is enabled, and
+	returns null if it could not be allocated.
+------------------------------------------------------------------------------*/
+static void* allocate(std::size_t size)
+{
+	void* block = std::malloc(size ? size : 1);
+	if(block == nullptr || !is_counting.load(std::memory_order_relaxed))
+	{
+		return block;
+	}
+	long long size_of_block = getBlockSize(block);
+	num_allocations.fetch_add(1, std::memory_order_relaxed);
+	long long bytes = allocated_bytes.fetch_add(size_of_block,
+		std::memory_order_relaxed) + size_of_block;
+	long long peak = peak_allocated_bytes.load(std::memory_order_relaxed);
+	while(bytes > peak && !peak_allocated_bytes.compare_exchange_weak(
+		peak, bytes, std::memory_order_relaxed))
+	{
+	}
+	return block;
+}
+
+/*------------------------------------------------------------------------------
+	allocateOrThrow
+
+	Allocates and counts a block of memory, calling the new handler until
+	it can be allocated or throwing std::bad_alloc if there is none.
+------------------------------------------------------------------------------*/
+static void* allocateOrThrow(std::size_t size)
+{
+	void* p;
+	while((p = allocate(size)) == nullptr)
+	{
+		std::new_handler handler = std::get_new_handler();
+		if(handler == nullptr)
+		{
+			throw std::bad_alloc();
+		}
+		handler();
+	}
+	return p;
+}
+
+/*------------------------------------------------------------------------------
+	release
+
+	Releases a block of memory allocated by allocate, counting it if
+	counting is enabled.
+------------------------------------------------------------------------------*/
+static void release(void* p)
+{
+	if(p == nullptr)
+	{
+		return;
+	}
+	if(is_counting.load(std::memory_order_relaxed))
+	{
+		allocated_bytes.fetch_sub(getBlockSize(p), std::memory_order_relaxed);
+	}
+	std::free(p);
+}
+
+/*------------------------------------------------------------------------------
+	replacements of the global allocation functions
+------------------------------------------------------------------------------*/
+void* operator new(std::size_t size)
+{
+	return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size)
+{
+	return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+	return allocate(size);
+}
+
+void operator delete(void* p) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+	release(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept
+{
+	release(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	release(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept
+{
+	release(p);
+}
+
+/*------------------------------------------------------------------------------
+	enable
+
+	Starts counting the allocations made from now on.
+------------------------------------------------------------------------------*/
+void AllocationCounter::enable()
+{
+	is_counting.store(true, std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------
+	getNumAllocations
+
+	Returns the number of allocations made so far.
+------------------------------------------------------------------------------*/
+const unsigned long long AllocationCounter::getNumAllocations()
+{
+	return num_allocations.load(std::memory_order_relaxed);
+}
+
+/*------------------------------------------------------------------------------
+	getAllocatedBytes
+
+	Returns the number of bytes allocated and not yet released.
+------------------------------------------------------------------------------*/
+const std::size_t AllocationCounter::getAllocatedBytes()
+{
+	long long bytes = allocated_bytes.load(std::memory_order_relaxed);
+	return bytes > 0 ? bytes : 0;
+}
+
+/*------------------------------------------------------------------------------
+	getPeakAllocatedBytes
+
+	Returns the largest number of bytes allocated at once since the peak was
+	last reset.
+------------------------------------------------------------------------------*/
+const std::size_t AllocationCounter::getPeakAllocatedBytes()
+{
+	long long bytes = peak_allocated_bytes.load(std::memory_order_relaxed);
+	return bytes > 0 ? bytes : 0;
+}
+
+/*------------------------------------------------------------------------------
+	resetPeakAllocatedBytes
+
+	Resets the peak to the number of bytes allocated now.
+------------------------------------------------------------------------------*/
+void AllocationCounter::resetPeakAllocatedBytes()
+{
+	peak_allocated_bytes.store(allocated_bytes.load(std::memory_order_relaxed),
+		std::memory_order_relaxed);
+}
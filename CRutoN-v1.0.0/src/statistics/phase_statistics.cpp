@@ -0,0 +1,101 @@
+/*==============================================================================
+	PhaseStatistics
+
+	Records the wall time and memory use of each phase of parsing and
+	translation.
+
+	File			: phase_statistics.cpp
+	Author			: Paul Gainer
+	Created			: 17/10/2026
+	Last modified	: 17/10/2026
+==============================================================================*/
+/*<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>
+/==============================================================================\
+|   Copyright (C) 2015 Paul Gainer, University of Liverpool                    |
+|                                                                              |
+|   This file is part of CRuToN.                                               |
+|                                                                              |
+|   CRuToN is free software; you can redistribute it and/or modify it          |
+|   under the terms of the GNU General Public License as published by the Free |
+|   Software Foundation, either version 3 of the License; or (at your option)  |
+|   any later version.                                                         |
+|                                                                              |
+|   CruToN is distributed in the hope that it will be useful, but WITHOUT      |
+|   ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or      |
+|   FITNESS FOR A PARTICULAR PURPOSE. See the GNU General Public License for   |
+|   more details.                                                              |
+|                                                                              |
+|   You should have received a copy of the GNU General Public License along    |
+|   with CRuToN. If not, see <http:/www.gnu.org/licenses/>.                    |
+|																			   |
+\==============================================================================/
+<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
+#include <chrono>
+#include <ostream>
+#include <string>
+
+#include "statistics/allocation_counter.h"
+#include "statistics/phase_statistics.h"
+
+/*------------------------------------------------------------------------------
+	beginPhase
+
+	Begins a phase, ending the current phase if there is one.
+------------------------------------------------------------------------------*/
+void PhaseStatistics::beginPhase(const std::string& name)
+{
+	endPhase();
+	is_in_phase = true;
+	phase_name = name;
+	start_num_allocations = AllocationCounter::getNumAllocations();
+	AllocationCounter::resetPeakAllocatedBytes();
+	start_time = std::chrono::steady_clock::now();
+}
+
+/*------------------------------------------------------------------------------
+	endPhase
+
+	Ends the current phase, if there is one, and records its statistics.
+------------------------------------------------------------------------------*/
+void PhaseStatistics::endPhase()
+{
+	if(!is_in_phase)
+	{
+		return;
+	}
+	Phase phase;
+	phase.seconds = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start_time).count();
+	phase.num_allocations = AllocationCounter::getNumAllocations()
+		- start_num_allocations;
+	phase.peak_bytes = AllocationCounter::getPeakAllocatedBytes();
+	phase.end_bytes = AllocationCounter::getAllocatedBytes();
+	phase.name = phase_name;
+	phases.push_back(phase);
+	is_in_phase = false;
+}
+
+/*------------------------------------------------------------------------------
+	writeJson
+
+	Writes the statistics of each phase as a JSON array.
+------------------------------------------------------------------------------*/
+void PhaseStatistics::writeJson(std::ostream& os, const int num_tabs) const
+{
+	std::string indent(num_tabs, '\t');
+	os << "[";
+	for(unsigned int i = 0; i < phases.size(); i++)
+	{
+		// phase names are identifiers, and need no escaping
+		os << (i == 0 ? "\n" : ",\n") << indent << "{\"name\": \""
+			<< phases[i].name << "\", \"seconds\": " << phases[i].seconds
+			<< ", \"allocations\": " << phases[i].num_allocations
+			<< ", \"peak_bytes\": " << phases[i].peak_bytes
+			<< ", \"end_bytes\": " << phases[i].end_bytes << "}";
+	}
+	if(!phases.empty())
+	{
+		os << "\n" << std::string(num_tabs - 1, '\t');
+	}
+	os << "]";
+}
@@ -28,11 +28,14 @@
 \==============================================================================/
 <<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<<>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>>*/
 #include <algorithm>
+#include <bitset>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 #include <locale>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include "define.h"
 #include "global.h"
@@ -201,6 +204,19 @@ const bool caseInsensitiveCompare(const std::string& s_1,
 	return true;
 }
 
+/*------------------------------------------------------------------------------
+	similarityPercentage
+
+	Returns the similarity (as a percentage) of two strings of length m and n
+	having an LCS of the given length.
+------------------------------------------------------------------------------*/
+static const int similarityPercentage(const int lcs_length, const int m,
+	const int n)
+{
+	int max_length = m > n ? m : n;
+	return (float)lcs_length / (float)max_length * 100.0f;
+}
+
 /*------------------------------------------------------------------------------
 	compareStrings
 
@@ -220,30 +236,25 @@ const std::pair<const std::string, const int> compareStrings(
 	}
 	else
 	{
-		int lcs[m + 1][n + 1];
-		for(int i = 1; i <= m; i++)
-		{
-			lcs[i][0] = 0;
-		}
-		for(int j = 0; j <= n; j++)
-		{
-			lcs[0][j] = 0;
-		}
+		// the table is kept on the heap since rule text can be long
+		int width = n + 1;
+		std::vector<int> lcs((m + 1) * width, 0);
 		for(int i = 1; i <= m; i++)
 		{
 			for(int j = 1; j <= n; j++)
 			{
-				if(this_string.at(i - 1) == that_string.at(j - 1))
+				int index = i * width + j;
+				if(this_string[i - 1] == that_string[j - 1])
 				{
-					lcs[i][j] = lcs[i - 1][j - 1] + 1;
+					lcs[index] = lcs[index - width - 1] + 1;
 				}
-				else if(lcs[i - 1][j] >= lcs[i][j - 1])
+				else if(lcs[index - width] >= lcs[index - 1])
 				{
-					lcs[i][j] = lcs[i - 1][j];
+					lcs[index] = lcs[index - width];
 				}
 				else
 				{
-					lcs[i][j] = lcs[i][j - 1];
+					lcs[index] = lcs[index - 1];
 				}
 			}
 		}
@@ -253,14 +264,14 @@ const std::pair<const std::string, const int> compareStrings(
 		int j = n;
 		while(i > 0 && j > 0)
 		{
-			if(lcs[i][j] == lcs[i - 1][j - 1] + 1)
+			int index = i * width + j;
+			if(lcs[index] == lcs[index - width - 1] + 1)
 			{
-				subsequence = this_string.at(i - 1) + subsequence;
+				subsequence += this_string[i - 1];
 				i--;
 				j--;
 			}
-
-			else if(lcs[i][j] == lcs[i - 1][j])
+			else if(lcs[index] == lcs[index - width])
 			{
 				i--;
 			}
@@ -269,11 +280,131 @@ const std::pair<const std::string, const int> compareStrings(
 				j--;
 			}
 		}
+		std::reverse(subsequence.begin(), subsequence.end());
+
+		return std::pair<const std::string, const int>(subsequence,
+			similarityPercentage(lcs[m * width + n], m, n));
+	}
+}
+
+/*------------------------------------------------------------------------------
+	stringSimilarity
+
+	Calculates the similarity (as a percentage) of the two strings without
+	constructing their LCS.
+
+	The length of the LCS is computed with the bit-parallel algorithm of
+	Allison and Dix (in the form given by Hyyro), one 64-bit word for every
+	64 characters of the shorter string. Bit i of the vector v is cleared
+	once the i^th character of the shorter string has been used in the LCS
+	of the prefix of the longer string processed so far, so the LCS length
+	is the number of cleared bits. For each character of the longer string:
+
+		u = v & match[c]
+		v = (v + u) | (v & ~match[c])
+
+	where the addition carries across words. After each character the LCS can
+	grow by at most the number of characters still to be processed, so the
+	computation stops as soon as the threshold cannot be reached.
+------------------------------------------------------------------------------*/
+const int stringSimilarity(const std::string& this_string,
+	const std::string& that_string, const int threshold)
+{
+	const std::string& shorter = this_string.size() <= that_string.size()
+		? this_string : that_string;
+	const std::string& longer = this_string.size() <= that_string.size()
+		? that_string : this_string;
+	int m = shorter.size();
+	int n = longer.size();
+	if(m == 0)
+	{
+		return 0;
+	}
+	if(similarityPercentage(m, m, n) < threshold)
+	{
+		return similarityPercentage(m, m, n);
+	}
+
+	const int num_words = (m + 63) / 64;
+	const int tail_bits = m - (num_words - 1) * 64;
+	const std::uint64_t tail_mask = tail_bits == 64
+		? ~(std::uint64_t)0 : ((std::uint64_t)1 << tail_bits) - 1;
+
+	// match[c * num_words + w] has bit i set if shorter[w * 64 + i] == c
+	std::vector<std::uint64_t> match(256 * num_words, 0);
+	for(int i = 0; i < m; i++)
+	{
+		match[(unsigned char)shorter[i] * num_words + i / 64]
+			|= (std::uint64_t)1 << (i % 64);
+	}
+
+	std::vector<std::uint64_t> v(num_words, ~(std::uint64_t)0);
+	v[num_words - 1] = tail_mask;
+	int lcs_length = 0;
+	for(int j = 0; j < n; j++)
+	{
+		const std::uint64_t* match_c =
+			&match[(unsigned char)longer[j] * num_words];
+		std::uint64_t carry = 0;
+		lcs_length = 0;
+		for(int w = 0; w < num_words; w++)
+		{
+			std::uint64_t u = v[w] & match_c[w];
+			std::uint64_t sum = v[w] + u;
+			std::uint64_t next_carry = sum < v[w] ? 1 : 0;
+			sum += carry;
+			next_carry |= sum < carry ? 1 : 0;
+			carry = next_carry;
+			v[w] = sum | (v[w] & ~match_c[w]);
+		}
+		v[num_words - 1] &= tail_mask;
+		for(int w = 0; w < num_words; w++)
+		{
+			lcs_length += std::bitset<64>(v[w]).count();
+		}
+		lcs_length = m - lcs_length;
+
+		int bound = lcs_length + (n - j - 1);
+		if(bound < m && similarityPercentage(bound, m, n) < threshold)
+		{
+			return similarityPercentage(bound, m, n);
+		}
+	}
+	return similarityPercentage(lcs_length, m, n);
+}
 
-		int max_length = m > n ? m : n;
-		int similarity = (float)lcs[m][n] / (float)max_length * 100.0f;
-		return std::pair<const std::string, const int>(subsequence, similarity);
+/*------------------------------------------------------------------------------
+	similarityUpperBound
+
+	Returns an upper bound on the similarity that compareStrings would return
+	for the two strings. The LCS can contain each character no more often than
+	it occurs in either string, so the number of characters the two strings
+	have in common bounds the length of the LCS.
+------------------------------------------------------------------------------*/
+const int similarityUpperBound(const std::string& this_string,
+	const std::string& that_string)
+{
+	int m = this_string.size();
+	int n = that_string.size();
+	if(n == 0 || m == 0)
+	{
+		return 0;
+	}
+	int counts[256] = {0};
+	for(char c : this_string)
+	{
+		counts[(unsigned char)c]++;
+	}
+	int common = 0;
+	for(char c : that_string)
+	{
+		if(counts[(unsigned char)c]-- > 0)
+		{
+			common++;
+		}
 	}
+	int max_length = m > n ? m : n;
+	return (float)common / (float)max_length * 100.0f;
 }
 
 /*------------------------------------------------------------------------------